@@ -104,6 +104,20 @@ set_target_properties(cudaq::cudaq-qpp-cpu-target PROPERTIES
   IMPORTED_SONAME "libnvqir-qpp${CMAKE_SHARED_LIBRARY_SUFFIX}"
   IMPORTED_LINK_INTERFACE_LIBRARIES "cudaq::cudaq-platform-default;cudaq::cudaq-em-default")
 
+# QPP CPU SIMD Target
+add_library(cudaq::cudaq-qpp-cpu-simd-target SHARED IMPORTED)
+set_target_properties(cudaq::cudaq-qpp-cpu-simd-target PROPERTIES
+  IMPORTED_LOCATION "${CUDAQ_LIBRARY_DIR}/libnvqir-qpp-simd${CMAKE_SHARED_LIBRARY_SUFFIX}"
+  IMPORTED_SONAME "libnvqir-qpp-simd${CMAKE_SHARED_LIBRARY_SUFFIX}"
+  IMPORTED_LINK_INTERFACE_LIBRARIES "cudaq::cudaq-platform-default;cudaq::cudaq-em-default")
+
+# QPP CPU MPI Target
+add_library(cudaq::cudaq-qpp-cpu-mpi-target SHARED IMPORTED)
+set_target_properties(cudaq::cudaq-qpp-cpu-mpi-target PROPERTIES
+  IMPORTED_LOCATION "${CUDAQ_LIBRARY_DIR}/libnvqir-qpp-mpi${CMAKE_SHARED_LIBRARY_SUFFIX}"
+  IMPORTED_SONAME "libnvqir-qpp-mpi${CMAKE_SHARED_LIBRARY_SUFFIX}"
+  IMPORTED_LINK_INTERFACE_LIBRARIES "cudaq::cudaq-platform-default;cudaq::cudaq-em-default")
+
 # QPP CPU DensityMatrix Target
 add_library(cudaq::cudaq-qpp-density-matrix-cpu-target SHARED IMPORTED)
 set_target_properties(cudaq::cudaq-qpp-density-matrix-cpu-target PROPERTIES
@@ -0,0 +1,69 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace cudaq::opt {
+
+/// Resources used by a kernel, determined statically from its Quake IR rather
+/// than by tracing an execution. Loops with a compile-time constant number of
+/// iterations multiply the counts of their body, and calls multiply the
+/// counts of the callee, so the cost of the analysis does not depend on the
+/// number of gates executed. All counts saturate at `UINT64_MAX`.
+struct ResourceCounts {
+  /// The number of each quantum operator, by name and number of controls.
+  std::map<std::pair<std::string, std::size_t>, std::uint64_t> gates;
+  /// The number of qubits measured and reset.
+  std::uint64_t measurements = 0;
+  std::uint64_t resets = 0;
+  /// The number of uncontrolled `t` (and adjoint `t`) gates.
+  std::uint64_t tCount = 0;
+  /// An upper bound on the circuit depth, counting gates and measurements.
+  std::uint64_t depth = 0;
+  /// The maximum number of qubits allocated at the same time.
+  std::uint64_t qubits = 0;
+  /// The number of qubits allocated but not deallocated by the kernel.
+  std::uint64_t liveQubits = 0;
+  /// False if the counts are upper bounds, because of conditionals or loops
+  /// that may exit early.
+  bool exact = true;
+  /// False if some counts are missing, because of loops with unknown trip
+  /// counts (their body is counted once), registers of unknown size, indirect
+  /// or recursive calls.
+  bool bounded = true;
+
+  /// Return the total number of quantum operators.
+  std::uint64_t getTotalGates() const;
+};
+
+/// Computes the `ResourceCounts` of functions, reusing the counts of callees
+/// across queries.
+class ResourceCounter {
+public:
+  /// Return the resources of `func`. The counts of a function with a
+  /// compile-time constant size are exact only after its arguments have been
+  /// synthesized, and loops normalized (e.g., by `quake-synth`,
+  /// `canonicalize` and `cc-loop-normalize`).
+  const ResourceCounts &count(mlir::func::FuncOp func);
+
+private:
+  llvm::DenseMap<mlir::Operation *, ResourceCounts> cache;
+  llvm::SmallPtrSet<mlir::Operation *, 4> inProgress;
+};
+
+/// Convenience wrapper around `ResourceCounter` for a single function.
+ResourceCounts countResources(mlir::func::FuncOp func);
+
+} // namespace cudaq::opt
@@ -11,6 +11,8 @@
 #include "cudaq/ADT/GraphCSR.h"
 #include "cudaq/Support/Graph.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include <cmath>
+#include <limits>
 
 namespace cudaq {
 
@@ -209,7 +211,201 @@ public:
     return device;
   }
 
-  /// TODO: Implement a method to load device info from a file.
+  /// Read calibration data from a file, and return false if it cannot be
+  /// read. The file lists the properties of qubits and couplers, one per line,
+  /// as:
+  ///
+  ///   Qubit <Node>: readout_error <p>, t1 <T1>, t2 <T2>
+  ///   Coupler <Node1> <Node2>: fidelity <f>
+  ///   Gate time: <t>
+  ///
+  /// where any property may be omitted (a qubit or coupler without data is
+  /// assumed to be perfect), and `<t>` is the duration of a two-qubit gate in
+  /// the same unit as T1 and T2. Lines starting with '#' are comments.
+  bool loadCalibration(llvm::StringRef filename) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> fileBuffer =
+        llvm::MemoryBuffer::getFile(filename);
+    if (std::error_code EC = fileBuffer.getError()) {
+      llvm::errs() << "Error reading file: " << EC.message() << "\n";
+      return false;
+    }
+
+    const unsigned numQubits = getNumQubits();
+    mlir::SmallVector<double> t1(numQubits, 0.0), t2(numQubits, 0.0);
+    mlir::SmallVector<std::tuple<unsigned, unsigned, double>> fidelities;
+    double gateTime = 0.0;
+    readoutError.assign(numQubits, 0.0);
+
+    // Parse `<key> <value>` pairs separated by commas.
+    auto parseProperties = [](llvm::StringRef line, auto &&setProperty) {
+      mlir::SmallVector<llvm::StringRef> properties;
+      line.split(properties, ',', /*MaxSplit=*/-1, /*KeepEmpty=*/false);
+      for (auto property : properties) {
+        auto [key, value] = property.trim().split(' ');
+        double number = 0.0;
+        if (value.trim().getAsDouble(number) || !setProperty(key, number))
+          return false;
+      }
+      return true;
+    };
+
+    llvm::StringRef fileContent = fileBuffer->get()->getBuffer();
+    while (!fileContent.empty()) {
+      auto [line, rest] = fileContent.split('\n');
+      fileContent = rest;
+      line = line.trim();
+      if (line.empty() || line.starts_with("#"))
+        continue;
+      const llvm::StringRef entry = line;
+
+      // Parse a node number, and return false on success like
+      // `consumeInteger`.
+      auto consumeNode = [&](unsigned &node) {
+        line = line.ltrim();
+        return line.consumeInteger(/*Radix=*/10, node) || node >= numQubits;
+      };
+      bool valid = false;
+      unsigned v1 = 0, v2 = 0;
+      if (line.consume_front("Gate time:")) {
+        valid = !line.trim().getAsDouble(gateTime);
+      } else if (line.consume_front("Qubit")) {
+        valid = !consumeNode(v1) && line.consume_front(":") &&
+                parseProperties(line, [&](llvm::StringRef key, double value) {
+                  if (key == "readout_error")
+                    readoutError[v1] = value;
+                  else if (key == "t1")
+                    t1[v1] = value;
+                  else if (key == "t2")
+                    t2[v1] = value;
+                  else
+                    return false;
+                  return true;
+                });
+      } else if (line.consume_front("Coupler")) {
+        valid = !consumeNode(v1) && !consumeNode(v2) &&
+                line.consume_front(":") &&
+                parseProperties(line, [&](llvm::StringRef key, double value) {
+                  if (key != "fidelity")
+                    return false;
+                  fidelities.emplace_back(v1, v2, value);
+                  return true;
+                });
+      }
+      if (!valid) {
+        llvm::errs() << "Invalid calibration data: " << entry << '\n';
+        return false;
+      }
+    }
+
+    // The error of a two-qubit gate combines the infidelity of the coupler and
+    // the average infidelity of amplitude and phase damping on both qubits for
+    // the duration of the gate.
+    auto decoherence = [&](unsigned q) {
+      double f1 = t1[q] > 0.0 ? std::exp(-gateTime / t1[q]) : 1.0;
+      double f2 = t2[q] > 0.0 ? std::exp(-gateTime / t2[q]) : 1.0;
+      return (3.0 + f1 + 2.0 * f2) / 6.0;
+    };
+    couplerError.assign(shortestPaths.size(), 0.0);
+    for (unsigned q0 = 0; q0 < numQubits; ++q0)
+      for (auto q1 : getNeighbours(Qubit(q0)))
+        couplerError[getPairID(q0, q1.index)] =
+            1.0 - decoherence(q0) * decoherence(q1.index);
+    for (auto [q0, q1, fidelity] : fidelities) {
+      if (!areConnected(Qubit(q0), Qubit(q1))) {
+        llvm::errs() << "Calibration data for unconnected qubits " << q0
+                     << " and " << q1 << '\n';
+        return false;
+      }
+      double &error = couplerError[getPairID(q0, q1)];
+      error = 1.0 - fidelity * (1.0 - error);
+    }
+    return true;
+  }
+
+  /// Set the calibration data: the readout error of each qubit, and the error
+  /// of a two-qubit gate on each pair of connected qubits.
+  void setCalibration(mlir::ArrayRef<double> readoutErrors,
+                      mlir::ArrayRef<std::tuple<Qubit, Qubit, double>> errors) {
+    readoutError.assign(readoutErrors.begin(), readoutErrors.end());
+    readoutError.resize(getNumQubits(), 0.0);
+    couplerError.assign(shortestPaths.size(), 0.0);
+    for (auto [q0, q1, error] : errors)
+      couplerError[getPairID(q0.index, q1.index)] = error;
+  }
+
+  /// Returns true if the device has calibration data.
+  bool hasCalibration() const { return !readoutError.empty(); }
+
+  /// Returns the readout error of a qubit, 0 without calibration data.
+  double getReadoutError(Qubit q) const {
+    return hasCalibration() ? readoutError[q.index] : 0.0;
+  }
+
+  /// Returns the error of a two-qubit gate on connected qubits, 0 without
+  /// calibration data.
+  double getCouplerError(Qubit q0, Qubit q1) const {
+    return hasCalibration() ? couplerError[getPairID(q0.index, q1.index)]
+                            : 0.0;
+  }
+
+  /// Weigh routing costs by the coupler errors. Each connection costs
+  /// `1 + errorWeight * e / mean(e)`, where `e` is the negated log-fidelity of
+  /// the connection, so that an `errorWeight` of 0 counts swaps.
+  void computeWeightedDistances(double errorWeight) {
+    weightedDistances.clear();
+    if (!hasCalibration() || errorWeight <= 0.0)
+      return;
+
+    const unsigned numQubits = getNumQubits();
+    double meanError = 0.0;
+    unsigned numEdges = 0;
+    for (unsigned q0 = 0; q0 < numQubits; ++q0)
+      for (auto q1 : getNeighbours(Qubit(q0))) {
+        meanError += -std::log1p(-getCouplerError(Qubit(q0), q1));
+        ++numEdges;
+      }
+    if (meanError <= 0.0)
+      return;
+    meanError /= numEdges;
+
+    // Floyd-Warshall over the weighted connections.
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    weightedDistances.assign(shortestPaths.size(), inf);
+    for (unsigned q0 = 0; q0 < numQubits; ++q0) {
+      weightedDistances[getPairID(q0, q0)] = 0.0;
+      for (auto q1 : getNeighbours(Qubit(q0))) {
+        double e = -std::log1p(-getCouplerError(Qubit(q0), q1));
+        double &d = weightedDistances[getPairID(q0, q1.index)];
+        d = std::min(d, 1.0 + errorWeight * e / meanError);
+      }
+    }
+    for (unsigned k = 0; k < numQubits; ++k)
+      for (unsigned i = 0; i < numQubits; ++i)
+        for (unsigned j = i + 1; j < numQubits; ++j) {
+          double viaK = weightedDistances[getPairID(i, k)] +
+                        weightedDistances[getPairID(k, j)];
+          double &d = weightedDistances[getPairID(i, j)];
+          d = std::min(d, viaK);
+        }
+  }
+
+  /// Returns the cost of making two qubits adjacent: the number of swaps
+  /// required without weighted distances, and otherwise the weighted distance
+  /// minus one, which also favors the best connections between adjacent
+  /// qubits.
+  double getRoutingCost(Qubit src, Qubit dst) const {
+    if (weightedDistances.empty())
+      return src == dst ? 0.0 : getDistance(src, dst) - 1.0;
+    return src == dst ? 0.0
+                      : weightedDistances[getPairID(src.index, dst.index)] - 1;
+  }
+
+  /// Returns the additional cost of a swap between connected qubits over a
+  /// swap between perfect qubits, 0 without weighted distances.
+  double getSwapPenalty(Qubit q0, Qubit q1) const {
+    // A swap is made of three two-qubit gates.
+    return 3.0 * getRoutingCost(q0, q1);
+  }
 
   /// Returns the number of physical qubits in the device.
   unsigned getNumQubits() const { return topology.getNumNodes(); }
@@ -294,6 +490,15 @@ private:
 
   /// Storage for `PathRef`'s in `shortestPaths`
   mlir::SmallVector<Qubit> pathsData;
+
+  /// Calibration data: the readout error of each qubit and the error of a
+  /// two-qubit gate on every pair of qubits (indexed like `shortestPaths`).
+  /// Both are empty without calibration data.
+  mlir::SmallVector<double> readoutError;
+  mlir::SmallVector<double> couplerError;
+
+  /// Routing costs weighted by `couplerError`, indexed like `shortestPaths`.
+  mlir::SmallVector<double> weightedDistances;
 };
 
 } // namespace cudaq
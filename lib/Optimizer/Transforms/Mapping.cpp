@@ -15,7 +15,10 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Transforms/TopologicalSortUtils.h"
+#include <numeric>
+#include <random>
 
 #define DEBUG_TYPE "quantum-mapper"
 
@@ -39,6 +42,8 @@ namespace cudaq::opt {
 namespace {
 
 constexpr StringRef mappedWireSetName("mapped_wireset");
+constexpr StringRef readoutErrorAttrName("readout_error");
+constexpr StringRef couplerErrorAttrName("coupler_error");
 
 //===----------------------------------------------------------------------===//
 // Placement
@@ -49,6 +54,277 @@ void identityPlacement(Placement &placement) {
     placement.map(Placement::VirtualQ(i), Placement::DeviceQ(i));
 }
 
+/// The estimated quality of a routed circuit.
+struct RoutingScore {
+  /// The log of the fidelity estimated from the calibration data, i.e., 0
+  /// without calibration data.
+  double logFidelity = 0.0;
+  std::size_t numSwaps = 0;
+
+  /// Returns true if this score is better than \p other.
+  bool isBetterThan(const RoutingScore &other) const {
+    constexpr double tolerance = 1e-12;
+    if (std::abs(logFidelity - other.logFidelity) > tolerance)
+      return logFidelity > other.logFidelity;
+    return numSwaps < other.numSwaps;
+  }
+};
+
+/// The `PlacementSearch` class searches for an initial placement of the virtual
+/// qubits. It routes an abstract circuit, made of the two-qubit operations of
+/// the kernel, with the same heuristic as `SabreRouter` but without rewriting
+/// the IR, so that the trials can run in parallel.
+///
+/// Each trial starts from a random placement, which is refined by routing the
+/// circuit forward and then backward from the resulting placement, as in the
+/// SABRE paper. The refined placement is kept if routing the circuit forward
+/// from it scores better than from the starting placement.
+class PlacementSearch {
+public:
+  using Interaction = std::pair<Placement::VirtualQ, Placement::VirtualQ>;
+
+  PlacementSearch(const Device &device, ArrayRef<Interaction> circuit,
+                  ArrayRef<Placement::VirtualQ> measured, unsigned numVirtualQ,
+                  unsigned extendedLayerSize, float extendedLayerWeight,
+                  float decayDelta, unsigned roundsDecayReset)
+      : device(device), circuit(circuit), measured(measured),
+        qubitOps(numVirtualQ), extendedLayerSize(extendedLayerSize),
+        extendedLayerWeight(extendedLayerWeight), decayDelta(decayDelta),
+        roundsDecayReset(roundsDecayReset) {
+    for (auto &&[i, op] : llvm::enumerate(circuit)) {
+      qubitOps[op.first.index].push_back(i);
+      qubitOps[op.second.index].push_back(i);
+    }
+  }
+
+  /// Run \p numTrials trials, the first one starting from \p placement, and
+  /// set \p placement to the best placement found. Fails if the circuit
+  /// cannot be routed from any of the trial placements.
+  LogicalResult run(MLIRContext *context, Placement &placement,
+                    unsigned numTrials, unsigned seed) const;
+
+private:
+  /// Route the circuit (backward if \p reverse) from \p placement, updated to
+  /// the final placement. Ties between swaps are broken by \p rng. Returns
+  /// `std::nullopt` if an operation acts on qubits that no swap can bring
+  /// together.
+  std::optional<RoutingScore> route(Placement &placement, bool reverse,
+                                    std::mt19937_64 &rng) const;
+
+  const Device &device;
+  ArrayRef<Interaction> circuit;
+  ArrayRef<Placement::VirtualQ> measured;
+
+  /// The indices of the operations of `circuit` on each virtual qubit.
+  SmallVector<SmallVector<std::size_t>> qubitOps;
+
+  // Parameters
+  const unsigned extendedLayerSize;
+  const float extendedLayerWeight;
+  const float decayDelta;
+  const unsigned roundsDecayReset;
+};
+
+std::optional<RoutingScore>
+PlacementSearch::route(Placement &placement, bool reverse,
+                       std::mt19937_64 &rng) const {
+  constexpr std::size_t none = std::numeric_limits<std::size_t>::max();
+  const unsigned numDeviceQ = placement.getNumDeviceQ();
+  RoutingScore score;
+
+  // The number of operations routed on each virtual qubit, and the next one.
+  SmallVector<std::size_t> numRouted(qubitOps.size(), 0);
+  auto nextOp = [&](Placement::VirtualQ vr, std::size_t ahead = 0) {
+    auto &ops = qubitOps[vr.index];
+    auto k = numRouted[vr.index] + ahead;
+    if (k >= ops.size())
+      return none;
+    return reverse ? ops[ops.size() - 1 - k] : ops[k];
+  };
+  auto isReady = [&](std::size_t op) {
+    return op != none && nextOp(circuit[op].first) == op &&
+           nextOp(circuit[op].second) == op;
+  };
+
+  SmallVector<std::size_t> frontLayer;
+  for (unsigned v = 0; v < qubitOps.size(); ++v) {
+    auto op = nextOp(Placement::VirtualQ(v));
+    if (isReady(op) && circuit[op].first.index == v)
+      frontLayer.push_back(op);
+  }
+
+  auto layerCost = [&](ArrayRef<std::size_t> layer) {
+    double cost = 0.0;
+    for (auto op : layer)
+      cost += device.getRoutingCost(placement.getPhy(circuit[op].first),
+                                    placement.getPhy(circuit[op].second));
+    return layer.empty() ? 0.0 : cost / layer.size();
+  };
+  auto applySwap = [&](Placement::DeviceQ phy0, Placement::DeviceQ phy1) {
+    placement.swap(phy0, phy1);
+    score.numSwaps++;
+    // A swap is made of three two-qubit gates.
+    score.logFidelity += 3.0 * std::log1p(-device.getCouplerError(phy0, phy1));
+  };
+
+  SmallVector<float> phyDecay(numDeviceQ, 1.0);
+  std::size_t numSwapSearches = 0;
+  std::size_t swapsSinceProgress = 0;
+  while (!frontLayer.empty()) {
+    // Route the operations on adjacent qubits.
+    SmallVector<std::size_t> newFrontLayer;
+    bool progress = false;
+    for (auto op : frontLayer) {
+      auto [vr0, vr1] = circuit[op];
+      auto phy0 = placement.getPhy(vr0);
+      auto phy1 = placement.getPhy(vr1);
+      if (!device.areConnected(phy0, phy1)) {
+        newFrontLayer.push_back(op);
+        continue;
+      }
+      score.logFidelity += std::log1p(-device.getCouplerError(phy0, phy1));
+      progress = true;
+      numRouted[vr0.index]++;
+      numRouted[vr1.index]++;
+      for (auto vr : {vr0, vr1}) {
+        auto next = nextOp(vr);
+        if (isReady(next) && !llvm::is_contained(newFrontLayer, next))
+          newFrontLayer.push_back(next);
+      }
+    }
+    frontLayer = std::move(newFrontLayer);
+    if (progress) {
+      swapsSinceProgress = 0;
+      continue;
+    }
+
+    // The heuristic may cycle, in which case the first operation of the front
+    // layer is routed along a shortest path.
+    if (swapsSinceProgress > 2 * numDeviceQ) {
+      auto [vr0, vr1] = circuit[frontLayer[0]];
+      auto path = device.getShortestPath(placement.getPhy(vr0),
+                                         placement.getPhy(vr1));
+      for (std::size_t i = 0; i + 1 < path.size(); ++i)
+        if (!device.areConnected(path[i], path[i + 1]))
+          return std::nullopt;
+      for (std::size_t i = 0; i + 2 < path.size(); ++i)
+        applySwap(path[i], path[i + 1]);
+      continue;
+    }
+
+    // The extended layer holds the following operations on the qubits of the
+    // front layer.
+    SmallVector<std::size_t> extendedLayer;
+    for (std::size_t ahead = 1; extendedLayer.size() < extendedLayerSize;
+         ++ahead) {
+      bool found = false;
+      for (auto op : frontLayer)
+        for (auto vr : {circuit[op].first, circuit[op].second}) {
+          auto next = nextOp(vr, ahead);
+          if (next != none && extendedLayer.size() < extendedLayerSize &&
+              !llvm::is_contained(extendedLayer, next)) {
+            extendedLayer.push_back(next);
+            found = true;
+          }
+        }
+      if (!found)
+        break;
+    }
+
+    // Choose the swap of minimal cost, breaking ties randomly.
+    SmallVector<std::pair<Placement::DeviceQ, Placement::DeviceQ>> best;
+    double bestCost = std::numeric_limits<double>::infinity();
+    for (auto op : frontLayer)
+      for (auto vr : {circuit[op].first, circuit[op].second}) {
+        auto phy0 = placement.getPhy(vr);
+        for (auto phy1 : device.getNeighbours(phy0)) {
+          placement.swap(phy0, phy1);
+          double cost = layerCost(frontLayer) +
+                        extendedLayerWeight * layerCost(extendedLayer) +
+                        device.getSwapPenalty(phy0, phy1) / frontLayer.size();
+          cost *= std::max(phyDecay[phy0.index], phyDecay[phy1.index]);
+          placement.swap(phy0, phy1);
+          if (cost < bestCost - 1e-12) {
+            bestCost = cost;
+            best.clear();
+          }
+          if (cost <= bestCost + 1e-12)
+            best.emplace_back(phy0, phy1);
+        }
+      }
+    if (best.empty())
+      return std::nullopt;
+    auto [phy0, phy1] = best[rng() % best.size()];
+    applySwap(phy0, phy1);
+    swapsSinceProgress++;
+
+    // Update decay
+    if ((++numSwapSearches % roundsDecayReset) == 0) {
+      std::fill(phyDecay.begin(), phyDecay.end(), 1.0);
+    } else {
+      phyDecay[phy0.index] += decayDelta;
+      phyDecay[phy1.index] += decayDelta;
+    }
+  }
+
+  // Measurements are mapped last, so they use the final placement.
+  if (!reverse)
+    for (auto vr : measured)
+      score.logFidelity +=
+          std::log1p(-device.getReadoutError(placement.getPhy(vr)));
+  return score;
+}
+
+LogicalResult PlacementSearch::run(MLIRContext *context, Placement &placement,
+                                   unsigned numTrials, unsigned seed) const {
+  const unsigned numVirtualQ = placement.getNumVirtualQ();
+  const unsigned numDeviceQ = placement.getNumDeviceQ();
+  SmallVector<Placement> placements(numTrials, placement);
+  SmallVector<std::optional<RoutingScore>> scores(numTrials);
+  parallelFor(context, 0, numTrials, [&](std::size_t trial) {
+    std::mt19937_64 rng(seed + trial);
+    Placement &initial = placements[trial];
+    if (trial > 0) {
+      // Shuffle with Fisher-Yates rather than `std::shuffle`, whose results
+      // depend on the standard library.
+      SmallVector<unsigned> phys(numDeviceQ);
+      std::iota(phys.begin(), phys.end(), 0);
+      for (unsigned i = numDeviceQ - 1; i > 0; --i)
+        std::swap(phys[i], phys[rng() % (i + 1)]);
+      initial = Placement(numVirtualQ, numDeviceQ);
+      for (unsigned v = 0; v < numVirtualQ; ++v)
+        initial.map(Placement::VirtualQ(v), Placement::DeviceQ(phys[v]));
+    }
+
+    // Routing backward from the final placement refines the initial one.
+    Placement current = initial;
+    scores[trial] = route(current, /*reverse=*/false, rng);
+    if (!scores[trial] || !route(current, /*reverse=*/true, rng))
+      return;
+    Placement refined = current;
+    auto refinedScore = route(current, /*reverse=*/false, rng);
+    if (refinedScore && refinedScore->isBetterThan(*scores[trial])) {
+      scores[trial] = refinedScore;
+      initial = refined;
+    }
+  });
+
+  // Ties are broken by the trial number, for reproducibility.
+  std::optional<std::size_t> best;
+  for (std::size_t trial = 0; trial < numTrials; ++trial)
+    if (scores[trial] &&
+        (!best || scores[trial]->isBetterThan(*scores[*best])))
+      best = trial;
+  if (!best)
+    return failure();
+  LLVM_DEBUG(llvm::dbgs() << "Selected placement of trial " << *best << " of "
+                          << numTrials << " (log-fidelity "
+                          << scores[*best]->logFidelity << ", "
+                          << scores[*best]->numSwaps << " swaps)\n");
+  placement = placements[*best];
+  return success();
+}
+
 //===----------------------------------------------------------------------===//
 // Routing
 //===----------------------------------------------------------------------===//
@@ -295,7 +571,7 @@ double SabreRouter::computeLayerCost(ArrayRef<VirtualOp> layer) {
   for (VirtualOp const &virtOp : layer) {
     auto phy0 = placement.getPhy(virtOp.qubits[0]);
     auto phy1 = placement.getPhy(virtOp.qubits[1]);
-    cost += device.getDistance(phy0, phy1) - 1;
+    cost += device.getRoutingCost(phy0, phy1);
   }
   return cost / layer.size();
 }
@@ -323,6 +599,7 @@ SabreRouter::Swap SabreRouter::chooseSwap() {
       swapCost /= frontLayer.size();
       swapCost += extendedLayerWeight * extendedLayerCost;
     }
+    swapCost += device.getSwapPenalty(phy0, phy1);
 
     cost.emplace_back(maxDecay * swapCost);
     placement.swap(phy0, phy1);
@@ -451,6 +728,10 @@ struct MappingPrep : public cudaq::opt::impl::MappingPrepBase<MappingPrep> {
   /// If the deviceTopoType is File, this is the path to the file.
   StringRef deviceFilename;
 
+  /// The path to the calibration file, without the double quotes that protect
+  /// it in a pass pipeline, if any.
+  StringRef calibrationFile;
+
   virtual LogicalResult initialize(MLIRContext *context) override {
     // Initialize prior to parsing
     deviceDim[0] = deviceDim[1] = 0;
@@ -519,6 +800,15 @@ struct MappingPrep : public cudaq::opt::impl::MappingPrepBase<MappingPrep> {
       return failure();
     }
 
+    calibrationFile = StringRef(calibration).trim();
+    if (calibrationFile.size() >= 2 && calibrationFile.front() == '"' &&
+        calibrationFile.back() == '"')
+      calibrationFile = calibrationFile.drop_front().drop_back();
+    if (!calibrationFile.empty() && !llvm::sys::fs::exists(calibrationFile)) {
+      llvm::errs() << "Path " << calibrationFile << " does not exist\n";
+      return failure();
+    }
+
     return success();
   }
 
@@ -551,6 +841,32 @@ struct MappingPrep : public cudaq::opt::impl::MappingPrepBase<MappingPrep> {
     return sparseInt;
   }
 
+  /// Create a sparse matrix attribute with the error of every connection of
+  /// the device, with the same indices as the adjacency matrix.
+  SparseElementsAttr getCouplerErrorsFromDevice(Device &d, MLIRContext *ctx) {
+    unsigned int qubitCardinality = static_cast<unsigned int>(d.getNumQubits());
+
+    SmallVector<APInt, 32> edgeVector;
+    SmallVector<double, 16> errors;
+    for (unsigned int i = 0; i < qubitCardinality; i++)
+      for (auto neighbor : d.getNeighbours(Device::Qubit(i))) {
+        edgeVector.emplace_back(64, i);
+        edgeVector.emplace_back(64, neighbor.index);
+        errors.push_back(d.getCouplerError(Device::Qubit(i), neighbor));
+      }
+
+    auto f64Ty = Float64Type::get(ctx);
+    std::int64_t numEdges = errors.size();
+    ShapedType tensorF64 =
+        RankedTensorType::get({qubitCardinality, qubitCardinality}, f64Ty);
+    auto indicesType =
+        RankedTensorType::get({numEdges, 2}, IntegerType::get(ctx, 64));
+    auto indices = DenseIntElementsAttr::get(indicesType, edgeVector);
+    auto values = DenseElementsAttr::get(
+        RankedTensorType::get({numEdges}, f64Ty), ArrayRef<double>(errors));
+    return SparseElementsAttr::get(tensorF64, indices, values);
+  }
+
   quake::WireSetOp insertWireSetOpForDevice(Device &d, ModuleOp mod) {
     if (auto wires = mod.lookupSymbol<quake::WireSetOp>(mappedWireSetName))
       return wires;
@@ -561,6 +877,15 @@ struct MappingPrep : public cudaq::opt::impl::MappingPrepBase<MappingPrep> {
         builder.getUnknownLoc(), mappedWireSetName, d.getNumQubits(),
         adjacency);
     wireSetOp.setPrivate();
+    if (d.hasCalibration()) {
+      SmallVector<double> readoutErrors;
+      for (unsigned i = 0; i < d.getNumQubits(); i++)
+        readoutErrors.push_back(d.getReadoutError(Device::Qubit(i)));
+      wireSetOp->setAttr(readoutErrorAttrName,
+                         builder.getDenseF64ArrayAttr(readoutErrors));
+      wireSetOp->setAttr(couplerErrorAttrName,
+                         getCouplerErrorsFromDevice(d, mod.getContext()));
+    }
     return wireSetOp;
   }
 
@@ -588,6 +913,12 @@ struct MappingPrep : public cudaq::opt::impl::MappingPrepBase<MappingPrep> {
     else if (deviceTopoType == File)
       d = Device::file(deviceFilename);
 
+    if (!calibrationFile.empty() && !d.loadCalibration(calibrationFile)) {
+      mod.emitError("Invalid calibration file " + calibrationFile);
+      signalPassFailure();
+      return;
+    }
+
     insertWireSetOpForDevice(d, mod);
   }
 };
@@ -669,6 +1000,24 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
       return;
     }
 
+    // Load the calibration data, if any.
+    if (auto readoutErrors =
+            wireSetOp->getAttrOfType<DenseF64ArrayAttr>(readoutErrorAttrName)) {
+      SmallVector<std::tuple<Device::Qubit, Device::Qubit, double>> errors;
+      if (auto couplerErrors =
+              wireSetOp->getAttrOfType<SparseElementsAttr>(
+                  couplerErrorAttrName)) {
+        auto indicesIt = couplerErrors.getIndices().value_begin<APInt>();
+        for (double error : couplerErrors.getValues().getValues<double>()) {
+          auto row = (*(indicesIt++)).getZExtValue();
+          auto col = (*(indicesIt++)).getZExtValue();
+          errors.emplace_back(Device::Qubit(row), Device::Qubit(col), error);
+        }
+      }
+      d.setCalibration(readoutErrors.asArrayRef(), errors);
+      d.computeWeightedDistances(errorWeight);
+    }
+
     LLVM_DEBUG({ d.dump(); });
 
     const std::size_t deviceNumQubits = d.getNumQubits();
@@ -813,6 +1162,31 @@ struct MappingFunc : public cudaq::opt::impl::MappingFuncBase<MappingFunc> {
     // Place
     Placement placement(sources.size(), d.getNumQubits());
     identityPlacement(placement);
+    if (placementTrials > 0) {
+      SmallVector<PlacementSearch::Interaction> circuit;
+      for (Operation &op : block.getOperations()) {
+        if (op.hasTrait<QuantumMeasure>() ||
+            !quake::isSupportedMappingOperation(&op))
+          continue;
+        auto wires = quake::getQuantumOperands(&op);
+        if (wires.size() == 2)
+          circuit.emplace_back(wireToVirtualQ[wires[0]],
+                               wireToVirtualQ[wires[1]]);
+      }
+      SmallVector<Placement::VirtualQ> measured;
+      for (auto mq : userQubitsMeasured)
+        measured.push_back(Placement::VirtualQ(mq));
+      PlacementSearch search(d, circuit, measured, sources.size(),
+                             extendedLayerSize, extendedLayerWeight,
+                             decayDelta, roundsDecayReset);
+      if (failed(
+              search.run(&getContext(), placement, placementTrials, seed))) {
+        func.emitError("Cannot route the kernel on the device, whose qubits "
+                       "are not all connected.");
+        signalPassFailure();
+        return;
+      }
+    }
 
     // Route
     SabreRouter router(d, wireToVirtualQ, placement, extendedLayerSize,
@@ -911,10 +1285,14 @@ struct MappingPipelineOptions
 #define DECLARE_SUB_OPTION(_PARENT_STRUCT, _FIELD)                             \
   PassOptions::Option<decltype(_PARENT_STRUCT::_FIELD)> _FIELD{*this, #_FIELD}
   DECLARE_SUB_OPTION(MappingPrepOptions, device);
+  DECLARE_SUB_OPTION(MappingPrepOptions, calibration);
   DECLARE_SUB_OPTION(MappingFuncOptions, extendedLayerSize);
   DECLARE_SUB_OPTION(MappingFuncOptions, extendedLayerWeight);
   DECLARE_SUB_OPTION(MappingFuncOptions, decayDelta);
   DECLARE_SUB_OPTION(MappingFuncOptions, roundsDecayReset);
+  DECLARE_SUB_OPTION(MappingFuncOptions, errorWeight);
+  DECLARE_SUB_OPTION(MappingFuncOptions, placementTrials);
+  DECLARE_SUB_OPTION(MappingFuncOptions, seed);
 };
 
 // Helper macro to set MappingFuncOptions field if the corresponding field in
@@ -934,6 +1312,7 @@ void registerMappingPipeline() {
         // Add the prep pass
         MappingPrepOptions prepOpt;
         SET_IF_EXISTS(prepOpt, opt, device);
+        SET_IF_EXISTS(prepOpt, opt, calibration);
         pm.addPass(cudaq::opt::createMappingPrep(prepOpt));
 
         // Add the per-function pass
@@ -942,6 +1321,9 @@ void registerMappingPipeline() {
         SET_IF_EXISTS(funcOpts, opt, extendedLayerWeight);
         SET_IF_EXISTS(funcOpts, opt, decayDelta);
         SET_IF_EXISTS(funcOpts, opt, roundsDecayReset);
+        SET_IF_EXISTS(funcOpts, opt, errorWeight);
+        SET_IF_EXISTS(funcOpts, opt, placementTrials);
+        SET_IF_EXISTS(funcOpts, opt, seed);
         pm.addNestedPass<func::FuncOp>(cudaq::opt::createMappingFunc(funcOpts));
       });
 }
@@ -0,0 +1,486 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "cudaq/Optimizer/Transforms/ResourceCount.h"
+#include "LoopAnalysis.h"
+#include "PassDetails.h"
+#include "cudaq/Optimizer/Builder/Factory.h"
+#include "cudaq/Optimizer/Transforms/Passes.h"
+#include "llvm/Support/Debug.h"
+#include "llvm/Support/MathExtras.h"
+
+namespace cudaq::opt {
+#define GEN_PASS_DEF_RESOURCECOUNT
+#include "cudaq/Optimizer/Transforms/Passes.h.inc"
+} // namespace cudaq::opt
+
+#define DEBUG_TYPE "resource-count"
+
+using namespace mlir;
+
+static std::uint64_t add(std::uint64_t a, std::uint64_t b) {
+  return llvm::SaturatingAdd(a, b);
+}
+
+static std::uint64_t mul(std::uint64_t a, std::uint64_t b) {
+  return llvm::SaturatingMultiply(a, b);
+}
+
+std::uint64_t cudaq::opt::ResourceCounts::getTotalGates() const {
+  std::uint64_t total = 0;
+  for (auto &[key, count] : gates)
+    total = add(total, count);
+  return total;
+}
+
+/// Return the number of qubits of a quantum value, if known.
+static std::optional<std::uint64_t> getNumQubits(Value v) {
+  auto ty = v.getType();
+  if (isa<quake::RefType, quake::WireType, quake::ControlType>(ty))
+    return 1;
+  if (auto veqTy = dyn_cast<quake::VeqType>(ty)) {
+    if (veqTy.hasSpecifiedSize())
+      return veqTy.getSize();
+    if (auto alloc = v.getDefiningOp<quake::AllocaOp>())
+      if (auto size = alloc.getSize())
+        return cudaq::opt::factory::maybeValueOfIntConstant(size);
+  }
+  return std::nullopt;
+}
+
+/// Return the number of iterations of a loop if it is bounded by a constant.
+/// `exact` is cleared if the loop may exit early.
+static std::optional<std::uint64_t> getTripCount(cudaq::cc::LoopOp loop,
+                                                 bool &exact) {
+  if (loop->hasAttr(cudaq::opt::DeadLoopAttr))
+    return 0;
+  if (!cudaq::opt::isaCountedLoop(loop)) {
+    if (!cudaq::opt::isaConstantUpperBoundLoop(loop))
+      return std::nullopt;
+    exact = false;
+  }
+  auto components = cudaq::opt::getLoopComponents(loop);
+  if (!components)
+    return std::nullopt;
+  if (components->hasAlwaysFalseCondition())
+    return 0;
+  if (loop->hasAttr(cudaq::opt::NormalizedLoopAttr))
+    return cudaq::opt::factory::maybeValueOfIntConstant(
+        components->compareValue);
+  return components->getIterationsConstant();
+}
+
+namespace {
+/// A qubit, as an element of a register (an allocation or an argument).
+/// The index is `-1` if the element is unknown.
+using QubitKey = std::pair<Value, std::int64_t>;
+
+/// The resources of a sequence of operations as they are being counted. The
+/// depth of each qubit is tracked while the qubits can be identified, and
+/// everything is serialized (a conservative bound) otherwise.
+struct RegionCounter {
+  cudaq::opt::ResourceCounter &counter;
+  cudaq::opt::ResourceCounts counts;
+  DenseMap<QubitKey, std::uint64_t> qubitDepth;
+  DenseMap<Value, std::uint64_t> registerDepth;
+  std::uint64_t floor = 0;
+
+  explicit RegionCounter(cudaq::opt::ResourceCounter &counter)
+      : counter(counter) {}
+
+  /// Return the register (an allocation or an argument) that the register
+  /// `v` is part of, and the offset of `v` in it (`-1` if unknown).
+  static std::optional<QubitKey> resolveRegister(Value v) {
+    std::int64_t offset = 0;
+    while (true) {
+      if (auto relax = v.getDefiningOp<quake::RelaxSizeOp>()) {
+        v = relax.getInputVec();
+        continue;
+      }
+      if (auto init = v.getDefiningOp<quake::InitializeStateOp>()) {
+        v = init.getTargets();
+        continue;
+      }
+      if (auto sub = v.getDefiningOp<quake::SubVeqOp>()) {
+        if (!sub.hasConstantLowerBound())
+          offset = -1;
+        else if (offset >= 0)
+          offset += sub.getConstantLowerBound();
+        v = sub.getVeq();
+        continue;
+      }
+      if (auto *def = v.getDefiningOp(); def && !isa<quake::AllocaOp>(def))
+        return std::nullopt;
+      return QubitKey{v, offset};
+    }
+  }
+
+  /// Return the register and index of the qubit `v`, following wires back to
+  /// their origin. A whole register has index `-1`.
+  static std::optional<QubitKey> resolveQubit(Value v) {
+    while (true) {
+      if (isa<quake::VeqType>(v.getType())) {
+        auto reg = resolveRegister(v);
+        if (!reg)
+          return std::nullopt;
+        return QubitKey{reg->first, -1};
+      }
+      if (auto ext = v.getDefiningOp<quake::ExtractRefOp>()) {
+        auto reg = resolveRegister(ext.getVeq());
+        if (!reg)
+          return std::nullopt;
+        if (!ext.hasConstantIndex() || reg->second < 0)
+          return QubitKey{reg->first, -1};
+        return QubitKey{reg->first,
+                        reg->second + (std::int64_t)ext.getConstantIndex()};
+      }
+      auto *def = v.getDefiningOp();
+      auto result = dyn_cast<OpResult>(v);
+      // In value form, the wires returned by an operation continue its
+      // (controls and) targets, in order.
+      if (auto op = dyn_cast_if_present<quake::OperatorInterface>(def)) {
+        SmallVector<Value> wires(op.getControls());
+        wires.append(op.getTargets().begin(), op.getTargets().end());
+        if (result.getResultNumber() >= wires.size())
+          return std::nullopt;
+        v = wires[result.getResultNumber()];
+        continue;
+      }
+      if (auto meas = dyn_cast_if_present<quake::MeasurementInterface>(def)) {
+        auto targets = meas.getTargets();
+        if (result.getResultNumber() == 0 ||
+            result.getResultNumber() > targets.size())
+          return std::nullopt;
+        v = targets[result.getResultNumber() - 1];
+        continue;
+      }
+      if (auto reset = dyn_cast_if_present<quake::ResetOp>(def)) {
+        v = reset.getTargets();
+        continue;
+      }
+      if (def && !isa<quake::AllocaOp, quake::NullWireOp,
+                      quake::BorrowWireOp>(def))
+        return std::nullopt;
+      return QubitKey{v, 0};
+    }
+  }
+
+  std::uint64_t currentDepth(const std::optional<QubitKey> &key) {
+    if (!key)
+      return counts.depth;
+    auto depth = std::max(floor, registerDepth.lookup(key->first));
+    if (key->second >= 0)
+      return std::max(depth, qubitDepth.lookup(*key));
+    // An unknown element of a register may be any of its qubits.
+    for (auto &[k, d] : qubitDepth)
+      if (k.first == key->first)
+        depth = std::max(depth, d);
+    return depth;
+  }
+
+  /// Add a layer of operations acting on the qubits `qubits`.
+  void addLayer(ArrayRef<Value> qubits) {
+    SmallVector<std::optional<QubitKey>> keys;
+    std::uint64_t depth = 0;
+    bool unknown = false;
+    for (auto q : qubits) {
+      keys.push_back(resolveQubit(q));
+      unknown |= !keys.back().has_value();
+      depth = std::max(depth, currentDepth(keys.back()));
+    }
+    depth = add(depth, 1);
+    counts.depth = std::max(counts.depth, depth);
+    if (unknown) {
+      floor = depth;
+      return;
+    }
+    for (auto &key : keys) {
+      if (key->second >= 0)
+        qubitDepth[*key] = depth;
+      else
+        registerDepth[key->first] = depth;
+    }
+  }
+
+  void allocate(std::uint64_t numQubits) {
+    counts.liveQubits = add(counts.liveQubits, numQubits);
+    counts.qubits = std::max(counts.qubits, counts.liveQubits);
+  }
+
+  void deallocate(std::uint64_t numQubits) {
+    counts.liveQubits -= std::min(counts.liveQubits, numQubits);
+  }
+
+  /// Return the number of qubits of `v`, or 1 if unknown (and then the counts
+  /// are incomplete).
+  std::uint64_t numQubitsOrOne(Value v) {
+    if (auto n = getNumQubits(v))
+      return *n;
+    counts.bounded = false;
+    return 1;
+  }
+
+  /// Append `times` repetitions of `other`, with `extraControls` controls
+  /// added to each of its gates. Its operations are serialized after all the
+  /// operations counted so far.
+  void append(const cudaq::opt::ResourceCounts &other, std::uint64_t times,
+              std::size_t extraControls = 0) {
+    for (auto &[key, count] : other.gates) {
+      auto &total = counts.gates[{key.first, key.second + extraControls}];
+      total = add(total, mul(times, count));
+    }
+    counts.measurements =
+        add(counts.measurements, mul(times, other.measurements));
+    counts.resets = add(counts.resets, mul(times, other.resets));
+    if (extraControls == 0)
+      counts.tCount = add(counts.tCount, mul(times, other.tCount));
+    if (times > 0) {
+      if (other.depth > 0) {
+        counts.depth = add(counts.depth, mul(times, other.depth));
+        floor = counts.depth;
+      }
+      // The peak is reached in the last repetition.
+      counts.qubits =
+          std::max(counts.qubits,
+                   add(counts.liveQubits,
+                       add(mul(times - 1, other.liveQubits), other.qubits)));
+      counts.liveQubits = add(counts.liveQubits, mul(times, other.liveQubits));
+    }
+    counts.exact &= other.exact;
+    counts.bounded &= other.bounded;
+  }
+
+  /// Count the operations of `region`, as a separate sequence.
+  cudaq::opt::ResourceCounts countRegion(Region &region) {
+    RegionCounter nested(counter);
+    // Not all blocks of a region with branches may be executed.
+    if (!region.hasOneBlock() && !region.empty())
+      nested.counts.exact = false;
+    for (auto &block : region)
+      for (auto &op : block)
+        nested.visit(&op);
+    return std::move(nested.counts);
+  }
+
+  /// Return the counts of the function called by `op`, if known.
+  std::optional<cudaq::opt::ResourceCounts>
+  getCalleeCounts(Operation *op, SymbolRefAttr sym) {
+    if (!sym)
+      return std::nullopt;
+    auto func = SymbolTable::lookupNearestSymbolFrom<func::FuncOp>(op, sym);
+    if (!func || func.empty())
+      return std::nullopt;
+    return counter.count(func);
+  }
+
+  void visitCall(Operation *op, SymbolRefAttr sym, std::size_t numControls) {
+    if (auto callee = getCalleeCounts(op, sym)) {
+      append(*callee, 1, numControls);
+      return;
+    }
+    // Calls to functions without quantum operations are common (e.g., to the
+    // runtime library), and only a call that takes qubits is unknown.
+    if (llvm::any_of(op->getOperandTypes(), [](Type ty) {
+          return isa<quake::RefType, quake::VeqType, quake::StruqType,
+                     cudaq::cc::CallableType>(ty);
+        }))
+      counts.bounded = false;
+  }
+
+  void visit(Operation *op) {
+    if (auto alloc = dyn_cast<quake::AllocaOp>(op)) {
+      allocate(numQubitsOrOne(alloc.getResult()));
+      return;
+    }
+    if (auto dealloc = dyn_cast<quake::DeallocOp>(op)) {
+      auto ref = dealloc.getReference();
+      auto numQubits = getNumQubits(ref);
+      if (!numQubits)
+        if (auto key = resolveQubit(ref))
+          numQubits = getNumQubits(key->first);
+      deallocate(numQubits.value_or(0));
+      return;
+    }
+    if (isa<quake::NullWireOp, quake::BorrowWireOp>(op)) {
+      allocate(1);
+      return;
+    }
+    if (isa<quake::SinkOp, quake::ReturnWireOp>(op)) {
+      deallocate(1);
+      return;
+    }
+    if (auto meas = dyn_cast<quake::MeasurementInterface>(op)) {
+      SmallVector<Value> targets(meas.getTargets());
+      for (auto t : targets)
+        counts.measurements = add(counts.measurements, numQubitsOrOne(t));
+      addLayer(targets);
+      return;
+    }
+    if (auto reset = dyn_cast<quake::ResetOp>(op)) {
+      counts.resets = add(counts.resets, numQubitsOrOne(reset.getTargets()));
+      addLayer({reset.getTargets()});
+      return;
+    }
+    if (auto gate = dyn_cast<quake::OperatorInterface>(op)) {
+      std::size_t numControls = 0;
+      for (auto c : gate.getControls())
+        numControls += numQubitsOrOne(c);
+      // A single-target gate on a register applies to each of its qubits.
+      SmallVector<Value> targets(gate.getTargets());
+      std::uint64_t instances = 1;
+      if (targets.size() == 1 && isa<quake::VeqType>(targets[0].getType()))
+        instances = numQubitsOrOne(targets[0]);
+      auto name = op->getName().stripDialect().str();
+      auto &total = counts.gates[{name, numControls}];
+      total = add(total, instances);
+      if (isa<quake::TOp>(op) && numControls == 0)
+        counts.tCount = add(counts.tCount, instances);
+      SmallVector<Value> qubits(gate.getControls());
+      qubits.append(targets);
+      addLayer(qubits);
+      return;
+    }
+    if (auto call = dyn_cast<func::CallOp>(op)) {
+      visitCall(op, call.getCalleeAttr(), 0);
+      return;
+    }
+    if (auto apply = dyn_cast<quake::ApplyOp>(op)) {
+      std::size_t numControls = 0;
+      for (auto c : apply.getControls())
+        numControls += numQubitsOrOne(c);
+      if (!apply.getCalleeAttr()) {
+        counts.bounded = false;
+        return;
+      }
+      visitCall(op, apply.getCalleeAttr(), numControls);
+      return;
+    }
+    if (isa<cudaq::cc::CallCallableOp, cudaq::cc::CallIndirectCallableOp,
+            func::CallIndirectOp>(op)) {
+      counts.bounded = false;
+      return;
+    }
+    if (auto ifOp = dyn_cast<cudaq::cc::IfOp>(op)) {
+      // Either branch may execute, so take the larger count of each.
+      auto thenCounts = countRegion(ifOp.getThenRegion());
+      auto elseCounts = countRegion(ifOp.getElseRegion());
+      cudaq::opt::ResourceCounts branch = thenCounts;
+      for (auto &[key, count] : elseCounts.gates)
+        branch.gates[key] = std::max(branch.gates[key], count);
+      branch.measurements =
+          std::max(branch.measurements, elseCounts.measurements);
+      branch.resets = std::max(branch.resets, elseCounts.resets);
+      branch.tCount = std::max(branch.tCount, elseCounts.tCount);
+      branch.depth = std::max(branch.depth, elseCounts.depth);
+      branch.qubits = std::max(branch.qubits, elseCounts.qubits);
+      branch.liveQubits = std::max(branch.liveQubits, elseCounts.liveQubits);
+      branch.bounded &= elseCounts.bounded;
+      if (branch.getTotalGates() || branch.measurements || branch.resets ||
+          elseCounts.getTotalGates() || elseCounts.measurements ||
+          elseCounts.resets)
+        branch.exact = false;
+      append(branch, 1);
+      return;
+    }
+    if (auto loop = dyn_cast<cudaq::cc::LoopOp>(op)) {
+      RegionCounter body(counter);
+      for (auto *region : {&loop.getWhileRegion(), &loop.getBodyRegion(),
+                           &loop.getStepRegion()})
+        body.append(countRegion(*region), 1);
+      bool exact = true;
+      auto tripCount = getTripCount(loop, exact);
+      body.counts.exact &= exact;
+      if (!tripCount) {
+        LLVM_DEBUG(llvm::dbgs() << "unknown trip count: " << loop << '\n');
+        body.counts.bounded = false;
+      }
+      append(body.counts, tripCount.value_or(1));
+      return;
+    }
+    // Any other operation with regions (e.g., `cc.scope`) executes them once.
+    for (auto &region : op->getRegions())
+      append(countRegion(region), 1);
+  }
+};
+} // namespace
+
+const cudaq::opt::ResourceCounts &
+cudaq::opt::ResourceCounter::count(func::FuncOp func) {
+  auto *key = func.getOperation();
+  if (auto iter = cache.find(key); iter != cache.end())
+    return iter->second;
+  if (!inProgress.insert(key).second) {
+    // Recursion: the number of calls is not known statically.
+    static const ResourceCounts unbounded = [] {
+      ResourceCounts counts;
+      counts.bounded = false;
+      return counts;
+    }();
+    return unbounded;
+  }
+  auto counts = RegionCounter(*this).countRegion(func.getBody());
+  inProgress.erase(key);
+  return cache[key] = std::move(counts);
+}
+
+cudaq::opt::ResourceCounts cudaq::opt::countResources(func::FuncOp func) {
+  ResourceCounter counter;
+  return counter.count(func);
+}
+
+namespace {
+/// Attach the statically counted resources of each function with quantum
+/// operations as a `quake.resources` dictionary attribute.
+class ResourceCountPass
+    : public cudaq::opt::impl::ResourceCountBase<ResourceCountPass> {
+public:
+  using ResourceCountBase::ResourceCountBase;
+
+  void runOnOperation() override {
+    auto module = getOperation();
+    auto *ctx = &getContext();
+    OpBuilder builder(ctx);
+    cudaq::opt::ResourceCounter counter;
+    for (auto func : module.getOps<func::FuncOp>()) {
+      if (func.empty())
+        continue;
+      bool hasQuantumOps = false;
+      func.walk([&](Operation *op) {
+        if (isa_and_nonnull<quake::QuakeDialect>(op->getDialect()))
+          hasQuantumOps = true;
+      });
+      if (!hasQuantumOps)
+        continue;
+
+      const auto &counts = counter.count(func);
+      auto i64 = [&](std::uint64_t value) {
+        return builder.getI64IntegerAttr(value);
+      };
+      SmallVector<NamedAttribute> gates;
+      for (auto &[key, count] : counts.gates) {
+        auto name = key.second
+                        ? key.first + "[" + std::to_string(key.second) + "]"
+                        : key.first;
+        gates.push_back(builder.getNamedAttr(name, i64(count)));
+      }
+      SmallVector<NamedAttribute> entries = {
+          builder.getNamedAttr("gates", builder.getDictionaryAttr(gates)),
+          builder.getNamedAttr("total_gates", i64(counts.getTotalGates())),
+          builder.getNamedAttr("measurements", i64(counts.measurements)),
+          builder.getNamedAttr("resets", i64(counts.resets)),
+          builder.getNamedAttr("t_count", i64(counts.tCount)),
+          builder.getNamedAttr("depth", i64(counts.depth)),
+          builder.getNamedAttr("qubits", i64(counts.qubits)),
+          builder.getNamedAttr("exact", builder.getBoolAttr(counts.exact)),
+          builder.getNamedAttr("bounded",
+                               builder.getBoolAttr(counts.bounded))};
+      func->setAttr("quake.resources", builder.getDictionaryAttr(entries));
+    }
+  }
+};
+} // namespace
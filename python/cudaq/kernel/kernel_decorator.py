@@ -76,6 +76,11 @@ class PyKernelDecorator(object):
         self.verbose = verbose
         self.argTypes = None
 
+        # The module the JIT compilation hash below was computed for. The hash
+        # is reset whenever the module is modified in place.
+        self.hashedModule = None
+        self.moduleHash = None
+
         # Get any global variables from parent scope.
         # We filter only types we accept: integers and floats.
         # Note here we assume that the parent scope is 2 stack frames up
@@ -254,11 +259,22 @@ class PyKernelDecorator(object):
         """
         self.compile()
         cudaq_runtime.synthPyCallable(self.module, funcNames)
+        self.moduleHash = None
         # Reset the argument types by removing the Callable
         self.argTypes = [
             a for a in self.argTypes if not cc.CallableType.isinstance(a)
         ]
 
+    def get_module_hash(self):
+        """
+        Return the hash identifying the JIT compilation of the module. It is
+        computed once per module, rather than on every launch.
+        """
+        if self.moduleHash is None or self.hashedModule is not self.module:
+            self.hashedModule = self.module
+            self.moduleHash = cudaq_runtime.getModuleHash(self.module)
+        return self.moduleHash
+
     def extract_c_function_pointer(self, name=None):
         """
         Return the C function pointer for the function with given name, or 
@@ -484,6 +500,7 @@ class PyKernelDecorator(object):
                                             existingModule=self.module,
                                             disableEntryPointTag=True)
                     tmpBridge.visit(globalAstRegistry[arg.name][0])
+                    self.moduleHash = None
 
             # Convert `numpy` arrays to lists
             if cc.StdvecType.isinstance(mlirType) and hasattr(arg, "tolist"):
@@ -499,14 +516,16 @@ class PyKernelDecorator(object):
             cudaq_runtime.pyAltLaunchKernel(self.name,
                                             self.module,
                                             *processedArgs,
-                                            callable_names=callableNames)
+                                            callable_names=callableNames,
+                                            module_hash=self.get_module_hash())
         else:
             result = cudaq_runtime.pyAltLaunchKernelR(
                 self.name,
                 self.module,
                 mlirTypeFromPyType(self.returnType, self.module.context),
                 *processedArgs,
-                callable_names=callableNames)
+                callable_names=callableNames,
+                module_hash=self.get_module_hash())
             return result
 
 
@@ -94,6 +94,11 @@ Returns:
     ctx = cudaq_runtime.ExecutionContext("sample", shots_count)
     ctx.hasConditionalsOnMeasureResults = has_conditionals_on_measure_result
     ctx.explicitMeasurements = explicit_measurements
+    if has_conditionals_on_measure_result:
+        # Execute once per branch of measurement outcomes if the simulator
+        # supports it, otherwise shot by shot.
+        ctx.shotBranching = True
+        ctx.branchShots = shots_count
     cudaq_runtime.setExecutionContext(ctx)
 
     counts = cudaq_runtime.SampleResult()
@@ -117,6 +122,8 @@ Returns:
                   "infinite loop.")
             break
         ctx.result.clear()
+        if ctx.shotBranching and not ctx.nextShotBranch():
+            break
         if counts.get_total_shots() < shots_count:
             cudaq_runtime.setExecutionContext(ctx)
     cudaq_runtime.unset_noise()
@@ -32,6 +32,9 @@ void bindExecutionContext(py::module &mod) {
                      &cudaq::ExecutionContext::numberTrajectories)
       .def_readwrite("explicitMeasurements",
                      &cudaq::ExecutionContext::explicitMeasurements)
+      .def_readwrite("shotBranching", &cudaq::ExecutionContext::shotBranching)
+      .def_readwrite("branchShots", &cudaq::ExecutionContext::branchShots)
+      .def("nextShotBranch", &cudaq::ExecutionContext::nextShotBranch)
       .def("setSpinOperator",
            [](cudaq::ExecutionContext &ctx, cudaq::spin_op &spin) {
              ctx.spin = spin;
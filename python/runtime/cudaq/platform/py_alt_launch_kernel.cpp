@@ -11,6 +11,7 @@
 #include "common/ArgumentConversion.h"
 #include "common/ArgumentWrapper.h"
 #include "common/Environment.h"
+#include "common/JITModuleCache.h"
 #include "cudaq/Optimizer/Builder/Factory.h"
 #include "cudaq/Optimizer/Builder/Runtime.h"
 #include "cudaq/Optimizer/CAPI/Dialects.h"
@@ -26,6 +27,7 @@
 #include "cudaq/platform/qpu.h"
 #include "utils/OpaqueArguments.h"
 #include "utils/PyTypes.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/Error.h"
 #include "mlir/Bindings/Python/PybindAdaptors.h"
 #include "mlir/CAPI/ExecutionEngine.h"
@@ -67,11 +69,22 @@ static std::unique_ptr<PyStateVectorStorage> stateStorage =
 static std::unique_ptr<PyStateStorage> cudaqStateStorage =
     std::make_unique<PyStateStorage>();
 
+/// @brief Return the hash of `module` identifying its JIT compilation in this
+/// process.
+static std::size_t computeModuleHash(ModuleOp module) {
+  auto hash = llvm::hash_code{0};
+  module.walk([&hash](Operation *op) {
+    hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
+  });
+  return static_cast<std::size_t>(hash);
+}
+
 std::tuple<ExecutionEngine *, void *, std::size_t, std::int32_t>
 jitAndCreateArgs(const std::string &name, MlirModule module,
                  cudaq::OpaqueArguments &runtimeArgs,
                  const std::vector<std::string> &names, Type returnType,
-                 std::size_t startingArgIdx = 0) {
+                 std::size_t startingArgIdx = 0,
+                 std::optional<std::size_t> moduleHash = std::nullopt) {
   ScopedTraceWithContext(cudaq::TIMING_JIT, "jitAndCreateArgs", name);
   auto mod = unwrap(module);
 
@@ -81,12 +94,10 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
   // cached.
   const bool allowCache = startingArgIdx == 0;
 
-  // Have we JIT compiled this before?
-  auto hash = llvm::hash_code{0};
-  mod.walk([&hash](Operation *op) {
-    hash = llvm::hash_combine(hash, OperationEquivalence::computeHash(op));
-  });
-  auto hashKey = static_cast<size_t>(hash);
+  // Have we JIT compiled this before? Kernels that do not change between
+  // launches pass the hash of their module, so that it is not recomputed by
+  // walking every operation on each launch.
+  auto hashKey = moduleHash ? *moduleHash : computeModuleHash(mod);
 
   ExecutionEngine *jit = nullptr;
   if (allowCache && jitCache->hasJITEngine(hashKey)) {
@@ -95,34 +106,49 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
     ScopedTraceWithContext(cudaq::TIMING_JIT,
                            "jitAndCreateArgs - execute passes", name);
 
-    auto cloned = mod.clone();
-    auto context = cloned.getContext();
-    PassManager pm(context);
-    pm.addNestedPass<func::FuncOp>(cudaq::opt::createPySynthCallableBlockArgs(
-        SmallVector<StringRef>(names.begin(), names.end())));
-    pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader({.jitTime = true}));
-    pm.addPass(cudaq::opt::createGenerateKernelExecution(
-        {.startingArgIdx = startingArgIdx}));
-    pm.addPass(cudaq::opt::createLambdaLiftingPass());
-    pm.addPass(createSymbolDCEPass());
-    cudaq::opt::addPipelineConvertToQIR(pm);
-
     auto enablePrintMLIREachPass =
         getEnvBool("CUDAQ_MLIR_PRINT_EACH_PASS", false);
 
-    if (enablePrintMLIREachPass) {
-      cloned.getContext()->disableMultithreading();
-      pm.enableIRPrinting();
+    // A previous process may have lowered the same module already. Skip the
+    // MLIR pipeline and the translation to LLVM IR then.
+    auto &moduleCache = cudaq::JITModuleCache::get();
+    std::string moduleKey;
+    std::unique_ptr<llvm::MemoryBuffer> cachedModule;
+    if (moduleCache.enabled() && !enablePrintMLIREachPass) {
+      moduleKey = cudaq::JITModuleCache::getKey(
+          mod, "python-jit;" + std::to_string(startingArgIdx) + ";" +
+                   llvm::join(names, ","));
+      cachedModule = moduleCache.lookup(moduleKey);
     }
 
-    DefaultTimingManager tm;
-    tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
-    auto timingScope = tm.getRootScope(); // starts the timer
-    pm.enableTiming(timingScope);         // do this right before pm.run
-    if (failed(pm.run(cloned)))
-      throw std::runtime_error(
-          "cudaq::builder failed to JIT compile the Quake representation.");
-    timingScope.stop();
+    // On a hit, the module is not lowered, nor read by the ExecutionEngine.
+    auto cloned = cachedModule ? mod : mod.clone();
+    if (!cachedModule) {
+      auto context = cloned.getContext();
+      PassManager pm(context);
+      pm.addNestedPass<func::FuncOp>(cudaq::opt::createPySynthCallableBlockArgs(
+          SmallVector<StringRef>(names.begin(), names.end())));
+      pm.addPass(cudaq::opt::createGenerateDeviceCodeLoader({.jitTime = true}));
+      pm.addPass(cudaq::opt::createGenerateKernelExecution(
+          {.startingArgIdx = startingArgIdx}));
+      pm.addPass(cudaq::opt::createLambdaLiftingPass());
+      pm.addPass(createSymbolDCEPass());
+      cudaq::opt::addPipelineConvertToQIR(pm);
+
+      if (enablePrintMLIREachPass) {
+        cloned.getContext()->disableMultithreading();
+        pm.enableIRPrinting();
+      }
+
+      DefaultTimingManager tm;
+      tm.setEnabled(cudaq::isTimingTagEnabled(cudaq::TIMING_JIT_PASSES));
+      auto timingScope = tm.getRootScope(); // starts the timer
+      pm.enableTiming(timingScope);         // do this right before pm.run
+      if (failed(pm.run(cloned)))
+        throw std::runtime_error(
+            "cudaq::builder failed to JIT compile the Quake representation.");
+      timingScope.stop();
+    }
 
     // The "fast" instruction selection compilation algorithm is actually very
     // slow for large quantum circuits. Disable that here. Revisit this
@@ -141,15 +167,19 @@ jitAndCreateArgs(const std::string &name, MlirModule module,
     opts.jitCodeGenOptLevel = llvm::CodeGenOpt::None;
     SmallVector<StringRef, 4> sharedLibs;
     opts.llvmModuleBuilder =
-        [](Operation *module,
-           llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
+        [&](Operation *module,
+            llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
       llvmContext.setOpaquePointers(false);
+      if (cachedModule)
+        return cudaq::JITModuleCache::load(*cachedModule, llvmContext);
       auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
       if (!llvmModule) {
         llvm::errs() << "Failed to emit LLVM IR\n";
         return nullptr;
       }
       ExecutionEngine::setupTargetTriple(llvmModule.get());
+      if (!moduleKey.empty())
+        moduleCache.insert(moduleKey, *llvmModule);
       return llvmModule;
     };
 
@@ -313,13 +343,15 @@ std::tuple<void *, std::size_t, std::int32_t>
 pyAltLaunchKernelBase(const std::string &name, MlirModule module,
                       Type returnType, cudaq::OpaqueArguments &runtimeArgs,
                       const std::vector<std::string> &names,
-                      std::size_t startingArgIdx = 0) {
+                      std::size_t startingArgIdx = 0,
+                      std::optional<std::size_t> moduleHash = std::nullopt) {
   // Do not allow kernel execution if we are running with startingArgIdx > 0.
   // This is used in remote VQE execution.
   const bool launch = startingArgIdx == 0;
 
-  auto [jit, rawArgs, size, returnOffset] = jitAndCreateArgs(
-      name, module, runtimeArgs, names, returnType, startingArgIdx);
+  auto [jit, rawArgs, size, returnOffset] =
+      jitAndCreateArgs(name, module, runtimeArgs, names, returnType,
+                       startingArgIdx, moduleHash);
 
   auto mod = unwrap(module);
   auto thunkName = name + ".thunk";
@@ -431,13 +463,20 @@ pyCreateNativeKernel(const std::string &name, MlirModule module,
   return cudaq::KernelArgsHolder(wrapper, size, returnOffset);
 }
 
+static void pyAltLaunchKernel(const std::string &name, MlirModule module,
+                              cudaq::OpaqueArguments &runtimeArgs,
+                              const std::vector<std::string> &names,
+                              std::optional<std::size_t> moduleHash) {
+  auto noneType = mlir::NoneType::get(unwrap(module).getContext());
+  auto [rawArgs, size, returnOffset] = pyAltLaunchKernelBase(
+      name, module, noneType, runtimeArgs, names, 0, moduleHash);
+  std::free(rawArgs);
+}
+
 void pyAltLaunchKernel(const std::string &name, MlirModule module,
                        cudaq::OpaqueArguments &runtimeArgs,
                        const std::vector<std::string> &names) {
-  auto noneType = mlir::NoneType::get(unwrap(module).getContext());
-  auto [rawArgs, size, returnOffset] =
-      pyAltLaunchKernelBase(name, module, noneType, runtimeArgs, names);
-  std::free(rawArgs);
+  pyAltLaunchKernel(name, module, runtimeArgs, names, std::nullopt);
 }
 
 void pyAltLaunchAnalogKernel(const std::string &name,
@@ -492,9 +531,10 @@ py::object readPyObject(mlir::Type ty, char *arg) {
 py::object pyAltLaunchKernelR(const std::string &name, MlirModule module,
                               MlirType returnType,
                               cudaq::OpaqueArguments &runtimeArgs,
-                              const std::vector<std::string> &names) {
+                              const std::vector<std::string> &names,
+                              std::optional<std::size_t> moduleHash) {
   auto [rawArgs, size, returnOffset] = pyAltLaunchKernelBase(
-      name, module, unwrap(returnType), runtimeArgs, names);
+      name, module, unwrap(returnType), runtimeArgs, names, 0, moduleHash);
 
   auto unwrapped = unwrap(returnType);
   auto rawReturn = ((char *)rawArgs) + returnOffset;
@@ -749,30 +789,42 @@ void bindAltLaunchKernel(py::module &mod) {
   mod.def(
       "pyAltLaunchKernel",
       [&](const std::string &kernelName, MlirModule module,
-          py::args runtimeArgs, std::vector<std::string> callable_names) {
+          py::args runtimeArgs, std::vector<std::string> callable_names,
+          std::optional<std::size_t> module_hash) {
         auto kernelFunc = getKernelFuncOp(module, kernelName);
 
         cudaq::OpaqueArguments args;
         cudaq::packArgs(args, runtimeArgs, kernelFunc, callableArgHandler);
-        pyAltLaunchKernel(kernelName, module, args, callable_names);
+        pyAltLaunchKernel(kernelName, module, args, callable_names,
+                          module_hash);
       },
       py::arg("kernelName"), py::arg("module"), py::kw_only(),
-      py::arg("callable_names") = std::vector<std::string>{}, "DOC STRING");
+      py::arg("callable_names") = std::vector<std::string>{},
+      py::arg("module_hash") = std::nullopt, "DOC STRING");
 
   mod.def(
       "pyAltLaunchKernelR",
       [&](const std::string &kernelName, MlirModule module, MlirType returnType,
-          py::args runtimeArgs, std::vector<std::string> callable_names) {
+          py::args runtimeArgs, std::vector<std::string> callable_names,
+          std::optional<std::size_t> module_hash) {
         auto kernelFunc = getKernelFuncOp(module, kernelName);
 
         cudaq::OpaqueArguments args;
         cudaq::packArgs(args, runtimeArgs, kernelFunc, callableArgHandler);
         return pyAltLaunchKernelR(kernelName, module, returnType, args,
-                                  callable_names);
+                                  callable_names, module_hash);
       },
       py::arg("kernelName"), py::arg("module"), py::arg("returnType"),
       py::kw_only(), py::arg("callable_names") = std::vector<std::string>{},
-      "DOC STRING");
+      py::arg("module_hash") = std::nullopt, "DOC STRING");
+
+  mod.def(
+      "getModuleHash",
+      [](MlirModule module) { return computeModuleHash(unwrap(module)); },
+      py::arg("module"),
+      "Return the hash identifying the JIT compilation of the given module in "
+      "this process. Kernels whose module does not change between launches "
+      "can pass it to `pyAltLaunchKernel` as `module_hash`.");
 
   mod.def(
       "pyAltLaunchAnalogKernel",
@@ -9,11 +9,13 @@
 #pragma once
 
 #include "common/ArgumentConversion.h"
+#include "common/CompiledKernelCache.h"
 #include "common/Environment.h"
 #include "common/ExecutionContext.h"
 #include "common/Executor.h"
 #include "common/FmtCore.h"
 #include "common/Logger.h"
+#include "common/MeasurementGrouping.h"
 #include "common/RestClient.h"
 #include "common/RuntimeMLIR.h"
 #include "cudaq.h"
@@ -29,6 +31,7 @@
 #include "cudaq/Optimizer/Dialect/Quake/QuakeOps.h"
 #include "cudaq/Optimizer/Transforms/Passes.h"
 #include "cudaq/Support/Plugin.h"
+#include "cudaq/Support/Version.h"
 #include "cudaq/Support/TargetConfig.h"
 #include "cudaq/operators.h"
 #include "cudaq/platform/qpu.h"
@@ -46,17 +49,22 @@
 #include "mlir/ExecutionEngine/ExecutionEngine.h"
 #include "mlir/ExecutionEngine/OptUtils.h"
 #include "mlir/IR/ImplicitLocOpBuilder.h"
+#include "mlir/IR/Threading.h"
 #include "mlir/Parser/Parser.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Pass/PassRegistry.h"
 #include "mlir/Tools/mlir-translate/Translation.h"
 #include "mlir/Transforms/Passes.h"
+#include <exception>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <netinet/in.h>
 #include <regex>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unordered_map>
 
 namespace cudaq {
 
@@ -114,6 +122,11 @@ protected:
   /// to be printed. This is similar to `-mlir-pass-statistics` in `cudaq-opt`
   bool enablePassStatistics = false;
 
+  /// @brief Flag indicating whether kernels whose arguments are all
+  /// floating-point scalars are lowered once with symbolic arguments and reused
+  /// for every set of argument values.
+  bool useParameterizedTemplates = true;
+
   /// @brief If we are emulating locally, keep track
   /// of JIT engines for invoking the kernels.
   std::vector<mlir::ExecutionEngine *> jitEngines;
@@ -258,6 +271,8 @@ public:
         getEnvBool("CUDAQ_MLIR_PRINT_EACH_PASS", enablePrintMLIREachPass);
     enablePassStatistics =
         getEnvBool("CUDAQ_MLIR_PASS_STATISTICS", enablePassStatistics);
+    useParameterizedTemplates = getEnvBool("CUDAQ_REST_PARAMETERIZED_TEMPLATES",
+                                           useParameterizedTemplates);
 
     // If the very verbose enablePrintMLIREachPass flag is set, then
     // multi-threading must be disabled.
@@ -383,6 +398,47 @@ public:
     return output_names;
   }
 
+  /// @brief Return the key under which the lowering of the given
+  /// (argument-synthesized) module is cached, or `std::nullopt` if it must not
+  /// be cached. The key captures the kernel IR as well as everything in the
+  /// target configuration and execution context that the lowering depends on.
+  std::optional<std::string>
+  getCompiledKernelCacheKey(mlir::ModuleOp moduleOp) {
+    // Emulation needs the JIT engines built during lowering, and the debug
+    // options print while lowering.
+    if (emulate || printIR || enablePrintMLIREachPass || enablePassStatistics ||
+        !CompiledKernelCache::get().enabled())
+      return std::nullopt;
+    return getLoweringKey(moduleOp);
+  }
+
+  /// @brief Return a string identifying the lowering of the given module for
+  /// the current target configuration and execution context.
+  std::string getLoweringKey(mlir::ModuleOp moduleOp) {
+    std::string key;
+    llvm::raw_string_ostream os(key);
+    os << cudaq::getFullRepositoryVersion() << '\n'
+       << qpuName << '\n'
+       << passPipelineConfig << '\n'
+       << codegenTranslation << '\n'
+       << postCodeGenPasses << '\n';
+    for (auto &[k, v] : backendConfig)
+      os << k << '=' << v << ';';
+    os << '\n';
+    if (executionContext) {
+      os << executionContext->name << '\n';
+      // Observe lowers one module per measurement group, named after its
+      // basis or, for a single term, after the term.
+      if (executionContext->name == "observe")
+        for (auto &group :
+             cudaq::groupCommutingTerms(executionContext->spin.value()))
+          os << group.basis << ':' << group.terms.size() << ';';
+      os << '\n';
+    }
+    moduleOp.print(os);
+    return os.str();
+  }
+
   std::vector<cudaq::KernelExecution>
   lowerQuakeCode(const std::string &kernelName, void *kernelArgs) {
     return lowerQuakeCode(kernelName, kernelArgs, {});
@@ -431,71 +487,28 @@ public:
         moduleOp.push_back(globalOp.clone());
     }
 
-    // Lambda to apply a specific pipeline to the given ModuleOp
-    auto runPassPipeline = [&](const std::string &pipeline,
-                               mlir::ModuleOp moduleOpIn) {
-      mlir::PassManager pm(&context);
-      std::string errMsg;
-      llvm::raw_string_ostream os(errMsg);
-      cudaq::info("Pass pipeline for {} = {}", kernelName, pipeline);
-      if (failed(parsePassPipeline(pipeline, pm, os)))
-        throw std::runtime_error(
-            "Remote rest platform failed to add passes to pipeline (" + errMsg +
-            ").");
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOpIn.getContext()->disableMultithreading();
-      if (enablePrintMLIREachPass)
-        pm.enableIRPrinting();
-      if (failed(pm.run(moduleOpIn)))
-        throw std::runtime_error("Remote rest platform Quake lowering failed.");
-    };
-
-    if (!rawArgs.empty() || updatedArgs) {
-      mlir::PassManager pm(&context);
-      if (!rawArgs.empty()) {
-        cudaq::info("Run Argument Synth.\n");
-        // For quantum devices, we generate a collection of `init` and
-        // `num_qubits` functions and their substitutions created
-        // from a kernel and arguments that generated a state argument.
-        cudaq::opt::ArgumentConverter argCon(kernelName, moduleOp);
-        argCon.gen(rawArgs);
-
-        // Store kernel and substitution strings on the stack.
-        // We pass string references to the `createArgumentSynthesisPass`.
-        mlir::SmallVector<std::string> kernels;
-        mlir::SmallVector<std::string> substs;
-        for (auto *kInfo : argCon.getKernelSubstitutions()) {
-          std::string kernName =
-              cudaq::runtime::cudaqGenPrefixName + kInfo->getKernelName().str();
-          kernels.emplace_back(kernName);
-          std::string substBuff;
-          llvm::raw_string_ostream ss(substBuff);
-          ss << kInfo->getSubstitutionModule();
-          substs.emplace_back(substBuff);
-        }
+    // Kernels taking only floating-point arguments (e.g., the angles of a
+    // variational ansatz) reuse a lowering with symbolic arguments.
+    if (auto codes = lowerWithParameterizedTemplate(kernelName, moduleOp,
+                                                    rawArgs, updatedArgs)) {
+      cleanupContext(contextPtr);
+      return std::move(*codes);
+    }
 
-        // Collect references for the argument synthesis.
-        mlir::SmallVector<mlir::StringRef> kernelRefs{kernels.begin(),
-                                                      kernels.end()};
-        mlir::SmallVector<mlir::StringRef> substRefs{substs.begin(),
-                                                     substs.end()};
-        pm.addPass(opt::createArgumentSynthesisPass(kernelRefs, substRefs));
-        pm.addPass(opt::createDeleteStates());
-        pm.addNestedPass<mlir::func::FuncOp>(
-            opt::createReplaceStateWithKernel());
-        pm.addPass(mlir::createSymbolDCEPass());
-      } else if (updatedArgs) {
-        cudaq::info("Run Quake Synth.\n");
-        pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, updatedArgs));
+    if (!rawArgs.empty() || updatedArgs)
+      synthesizeArguments(kernelName, moduleOp, rawArgs, updatedArgs);
+
+    // Lowering a kernel the same way it was lowered before (e.g., in each
+    // iteration of a variational loop) reuses the cached result.
+    auto cacheKey = getCompiledKernelCacheKey(moduleOp);
+    if (cacheKey)
+      if (auto codes = CompiledKernelCache::get().lookup(*cacheKey)) {
+        cudaq::info("Using cached lowering of kernel {}.", kernelName);
+        setReorderIdx(codes->empty() ? std::vector<std::size_t>{}
+                                     : codes->front().mapping_reorder_idx);
+        cleanupContext(contextPtr);
+        return std::move(*codes);
       }
-      pm.addPass(mlir::createCanonicalizerPass());
-      if (disableMLIRthreading || enablePrintMLIREachPass)
-        moduleOp.getContext()->disableMultithreading();
-      if (enablePrintMLIREachPass)
-        pm.enableIRPrinting();
-      if (failed(pm.run(moduleOp)))
-        throw std::runtime_error("Could not successfully apply quake-synth.");
-    }
 
     // Delay combining measurements for backends that cannot handle
     // subveqs and multiple measurements until we created the emulation code.
@@ -511,11 +524,146 @@ public:
                   passPipelineConfig);
     }
 
-    runPassPipeline(passPipelineConfig, moduleOp);
+    std::vector<std::size_t> mapping_reorder_idx;
+    auto modules =
+        lowerToTargetModules(kernelName, moduleOp, mapping_reorder_idx);
+    setReorderIdx(mapping_reorder_idx);
+
+    if (emulate) {
+      // If we are in emulation mode, we need to first get a full QIR
+      // representation of the code. Then we'll map to an LLVM Module, create a
+      // JIT ExecutionEngine pointer and use that for execution
+      for (auto &[name, module] : modules) {
+        auto clonedModule = module.clone();
+        jitEngines.emplace_back(
+            cudaq::createQIRJITEngine(clonedModule, codegenTranslation));
+      }
+    }
+
+    if (emulate && combineMeasurements)
+      for (auto &[name, module] : modules)
+        runPassPipeline(kernelName, "func.func(combine-measurements)", module);
+
+    auto codes = translateModules(modules, mapping_reorder_idx);
+    if (cacheKey)
+      CompiledKernelCache::get().insert(*cacheKey, codes);
+    cleanupContext(contextPtr);
+    return codes;
+  }
+
+  /// @brief Apply the given pass pipeline to the given module.
+  void runPassPipeline(const std::string &kernelName,
+                       const std::string &pipeline, mlir::ModuleOp moduleOp) {
+    mlir::PassManager pm(moduleOp.getContext());
+    std::string errMsg;
+    llvm::raw_string_ostream os(errMsg);
+    cudaq::info("Pass pipeline for {} = {}", kernelName, pipeline);
+    if (failed(parsePassPipeline(pipeline, pm, os)))
+      throw std::runtime_error(
+          "Remote rest platform failed to add passes to pipeline (" + errMsg +
+          ").");
+    if (disableMLIRthreading || enablePrintMLIREachPass)
+      moduleOp.getContext()->disableMultithreading();
+    if (enablePrintMLIREachPass)
+      pm.enableIRPrinting();
+    if (failed(pm.run(moduleOp)))
+      throw std::runtime_error("Remote rest platform Quake lowering failed.");
+  }
+
+  /// @brief Replace the arguments of the kernel in the given module with the
+  /// given argument values, either as raw pointers to each argument or as a
+  /// packed argument buffer.
+  void synthesizeArguments(const std::string &kernelName,
+                           mlir::ModuleOp moduleOp,
+                           const std::vector<void *> &rawArgs,
+                           void *updatedArgs) {
+    mlir::PassManager pm(moduleOp.getContext());
+    if (!rawArgs.empty()) {
+      cudaq::info("Run Argument Synth.\n");
+      // For quantum devices, we generate a collection of `init` and
+      // `num_qubits` functions and their substitutions created
+      // from a kernel and arguments that generated a state argument.
+      cudaq::opt::ArgumentConverter argCon(kernelName, moduleOp);
+      argCon.gen(rawArgs);
+
+      // Store kernel and substitution strings on the stack.
+      // We pass string references to the `createArgumentSynthesisPass`.
+      mlir::SmallVector<std::string> kernels;
+      mlir::SmallVector<std::string> substs;
+      for (auto *kInfo : argCon.getKernelSubstitutions()) {
+        std::string kernName =
+            cudaq::runtime::cudaqGenPrefixName + kInfo->getKernelName().str();
+        kernels.emplace_back(kernName);
+        std::string substBuff;
+        llvm::raw_string_ostream ss(substBuff);
+        ss << kInfo->getSubstitutionModule();
+        substs.emplace_back(substBuff);
+      }
+
+      // Collect references for the argument synthesis.
+      mlir::SmallVector<mlir::StringRef> kernelRefs{kernels.begin(),
+                                                    kernels.end()};
+      mlir::SmallVector<mlir::StringRef> substRefs{substs.begin(),
+                                                   substs.end()};
+      pm.addPass(opt::createArgumentSynthesisPass(kernelRefs, substRefs));
+      pm.addPass(opt::createDeleteStates());
+      pm.addNestedPass<mlir::func::FuncOp>(opt::createReplaceStateWithKernel());
+      pm.addPass(mlir::createSymbolDCEPass());
+    } else if (updatedArgs) {
+      cudaq::info("Run Quake Synth.\n");
+      pm.addPass(cudaq::opt::createQuakeSynthesizer(kernelName, updatedArgs));
+    }
+    pm.addPass(mlir::createCanonicalizerPass());
+    if (disableMLIRthreading || enablePrintMLIREachPass)
+      moduleOp.getContext()->disableMultithreading();
+    if (enablePrintMLIREachPass)
+      pm.enableIRPrinting();
+    if (failed(pm.run(moduleOp)))
+      throw std::runtime_error("Could not successfully apply quake-synth.");
+  }
+
+  /// @brief Call `body` with each index in `[0, count)`. The calls after the
+  /// first one run concurrently on the thread pool of `context`, unless MLIR
+  /// multithreading is disabled or a debug option prints while lowering. The
+  /// first call runs alone, so that the dialects the calls need are loaded
+  /// before any concurrent call (loading a dialect is not thread-safe). An
+  /// exception thrown by a call is rethrown once all calls have completed.
+  void forEachModule(mlir::MLIRContext *context, std::size_t count,
+                     const std::function<void(std::size_t)> &body) {
+    if (count == 0)
+      return;
+    body(0);
+    if (disableMLIRthreading || printIR || enablePassStatistics) {
+      for (std::size_t i = 1; i < count; i++)
+        body(i);
+      return;
+    }
+    std::vector<std::exception_ptr> errors(count);
+    mlir::parallelFor(context, 1, count, [&](std::size_t i) {
+      try {
+        body(i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+    for (auto &error : errors)
+      if (error)
+        std::rethrow_exception(error);
+  }
+
+  /// @brief Run the target pass pipeline on the given module and return the
+  /// modules to translate and submit, with their names. For observe, there is
+  /// one module per measurement group.
+  std::vector<std::pair<std::string, mlir::ModuleOp>>
+  lowerToTargetModules(const std::string &kernelName, mlir::ModuleOp moduleOp,
+                       std::vector<std::size_t> &mapping_reorder_idx) {
+    auto combineMeasurements =
+        passPipelineConfig.find("combine-measurements") != std::string::npos;
+    runPassPipeline(kernelName, passPipelineConfig, moduleOp);
 
     auto entryPointFunc = moduleOp.lookupSymbol<mlir::func::FuncOp>(
         std::string(cudaq::runtime::cudaqGenPrefixName) + kernelName);
-    std::vector<std::size_t> mapping_reorder_idx;
+    mapping_reorder_idx.clear();
     if (auto mappingAttr = dyn_cast_if_present<mlir::ArrayAttr>(
             entryPointFunc->getAttr("mapping_reorder_idx"))) {
       mapping_reorder_idx.resize(mappingAttr.size());
@@ -525,100 +673,216 @@ public:
                      });
     }
 
-    if (executionContext) {
-      if (executionContext->name == "sample")
-        executionContext->reorderIdx = mapping_reorder_idx;
-      else
-        executionContext->reorderIdx.clear();
-    }
-
     std::vector<std::pair<std::string, mlir::ModuleOp>> modules;
     // Apply observations if necessary
     if (executionContext && executionContext->name == "observe") {
       mapping_reorder_idx.clear();
-      runPassPipeline("canonicalize,cse", moduleOp);
+      runPassPipeline(kernelName, "canonicalize,cse", moduleOp);
       cudaq::spin_op &spin = executionContext->spin.value();
-      for (const auto &term : spin) {
-        if (term.is_identity())
-          continue;
-
-        // Get the ansatz
-        [[maybe_unused]] auto ansatz =
-            moduleOp.lookupSymbol<mlir::func::FuncOp>(
-                cudaq::runtime::cudaqGenPrefixName + kernelName);
-        assert(ansatz && "could not find the ansatz kernel");
-
-        // Create a new Module to clone the ansatz into it
-        auto tmpModuleOp = moduleOp.clone();
+      // Measure each set of qubit-wise commuting terms with a single circuit.
+      // The results of the terms are recovered from the group results by
+      // `expandMeasurementGroups`.
+      auto groups = cudaq::groupCommutingTerms(spin);
+
+      // Get the ansatz
+      [[maybe_unused]] auto ansatz = moduleOp.lookupSymbol<mlir::func::FuncOp>(
+          cudaq::runtime::cudaqGenPrefixName + kernelName);
+      assert(ansatz && "could not find the ansatz kernel");
+
+      // The target pipeline ran once on the ansatz above. Each group clones
+      // the lowered ansatz and only appends its basis change and
+      // measurements, concurrently with the other groups.
+      for (const auto &group : groups)
+        modules.emplace_back(group.terms.size() == 1
+                                 ? group.terms.front().get_term_id()
+                                 : group.registerName(),
+                             moduleOp.clone());
+
+      // The full pass pipeline was run above, but the ansatz pass can
+      // introduce gates that aren't supported by the backend, so we need to
+      // re-run the gate set mapping if that existed in the original pass
+      // pipeline.
+      std::vector<std::string> gateSetMappings;
+      for (auto &pass : cudaq::split(passPipelineConfig, ','))
+        if (pass.ends_with("-gate-set-mapping"))
+          gateSetMappings.push_back(pass);
+
+      if (disableMLIRthreading)
+        moduleOp.getContext()->disableMultithreading();
+      forEachModule(moduleOp.getContext(), groups.size(), [&](std::size_t i) {
+        const auto &group = groups[i];
+        auto bsf = group.terms.size() == 1
+                       ? group.terms.front().get_binary_symplectic_form()
+                       : cudaq::spin_op::from_word(group.basis)
+                             .get_binary_symplectic_form();
+        auto tmpModuleOp = modules[i].second;
 
         // Create the pass manager, add the quake observe ansatz pass and run it
         // followed by the canonicalizer
-        mlir::PassManager pm(&context);
+        mlir::PassManager pm(tmpModuleOp.getContext());
         pm.addNestedPass<mlir::func::FuncOp>(
-            cudaq::opt::createObserveAnsatzPass(
-                term.get_binary_symplectic_form()));
-        if (disableMLIRthreading || enablePrintMLIREachPass)
-          tmpModuleOp.getContext()->disableMultithreading();
+            cudaq::opt::createObserveAnsatzPass(bsf));
         if (enablePrintMLIREachPass)
           pm.enableIRPrinting();
         if (failed(pm.run(tmpModuleOp)))
           throw std::runtime_error("Could not apply measurements to ansatz.");
-        // The full pass pipeline was run above, but the ansatz pass can
-        // introduce gates that aren't supported by the backend, so we need to
-        // re-run the gate set mapping if that existed in the original pass
-        // pipeline.
-        auto csvSplit = cudaq::split(passPipelineConfig, ',');
-        for (auto &pass : csvSplit)
-          if (pass.ends_with("-gate-set-mapping"))
-            runPassPipeline(pass, tmpModuleOp);
+        for (auto &pass : gateSetMappings)
+          runPassPipeline(kernelName, pass, tmpModuleOp);
         if (!emulate && combineMeasurements)
-          runPassPipeline("func.func(combine-measurements)", tmpModuleOp);
-        modules.emplace_back(term.get_term_id(), tmpModuleOp);
-      }
+          runPassPipeline(kernelName, "func.func(combine-measurements)",
+                          tmpModuleOp);
+      });
     } else
       modules.emplace_back(kernelName, moduleOp);
+    return modules;
+  }
 
-    if (emulate) {
-      // If we are in emulation mode, we need to first get a full QIR
-      // representation of the code. Then we'll map to an LLVM Module, create a
-      // JIT ExecutionEngine pointer and use that for execution
-      for (auto &[name, module] : modules) {
-        auto clonedModule = module.clone();
-        jitEngines.emplace_back(
-            cudaq::createQIRJITEngine(clonedModule, codegenTranslation));
-      }
-    }
-
-    if (emulate && combineMeasurements)
-      for (auto &[name, module] : modules)
-        runPassPipeline("func.func(combine-measurements)", module);
-
+  /// @brief Translate the given modules with the target code generation.
+  std::vector<cudaq::KernelExecution> translateModules(
+      const std::vector<std::pair<std::string, mlir::ModuleOp>> &modules,
+      std::vector<std::size_t> mapping_reorder_idx) {
     // Get the code gen translation
     auto translation = cudaq::getTranslation(codegenTranslation);
 
-    // Apply user-specified codegen
+    // Apply user-specified codegen. The modules are independent (e.g., one
+    // per measurement group for observe), translate them concurrently.
+    std::vector<std::string> codeStrs(modules.size());
+    std::vector<nlohmann::json> outputNames(modules.size());
+    if (!modules.empty() && disableMLIRthreading)
+      modules.front().second.getContext()->disableMultithreading();
+    forEachModule(
+        modules.empty() ? nullptr : modules.front().second.getContext(),
+        modules.size(), [&](std::size_t i) {
+          auto moduleOpI = modules[i].second;
+          {
+            llvm::raw_string_ostream outStr(codeStrs[i]);
+            if (failed(translation(moduleOpI, outStr, postCodeGenPasses,
+                                   printIR, enablePrintMLIREachPass,
+                                   enablePassStatistics)))
+              throw std::runtime_error("Could not successfully translate to " +
+                                       codegenTranslation + ".");
+          }
+
+          // Form an output_names mapping from codeStr
+          outputNames[i] =
+              formOutputNames(codegenTranslation, moduleOpI, codeStrs[i]);
+        });
+
     std::vector<cudaq::KernelExecution> codes;
-    for (auto &[name, moduleOpI] : modules) {
-      std::string codeStr;
-      {
-        llvm::raw_string_ostream outStr(codeStr);
-        if (disableMLIRthreading)
-          moduleOpI.getContext()->disableMultithreading();
-        if (failed(translation(moduleOpI, outStr, postCodeGenPasses, printIR,
-                               enablePrintMLIREachPass, enablePassStatistics)))
-          throw std::runtime_error("Could not successfully translate to " +
-                                   codegenTranslation + ".");
-      }
+    for (std::size_t i = 0; i < modules.size(); i++)
+      codes.emplace_back(modules[i].first, codeStrs[i], outputNames[i],
+                         mapping_reorder_idx);
+    return codes;
+  }
+
+  /// @brief Set the qubit reordering of the current execution context.
+  void setReorderIdx(const std::vector<std::size_t> &mapping_reorder_idx) {
+    if (!executionContext)
+      return;
+    if (executionContext->name == "sample")
+      executionContext->reorderIdx = mapping_reorder_idx;
+    else
+      executionContext->reorderIdx.clear();
+  }
 
-      // Form an output_names mapping from codeStr
-      nlohmann::json j =
-          formOutputNames(codegenTranslation, moduleOpI, codeStr);
+  /// @brief Lower a kernel whose arguments are all floating-point scalars with
+  /// a parameterized template. The first call for a kernel runs the target
+  /// pass pipeline (decomposition, qubit mapping, observe measurements) with
+  /// the arguments left symbolic. Every call then only binds the argument
+  /// values into the template and translates it. Return `std::nullopt` if the
+  /// kernel must be lowered with its arguments synthesized.
+  ///
+  /// Templates are stored in the `CompiledKernelCache`, as one entry per
+  /// lowered module holding its printed (generic form) MLIR. An empty entry
+  /// marks a kernel that cannot be lowered with symbolic arguments.
+  std::optional<std::vector<cudaq::KernelExecution>>
+  lowerWithParameterizedTemplate(const std::string &kernelName,
+                                 mlir::ModuleOp moduleOp,
+                                 const std::vector<void *> &rawArgs,
+                                 void *updatedArgs) {
+    if (!useParameterizedTemplates || (rawArgs.empty() && !updatedArgs))
+      return std::nullopt;
 
-      codes.emplace_back(name, codeStr, j, mapping_reorder_idx);
+    auto func = moduleOp.lookupSymbol<mlir::func::FuncOp>(
+        std::string(cudaq::runtime::cudaqGenPrefixName) + kernelName);
+    auto argTypes = func.getFunctionType().getInputs();
+    if (argTypes.empty() ||
+        (!rawArgs.empty() && rawArgs.size() != argTypes.size()) ||
+        !llvm::all_of(argTypes, [](mlir::Type ty) {
+          return mlir::isa<mlir::FloatType>(ty);
+        }))
+      return std::nullopt;
+
+    // Keyed by the kernel before argument synthesis, which cannot collide
+    // with the key of a synthesized kernel thanks to the prefix.
+    auto cacheKey = getCompiledKernelCacheKey(moduleOp);
+    if (!cacheKey)
+      return std::nullopt;
+    cacheKey->insert(0, "parameterized-template\n");
+
+    auto &cache = CompiledKernelCache::get();
+    auto tmpl = cache.lookup(*cacheKey);
+    if (!tmpl) {
+      tmpl.emplace();
+      auto templateModule = moduleOp.clone();
+      try {
+        std::vector<std::size_t> mappingReorderIdx;
+        auto modules = lowerToTargetModules(kernelName, templateModule,
+                                            mappingReorderIdx);
+        for (auto &[name, module] : modules) {
+          std::string moduleStr;
+          {
+            llvm::raw_string_ostream os(moduleStr);
+            module->print(os, mlir::OpPrintingFlags().printGenericOpForm());
+          }
+          nlohmann::json outputNames;
+          tmpl->emplace_back(name, moduleStr, outputNames,
+                             mappingReorderIdx);
+          if (module != templateModule)
+            module->erase();
+        }
+        cudaq::info("Created parameterized template for kernel {}.",
+                    kernelName);
+      } catch (std::exception &e) {
+        cudaq::info("Kernel {} cannot be lowered with symbolic arguments ({}), "
+                    "synthesizing its arguments instead.",
+                    kernelName, e.what());
+        tmpl->clear();
+      }
+      templateModule->erase();
+      cache.insert(*cacheKey, *tmpl);
     }
 
-    cleanupContext(contextPtr);
-    return codes;
+    if (tmpl->empty())
+      return std::nullopt;
+
+    const auto &mappingReorderIdx = tmpl->front().mapping_reorder_idx;
+    try {
+      std::vector<mlir::OwningOpRef<mlir::ModuleOp>> boundModules(
+          tmpl->size());
+      forEachModule(moduleOp.getContext(), tmpl->size(), [&](std::size_t i) {
+        auto module = mlir::parseSourceString<mlir::ModuleOp>(
+            (*tmpl)[i].code, moduleOp.getContext());
+        if (!module)
+          throw std::runtime_error("could not parse the template");
+        synthesizeArguments(kernelName, *module, rawArgs, updatedArgs);
+        boundModules[i] = std::move(module);
+      });
+      std::vector<std::pair<std::string, mlir::ModuleOp>> modules;
+      for (std::size_t i = 0; i < boundModules.size(); i++)
+        modules.emplace_back((*tmpl)[i].name, *boundModules[i]);
+      auto codes = translateModules(modules, mappingReorderIdx);
+      setReorderIdx(mappingReorderIdx);
+      return codes;
+    } catch (std::exception &e) {
+      // Do not try the template again, the kernel is lowered with its
+      // arguments synthesized from now on.
+      cudaq::info("Could not bind the arguments of kernel {} ({}), "
+                  "synthesizing its arguments instead.",
+                  kernelName, e.what());
+      cache.insert(*cacheKey, {});
+      return std::nullopt;
+    }
   }
 
   void launchKernel(const std::string &kernelName,
@@ -780,6 +1044,9 @@ public:
 
     // Otherwise make this synchronous
     executionContext->result = future.get();
+    if (isObserve)
+      cudaq::expandMeasurementGroups(executionContext->result,
+                                     executionContext->spin.value());
   }
 };
 } // namespace cudaq
@@ -50,8 +50,10 @@
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <regex>
 #include <streambuf>
+#include <unordered_set>
 
 namespace {
 /// Util class to execute a functor when an object of this class goes
@@ -101,6 +103,62 @@ protected:
   /// `-mlir-print-ir-after-all` in `cudaq-opt`.
   bool enablePrintMLIREachPass = false;
 
+  /// @brief Hashes of the kernel modules that the server has acknowledged to
+  /// hold in its module cache. Requests for these modules omit the code.
+  std::unordered_set<std::string> m_serverCodeHashes;
+  std::mutex m_serverCodeHashesMutex;
+
+  bool isCodeCachedOnServer(const std::string &codeHash) {
+    std::scoped_lock lock(m_serverCodeHashesMutex);
+    return m_serverCodeHashes.contains(codeHash);
+  }
+
+  void setCodeCachedOnServer(const std::string &codeHash, bool cached) {
+    std::scoped_lock lock(m_serverCodeHashesMutex);
+    if (cached)
+      m_serverCodeHashes.insert(codeHash);
+    else
+      m_serverCodeHashes.erase(codeHash);
+  }
+
+  /// @brief Post the job `request` to the server and return its response. The
+  /// code of the request is only uploaded if the server does not hold the
+  /// module already, i.e., if it has not acknowledged the hash of the code in
+  /// the response to a previous request, or if it reports that the module is
+  /// missing (e.g., because it has been evicted from the server cache).
+  json postJobRequest(cudaq::RestRequest &request,
+                      std::map<std::string, std::string> &headers) {
+    cudaq::RestClient restClient;
+    std::string omittedCode;
+    if (request.codeHash.has_value() &&
+        isCodeCachedOnServer(*request.codeHash)) {
+      cudaq::info("Sending the hash of the kernel module {} in lieu of its "
+                  "code.",
+                  *request.codeHash);
+      omittedCode = std::exchange(request.code, std::string());
+    }
+
+    json requestJson = request;
+    auto resultJs = restClient.post(m_url, "job", requestJson, headers, false);
+    if (!omittedCode.empty() &&
+        resultJs.contains(cudaq::RestRequest::MISSING_CODE_HASH_KEY)) {
+      cudaq::info("The server does not hold the kernel module {}, resending "
+                  "the request with its code.",
+                  *request.codeHash);
+      setCodeCachedOnServer(*request.codeHash, false);
+      request.code = std::move(omittedCode);
+      requestJson = request;
+      resultJs = restClient.post(m_url, "job", requestJson, headers, false);
+    }
+
+    if (request.codeHash.has_value() &&
+        resultJs.contains(cudaq::RestRequest::CACHED_CODE_HASH_KEY) &&
+        resultJs[cudaq::RestRequest::CACHED_CODE_HASH_KEY] ==
+            *request.codeHash)
+      setCodeCachedOnServer(*request.codeHash, true);
+    return resultJs;
+  }
+
 public:
   virtual void setConfig(
       const std::unordered_map<std::string, std::string> &configs) override {
@@ -425,16 +483,18 @@ public:
       return false;
     }
 
+    // Identify the kernel module by its content, so that the server can reuse
+    // the module (and its JIT compilation) across requests.
+    if (!request.code.empty())
+      request.codeHash = cudaq::RestRequest::getCodeHash(request.code);
+
     // Don't let curl adding "Expect: 100-continue" header, which is not
     // suitable for large requests, e.g., bitcode in the JSON request.
     //  Ref: https://gms.tf/when-curl-sends-100-continue.html
     std::map<std::string, std::string> headers{
         {"Expect:", ""}, {"Content-type", "application/json"}};
-    json requestJson = request;
     try {
-      cudaq::RestClient restClient;
-      auto resultJs =
-          restClient.post(m_url, "job", requestJson, headers, false);
+      auto resultJs = postJobRequest(request, headers);
       cudaq::debug("Response: {}", resultJs.dump(/*indent=*/2));
 
       if (!resultJs.contains("executionContext")) {
@@ -0,0 +1,211 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CompiledKernelCache.h"
+#include "Logger.h"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+
+namespace cudaq {
+
+namespace {
+/// @brief 64-bit FNV-1a hash. Unlike `std::hash`, the value is specified, so
+/// that on-disk entries are found across processes and builds.
+std::uint64_t hashKey(const std::string &key) {
+  std::uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : key) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+nlohmann::json toJson(const std::string &key,
+                      const std::vector<KernelExecution> &codes) {
+  nlohmann::json entry;
+  entry["key"] = key;
+  auto &jsonCodes = entry["codes"] = nlohmann::json::array();
+  for (const auto &code : codes)
+    jsonCodes.push_back({{"name", code.name},
+                         {"code", code.code},
+                         {"output_names", code.output_names},
+                         {"mapping_reorder_idx", code.mapping_reorder_idx},
+                         {"user_data", code.user_data}});
+  return entry;
+}
+
+std::vector<KernelExecution> fromJson(const nlohmann::json &entry) {
+  std::vector<KernelExecution> codes;
+  for (const auto &jsonCode : entry.at("codes")) {
+    auto name = jsonCode.at("name").get<std::string>();
+    auto code = jsonCode.at("code").get<std::string>();
+    auto outputNames = jsonCode.at("output_names");
+    auto reorderIdx =
+        jsonCode.at("mapping_reorder_idx").get<std::vector<std::size_t>>();
+    auto userData = jsonCode.at("user_data");
+    codes.emplace_back(name, code, outputNames, reorderIdx, userData);
+  }
+  return codes;
+}
+} // namespace
+
+CompiledKernelCache::CompiledKernelCache(std::size_t capacity,
+                                         const std::filesystem::path &directory)
+    : capacity(capacity), directory(directory) {
+  if (directory.empty() || capacity == 0)
+    return;
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) {
+    cudaq::warn("Could not create the kernel cache directory {} ({}), "
+                "caching in memory only.",
+                directory.string(), ec.message());
+    this->directory.clear();
+  }
+}
+
+CompiledKernelCache &CompiledKernelCache::get() {
+  static CompiledKernelCache cache = [] {
+    std::size_t capacity = 128;
+    if (auto envVal = std::getenv("CUDAQ_REST_CACHE_CAPACITY")) {
+      try {
+        capacity = std::stoul(envVal);
+      } catch (...) {
+        throw std::runtime_error(
+            "Invalid CUDAQ_REST_CACHE_CAPACITY value, must be a "
+            "non-negative integer.");
+      }
+    }
+    std::filesystem::path directory;
+    if (auto envVal = std::getenv("CUDAQ_REST_CACHE_DIR"))
+      directory = envVal;
+    return CompiledKernelCache(capacity, directory);
+  }();
+  return cache;
+}
+
+std::optional<std::vector<KernelExecution>>
+CompiledKernelCache::lookup(const std::string &key) {
+  if (!enabled())
+    return std::nullopt;
+
+  {
+    std::scoped_lock lock(mutex);
+    auto iter = index.find(key);
+    if (iter != index.end()) {
+      // Move to the front (most recently used).
+      entries.splice(entries.begin(), entries, iter->second);
+      return iter->second->second;
+    }
+  }
+
+  auto codes = loadFromDisk(key);
+  if (codes)
+    insertInMemory(key, *codes);
+  return codes;
+}
+
+void CompiledKernelCache::insert(const std::string &key,
+                                 const std::vector<KernelExecution> &codes) {
+  if (!enabled())
+    return;
+  insertInMemory(key, codes);
+  storeToDisk(key, codes);
+}
+
+void CompiledKernelCache::clear() {
+  std::scoped_lock lock(mutex);
+  index.clear();
+  entries.clear();
+}
+
+std::size_t CompiledKernelCache::size() const {
+  std::scoped_lock lock(mutex);
+  return entries.size();
+}
+
+void CompiledKernelCache::insertInMemory(
+    const std::string &key, const std::vector<KernelExecution> &codes) {
+  std::scoped_lock lock(mutex);
+  auto iter = index.find(key);
+  if (iter != index.end()) {
+    iter->second->second = codes;
+    entries.splice(entries.begin(), entries, iter->second);
+    return;
+  }
+
+  if (entries.size() == capacity) {
+    index.erase(entries.back().first);
+    entries.pop_back();
+  }
+  entries.emplace_front(key, codes);
+  index.emplace(entries.front().first, entries.begin());
+}
+
+std::filesystem::path
+CompiledKernelCache::getEntryPath(const std::string &key) const {
+  std::stringstream name;
+  name << std::hex << hashKey(key) << ".json";
+  return directory / name.str();
+}
+
+std::optional<std::vector<KernelExecution>>
+CompiledKernelCache::loadFromDisk(const std::string &key) const {
+  if (directory.empty())
+    return std::nullopt;
+
+  auto path = getEntryPath(key);
+  std::ifstream file(path);
+  if (!file)
+    return std::nullopt;
+  try {
+    auto entry = nlohmann::json::parse(file);
+    if (entry.at("key").get<std::string>() != key)
+      return std::nullopt;
+    cudaq::info("Loaded cached kernel lowering from {}.", path.string());
+    return fromJson(entry);
+  } catch (std::exception &e) {
+    cudaq::info("Ignoring invalid kernel cache entry {} ({}).", path.string(),
+                e.what());
+    return std::nullopt;
+  }
+}
+
+void CompiledKernelCache::storeToDisk(
+    const std::string &key, const std::vector<KernelExecution> &codes) const {
+  if (directory.empty())
+    return;
+
+  // Write to a unique temporary file, then rename it, so that concurrent
+  // readers and writers never see a partial entry.
+  auto path = getEntryPath(key);
+  auto tmpPath = path;
+  tmpPath += "." + std::to_string(::getpid()) + "." +
+             std::to_string(std::hash<std::thread::id>{}(
+                 std::this_thread::get_id())) +
+             ".tmp";
+  bool written = false;
+  {
+    std::ofstream file(tmpPath);
+    file << toJson(key, codes).dump();
+    written = file.good();
+  }
+  std::error_code ec;
+  if (written)
+    std::filesystem::rename(tmpPath, path, ec);
+  if (!written || ec) {
+    cudaq::info("Could not write kernel cache entry {} ({}).", path.string(),
+                ec.message());
+    std::filesystem::remove(tmpPath, ec);
+  }
+}
+
+} // namespace cudaq
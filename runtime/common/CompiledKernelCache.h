@@ -0,0 +1,81 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/ServerHelper.h"
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief A content-addressed cache of kernels lowered for remote QPUs.
+///
+/// Entries map a key, which must capture everything the lowering depends on
+/// (synthesized kernel IR, target configuration, pass pipelines, execution
+/// context), to the `KernelExecution` payloads produced for it. The cache has
+/// an in-memory LRU layer and an optional on-disk layer, which can be shared
+/// between processes. On-disk entries are written atomically and store their
+/// full key, so that a hash collision or a truncated file is a miss.
+class CompiledKernelCache {
+public:
+  /// @brief Create a cache holding up to `capacity` entries in memory. If
+  /// `directory` is not empty, entries are also persisted there.
+  CompiledKernelCache(std::size_t capacity,
+                      const std::filesystem::path &directory = {});
+
+  /// @brief Return the process-wide cache, configured with the
+  /// `CUDAQ_REST_CACHE_CAPACITY` (number of in-memory entries, `0` disables
+  /// caching, default 128) and `CUDAQ_REST_CACHE_DIR` (on-disk layer, off by
+  /// default) environment variables.
+  static CompiledKernelCache &get();
+
+  /// @brief Return true if the cache stores anything.
+  bool enabled() const { return capacity > 0; }
+
+  /// @brief Return the payloads cached for `key`, if any.
+  std::optional<std::vector<KernelExecution>> lookup(const std::string &key);
+
+  /// @brief Cache the payloads for `key`, evicting the least recently used
+  /// in-memory entry if the cache is full.
+  void insert(const std::string &key, const std::vector<KernelExecution> &codes);
+
+  /// @brief Drop all in-memory entries. On-disk entries are kept.
+  void clear();
+
+  /// @brief Return the number of in-memory entries.
+  std::size_t size() const;
+
+private:
+  using Entry = std::pair<std::string, std::vector<KernelExecution>>;
+
+  void insertInMemory(const std::string &key,
+                      const std::vector<KernelExecution> &codes);
+  std::filesystem::path getEntryPath(const std::string &key) const;
+  std::optional<std::vector<KernelExecution>>
+  loadFromDisk(const std::string &key) const;
+  void storeToDisk(const std::string &key,
+                   const std::vector<KernelExecution> &codes) const;
+
+  std::size_t capacity;
+  std::filesystem::path directory;
+
+  mutable std::mutex mutex;
+  /// @brief The in-memory entries, most recently used first.
+  std::list<Entry> entries;
+  /// @brief Index of `entries`, viewing the keys stored in the list nodes.
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+};
+
+} // namespace cudaq
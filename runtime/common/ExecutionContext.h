@@ -117,6 +117,47 @@ public:
   /// order.
   bool explicitMeasurements = false;
 
+  /// @brief For the "adjoint-gradient" context, the derivatives of the
+  /// expectation value of `spin` with respect to the parameters of the gates
+  /// applied by the kernel, in the order the gates and their parameters were
+  /// applied, which are recorded in `kernelTrace`. The simulator also sets
+  /// `expectationValue` when it computed them, and leaves both empty if it
+  /// cannot.
+  std::vector<double> gateParameterGradient;
+
+  /// @brief Whether the shots of a sampling task on a kernel with conditional
+  /// feedback are branched at each measurement. Set by the sampling loop to
+  /// request branching, and cleared by the simulator if it cannot branch.
+  /// Rather than executing the kernel once per shot, each execution follows one
+  /// branch of measurement outcomes (`branchOutcomes`) and accounts for
+  /// `branchShots` shots. At a measurement not yet on the branch, the simulator
+  /// splits these shots binomially between the two outcomes, continues with
+  /// one and records the other in `pendingBranches`. The sampling loop executes
+  /// the pending branches (see `nextShotBranch()`) until all shots are
+  /// accounted for, so that the number of executions is the number of distinct
+  /// measurement histories rather than the number of shots.
+  bool shotBranching = false;
+
+  /// @brief The measurement outcomes of the current branch, in execution order.
+  std::vector<bool> branchOutcomes;
+
+  /// @brief The number of shots of the current branch.
+  std::size_t branchShots = 0;
+
+  /// @brief Branches (outcomes and number of shots) left to execute.
+  std::vector<std::pair<std::vector<bool>, std::size_t>> pendingBranches;
+
+  /// @brief Make the next pending branch the current one. Return false if
+  /// there are no pending branches.
+  bool nextShotBranch() {
+    if (pendingBranches.empty())
+      return false;
+    branchOutcomes = std::move(pendingBranches.back().first);
+    branchShots = pendingBranches.back().second;
+    pendingBranches.pop_back();
+    return true;
+  }
+
   /// @brief The Constructor, takes the name of the context
   /// @param n The name of the context
   ExecutionContext(const std::string n) : name(n) {}
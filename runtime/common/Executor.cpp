@@ -8,8 +8,99 @@
 
 #include "Executor.h"
 #include "common/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
 
 namespace cudaq {
+namespace {
+/// @brief Process-wide pool of threads posting jobs, each over its own
+/// persistent `RestClient` session. All executors share it, so that
+/// concurrent launches (e.g., asynchronous ones on several QPUs) never post
+/// more than `Executor::getMaxConcurrentSubmissions()` jobs at a time, and no
+/// thread is created per launch.
+class SubmissionPool {
+public:
+  using Task = std::packaged_task<void(RestClient &)>;
+
+  explicit SubmissionPool(std::size_t numThreads) {
+    for (std::size_t i = 0; i < numThreads; i++)
+      threads.emplace_back([this]() { run(); });
+  }
+
+  ~SubmissionPool() {
+    {
+      std::scoped_lock lock(mutex);
+      stopping = true;
+    }
+    taskAdded.notify_all();
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  /// @brief Queue `task`, to be run by the next available thread.
+  std::future<void> submit(Task task) {
+    auto future = task.get_future();
+    {
+      std::scoped_lock lock(mutex);
+      tasks.push_back(std::move(task));
+    }
+    taskAdded.notify_one();
+    return future;
+  }
+
+private:
+  void run() {
+    RestClient client;
+    while (true) {
+      Task task;
+      {
+        std::unique_lock lock(mutex);
+        taskAdded.wait(lock, [this] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+          return;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task(client);
+    }
+  }
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable taskAdded;
+  std::deque<Task> tasks;
+  bool stopping = false;
+};
+
+SubmissionPool &getSubmissionPool() {
+  static SubmissionPool pool(Executor::getMaxConcurrentSubmissions());
+  return pool;
+}
+} // namespace
+
+std::size_t Executor::getMaxConcurrentSubmissions() {
+  static const std::size_t maxConcurrentSubmissions = [] {
+    std::size_t value = 8;
+    if (auto envVal = std::getenv("CUDAQ_REST_MAX_CONCURRENT_SUBMISSIONS")) {
+      try {
+        value = std::stoul(envVal);
+      } catch (...) {
+        throw std::runtime_error(
+            "Invalid CUDAQ_REST_MAX_CONCURRENT_SUBMISSIONS value, must be a "
+            "positive integer.");
+      }
+    }
+    return std::max<std::size_t>(value, 1);
+  }();
+  return maxConcurrentSubmissions;
+}
+
 details::future Executor::execute(std::vector<KernelExecution> &codesToExecute,
                                   bool isObserve) {
 
@@ -20,36 +111,80 @@ details::future Executor::execute(std::vector<KernelExecution> &codesToExecute,
 
   // Create the Job Payload, composed of job post path, headers,
   // and the job json messages themselves
-  auto [jobPostPath, headers, jobs] = serverHelper->createJob(codesToExecute);
+  std::string jobPostPath;
+  RestHeaders headers;
+  std::vector<ServerMessage> jobs;
+  std::tie(jobPostPath, headers, jobs) =
+      serverHelper->createJob(codesToExecute);
 
   auto config = serverHelper->getConfig();
 
-  std::vector<details::future::Job> ids;
-  for (std::size_t i = 0; auto &job : jobs) {
-    cudaq::info("Job (name={}) created, posting to {}", codesToExecute[i].name,
+  // Post the jobs concurrently from the submission pool.
+  std::vector<ServerMessage> responses(jobs.size());
+  auto postJob = [&](RestClient &postClient, std::size_t i,
+                     RestHeaders &postHeaders) {
+    cudaq::info("Job {} of {} created, posting to {}", i + 1, jobs.size(),
                 jobPostPath);
+    responses[i] = postClient.post(jobPostPath, "", jobs[i], postHeaders);
+    cudaq::info("Job {} of {} posted, response was {}", i + 1, jobs.size(),
+                responses[i].dump());
+  };
 
-    // Post it, get the response
-    auto response = client.post(jobPostPath, "", job, headers);
-    cudaq::info("Job (name={}) posted, response was {}", codesToExecute[i].name,
-                response.dump());
-
-    // Add the job id and the job name.
-    auto task_id = serverHelper->extractJobId(response);
-    if (task_id.empty()) {
-      nlohmann::json tmp(job.at("tasks"));
-      serverHelper->constructGetJobPath(tmp[0]);
-      task_id = tmp[0].at("task_id");
+  // Once a job fails, the jobs that did not start yet are not posted.
+  std::atomic<bool> failed = false;
+  std::vector<std::future<void>> posted;
+  for (std::size_t i = 0; i < jobs.size(); i++)
+    posted.push_back(getSubmissionPool().submit(
+        SubmissionPool::Task([&, i](RestClient &poolClient) {
+          if (failed)
+            return;
+          auto jobHeaders = headers;
+          try {
+            postJob(poolClient, i, jobHeaders);
+          } catch (...) {
+            failed = true;
+            throw;
+          }
+        })));
+  // Wait for all the jobs before reporting the first error, since the tasks
+  // refer to this frame.
+  std::exception_ptr error;
+  for (auto &f : posted) {
+    try {
+      f.get();
+    } catch (...) {
+      if (!error)
+        error = std::current_exception();
     }
-    cudaq::info("Task ID is {}", task_id);
-    ids.emplace_back(task_id, codesToExecute[i].name);
-    config["output_names." + task_id] = codesToExecute[i].output_names.dump();
+  }
+  if (error)
+    std::rethrow_exception(error);
 
-    nlohmann::json jReorder = codesToExecute[i].mapping_reorder_idx;
-    config["reorderIdx." + task_id] = jReorder.dump();
+  // A job message may carry several kernels, hence the ids of all jobs are
+  // matched to the kernels in order.
+  std::vector<details::future::Job> ids;
+  for (std::size_t i = 0; i < jobs.size(); i++) {
+    for (auto &task_id : serverHelper->extractJobIds(responses[i], jobs[i])) {
+      const auto k = ids.size();
+      if (k >= codesToExecute.size())
+        throw std::runtime_error("The " + serverHelper->name() +
+                                 " server returned more job ids than the " +
+                                 std::to_string(codesToExecute.size()) +
+                                 " kernels submitted.");
+      cudaq::info("Task ID is {}", task_id);
+      ids.emplace_back(task_id, codesToExecute[k].name);
+      config["output_names." + task_id] =
+          codesToExecute[k].output_names.dump();
 
-    i++;
+      nlohmann::json jReorder = codesToExecute[k].mapping_reorder_idx;
+      config["reorderIdx." + task_id] = jReorder.dump();
+    }
   }
+  if (ids.size() != codesToExecute.size())
+    throw std::runtime_error(
+        "The " + serverHelper->name() + " server returned " +
+        std::to_string(ids.size()) + " job ids for the " +
+        std::to_string(codesToExecute.size()) + " kernels submitted.");
 
   config.insert({"shots", std::to_string(shots)});
   std::string name = serverHelper->name();
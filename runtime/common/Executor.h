@@ -39,8 +39,15 @@ public:
   /// @brief Set the number of shots to execute
   void setShots(std::size_t s) { shots = s; }
 
+  /// @brief Return the maximum number of jobs posted concurrently by
+  /// `execute`, set by the `CUDAQ_REST_MAX_CONCURRENT_SUBMISSIONS` environment
+  /// variable (default 8).
+  static std::size_t getMaxConcurrentSubmissions();
+
   /// @brief Execute the provided quantum codes and return a future object
   /// The caller can make this synchronous by just immediately calling .get().
+  /// The jobs are posted concurrently from a process-wide pool of threads, up
+  /// to `getMaxConcurrentSubmissions()` at a time across all executors.
   virtual details::future execute(std::vector<KernelExecution> &codesToExecute,
                                   bool isObserve = false);
 };
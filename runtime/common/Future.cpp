@@ -11,6 +11,10 @@
 #include "ObserveResult.h"
 #include "RestClient.h"
 #include "ServerHelper.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <optional>
 #include <thread>
 
 namespace cudaq::details {
@@ -25,43 +29,112 @@ sample_result future::get() {
   serverHelper->initialize(serverConfig);
   auto headers = serverHelper->getHeaders();
 
-  std::vector<ExecutionResult> results;
-  for (auto &id : jobs) {
-    cudaq::info("Future retrieving results for {}.", id.first);
-
-    auto jobGetPath = serverHelper->constructGetJobPath(id.first);
-
-    cudaq::info("Future got job retrieval path as {}.", jobGetPath);
-    auto resultResponse = client.get(jobGetPath, "", headers);
-    while (!serverHelper->jobIsDone(resultResponse)) {
-      auto polling_interval =
-          serverHelper->nextResultPollingInterval(resultResponse);
-      std::this_thread::sleep_for(polling_interval);
-      resultResponse = client.get(jobGetPath, "", headers);
+  // Poll all outstanding jobs in rounds and process the results of each job
+  // as soon as it is done. The polling interval suggested by the server
+  // helper is backed off while no job completes. Servers that support it are
+  // polled for several jobs per request.
+  std::vector<std::vector<ExecutionResult>> jobResults(jobs.size());
+  const std::size_t jobsPerRequest =
+      std::max<std::size_t>(serverHelper->getMaxJobsPerResultsRequest(), 1);
+  std::vector<std::string> jobGetPaths;
+  if (jobsPerRequest == 1)
+    for (auto &id : jobs) {
+      jobGetPaths.push_back(serverHelper->constructGetJobPath(id.first));
+      cudaq::info("Future got job retrieval path for {} as {}.", id.first,
+                  jobGetPaths.back());
     }
-    auto c = serverHelper->processResults(resultResponse, id.first);
-
-    if (isObserve) {
-      // Use the job name instead of the global register.
-      results.emplace_back(c.to_map(), id.second);
-      results.back().sequentialData = c.sequential_data();
-    } else {
-      if (c.has_expectation()) {
-        // If the QPU returns the data with expectation values, just use it
-        // directly.
-        // This can be the case for remote emulation/simulation providers who
-        // compute the expectation value for us.
-        return c;
+
+  // Return the current responses for the jobs `pending`.
+  auto getResponses = [&](const std::vector<std::size_t> &pending) {
+    std::vector<ServerMessage> responses;
+    responses.reserve(pending.size());
+    if (jobsPerRequest == 1) {
+      for (auto i : pending) {
+        cudaq::info("Future retrieving results for {}.", jobs[i].first);
+        responses.push_back(client.get(jobGetPaths[i], "", headers));
       }
+      return responses;
+    }
 
-      // For each register, add the results into result.
-      for (auto &regName : c.register_names()) {
-        results.emplace_back(c.to_map(regName), regName);
-        results.back().sequentialData = c.sequential_data(regName);
+    for (std::size_t b = 0; b < pending.size(); b += jobsPerRequest) {
+      std::vector<std::string> ids;
+      for (std::size_t k = b; k < std::min(b + jobsPerRequest, pending.size());
+           k++)
+        ids.push_back(jobs[pending[k]].first);
+      cudaq::info("Future retrieving results for {} jobs.", ids.size());
+      auto bulkResponse =
+          client.get(serverHelper->constructGetJobsPath(ids), "", headers);
+      auto split = serverHelper->splitJobsResponse(bulkResponse, ids);
+      if (split.size() != ids.size())
+        throw std::runtime_error("Expected the results of " +
+                                 std::to_string(ids.size()) + " jobs, got " +
+                                 std::to_string(split.size()) + ".");
+      responses.insert(responses.end(), std::make_move_iterator(split.begin()),
+                       std::make_move_iterator(split.end()));
+    }
+    return responses;
+  };
+
+  constexpr std::chrono::microseconds maxBackoff = std::chrono::seconds(1);
+  std::vector<std::size_t> pending(jobs.size());
+  std::iota(pending.begin(), pending.end(), 0);
+  std::size_t backoffRounds = 0;
+  while (!pending.empty()) {
+    std::vector<std::size_t> stillPending;
+    std::optional<std::chrono::microseconds> interval;
+    auto responses = getResponses(pending);
+    for (std::size_t k = 0; k < pending.size(); k++) {
+      const auto i = pending[k];
+      auto &id = jobs[i];
+      auto &resultResponse = responses[k];
+      if (!serverHelper->jobIsDone(resultResponse)) {
+        auto jobInterval =
+            serverHelper->nextResultPollingInterval(resultResponse);
+        interval = interval ? std::min(*interval, jobInterval) : jobInterval;
+        stillPending.push_back(i);
+        continue;
+      }
+
+      auto c = serverHelper->processResults(resultResponse, id.first);
+      if (isObserve) {
+        // Use the job name instead of the global register.
+        jobResults[i].emplace_back(c.to_map(), id.second);
+        jobResults[i].back().sequentialData = c.sequential_data();
+      } else {
+        if (c.has_expectation()) {
+          // If the QPU returns the data with expectation values, just use it
+          // directly.
+          // This can be the case for remote emulation/simulation providers who
+          // compute the expectation value for us.
+          return c;
+        }
+
+        // For each register, add the results into result.
+        for (auto &regName : c.register_names()) {
+          jobResults[i].emplace_back(c.to_map(regName), regName);
+          jobResults[i].back().sequentialData = c.sequential_data(regName);
+        }
       }
     }
+
+    if (stillPending.empty())
+      break;
+    backoffRounds =
+        stillPending.size() < pending.size() ? 0 : backoffRounds + 1;
+    pending = std::move(stillPending);
+    std::chrono::microseconds delay =
+        *interval *
+        (std::int64_t{1} << std::min<std::size_t>(backoffRounds, 16));
+    std::this_thread::sleep_for(
+        std::max(*interval, std::min(delay, maxBackoff)));
   }
 
+  // Keep the results in the order of the jobs.
+  std::vector<ExecutionResult> results;
+  for (auto &r : jobResults)
+    results.insert(results.end(), std::make_move_iterator(r.begin()),
+                   std::make_move_iterator(r.end()));
+
   return sample_result(results);
 #else
   throw std::runtime_error("cudaq::details::future::get() requires REST Client "
@@ -8,6 +8,7 @@
 
 #pragma once
 #include "MeasureCounts.h"
+#include "MeasurementGrouping.h"
 #include "ObserveResult.h"
 
 #include <functional>
@@ -138,6 +139,7 @@ public:
         return observe_result(data.expectation(checkRegName), *spinOp, data);
 
       // this assumes we ran in shots mode.
+      expandMeasurementGroups(data, *spinOp);
       double sum = 0.0;
       for (const auto &term : spinOp.value()) {
         if (term.is_identity())
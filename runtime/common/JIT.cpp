@@ -31,10 +31,8 @@
 #define DEBUG_TYPE "cudaq-qpud"
 
 namespace cudaq {
-std::unique_ptr<llvm::orc::LLJIT>
-invokeWrappedKernel(std::string_view irString, const std::string &entryPointFn,
-                    void *args, std::uint64_t argsSize, std::size_t numTimes,
-                    std::function<void(std::size_t)> postExecCallback) {
+JitWrappedKernel compileWrappedKernel(std::string_view irString,
+                                      const std::string &entryPointFn) {
 
   std::unique_ptr<llvm::LLVMContext> ctx(new llvm::LLVMContext);
   // Parse bitcode
@@ -130,20 +128,26 @@ invokeWrappedKernel(std::string_view irString, const std::string &entryPointFn,
           dataLayout.getGlobalPrefix())));
 
   // Symbol lookup: kernel and wrapper
+  JitWrappedKernel result;
   auto kernelSymbolAddr = llvm::cantFail(jit->lookup(mangledKernelNames.first));
-  void *fptr = kernelSymbolAddr.toPtr<void *>();
+  result.kernel = kernelSymbolAddr.toPtr<void *>();
   auto wrapperSymbolAddr =
       llvm::cantFail(jit->lookup(mangledKernelNames.second));
-  auto *fptrWrapper =
+  result.wrapper =
       wrapperSymbolAddr.toPtr<void (*)(const void *, unsigned long, void *)>();
+  result.jit = std::move(jit);
+  return result;
+}
+
+void invokeWrappedKernel(const JitWrappedKernel &kernel, void *args,
+                         std::uint64_t argsSize, std::size_t numTimes,
+                         std::function<void(std::size_t)> postExecCallback) {
   for (std::size_t i = 0; i < numTimes; ++i) {
     // Invoke the wrapper with serialized data and the kernel.
-    fptrWrapper(args, argsSize, fptr);
+    kernel.wrapper(args, argsSize, kernel.kernel);
     if (postExecCallback) {
       postExecCallback(i);
     }
   }
-
-  return jit;
 }
 } // namespace cudaq
@@ -14,17 +14,25 @@
 #include <string>
 
 namespace cudaq {
-/// Util to invoke a wrapped kernel defined by LLVM IR with serialized
-/// arguments.
+/// A wrapped kernel JIT compiled from LLVM IR. It can be invoked any number of
+/// times, with different serialized arguments.
+struct JitWrappedKernel {
+  std::unique_ptr<llvm::orc::LLJIT> jit;
+  void *kernel = nullptr;
+  void (*wrapper)(const void *, unsigned long, void *) = nullptr;
+};
+
+/// Util to JIT compile a wrapped kernel defined by LLVM IR.
 // Note: We don't use `mlir::ExecutionEngine` to skip unnecessary
 // `packFunctionArguments` (slow for raw LLVM IR containing many functions from
 // included headers).
-// Optionally, the JIT'ed kernel can be executed a number of
-// times along with a post-execution callback. For example, sample a dynamic
-// kernel.
-std::unique_ptr<llvm::orc::LLJIT>
-invokeWrappedKernel(std::string_view llvmIr, const std::string &kernelName,
-                    void *args, std::uint64_t argsSize,
-                    std::size_t numTimes = 1,
-                    std::function<void(std::size_t)> postExecCallback = {});
+JitWrappedKernel compileWrappedKernel(std::string_view llvmIr,
+                                      const std::string &kernelName);
+
+/// Util to invoke a JIT compiled wrapped kernel with serialized arguments.
+// Optionally, the kernel can be executed a number of times along with a
+// post-execution callback. For example, sample a dynamic kernel.
+void invokeWrappedKernel(const JitWrappedKernel &kernel, void *args,
+                         std::uint64_t argsSize, std::size_t numTimes = 1,
+                         std::function<void(std::size_t)> postExecCallback = {});
 } // namespace cudaq
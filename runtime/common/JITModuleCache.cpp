@@ -0,0 +1,199 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "JITModuleCache.h"
+#include "Logger.h"
+#include "cudaq/Support/Version.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/Host.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SHA256.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/IR/Operation.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace cudaq {
+
+JITModuleCache::JITModuleCache(const std::filesystem::path &directory,
+                               std::uintmax_t maxBytes)
+    : directory(directory), maxBytes(maxBytes) {
+  if (directory.empty())
+    return;
+  std::error_code ec;
+  std::filesystem::create_directories(directory, ec);
+  if (ec) {
+    cudaq::warn("Could not create the JIT cache directory {} ({}), JIT "
+                "caching is disabled.",
+                directory.string(), ec.message());
+    this->directory.clear();
+  }
+}
+
+JITModuleCache &JITModuleCache::get() {
+  static JITModuleCache cache = [] {
+    std::filesystem::path directory;
+    if (auto envVal = std::getenv("CUDAQ_JIT_CACHE_DIR"))
+      directory = envVal;
+    std::uintmax_t maxMegabytes = 1024;
+    if (auto envVal = std::getenv("CUDAQ_JIT_CACHE_MAX_SIZE")) {
+      try {
+        maxMegabytes = std::stoull(envVal);
+      } catch (...) {
+        throw std::runtime_error("Invalid CUDAQ_JIT_CACHE_MAX_SIZE value, must "
+                                 "be a non-negative integer.");
+      }
+    }
+    return JITModuleCache(directory, maxMegabytes << 20);
+  }();
+  return cache;
+}
+
+std::string JITModuleCache::getKey(mlir::Operation *module,
+                                   llvm::StringRef pipeline) {
+  // Hash the printed IR rather than the operations, since the hash of an
+  // operation depends on the addresses of its (uniqued) attributes and types.
+  std::string key;
+  llvm::raw_string_ostream os(key);
+  os << cudaq::getFullRepositoryVersion() << '\n'
+     << LLVM_VERSION_STRING << '\n'
+     << llvm::sys::getProcessTriple() << '\n'
+     << pipeline << '\n';
+  module->print(os);
+  llvm::SHA256 hasher;
+  hasher.update(os.str());
+  return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+}
+
+std::filesystem::path
+JITModuleCache::getEntryPath(const std::string &key) const {
+  return directory / (key + ".bc");
+}
+
+std::unique_ptr<llvm::MemoryBuffer>
+JITModuleCache::lookup(const std::string &key) const {
+  if (!enabled())
+    return nullptr;
+
+  auto path = getEntryPath(key);
+  auto buffer = llvm::MemoryBuffer::getFile(path.string());
+  if (!buffer)
+    return nullptr;
+  // Entries are written atomically, so this only rejects files that are not
+  // bitcode at all.
+  if (auto modules = llvm::getBitcodeModuleList(**buffer); !modules) {
+    cudaq::info("Ignoring invalid JIT cache entry {} ({}).", path.string(),
+                llvm::toString(modules.takeError()));
+    return nullptr;
+  }
+  // Mark the entry as recently used, for the eviction.
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), ec);
+  cudaq::info("Loaded cached JIT module from {}.", path.string());
+  return std::move(*buffer);
+}
+
+std::unique_ptr<llvm::Module>
+JITModuleCache::load(const llvm::MemoryBuffer &bitcode,
+                     llvm::LLVMContext &context) {
+  auto moduleOrError =
+      llvm::parseBitcodeFile(bitcode.getMemBufferRef(), context);
+  if (!moduleOrError) {
+    llvm::errs() << "Failed to load the cached JIT module "
+                 << bitcode.getBufferIdentifier() << ": "
+                 << llvm::toString(moduleOrError.takeError()) << '\n';
+    return nullptr;
+  }
+  return std::move(*moduleOrError);
+}
+
+void JITModuleCache::insert(const std::string &key,
+                            const llvm::Module &module) const {
+  if (!enabled())
+    return;
+
+  // Write to a unique temporary file, then rename it, so that concurrent
+  // readers and writers never see a partial entry.
+  auto path = getEntryPath(key);
+  auto tmpPath = path;
+  tmpPath += "." + std::to_string(::getpid()) + "." +
+             std::to_string(std::hash<std::thread::id>{}(
+                 std::this_thread::get_id())) +
+             ".tmp";
+  std::error_code ec;
+  bool written = false;
+  {
+    llvm::raw_fd_ostream file(tmpPath.string(), ec);
+    if (!ec) {
+      llvm::WriteBitcodeToFile(module, file);
+      file.close();
+      written = !file.has_error();
+      file.clear_error();
+    }
+  }
+  if (written)
+    std::filesystem::rename(tmpPath, path, ec);
+  if (!written || ec) {
+    cudaq::info("Could not write JIT cache entry {} ({}).", path.string(),
+                ec.message());
+    std::filesystem::remove(tmpPath, ec);
+    return;
+  }
+  evict();
+}
+
+void JITModuleCache::evict() const {
+  if (maxBytes == 0)
+    return;
+
+  struct Entry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type lastUse;
+    std::uintmax_t size;
+  };
+  std::vector<Entry> entries;
+  std::uintmax_t totalBytes = 0;
+  std::error_code ec;
+  for (const auto &file : std::filesystem::directory_iterator(directory, ec)) {
+    if (file.path().extension() != ".bc")
+      continue;
+    std::error_code fileEc;
+    auto size = file.file_size(fileEc);
+    auto lastUse = file.last_write_time(fileEc);
+    // Another process may have evicted the entry in the meantime.
+    if (fileEc)
+      continue;
+    entries.push_back({file.path(), lastUse, size});
+    totalBytes += size;
+  }
+  if (totalBytes <= maxBytes)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) {
+              return a.lastUse < b.lastUse;
+            });
+  for (const auto &entry : entries) {
+    if (totalBytes <= maxBytes)
+      break;
+    std::filesystem::remove(entry.path, ec);
+    totalBytes -= entry.size;
+    cudaq::info("Evicted JIT cache entry {}.", entry.path.string());
+  }
+}
+
+} // namespace cudaq
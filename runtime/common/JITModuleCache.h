@@ -0,0 +1,91 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "llvm/ADT/StringRef.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace llvm {
+class LLVMContext;
+class MemoryBuffer;
+class Module;
+} // namespace llvm
+
+namespace mlir {
+class Operation;
+} // namespace mlir
+
+namespace cudaq {
+
+/// @brief An on-disk cache of the LLVM modules produced when lowering Quake
+/// for JIT execution.
+///
+/// Lowering a kernel to LLVM IR (the MLIR pass pipelines and the translation to
+/// LLVM IR) dominates the JIT time of a new process, while the result only
+/// depends on the kernel IR, the pipeline and the toolchain. This cache stores
+/// the translated module as bitcode, so that a later process JIT compiling the
+/// same kernel only runs the LLVM code generation. The `mlir::ExecutionEngine`
+/// does not accept an external `llvm::ObjectCache`, hence the cache is filled
+/// and consulted from its `llvmModuleBuilder` callback.
+///
+/// Entries are named after a SHA-256 digest of their key and are written
+/// atomically, so the directory can be shared between processes. An entry
+/// that cannot be read is a miss. A lookup refreshes the modification time of
+/// the entry, and the least recently used entries are evicted when an insertion
+/// takes the directory over its size limit.
+class JITModuleCache {
+public:
+  /// @brief Create a cache persisting entries in `directory`, evicting entries
+  /// when they take more than `maxBytes` (0 for no limit). An empty
+  /// `directory` disables the cache.
+  JITModuleCache(const std::filesystem::path &directory = {},
+                 std::uintmax_t maxBytes = 0);
+
+  /// @brief Return the process-wide cache, persisting entries in the
+  /// directory given by the `CUDAQ_JIT_CACHE_DIR` environment variable (off by
+  /// default), up to `CUDAQ_JIT_CACHE_MAX_SIZE` megabytes (1024 by default, 0
+  /// for no limit).
+  static JITModuleCache &get();
+
+  /// @brief Return true if the cache stores anything.
+  bool enabled() const { return !directory.empty(); }
+
+  /// @brief Return the key of the LLVM module that lowering `module` with the
+  /// pipeline identified by `pipeline` produces. Besides the printed IR, the
+  /// key captures the CUDA-Q and LLVM versions and the host target triple.
+  static std::string getKey(mlir::Operation *module, llvm::StringRef pipeline);
+
+  /// @brief Return the bitcode cached for `key`, or null. The lookup happens
+  /// before the `mlir::ExecutionEngine` creates the context of the module,
+  /// use `load` to parse the bitcode in that context.
+  std::unique_ptr<llvm::MemoryBuffer> lookup(const std::string &key) const;
+
+  /// @brief Parse the `bitcode` returned by `lookup` in `context`. Return null
+  /// if it is not a valid module.
+  static std::unique_ptr<llvm::Module> load(const llvm::MemoryBuffer &bitcode,
+                                            llvm::LLVMContext &context);
+
+  /// @brief Cache `module` for `key`.
+  void insert(const std::string &key, const llvm::Module &module) const;
+
+private:
+  std::filesystem::path getEntryPath(const std::string &key) const;
+
+  /// @brief Remove the least recently used entries until the entries take at
+  /// most `maxBytes`.
+  void evict() const;
+
+  std::filesystem::path directory;
+  std::uintmax_t maxBytes;
+};
+
+} // namespace cudaq
@@ -16,6 +16,8 @@
 #include "cudaq/optimizers.h"
 #include "cudaq/simulators.h"
 #include "nlohmann/json.hpp"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/SHA256.h"
 /*! \file
     \brief Utility to support JSON serialization between the client and server.
 */
@@ -568,7 +570,7 @@ public:
   // IMPORTANT: When a new version is defined, a new NVQC deployment will be
   // needed.
   static constexpr std::size_t REST_PAYLOAD_VERSION = 1;
-  static constexpr std::size_t REST_PAYLOAD_MINOR_VERSION = 1;
+  static constexpr std::size_t REST_PAYLOAD_MINOR_VERSION = 2;
   RestRequest(ExecutionContext &context, int versionNumber)
       : executionContext(context), version(versionNumber),
         clientVersion(CUDA_QUANTUM_VERSION) {}
@@ -581,6 +583,9 @@ public:
 
   // Underlying code (IR) payload as a Base64 string.
   std::string code;
+  // Optional content hash of `code` (see `getCodeHash`). A request carrying
+  // the hash of a module that the server has cached may omit the code.
+  std::optional<std::string> codeHash;
   // Name of the entry-point kernel.
   std::string entryPoint;
   // Name of the NVQIR simulator to use.
@@ -616,6 +621,7 @@ public:
     TO_JSON_HELPER(simulator);
     TO_JSON_HELPER(executionContext);
     TO_JSON_HELPER(code);
+    TO_JSON_OPT_HELPER(codeHash);
     TO_JSON_HELPER(args);
     TO_JSON_HELPER(format);
     TO_JSON_OPT_HELPER(opt);
@@ -632,6 +638,7 @@ public:
     FROM_JSON_HELPER(simulator);
     FROM_JSON_HELPER(executionContext);
     FROM_JSON_HELPER(code);
+    FROM_JSON_OPT_HELPER(codeHash);
     FROM_JSON_HELPER(args);
     FROM_JSON_HELPER(format);
     FROM_JSON_OPT_HELPER(opt);
@@ -641,6 +648,22 @@ public:
     FROM_JSON_HELPER(clientVersion);
     FROM_JSON_OPT_HELPER(serializedCodeExecutionContext);
   }
+
+  /// Return the content hash of the Base64-encoded `code` of a request, i.e.,
+  /// its SHA-256 digest as a hex string.
+  static std::string getCodeHash(const std::string &code) {
+    llvm::SHA256 hasher;
+    hasher.update(code);
+    return llvm::toHex(hasher.final(), /*LowerCase=*/true);
+  }
+
+  // Keys of the job response fields of the module cache protocol. The server
+  // sets `cachedCodeHash` to the `codeHash` of the request once it holds the
+  // module, so that later requests can omit the code. It responds with
+  // `missingCodeHash` (and no execution context) to a request without code
+  // whose module it does not hold, which the client then resends with code.
+  static constexpr const char *CACHED_CODE_HASH_KEY = "cachedCodeHash";
+  static constexpr const char *MISSING_CODE_HASH_KEY = "missingCodeHash";
 };
 
 /// NVCF function version status
@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "MeasureCounts.h"
+#include "PackedCounts.h"
 #include "cudaq/spin_op.h"
 
 #include <algorithm>
@@ -374,7 +375,7 @@ double sample_result::expectation(const std::string_view registerName) const {
   const auto &counts = result.counts;
   for (auto &kv : counts) {
     auto par = has_even_parity(kv.first);
-    auto p = probability(kv.first, registerName);
+    auto p = (double)kv.second / totalShots;
     if (!par) {
       p = -p;
     }
@@ -402,27 +403,15 @@ sample_result
 sample_result::get_marginal(const std::vector<std::size_t> &marginalIndices,
                             const std::string_view registerName) const {
   const auto &counts = retrieve_result(registerName.data()).counts;
-  auto mutableIndices = marginalIndices;
-
-  std::sort(mutableIndices.begin(), mutableIndices.end());
-
-  ExecutionResult sr;
-  for (auto &[bits, count] : counts) {
-    std::string newBits;
-    for ([[maybe_unused]] auto &m : mutableIndices)
-      newBits += "0";
-    for (int counter = 0; auto &index : mutableIndices) {
-      if (index > bits.size())
-        throw std::runtime_error("Invalid marginal index (" +
-                                 std::to_string(index) +
-                                 ", size=" + std::to_string(bits.size()));
-
-      newBits[counter++] = bits[index];
-    }
-    sr.appendResult(newBits, count);
-  }
+  if (counts.empty())
+    return sample_result(ExecutionResult());
 
-  return sample_result(sr);
+  // Select the bits on the packed form, so each distinct bit string is parsed
+  // and formed once.
+  PackedCounts packed(counts.begin()->first.size());
+  for (auto &[bits, count] : counts)
+    packed.add(bits, count);
+  return sample_result(packed.marginal(marginalIndices).toExecutionResult());
 }
 
 void sample_result::clear() {
@@ -504,13 +493,14 @@ void sample_result::reorder(const std::vector<std::size_t> &idx,
   }
   result.counts = newCounts;
 
-  // Now process the sequential data
+  // Now process the sequential data, reusing one buffer for all shots.
+  std::string newBits;
   for (auto &s : result.sequentialData) {
-    std::string newBits(s);
+    newBits.resize(s.size());
     int i = 0;
     for (auto oldIdx : idx)
       newBits[i++] = s[oldIdx];
-    s = newBits;
+    s.swap(newBits);
   }
 }
 } // namespace cudaq
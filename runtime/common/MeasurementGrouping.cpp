@@ -0,0 +1,305 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "MeasurementGrouping.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <set>
+#include <unordered_set>
+
+namespace cudaq {
+
+namespace {
+/// @brief The non-identity Pauli operators of a term, as (qubit, Pauli letter)
+/// pairs sorted by qubit.
+using TermSupport = std::vector<std::pair<std::size_t, char>>;
+
+TermSupport getSupport(const spin_op_term &term) {
+  TermSupport support;
+  for (const auto &op : term) {
+    switch (op.as_pauli()) {
+    case pauli::X:
+      support.emplace_back(op.target(), 'X');
+      break;
+    case pauli::Y:
+      support.emplace_back(op.target(), 'Y');
+      break;
+    case pauli::Z:
+      support.emplace_back(op.target(), 'Z');
+      break;
+    case pauli::I:
+      break;
+    }
+  }
+  std::sort(support.begin(), support.end());
+  return support;
+}
+
+bool compatible(const TermSupport &a, const TermSupport &b) {
+  auto i = a.begin();
+  auto j = b.begin();
+  while (i != a.end() && j != b.end()) {
+    if (i->first < j->first)
+      ++i;
+    else if (j->first < i->first)
+      ++j;
+    else if ((i++)->second != (j++)->second)
+      return false;
+  }
+  return true;
+}
+
+bool compatible(const std::string &basis, const TermSupport &term) {
+  for (auto [qubit, op] : term)
+    if (qubit < basis.size() && basis[qubit] != 'I' && basis[qubit] != op)
+      return false;
+  return true;
+}
+
+bool isDiagonalIn(const std::string &basis, const TermSupport &term) {
+  for (auto [qubit, op] : term)
+    if (qubit >= basis.size() || basis[qubit] != op)
+      return false;
+  return true;
+}
+
+void extendBasis(std::string &basis, const TermSupport &term) {
+  if (!term.empty() && term.back().first >= basis.size())
+    basis.resize(term.back().first + 1, 'I');
+  for (auto [qubit, op] : term)
+    basis[qubit] = op;
+}
+
+std::vector<MeasurementGroup>
+groupGreedy(const std::vector<spin_op_term> &terms,
+            const std::vector<TermSupport> &supports) {
+  // Placing the terms with the largest support first leaves the smaller ones
+  // to fill the remaining gaps.
+  std::vector<std::size_t> order(terms.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t a, std::size_t b) {
+                     return supports[a].size() > supports[b].size();
+                   });
+
+  std::vector<MeasurementGroup> groups;
+  for (auto i : order) {
+    auto iter = std::find_if(groups.begin(), groups.end(), [&](auto &group) {
+      return compatible(group.basis, supports[i]);
+    });
+    if (iter == groups.end())
+      iter = groups.emplace(groups.end());
+    extendBasis(iter->basis, supports[i]);
+    iter->terms.push_back(terms[i]);
+  }
+  return groups;
+}
+
+std::vector<MeasurementGroup>
+groupColoring(const std::vector<spin_op_term> &terms,
+              const std::vector<TermSupport> &supports) {
+  const auto numTerms = terms.size();
+  std::vector<std::vector<std::size_t>> conflicts(numTerms);
+  for (std::size_t i = 0; i < numTerms; ++i)
+    for (std::size_t j = i + 1; j < numTerms; ++j)
+      if (!compatible(supports[i], supports[j])) {
+        conflicts[i].push_back(j);
+        conflicts[j].push_back(i);
+      }
+
+  // DSATUR: repeatedly color the vertex with the most distinctly colored
+  // neighbors (ties broken by degree) with the smallest available color.
+  constexpr auto uncolored = std::numeric_limits<std::size_t>::max();
+  std::vector<std::size_t> colors(numTerms, uncolored);
+  std::vector<std::set<std::size_t>> saturation(numTerms);
+  std::size_t numColors = 0;
+  for (std::size_t step = 0; step < numTerms; ++step) {
+    std::size_t next = uncolored;
+    for (std::size_t i = 0; i < numTerms; ++i) {
+      if (colors[i] != uncolored)
+        continue;
+      if (next == uncolored ||
+          saturation[i].size() > saturation[next].size() ||
+          (saturation[i].size() == saturation[next].size() &&
+           conflicts[i].size() > conflicts[next].size()))
+        next = i;
+    }
+
+    std::size_t color = 0;
+    while (saturation[next].count(color))
+      ++color;
+    colors[next] = color;
+    numColors = std::max(numColors, color + 1);
+    for (auto neighbor : conflicts[next])
+      saturation[neighbor].insert(color);
+  }
+
+  std::vector<MeasurementGroup> groups(numColors);
+  for (std::size_t i = 0; i < numTerms; ++i) {
+    extendBasis(groups[colors[i]].basis, supports[i]);
+    groups[colors[i]].terms.push_back(terms[i]);
+  }
+  return groups;
+}
+} // namespace
+
+std::vector<std::size_t> MeasurementGroup::measuredQubits() const {
+  std::vector<std::size_t> qubits;
+  for (std::size_t i = 0; i < basis.size(); ++i)
+    if (basis[i] != 'I')
+      qubits.push_back(i);
+  return qubits;
+}
+
+std::string MeasurementGroup::registerName() const {
+  return MeasurementGroupPrefix + basis;
+}
+
+std::string getGroupBasis(const std::string &registerName) {
+  const std::string_view prefix = MeasurementGroupPrefix;
+  if (!registerName.starts_with(prefix))
+    return "";
+  return registerName.substr(prefix.size());
+}
+
+bool qubitWiseCommute(const spin_op_term &a, const spin_op_term &b) {
+  return compatible(getSupport(a), getSupport(b));
+}
+
+GroupingStrategy getGroupingStrategy() {
+  auto envVal = std::getenv("CUDAQ_OBSERVE_GROUPING");
+  if (!envVal)
+    return GroupingStrategy::greedy;
+  std::string value(envVal);
+  std::transform(value.begin(), value.end(), value.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (value == "none" || value == "0" || value == "off")
+    return GroupingStrategy::none;
+  if (value == "greedy")
+    return GroupingStrategy::greedy;
+  if (value == "coloring")
+    return GroupingStrategy::coloring;
+  throw std::runtime_error("Invalid CUDAQ_OBSERVE_GROUPING value '" + value +
+                           "', must be one of none, greedy or coloring.");
+}
+
+std::vector<MeasurementGroup> groupCommutingTerms(const spin_op &op,
+                                                  GroupingStrategy strategy) {
+  std::vector<spin_op_term> terms;
+  std::vector<TermSupport> supports;
+  for (const auto &term : op) {
+    auto support = getSupport(term);
+    if (support.empty())
+      continue;
+    terms.push_back(term);
+    supports.push_back(std::move(support));
+  }
+
+  std::vector<MeasurementGroup> groups;
+  switch (strategy) {
+  case GroupingStrategy::none:
+    for (std::size_t i = 0; i < terms.size(); ++i) {
+      auto &group = groups.emplace_back();
+      extendBasis(group.basis, supports[i]);
+      group.terms.push_back(terms[i]);
+    }
+    break;
+  case GroupingStrategy::greedy:
+    groups = groupGreedy(terms, supports);
+    break;
+  case GroupingStrategy::coloring:
+    groups = groupColoring(terms, supports);
+    break;
+  }
+
+  cudaq::info("Grouped {} spin operator terms into {} measurement groups.",
+              terms.size(), groups.size());
+  return groups;
+}
+
+std::vector<ExecutionResult>
+expandGroupResult(const MeasurementGroup &group,
+                  const ExecutionResult &groupResult) {
+  const auto measured = group.measuredQubits();
+  std::vector<ExecutionResult> results;
+  results.reserve(group.terms.size());
+  for (const auto &term : group.terms) {
+    // Positions of the term qubits in the group bit strings.
+    std::vector<std::size_t> positions;
+    for (auto [qubit, op] : getSupport(term)) {
+      auto iter = std::lower_bound(measured.begin(), measured.end(), qubit);
+      if (iter == measured.end() || *iter != qubit)
+        throw std::runtime_error("Term " + term.get_term_id() +
+                                 " is not measured by group " +
+                                 group.registerName() + ".");
+      positions.push_back(iter - measured.begin());
+    }
+    const auto marginalize = [&](const std::string &bits) {
+      if (bits.size() != measured.size())
+        throw std::runtime_error("Invalid bit string length for group " +
+                                 group.registerName() + ".");
+      std::string marginal(positions.size(), '0');
+      for (std::size_t k = 0; k < positions.size(); ++k)
+        marginal[k] = bits[positions[k]];
+      return marginal;
+    };
+
+    CountsDictionary counts;
+    std::size_t totalShots = 0;
+    double parity = 0.;
+    for (const auto &[bits, count] : groupResult.counts) {
+      auto marginal = marginalize(bits);
+      const bool odd = std::count(marginal.begin(), marginal.end(), '1') % 2;
+      parity += odd ? -static_cast<double>(count) : count;
+      totalShots += count;
+      counts[marginal] += count;
+    }
+    const double expVal = totalShots ? parity / totalShots : 0.;
+
+    auto &result =
+        results.emplace_back(std::move(counts), term.get_term_id(), expVal);
+    result.sequentialData.reserve(groupResult.sequentialData.size());
+    for (const auto &bits : groupResult.sequentialData)
+      result.sequentialData.push_back(marginalize(bits));
+  }
+  return results;
+}
+
+void expandMeasurementGroups(sample_result &data, const spin_op &op) {
+  auto names = data.register_names();
+  std::unordered_set<std::string> measured(names.begin(), names.end());
+  for (const auto &name : names) {
+    auto basis = getGroupBasis(name);
+    if (basis.empty())
+      continue;
+
+    // A term may be diagonal in several group bases, any of them gives an
+    // unbiased estimate. Use the first.
+    MeasurementGroup group{basis, {}};
+    for (const auto &term : op) {
+      auto support = getSupport(term);
+      if (support.empty() || !isDiagonalIn(basis, support))
+        continue;
+      if (measured.insert(term.get_term_id()).second)
+        group.terms.push_back(term);
+    }
+    if (group.terms.empty())
+      continue;
+
+    ExecutionResult groupResult(data.to_map(name), name);
+    groupResult.sequentialData = data.sequential_data(name);
+    for (auto &result : expandGroupResult(group, groupResult))
+      data.append(result);
+  }
+}
+
+} // namespace cudaq
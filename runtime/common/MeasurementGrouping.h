@@ -0,0 +1,87 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "common/MeasureCounts.h"
+#include "cudaq/operators.h"
+#include <string>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief Strategy used to partition the terms of a spin operator into sets of
+/// qubit-wise commuting terms, each of which is measured with a single
+/// circuit when computing an expectation value.
+enum class GroupingStrategy {
+  /// @brief Measure every term with its own circuit.
+  none,
+  /// @brief Visit the terms from the largest to the smallest support and add
+  /// each one to the first group it is compatible with.
+  greedy,
+  /// @brief Color the graph whose edges connect terms that do not commute
+  /// qubit-wise (DSATUR heuristic), one group per color. Typically yields
+  /// fewer groups than `greedy` for large operators, at a quadratic cost.
+  coloring
+};
+
+/// @brief A set of qubit-wise commuting spin operator terms, together with the
+/// product basis in which all of them are diagonal.
+struct MeasurementGroup {
+  /// @brief The measurement basis as a Pauli word, one letter per qubit, `I`
+  /// for the qubits that are not measured.
+  std::string basis;
+
+  /// @brief The (non-identity) terms measured by this group.
+  std::vector<spin_op_term> terms;
+
+  /// @brief Return the measured qubits, in increasing order. Bit `k` of the
+  /// bit strings sampled for this group is the result for the `k`-th of these.
+  std::vector<std::size_t> measuredQubits() const;
+
+  /// @brief Return the name under which the results for this group are
+  /// stored. The basis can be recovered from the name with
+  /// `getGroupBasis`.
+  std::string registerName() const;
+};
+
+/// @brief Prefix of the register names of measurement groups.
+inline constexpr const char *MeasurementGroupPrefix = "__group__";
+
+/// @brief Return the basis encoded in a measurement group register name, or an
+/// empty string if `registerName` does not name a measurement group.
+std::string getGroupBasis(const std::string &registerName);
+
+/// @brief Return true if the two terms commute qubit-wise, i.e. act with the
+/// same Pauli operator on every qubit they both act on non-trivially.
+bool qubitWiseCommute(const spin_op_term &a, const spin_op_term &b);
+
+/// @brief Return the grouping strategy selected with the
+/// `CUDAQ_OBSERVE_GROUPING` environment variable (`none`, `greedy` or
+/// `coloring`). Defaults to `greedy`.
+GroupingStrategy getGroupingStrategy();
+
+/// @brief Partition the non-identity terms of `op` into qubit-wise commuting
+/// measurement groups.
+std::vector<MeasurementGroup>
+groupCommutingTerms(const spin_op &op,
+                    GroupingStrategy strategy = getGroupingStrategy());
+
+/// @brief Compute the per-term results of a measurement group from the bit
+/// strings sampled in the group basis. The returned results are named by term
+/// id and carry the marginal counts and the `<Z...Z>` value of each term.
+std::vector<ExecutionResult>
+expandGroupResult(const MeasurementGroup &group,
+                  const ExecutionResult &groupResult);
+
+/// @brief For every measurement group register in `data`, add the results of
+/// the terms of `op` that are diagonal in the group basis and have no result
+/// yet. This makes results of grouped measurements accessible per term.
+void expandMeasurementGroups(sample_result &data, const spin_op &op);
+
+} // namespace cudaq
@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "PackedCounts.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace cudaq {
+
+namespace {
+/// @brief The `splitmix64` finalizer, to spread the bits of the packed words
+/// over the hash table.
+std::uint64_t mix(std::uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+constexpr std::size_t initialSlots = 16;
+} // namespace
+
+PackedCounts::PackedCounts(std::size_t numBits, bool recordShots)
+    : nBits(numBits), nWords((numBits + 63) / 64), recordShots(recordShots),
+      slots(initialSlots, 0) {}
+
+PackedCounts PackedCounts::fromExecutionResult(const ExecutionResult &result) {
+  std::size_t numBits =
+      result.counts.empty() ? 0 : result.counts.begin()->first.size();
+  std::size_t numShots = 0;
+  for (auto &[bits, count] : result.counts)
+    numShots += count;
+
+  const bool fromSequentialData = !result.sequentialData.empty() &&
+                                  result.sequentialData.size() == numShots;
+  PackedCounts packed(numBits, fromSequentialData);
+  if (fromSequentialData)
+    for (auto &bits : result.sequentialData)
+      packed.add(bits);
+  else
+    for (auto &[bits, count] : result.counts)
+      packed.add(bits, count);
+  return packed;
+}
+
+std::uint64_t PackedCounts::hash(const std::uint64_t *words) const {
+  std::uint64_t h = nWords;
+  for (std::size_t w = 0; w < nWords; ++w)
+    h = mix(h ^ words[w]);
+  return h;
+}
+
+std::size_t PackedCounts::find(const std::uint64_t *words,
+                               std::uint64_t hash) const {
+  const std::size_t mask = slots.size() - 1;
+  for (std::size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    const auto entry = slots[slot];
+    if (entry == 0)
+      return size();
+    if (std::equal(words, words + nWords, this->words(entry - 1)))
+      return entry - 1;
+  }
+}
+
+void PackedCounts::rehash(std::size_t numSlots) {
+  slots.assign(numSlots, 0);
+  const std::size_t mask = numSlots - 1;
+  for (std::size_t entry = 0; entry < size(); ++entry) {
+    std::size_t slot = hash(words(entry)) & mask;
+    while (slots[slot] != 0)
+      slot = (slot + 1) & mask;
+    slots[slot] = entry + 1;
+  }
+}
+
+std::size_t PackedCounts::insert(const std::uint64_t *words,
+                                 std::size_t count) {
+  const auto h = hash(words);
+  auto entry = find(words, h);
+  if (entry == size()) {
+    // Keep the load factor below 1/2.
+    if (2 * (size() + 1) > slots.size())
+      rehash(2 * slots.size());
+    keys.insert(keys.end(), words, words + nWords);
+    entryCounts.push_back(0);
+    const std::size_t mask = slots.size() - 1;
+    std::size_t slot = h & mask;
+    while (slots[slot] != 0)
+      slot = (slot + 1) & mask;
+    slots[slot] = entry + 1;
+  }
+  entryCounts[entry] += count;
+  shotCount += count;
+  return entry;
+}
+
+void PackedCounts::add(const std::uint64_t *words, std::size_t count) {
+  auto entry = insert(words, count);
+  if (recordShots)
+    shotEntries.insert(shotEntries.end(), count, entry);
+}
+
+void PackedCounts::pack(std::string_view bitString,
+                        std::uint64_t *words) const {
+  if (bitString.size() != nBits)
+    throw std::runtime_error("Bit string " + std::string(bitString) +
+                             " does not have " + std::to_string(nBits) +
+                             " bits.");
+  std::fill(words, words + nWords, 0);
+  for (std::size_t i = 0; i < nBits; ++i)
+    if (bitString[i] == '1')
+      words[i / 64] |= 1ULL << (i % 64);
+}
+
+void PackedCounts::add(std::string_view bitString, std::size_t count) {
+  std::vector<std::uint64_t> packed(nWords);
+  pack(bitString, packed.data());
+  add(packed.data(), count);
+}
+
+std::size_t PackedCounts::count(std::string_view bitString) const {
+  if (bitString.size() != nBits)
+    return 0;
+  std::vector<std::uint64_t> packed(nWords);
+  pack(bitString, packed.data());
+  auto entry = find(packed.data(), hash(packed.data()));
+  return entry == size() ? 0 : entryCounts[entry];
+}
+
+double PackedCounts::probability(std::string_view bitString) const {
+  return shotCount == 0 ? 0.0 : (double)count(bitString) / shotCount;
+}
+
+double PackedCounts::expectationZ() const {
+  if (shotCount == 0)
+    return 0.0;
+  double expVal = 0.0;
+  for (std::size_t entry = 0; entry < size(); ++entry) {
+    const auto *w = words(entry);
+    int parity = 0;
+    for (std::size_t i = 0; i < nWords; ++i)
+      parity ^= std::popcount(w[i]) & 1;
+    const double p = (double)entryCounts[entry] / shotCount;
+    expVal += parity ? -p : p;
+  }
+  return expVal;
+}
+
+std::string PackedCounts::toString(std::size_t entry) const {
+  std::string bitString(nBits, '0');
+  const auto *w = words(entry);
+  for (std::size_t i = 0; i < nBits; ++i)
+    if ((w[i / 64] >> (i % 64)) & 1ULL)
+      bitString[i] = '1';
+  return bitString;
+}
+
+PackedCounts
+PackedCounts::gather(const std::vector<std::size_t> &indices) const {
+  for (auto index : indices)
+    if (index >= nBits)
+      throw std::runtime_error("Invalid marginal index (" +
+                               std::to_string(index) +
+                               ", size=" + std::to_string(nBits) + ")");
+
+  PackedCounts result(indices.size(), recordShots);
+  std::vector<std::uint32_t> newEntries(size());
+  std::vector<std::uint64_t> newWords(result.nWords);
+  for (std::size_t entry = 0; entry < size(); ++entry) {
+    const auto *w = words(entry);
+    std::fill(newWords.begin(), newWords.end(), 0);
+    for (std::size_t i = 0; i < indices.size(); ++i)
+      if ((w[indices[i] / 64] >> (indices[i] % 64)) & 1ULL)
+        newWords[i / 64] |= 1ULL << (i % 64);
+    newEntries[entry] = result.insert(newWords.data(), entryCounts[entry]);
+  }
+  result.shotEntries.reserve(shotEntries.size());
+  for (auto entry : shotEntries)
+    result.shotEntries.push_back(newEntries[entry]);
+  return result;
+}
+
+PackedCounts
+PackedCounts::marginal(const std::vector<std::size_t> &indices) const {
+  auto sortedIndices = indices;
+  std::sort(sortedIndices.begin(), sortedIndices.end());
+  return gather(sortedIndices);
+}
+
+PackedCounts
+PackedCounts::reorder(const std::vector<std::size_t> &index) const {
+  if (index.size() != nBits)
+    throw std::runtime_error("Calling reorder() with invalid parameter idx");
+  return gather(index);
+}
+
+ExecutionResult
+PackedCounts::toExecutionResult(const std::string &registerName) const {
+  ExecutionResult result(registerName);
+  std::vector<const std::string *> bitStrings(size());
+  result.counts.reserve(size());
+  for (std::size_t entry = 0; entry < size(); ++entry) {
+    auto [iter, inserted] =
+        result.counts.emplace(toString(entry), entryCounts[entry]);
+    bitStrings[entry] = &iter->first;
+  }
+  result.sequentialData.reserve(shotEntries.size());
+  for (auto entry : shotEntries)
+    result.sequentialData.push_back(*bitStrings[entry]);
+  return result;
+}
+
+} // namespace cudaq
@@ -0,0 +1,118 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "MeasureCounts.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cudaq {
+
+/// @brief Measurement counts with bit strings packed into 64-bit words.
+///
+/// Bit `i` of a bit string (its `i`-th character) is bit `i % 64` of word
+/// `i / 64`, and every bit string takes the same number of words. The distinct
+/// bit strings are stored contiguously and indexed by an open-addressing hash
+/// table on their words. If shots are recorded, the bit string of each shot is
+/// kept as the index of its entry, in the order the shots were added. Bit
+/// strings are only formed as `std::string`s when converting to an
+/// `ExecutionResult`. Its sequential data still holds one string per shot,
+/// which copies the string of the entry.
+class PackedCounts {
+public:
+  /// @brief Create empty counts of `numBits`-bit strings. If `recordShots` is
+  /// true, the order of the shots is kept for the sequential data.
+  explicit PackedCounts(std::size_t numBits = 0, bool recordShots = true);
+
+  /// @brief Create packed counts from the counts, and the sequential data if
+  /// it covers the counts, of an `ExecutionResult`.
+  static PackedCounts fromExecutionResult(const ExecutionResult &result);
+
+  /// @brief Return the number of bits of each bit string.
+  std::size_t numBits() const { return nBits; }
+
+  /// @brief Return the number of 64-bit words of each bit string.
+  std::size_t numWords() const { return nWords; }
+
+  /// @brief Return the number of distinct bit strings.
+  std::size_t size() const { return entryCounts.size(); }
+
+  /// @brief Return the total number of shots.
+  std::size_t totalShots() const { return shotCount; }
+
+  /// @brief Add `count` shots of the bit string with the given packed words.
+  void add(const std::uint64_t *words, std::size_t count = 1);
+
+  /// @brief Add `count` shots of the given bit string of `0`s and `1`s.
+  void add(std::string_view bitString, std::size_t count = 1);
+
+  /// @brief Return the packed words of the `entry`-th distinct bit string.
+  const std::uint64_t *words(std::size_t entry) const {
+    return keys.data() + entry * nWords;
+  }
+
+  /// @brief Return the number of shots of the `entry`-th distinct bit string.
+  std::size_t count(std::size_t entry) const { return entryCounts[entry]; }
+
+  /// @brief Return the number of shots of the given bit string.
+  std::size_t count(std::string_view bitString) const;
+
+  /// @brief Return the probability of the given bit string.
+  double probability(std::string_view bitString) const;
+
+  /// @brief Return the expected value <Z...Z>, computed from the parity of
+  /// the packed words.
+  double expectationZ() const;
+
+  /// @brief Return the `entry`-th distinct bit string as a string.
+  std::string toString(std::size_t entry) const;
+
+  /// @brief Return the entry of each recorded shot, in shot order.
+  const std::vector<std::uint32_t> &shots() const { return shotEntries; }
+
+  /// @brief Return the counts of the bits at the given (sorted) indices.
+  PackedCounts marginal(const std::vector<std::size_t> &indices) const;
+
+  /// @brief Return the counts with the bits reordered such that
+  /// `newBitStr(:) = oldBitStr(index(:))`.
+  PackedCounts reorder(const std::vector<std::size_t> &index) const;
+
+  /// @brief Convert to an `ExecutionResult`, with the sequential data if the
+  /// shots were recorded. Each distinct bit string is formed once.
+  ExecutionResult
+  toExecutionResult(const std::string &registerName = GlobalRegisterName) const;
+
+private:
+  /// @brief Return the entry of the given words, or `size()` if not present.
+  std::size_t find(const std::uint64_t *words, std::uint64_t hash) const;
+  /// @brief Add `count` to the entry of the given words, creating it if
+  /// needed, and return the entry. Shots are not recorded.
+  std::size_t insert(const std::uint64_t *words, std::size_t count);
+  std::uint64_t hash(const std::uint64_t *words) const;
+  void pack(std::string_view bitString, std::uint64_t *words) const;
+  void rehash(std::size_t numSlots);
+  /// @brief Return the counts of the bits at the given indices.
+  PackedCounts gather(const std::vector<std::size_t> &indices) const;
+
+  std::size_t nBits;
+  std::size_t nWords;
+  bool recordShots;
+  std::size_t shotCount = 0;
+  /// @brief The words of the distinct bit strings, `nWords` per entry.
+  std::vector<std::uint64_t> keys;
+  std::vector<std::size_t> entryCounts;
+  /// @brief Open-addressing (linear probing) table of entry indices plus one,
+  /// zero marks an empty slot. The number of slots is a power of two.
+  std::vector<std::uint32_t> slots;
+  std::vector<std::uint32_t> shotEntries;
+};
+
+} // namespace cudaq
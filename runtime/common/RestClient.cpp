@@ -99,8 +99,18 @@ nlohmann::json RestClient::post(const std::string_view remoteUrl,
                 post.dump());
 
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Post(cpr::Url{actualPath}, cpr::Body(post.dump()), cprHeaders,
-                     cpr::VerifySsl(enableSsl), *sslOptions);
+  cpr::Response r;
+  {
+    std::scoped_lock lock(sessionMutex);
+    if (!postSession)
+      postSession = std::make_unique<cpr::Session>();
+    postSession->SetUrl(cpr::Url{actualPath});
+    postSession->SetBody(cpr::Body(post.dump()));
+    postSession->SetHeader(cprHeaders);
+    postSession->SetVerifySsl(cpr::VerifySsl(enableSsl));
+    postSession->SetSslOptions(*sslOptions);
+    r = postSession->Post();
+  }
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP POST Error - status code " +
@@ -147,10 +157,18 @@ nlohmann::json RestClient::get(const std::string_view remoteUrl,
   for (auto &kv : headers)
     cprHeaders.insert({kv.first, kv.second});
 
-  cpr::Parameters cprParams;
   auto actualPath = std::string(remoteUrl) + std::string(path);
-  auto r = cpr::Get(cpr::Url{actualPath}, cprHeaders, cprParams,
-                    cpr::VerifySsl(enableSsl), *sslOptions);
+  cpr::Response r;
+  {
+    std::scoped_lock lock(sessionMutex);
+    if (!getSession)
+      getSession = std::make_unique<cpr::Session>();
+    getSession->SetUrl(cpr::Url{actualPath});
+    getSession->SetHeader(cprHeaders);
+    getSession->SetVerifySsl(cpr::VerifySsl(enableSsl));
+    getSession->SetSslOptions(*sslOptions);
+    r = getSession->Get();
+  }
 
   if (r.status_code > validHttpCode || r.status_code == 0)
     throw std::runtime_error("HTTP GET Error - status code " +
@@ -9,17 +9,23 @@
 #pragma once
 #include "nlohmann/json.hpp"
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 
 // Forward declarations to avoid including CPR header files
 namespace cpr {
+class Session;
 struct SslOptions;
-}
+} // namespace cpr
 
 namespace cudaq {
 
 /// @brief The RestClient exposes a simple REST GET/POST
-/// interface for interacting with remote REST servers.
+/// interface for interacting with remote REST servers. POST and GET requests
+/// each reuse a persistent session, so that consecutive requests to the same
+/// server share a keep-alive connection. Requests through the same client are
+/// serialized; use one client per thread to issue concurrent requests.
 class RestClient {
 protected:
   // Use verbose printout
@@ -28,6 +34,12 @@ protected:
   /// SSL options to use for transfers
   std::unique_ptr<cpr::SslOptions> sslOptions;
 
+  /// Persistent sessions for POST and GET requests. They are kept separate
+  /// since a session that has sent a body sends it with later GET requests.
+  std::unique_ptr<cpr::Session> postSession;
+  std::unique_ptr<cpr::Session> getSession;
+  std::mutex sessionMutex;
+
 public:
   /// @brief set verbose printout
   /// @param v
@@ -9,6 +9,14 @@
 #include "ServerHelper.h"
 
 namespace cudaq {
+std::vector<std::string>
+ServerHelper::extractJobIds(ServerMessage &postResponse, ServerMessage &job) {
+  auto jobId = extractJobId(postResponse);
+  if (jobId.empty())
+    jobId = job.at("tasks")[0].at("task_id");
+  return {jobId};
+}
+
 void ServerHelper::parseConfigForCommonParams(const BackendConfig &config) {
   // Parse common parameters for each job and place into member variables
   for (auto &[key, val] : config) {
@@ -111,10 +111,41 @@ public:
   /// @brief Extract the job id from the server response from posting the job.
   virtual std::string extractJobId(ServerMessage &postResponse) = 0;
 
+  /// @brief Extract the ids of the jobs created by posting `job`, one per
+  /// kernel in the order they were passed to `createJob`. The default returns
+  /// the single id given by `extractJobId`, or the id of the first task of the
+  /// job message if the response has none. Servers accepting several kernels
+  /// per job message override this.
+  virtual std::vector<std::string> extractJobIds(ServerMessage &postResponse,
+                                                 ServerMessage &job);
+
   /// @brief Get the specific path required to retrieve job results.
   /// Construct specifically from the job id.
   virtual std::string constructGetJobPath(std::string &jobId) = 0;
 
+  /// @brief Return the maximum number of jobs whose status and results are
+  /// retrieved by a single request to `constructGetJobsPath`. The default of 1
+  /// retrieves each job separately from `constructGetJobPath`.
+  virtual std::size_t getMaxJobsPerResultsRequest() { return 1; }
+
+  /// @brief Get the path required to retrieve the results of several jobs in
+  /// a single request.
+  virtual std::string
+  constructGetJobsPath(const std::vector<std::string> &jobIds) {
+    throw std::runtime_error(name() +
+                             " does not support retrieving jobs in bulk.");
+  }
+
+  /// @brief Split the response to a `constructGetJobsPath` request into the
+  /// response for each of `jobIds`, as would have been returned by
+  /// `constructGetJobPath`.
+  virtual std::vector<ServerMessage>
+  splitJobsResponse(ServerMessage &getJobsResponse,
+                    const std::vector<std::string> &jobIds) {
+    throw std::runtime_error(name() +
+                             " does not support retrieving jobs in bulk.");
+  }
+
   /// @brief Get the specific path required to retrieve job results. Construct
   /// from the full server response message.
   virtual std::string constructGetJobPath(ServerMessage &postResponse) = 0;
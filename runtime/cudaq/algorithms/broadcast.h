@@ -10,6 +10,7 @@
 
 #include "cudaq/host_config.h"
 #include "cudaq/platform.h"
+#include <algorithm>
 
 namespace cudaq {
 
@@ -64,12 +65,14 @@ broadcastFunctionOverArguments(std::size_t numQpus, quantum_platform &platform,
     std::promise<std::vector<ResType>> _promise;
     futures.emplace_back(_promise.get_future());
     std::function<void()> functor = detail::make_copyable_function(
-        [&params, &apply, qpuId, nExecsPerQpu, seed,
+        [&params, &apply, qpuId, nExecsPerQpu, N, seed,
          promise = std::move(_promise)]() mutable {
           // Compute the lower and upper bounds of the
-          // argument set that should be computed on the current QPU
+          // argument set that should be computed on the current QPU. The
+          // last QPUs get fewer (or no) arguments when N is not a multiple of
+          // the number of QPUs.
           auto lowerBound = qpuId * nExecsPerQpu;
-          auto upperBound = lowerBound + nExecsPerQpu;
+          auto upperBound = std::min(lowerBound + nExecsPerQpu, N);
 
           // Store the results
           std::vector<ResType> results;
@@ -47,6 +47,15 @@ protected:
     return cudaq::observe(ansatz_functor, h, x);
   }
 
+  // Given a batch of parameters and the spin_op h, compute the expected value
+  // at each of them. The evaluations are distributed over the QPUs of
+  // platforms that support it.
+  std::vector<double>
+  getExpectedValues(const std::vector<std::vector<double>> &xs,
+                    const spin_op &h) {
+    return cudaq::observe_batch(ansatz_functor, h, xs);
+  }
+
   // Copy constructor. Derived classes should implement the clone() method.
   gradient(const gradient &o) {
     ansatz_functor = o.ansatz_functor;
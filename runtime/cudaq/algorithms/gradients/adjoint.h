@@ -0,0 +1,192 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "cudaq/algorithms/gradient.h"
+#include <algorithm>
+#include <cmath>
+#include <optional>
+
+namespace cudaq::gradients {
+
+/// @brief Compute the gradient of <H> with the adjoint method, on simulators
+/// that support it (the `qpp-cpu` state vector simulators).
+///
+/// @details The kernel is simulated once, and the simulator back-propagates
+/// H|psi> through the inverse of the applied gates to obtain the exact
+/// derivative of <H> with respect to every gate parameter in a single sweep.
+/// The gate parameters are mapped back to the variational parameters with the
+/// chain rule, through the affine map from the variational parameters to the
+/// gate angles. The map is identified once, from traces of the kernel (which
+/// record the gates without simulating the state), and reused as long as the
+/// recorded gate tape is consistent with it. This costs one simulation instead
+/// of 2 per variational parameter. The kernel must not measure or reset
+/// qubits, its gate structure (operations and qubits) must not depend on the
+/// parameters, and its gate angles must be affine functions of the
+/// parameters.
+class adjoint : public gradient {
+public:
+  using gradient::gradient;
+
+  virtual std::unique_ptr<cudaq::gradient> clone() override {
+    return std::make_unique<adjoint>(*this);
+  }
+
+  void compute(const std::vector<double> &x, std::vector<double> &dx,
+               const spin_op &h, double exp_h) override {
+    auto &platform = cudaq::get_platform();
+    ExecutionContext ctx("adjoint-gradient");
+    ctx.spin = cudaq::spin_op::canonicalize(h);
+    platform.set_exec_ctx(&ctx);
+    ansatz_functor(x);
+    platform.reset_exec_ctx();
+
+    // The simulator sets the expectation value only if it differentiated the
+    // kernel, an empty tape and gradient alone do not tell.
+    std::vector<Trace::Instruction> tape(ctx.kernelTrace.begin(),
+                                         ctx.kernelTrace.end());
+    if (!ctx.expectationValue ||
+        ctx.gateParameterGradient.size() != countParameters(tape))
+      throw std::runtime_error(
+          "Adjoint differentiation is not supported for this target or "
+          "kernel (kernels must not measure or reset qubits, and the "
+          "observable must act on the qubits of the kernel).");
+
+    if (!parameterMap || !parameterMap->matches(tape, x))
+      parameterMap = identifyParameterMap(x, tape);
+
+    // Chain rule, d<H>/dx_i = sum_k d<H>/dangle_k * dangle_k/dx_i.
+    dx.assign(x.size(), 0.);
+    for (std::size_t k = 0; k < ctx.gateParameterGradient.size(); k++)
+      for (std::size_t i = 0; i < x.size(); i++)
+        dx[i] += ctx.gateParameterGradient[k] * parameterMap->jacobian[k][i];
+  }
+
+  /// @brief The adjoint method differentiates through the kernel, so it does
+  /// not apply to an arbitrary function, `func`.
+  std::vector<double>
+  compute(const std::vector<double> &x,
+          const std::function<double(std::vector<double>)> &func,
+          double funcAtX) override {
+    throw std::runtime_error("The adjoint gradient can only be computed for "
+                             "the expectation value of a kernel.");
+  }
+
+private:
+  /// @brief The affine map `angles = offset + jacobian * x` from the
+  /// variational parameters `x` to the angles of the gates of a tape.
+  struct ParameterMap {
+    std::vector<Trace::Instruction> tape;
+    std::vector<double> offset;
+    std::vector<std::vector<double>> jacobian;
+
+    /// @brief Return true if `other` has the same gates as the tape of this
+    /// map, with the angles it predicts for `x`.
+    bool matches(const std::vector<Trace::Instruction> &other,
+                 const std::vector<double> &x) const {
+      if (!sameStructure(tape, other) ||
+          (!jacobian.empty() && jacobian.front().size() != x.size()))
+        return false;
+      std::size_t k = 0;
+      for (const auto &inst : other)
+        for (auto angle : inst.params) {
+          double predicted = offset[k];
+          for (std::size_t i = 0; i < x.size(); i++)
+            predicted += jacobian[k][i] * x[i];
+          if (!isClose(angle, predicted))
+            return false;
+          k++;
+        }
+      return true;
+    }
+  };
+
+  /// @brief The parameter map of the last kernel differentiated.
+  std::optional<ParameterMap> parameterMap;
+
+  static std::size_t countParameters(const std::vector<Trace::Instruction> &t) {
+    std::size_t count = 0;
+    for (const auto &inst : t)
+      count += inst.params.size();
+    return count;
+  }
+
+  /// @brief Compare angles computed with different rounding errors.
+  static bool isClose(double a, double b) {
+    return std::abs(a - b) <= 1e-9 * std::max({1., std::abs(a), std::abs(b)});
+  }
+
+  /// @brief Return true if the tapes apply the same operations to the same
+  /// qubits, regardless of the values of the angles.
+  static bool sameStructure(const std::vector<Trace::Instruction> &a,
+                            const std::vector<Trace::Instruction> &b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                      [](const auto &lhs, const auto &rhs) {
+                        return lhs.name == rhs.name &&
+                               lhs.params.size() == rhs.params.size() &&
+                               lhs.controls == rhs.controls &&
+                               lhs.targets == rhs.targets;
+                      });
+  }
+
+  /// @brief Trace the kernel at `x`, and return the applied gates, in order.
+  std::vector<Trace::Instruction> trace(const std::vector<double> &x) {
+    auto &platform = cudaq::get_platform();
+    ExecutionContext ctx("tracer");
+    platform.set_exec_ctx(&ctx);
+    ansatz_functor(x);
+    platform.reset_exec_ctx();
+    return {ctx.kernelTrace.begin(), ctx.kernelTrace.end()};
+  }
+
+  /// @brief Identify the affine map from the variational parameters to the
+  /// angles of `tape`, recorded at `x`, by tracing the kernel with each
+  /// parameter shifted by one in both directions. The shifts of an affine
+  /// map differ exactly (up to rounding), which is checked.
+  ParameterMap identifyParameterMap(const std::vector<double> &x,
+                                    const std::vector<Trace::Instruction> &t) {
+    ParameterMap map{t, {}, {}};
+    std::vector<double> angles;
+    for (const auto &inst : t)
+      angles.insert(angles.end(), inst.params.begin(), inst.params.end());
+    map.jacobian.assign(angles.size(), std::vector<double>(x.size(), 0.));
+
+    auto shiftedX = x;
+    for (std::size_t i = 0; i < x.size(); i++) {
+      shiftedX[i] = x[i] + 1.;
+      auto plus = trace(shiftedX);
+      shiftedX[i] = x[i] - 1.;
+      auto minus = trace(shiftedX);
+      shiftedX[i] = x[i];
+      if (!sameStructure(t, plus) || !sameStructure(t, minus))
+        throw std::runtime_error(
+            "The adjoint gradient requires the gate structure (operations and "
+            "qubits) of the kernel to not depend on its parameters.");
+
+      std::size_t k = 0;
+      for (std::size_t g = 0; g < t.size(); g++)
+        for (std::size_t p = 0; p < t[g].params.size(); p++, k++) {
+          const double up = plus[g].params[p] - angles[k];
+          const double down = angles[k] - minus[g].params[p];
+          if (!isClose(up, down))
+            throw std::runtime_error(
+                "The adjoint gradient requires the gate angles of the kernel "
+                "to be affine functions of its parameters.");
+          map.jacobian[k][i] = (up + down) / 2.;
+        }
+    }
+
+    map.offset = angles;
+    for (std::size_t k = 0; k < angles.size(); k++)
+      for (std::size_t i = 0; i < x.size(); i++)
+        map.offset[k] -= map.jacobian[k][i] * x[i];
+    return map;
+  }
+};
+} // namespace cudaq::gradients
@@ -24,18 +24,16 @@ public:
 
   void compute(const std::vector<double> &x, std::vector<double> &dx,
                const spin_op &h, double exp_h) override {
-    auto tmpX = x;
+    // Evaluate all shifted parameters as one batch, x_i + (shiftScalar * pi)
+    // and x_i - (shiftScalar * pi) for each i.
+    std::vector<std::vector<double>> shiftedX(2 * x.size(), x);
     for (std::size_t i = 0; i < x.size(); i++) {
-      // increase value to x_i + (shiftScalar * pi)
-      tmpX[i] += shiftScalar * M_PI;
-      auto px = getExpectedValue(tmpX, h);
-      // decrease value to x_i - (shiftScalar * pi)
-      tmpX[i] -= 2 * shiftScalar * M_PI;
-      auto mx = getExpectedValue(tmpX, h);
-      // return value back to x_i
-      tmpX[i] += shiftScalar * M_PI;
-      dx[i] = (px - mx) / 2.;
+      shiftedX[2 * i][i] += shiftScalar * M_PI;
+      shiftedX[2 * i + 1][i] -= shiftScalar * M_PI;
     }
+    auto values = getExpectedValues(shiftedX, h);
+    for (std::size_t i = 0; i < x.size(); i++)
+      dx[i] = (values[2 * i] - values[2 * i + 1]) / 2.;
   }
 
   /// @brief Compute the `parameter_shift` gradient for the arbitrary
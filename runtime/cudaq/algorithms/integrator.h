@@ -48,5 +48,81 @@ private:
   int m_order;
   std::optional<double> m_dt;
 };
+
+// The integrators below are implemented by the `dynamics-cpu` target only,
+// which defines `CUDAQ_DYNAMICS_CPU_TARGET`, so that using them with another
+// target fails at compile time rather than at link time.
+#if defined(CUDAQ_DYNAMICS_CPU_TARGET)
+/// @brief Adaptive `Runge-Kutta` integrator of order 5(4) with the
+/// `Dormand-Prince` coefficients. The step size is chosen to keep the local
+/// error estimate below `absolute_tolerance + relative_tolerance * |x|` for
+/// every component of the state.
+class dormand_prince : public cudaq::base_integrator {
+public:
+  /// @brief Constructor
+  // (1) Relative and (2) absolute error tolerances.
+  // (3) Max step size: if provided, the integrator will make sub-steps no
+  // larger than this value.
+  dormand_prince(double relative_tolerance = 1e-6,
+                 double absolute_tolerance = 1e-8,
+                 const std::optional<double> &max_step_size = {});
+  /// @brief Integrate toward a specified time point.
+  void integrate(double targetTime) override;
+  /// @brief Set the initial state of the integration
+  void setState(const cudaq::state &initialState, double t0) override;
+  /// @brief Get the current state of the integrator
+  // Returns the current time point and state.
+  std::pair<double, cudaq::state> getState() override;
+  /// @brief Clone the current integrator.
+  std::shared_ptr<base_integrator> clone() override;
+
+private:
+  double m_t;
+  std::shared_ptr<cudaq::state> m_state;
+  double m_rtol;
+  double m_atol;
+  std::optional<double> m_dt;
+  // The step size proposed by the last accepted step.
+  std::optional<double> m_nextStepSize;
+};
+
+/// @brief Exponential integrator propagating the state with `exp(h L)`, which
+/// is computed in a `Krylov` subspace of the generator `L` built by the
+/// `Arnoldi` iteration. Steps are shortened until the a-posteriori estimate of
+/// the `Krylov` approximation error is below `tolerance`. Time-dependent
+/// generators are evaluated at the midpoint of each step (exponential midpoint
+/// rule), hence `max_step_size` should resolve their time scale.
+class krylov : public cudaq::base_integrator {
+public:
+  /// @brief The default dimension of the `Krylov` subspace.
+  static constexpr int default_subspace_dimension = 30;
+  /// @brief Constructor
+  // (1) Dimension of the `Krylov` subspace.
+  // (2) Tolerance of the error estimate of a step.
+  // (3) Max step size: if none provided, the schedule of time points will be
+  // used as long as the error estimate allows it.
+  krylov(int subspace_dimension = default_subspace_dimension,
+         double tolerance = 1e-10,
+         const std::optional<double> &max_step_size = {});
+  /// @brief Integrate toward a specified time point.
+  void integrate(double targetTime) override;
+  /// @brief Set the initial state of the integration
+  void setState(const cudaq::state &initialState, double t0) override;
+  /// @brief Get the current state of the integrator
+  // Returns the current time point and state.
+  std::pair<double, cudaq::state> getState() override;
+  /// @brief Clone the current integrator.
+  std::shared_ptr<base_integrator> clone() override;
+
+private:
+  double m_t;
+  std::shared_ptr<cudaq::state> m_state;
+  int m_subspaceDim;
+  double m_tol;
+  std::optional<double> m_dt;
+  // The step size of the last accepted step.
+  std::optional<double> m_nextStepSize;
+};
+#endif
 } // namespace integrators
 } // namespace cudaq
@@ -737,4 +737,32 @@ std::vector<observe_result> observe(cudaq::observe_options &options,
   platform.reset_noise();
   return ret;
 }
+
+/// @brief Compute the expected value of `H` with respect to `kernel(x)` for
+/// every parameter vector `x` in `params`, and return the values in order.
+/// This is the batch evaluation used by gradient strategies and by
+/// population-based optimizers. If the platform supports task distribution
+/// and has more than one QPU, the evaluations are spread over the QPUs (see
+/// `broadcastFunctionOverArguments`), otherwise they run one after the other.
+template <typename QuantumKernel,
+          typename = std::enable_if_t<
+              std::is_invocable_r_v<void, QuantumKernel, std::vector<double>>>>
+std::vector<double>
+observe_batch(QuantumKernel &&kernel, const spin_op &H,
+              const std::vector<std::vector<double>> &params) {
+  auto &platform = cudaq::get_platform();
+  std::vector<double> values;
+  values.reserve(params.size());
+  if (params.size() > 1 && platform.supports_task_distribution() &&
+      platform.num_qpus() > 1) {
+    for (auto &result : observe(std::forward<QuantumKernel>(kernel), H,
+                                make_argset(params)))
+      values.push_back(result.expectation());
+    return values;
+  }
+
+  for (const auto &x : params)
+    values.push_back(observe(kernel, H, x).expectation());
+  return values;
+}
 } // namespace cudaq
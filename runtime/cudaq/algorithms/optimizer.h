@@ -9,6 +9,9 @@
 #pragma once
 
 #include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace cudaq {
 
@@ -18,7 +21,10 @@ namespace cudaq {
 using optimization_result = std::tuple<double, std::vector<double>>;
 
 /// An optimizable_function wraps a user-provided objective function
-/// to be optimized.
+/// to be optimized. The objective may also be given as a batch function, which
+/// takes a set of parameter vectors and returns the value at each of them, so
+/// that population-based optimizers can evaluate many points at once (e.g.,
+/// across the QPUs of the platform, see `cudaq::observe_batch`).
 class optimizable_function {
 private:
   // Useful typedefs
@@ -26,22 +32,34 @@ private:
       std::function<double(const std::vector<double> &)>;
   using GradientSignature =
       std::function<double(const std::vector<double> &, std::vector<double> &)>;
+  using BatchSignature = std::function<std::vector<double>(
+      const std::vector<std::vector<double>> &)>;
 
   // The function we are optimizing
   GradientSignature _opt_func;
+  // The batch evaluation of the function, if provided.
+  BatchSignature _batch_func;
   bool _providesGradients = true;
 
+  template <typename Callable>
+  static constexpr bool isBatchCallable =
+      std::is_invocable_r_v<std::vector<double>, Callable,
+                            std::vector<std::vector<double>>>;
+
 public:
   template <typename Callable>
   optimizable_function(Callable &&callable) {
     static_assert(
         std::is_invocable_v<Callable, std::vector<double>> ||
             std::is_invocable_v<Callable, std::vector<double>,
-                                std::vector<double> &>,
+                                std::vector<double> &> ||
+            isBatchCallable<Callable>,
         "Invalid optimization function. Must have signature double(const "
         "std::vector<double>&) or double(const std::vector<double>&, "
         "std::vector<double>&) for gradient-free or gradient-based "
-        "optimizations, respectively.");
+        "optimizations, respectively, or std::vector<double>(const "
+        "std::vector<std::vector<double>>&) for gradient-free batch "
+        "evaluation.");
 
     if constexpr (std::is_invocable_v<Callable, std::vector<double>>) {
       _opt_func = [c = std::move(callable)](const std::vector<double> &x,
@@ -49,15 +67,56 @@ public:
         return c(x);
       };
       _providesGradients = false;
+    } else if constexpr (isBatchCallable<Callable>) {
+      _batch_func = std::move(callable);
+      _opt_func = [c = _batch_func](const std::vector<double> &x,
+                                    std::vector<double> &) {
+        return c({x}).at(0);
+      };
+      _providesGradients = false;
     } else {
       _opt_func = std::move(callable);
     }
   }
 
+  /// Construct from a single-point objective, with or without gradients, and
+  /// a batch evaluation of the same objective.
+  template <typename Callable, typename BatchCallable>
+  optimizable_function(Callable &&callable, BatchCallable &&batchCallable)
+      : optimizable_function(std::forward<Callable>(callable)) {
+    static_assert(isBatchCallable<BatchCallable>,
+                  "Invalid batch function. Must have signature "
+                  "std::vector<double>(const "
+                  "std::vector<std::vector<double>>&).");
+    _batch_func = std::move(batchCallable);
+  }
+
   bool providesGradients() { return _providesGradients; }
+  bool providesBatchEvaluation() const { return bool(_batch_func); }
   double operator()(const std::vector<double> &x, std::vector<double> &dx) {
     return _opt_func(x, dx);
   }
+
+  /// Return the value of the objective at each of the parameter vectors `xs`,
+  /// with a single call to the batch function if one was provided.
+  std::vector<double>
+  evaluateBatch(const std::vector<std::vector<double>> &xs) {
+    if (_batch_func) {
+      auto values = _batch_func(xs);
+      if (values.size() != xs.size())
+        throw std::runtime_error(
+            "Batch objective function returned " +
+            std::to_string(values.size()) + " values for " +
+            std::to_string(xs.size()) + " parameter vectors.");
+      return values;
+    }
+    std::vector<double> values;
+    values.reserve(xs.size());
+    std::vector<double> dummyGrad;
+    for (const auto &x : xs)
+      values.push_back(_opt_func(x, dummyGrad));
+    return values;
+  }
 };
 
 ///
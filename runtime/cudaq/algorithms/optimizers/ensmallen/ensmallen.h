@@ -9,6 +9,7 @@
 #pragma once
 
 #include "cudaq/algorithms/optimizer.h"
+#include <optional>
 
 namespace cudaq::optimizers {
 struct max_eval;
@@ -53,4 +54,33 @@ CUDAQ_ENSMALLEN_ALGORITHM_TYPE(gradient_descent, true, )
 CUDAQ_ENSMALLEN_ALGORITHM_TYPE(sgd, true,
                                std::optional<std::size_t> batch_size;)
 
+// Population-based optimizers. Each iteration evaluates a set of parameter
+// vectors with a single call to the batch evaluation of the objective (see
+// `optimizable_function::evaluateBatch`), so that the evaluations can run in
+// parallel, e.g., on the QPUs of the platform. These are implemented here
+// rather than by ensmallen, which evaluates one point at a time.
+
+/// SPSA with `num_perturbations` random perturbations per iteration, whose
+/// 2 * `num_perturbations` evaluations form one batch. The gradient estimates
+/// of the perturbations are averaged. The optimization stops when no parameter
+/// changes by more than `f_tol` in an iteration.
+CUDAQ_ENSMALLEN_ALGORITHM_TYPE(batch_spsa, false, std::optional<double> alpha;
+                               std::optional<double> gamma;
+                               std::optional<double> eval_step_size;
+                               std::optional<std::size_t> num_perturbations;
+                               std::optional<std::size_t> seed;)
+
+/// Separable CMA-ES, i.e., with a diagonal covariance matrix. Each generation
+/// of `population_size` candidates forms one batch, the population is reduced
+/// to `max_eval` if needed. `step_size` is the initial standard deviation of
+/// the search distribution.
+CUDAQ_ENSMALLEN_ALGORITHM_TYPE(cmaes, false,
+                               std::optional<std::size_t> population_size;
+                               std::optional<std::size_t> seed;)
+
+/// Nelder-Mead, where the reflection, expansion and both contraction points of
+/// each iteration form one batch, as do the points of a shrink step.
+/// `step_size` is the size of the initial simplex.
+CUDAQ_ENSMALLEN_ALGORITHM_TYPE(batch_nelder_mead, false, )
+
 } // namespace cudaq::optimizers
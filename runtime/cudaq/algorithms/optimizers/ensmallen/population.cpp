@@ -0,0 +1,304 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "ensmallen.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+
+namespace {
+/// @brief Clamp `x` to the optional bounds, element-wise.
+void clampToBounds(std::vector<double> &x,
+                   const std::optional<std::vector<double>> &lower,
+                   const std::optional<std::vector<double>> &upper) {
+  for (std::size_t i = 0; i < x.size(); i++) {
+    if (lower && i < lower->size())
+      x[i] = std::max(x[i], (*lower)[i]);
+    if (upper && i < upper->size())
+      x[i] = std::min(x[i], (*upper)[i]);
+  }
+}
+
+/// @brief Return the index of the smallest value.
+std::size_t argmin(const std::vector<double> &values) {
+  return std::distance(values.begin(),
+                       std::min_element(values.begin(), values.end()));
+}
+} // namespace
+
+namespace cudaq::optimizers {
+
+optimization_result batch_spsa::optimize(const int dim,
+                                         optimizable_function &&opt_function) {
+  validate(opt_function);
+
+  std::vector<double> x = initial_parameters.value_or(std::vector<double>(dim));
+  auto localFtol = f_tol.value_or(1e-4);
+  auto localStepSize = step_size.value_or(0.16);
+  auto localAlpha = alpha.value_or(0.602);
+  auto localGamma = gamma.value_or(.101);
+  auto localEvalStepSize = eval_step_size.value_or(.3);
+  auto numPerturbations =
+      std::max<std::size_t>(num_perturbations.value_or(1), 1);
+  auto maxEval = max_eval.value_or(std::numeric_limits<std::size_t>::max());
+
+  std::mt19937_64 gen(seed.value_or(std::mt19937_64::default_seed));
+  std::bernoulli_distribution coin;
+
+  std::vector<std::vector<double>> deltas(numPerturbations,
+                                          std::vector<double>(dim));
+  std::vector<std::vector<double>> batch(2 * numPerturbations);
+  std::vector<double> gradient(dim);
+  std::size_t numEvals = 0;
+  for (std::size_t k = 0; numEvals + batch.size() < maxEval; k++) {
+    const double ak = localStepSize / std::pow(k + 1, localAlpha);
+    const double ck = localEvalStepSize / std::pow(k + 1, localGamma);
+    for (std::size_t p = 0; p < numPerturbations; p++) {
+      batch[2 * p] = x;
+      batch[2 * p + 1] = x;
+      for (int i = 0; i < dim; i++) {
+        deltas[p][i] = coin(gen) ? 1. : -1.;
+        batch[2 * p][i] += ck * deltas[p][i];
+        batch[2 * p + 1][i] -= ck * deltas[p][i];
+      }
+    }
+    auto values = opt_function.evaluateBatch(batch);
+    numEvals += batch.size();
+
+    std::fill(gradient.begin(), gradient.end(), 0.);
+    for (std::size_t p = 0; p < numPerturbations; p++)
+      for (int i = 0; i < dim; i++)
+        gradient[i] += (values[2 * p] - values[2 * p + 1]) /
+                       (2. * ck * deltas[p][i] * numPerturbations);
+    // The mean of the perturbed values is biased by the (slowly decaying)
+    // perturbation size, so convergence is judged on the size of the update.
+    double maxUpdate = 0.;
+    for (int i = 0; i < dim; i++) {
+      x[i] -= ak * gradient[i];
+      maxUpdate = std::max(maxUpdate, std::abs(ak * gradient[i]));
+    }
+    clampToBounds(x, lower_bounds, upper_bounds);
+    if (maxUpdate < localFtol)
+      break;
+  }
+
+  auto value = opt_function.evaluateBatch({x}).front();
+  return std::make_tuple(value, x);
+}
+
+optimization_result cmaes::optimize(const int dim,
+                                    optimizable_function &&opt_function) {
+  validate(opt_function);
+
+  std::vector<double> mean =
+      initial_parameters.value_or(std::vector<double>(dim));
+  const double n = dim;
+  auto localFtol = f_tol.value_or(1e-4);
+  double sigma = step_size.value_or(0.3);
+  auto maxEval = max_eval.value_or(std::numeric_limits<std::size_t>::max());
+  // A generation must fit in the evaluation budget.
+  const std::size_t lambda = std::max<std::size_t>(
+      std::min<std::size_t>(population_size.value_or(
+                                4 + static_cast<std::size_t>(3 * std::log(n))),
+                            maxEval),
+      2);
+  const std::size_t mu = lambda / 2;
+
+  // Recombination weights and the default strategy parameters of
+  // N. Hansen, "The CMA Evolution Strategy: A Tutorial", with the learning
+  // rates of the covariance scaled up for the separable variant (R. Ros and
+  // N. Hansen, "A Simple Modification in CMA-ES Achieving Linear Time and
+  // Space Complexity").
+  std::vector<double> weights(mu);
+  for (std::size_t i = 0; i < mu; i++)
+    weights[i] = std::log(mu + 0.5) - std::log(i + 1.);
+  const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.);
+  double weightSqSum = 0.;
+  for (auto &w : weights) {
+    w /= weightSum;
+    weightSqSum += w * w;
+  }
+  const double mueff = 1. / weightSqSum;
+  const double cc = (4. + mueff / n) / (n + 4. + 2. * mueff / n);
+  const double cs = (mueff + 2.) / (n + mueff + 5.);
+  double c1 = 2. / ((n + 1.3) * (n + 1.3) + mueff);
+  double cmu = std::min(1. - c1, 2. * (mueff - 2. + 1. / mueff) /
+                                     ((n + 2.) * (n + 2.) + mueff));
+  c1 = std::min(1., c1 * (n + 2.) / 3.);
+  cmu = std::min(1. - c1, cmu * (n + 2.) / 3.);
+  const double damps =
+      1. + 2. * std::max(0., std::sqrt((mueff - 1.) / (n + 1.)) - 1.) + cs;
+  const double chiN = std::sqrt(n) * (1. - 1. / (4. * n) + 1. / (21. * n * n));
+
+  std::mt19937_64 gen(seed.value_or(std::mt19937_64::default_seed));
+  std::normal_distribution<double> normal;
+
+  std::vector<double> variances(dim, 1.), pc(dim, 0.), ps(dim, 0.);
+  std::vector<std::vector<double>> steps(lambda, std::vector<double>(dim));
+  std::vector<std::vector<double>> candidates(lambda);
+  std::vector<std::size_t> order(lambda);
+  std::vector<double> bestX = mean;
+  double bestValue = std::numeric_limits<double>::max();
+  std::size_t numEvals = 0;
+  for (std::size_t generation = 0; numEvals + lambda <= maxEval; generation++) {
+    for (std::size_t k = 0; k < lambda; k++) {
+      candidates[k] = mean;
+      for (int i = 0; i < dim; i++) {
+        steps[k][i] = std::sqrt(variances[i]) * normal(gen);
+        candidates[k][i] += sigma * steps[k][i];
+      }
+      clampToBounds(candidates[k], lower_bounds, upper_bounds);
+    }
+    auto values = opt_function.evaluateBatch(candidates);
+    numEvals += lambda;
+
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      return values[a] < values[b];
+    });
+    if (values[order[0]] < bestValue) {
+      bestValue = values[order[0]];
+      bestX = candidates[order[0]];
+    }
+
+    // Move the mean to the weighted average of the best mu steps, and update
+    // the evolution paths.
+    std::vector<double> meanStep(dim, 0.);
+    for (std::size_t k = 0; k < mu; k++)
+      for (int i = 0; i < dim; i++)
+        meanStep[i] += weights[k] * steps[order[k]][i];
+    double psNormSq = 0.;
+    for (int i = 0; i < dim; i++) {
+      mean[i] += sigma * meanStep[i];
+      ps[i] = (1. - cs) * ps[i] + std::sqrt(cs * (2. - cs) * mueff) *
+                                      meanStep[i] / std::sqrt(variances[i]);
+      psNormSq += ps[i] * ps[i];
+    }
+    clampToBounds(mean, lower_bounds, upper_bounds);
+    const double psNorm = std::sqrt(psNormSq);
+    const bool hsig =
+        psNorm / std::sqrt(1. - std::pow(1. - cs, 2. * (generation + 1))) /
+            chiN <
+        1.4 + 2. / (n + 1.);
+    for (int i = 0; i < dim; i++) {
+      pc[i] = (1. - cc) * pc[i] +
+              (hsig ? std::sqrt(cc * (2. - cc) * mueff) * meanStep[i] : 0.);
+      double rankMu = 0.;
+      for (std::size_t k = 0; k < mu; k++)
+        rankMu += weights[k] * steps[order[k]][i] * steps[order[k]][i];
+      variances[i] = (1. - c1 - cmu) * variances[i] +
+                     c1 * (pc[i] * pc[i] +
+                           (hsig ? 0. : cc * (2. - cc) * variances[i])) +
+                     cmu * rankMu;
+    }
+    sigma *= std::exp((cs / damps) * (psNorm / chiN - 1.));
+
+    if (values[order[lambda - 1]] - values[order[0]] < localFtol)
+      break;
+  }
+
+  // Without the budget for a generation, return the initial point.
+  if (numEvals == 0)
+    bestValue = opt_function.evaluateBatch({bestX}).front();
+  return std::make_tuple(bestValue, bestX);
+}
+
+optimization_result
+batch_nelder_mead::optimize(const int dim,
+                            optimizable_function &&opt_function) {
+  validate(opt_function);
+
+  std::vector<double> x = initial_parameters.value_or(std::vector<double>(dim));
+  auto localFtol = f_tol.value_or(1e-6);
+  auto localStepSize = step_size.value_or(0.5);
+  auto maxEval = max_eval.value_or(std::numeric_limits<std::size_t>::max());
+
+  // The initial simplex, x and x + step along each axis.
+  std::vector<std::vector<double>> simplex(dim + 1, x);
+  for (int i = 0; i < dim; i++) {
+    simplex[i + 1][i] += localStepSize;
+    clampToBounds(simplex[i + 1], lower_bounds, upper_bounds);
+  }
+  auto values = opt_function.evaluateBatch(simplex);
+  std::size_t numEvals = simplex.size();
+
+  std::vector<std::size_t> order(dim + 1);
+  std::vector<double> centroid(dim);
+  std::vector<std::vector<double>> batch(4, std::vector<double>(dim));
+  while (true) {
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+      return values[a] < values[b];
+    });
+    const auto best = order.front();
+    const auto worst = order.back();
+    const auto secondWorst = order[dim - 1];
+    if (values[worst] - values[best] < localFtol || numEvals + 4 > maxEval)
+      break;
+
+    std::fill(centroid.begin(), centroid.end(), 0.);
+    for (std::size_t k = 0; k < order.size() - 1; k++)
+      for (int i = 0; i < dim; i++)
+        centroid[i] += simplex[order[k]][i] / dim;
+
+    // Reflection, expansion, outside and inside contraction, as one batch.
+    const double coefficients[] = {1., 2., 0.5, -0.5};
+    for (std::size_t b = 0; b < batch.size(); b++) {
+      for (int i = 0; i < dim; i++)
+        batch[b][i] =
+            centroid[i] + coefficients[b] * (centroid[i] - simplex[worst][i]);
+      clampToBounds(batch[b], lower_bounds, upper_bounds);
+    }
+    auto trial = opt_function.evaluateBatch(batch);
+    numEvals += batch.size();
+
+    std::optional<std::size_t> accepted;
+    if (trial[0] < values[best])
+      accepted = trial[1] < trial[0] ? 1 : 0;
+    else if (trial[0] < values[secondWorst])
+      accepted = 0;
+    else if (trial[0] < values[worst]) {
+      if (trial[2] <= trial[0])
+        accepted = 2;
+    } else if (trial[3] < values[worst])
+      accepted = 3;
+
+    if (accepted) {
+      simplex[worst] = batch[*accepted];
+      values[worst] = trial[*accepted];
+      continue;
+    }
+
+    // Shrink the simplex towards the best point, if the budget allows the
+    // evaluation of its dim new points.
+    if (numEvals + dim > maxEval)
+      break;
+    std::vector<std::vector<double>> shrunk;
+    for (std::size_t k = 0; k < simplex.size(); k++) {
+      if (k == best)
+        continue;
+      for (int i = 0; i < dim; i++)
+        simplex[k][i] =
+            simplex[best][i] + 0.5 * (simplex[k][i] - simplex[best][i]);
+      shrunk.push_back(simplex[k]);
+    }
+    auto shrunkValues = opt_function.evaluateBatch(shrunk);
+    numEvals += shrunk.size();
+    for (std::size_t k = 0, j = 0; k < simplex.size(); k++)
+      if (k != best)
+        values[k] = shrunkValues[j++];
+  }
+
+  auto best = argmin(values);
+  return std::make_tuple(values[best], simplex[best]);
+}
+
+} // namespace cudaq::optimizers
@@ -92,6 +92,13 @@ runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
   // Indicate that this is an async exec
   ctx->asyncExec = futureResult != nullptr;
 
+  // Kernels with conditional feedback are executed once per branch of
+  // measurement outcomes if the simulator supports it, otherwise shot by shot.
+  if (ctx->hasConditionalsOnMeasureResults) {
+    ctx->shotBranching = true;
+    ctx->branchShots = shots;
+  }
+
   // Set the platform and the qpu id.
   platform.set_exec_ctx(ctx.get(), qpu_id);
   platform.set_current_qpu(qpu_id);
@@ -121,6 +128,9 @@ runSampling(KernelFunctor &&wrappedKernel, quantum_platform &platform,
              "infinite loop.");
       break;
     }
+    // Continue with the next branch of measurement outcomes, if branching.
+    if (ctx->shotBranching && !ctx->nextShotBranch())
+      break;
     // Reset the context for the next round,
     // don't need to reset on the last exec
     if (counts.get_total_shots() < static_cast<std::size_t>(shots)) {
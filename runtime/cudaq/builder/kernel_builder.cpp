@@ -7,6 +7,7 @@
  ******************************************************************************/
 
 #include "kernel_builder.h"
+#include "common/JITModuleCache.h"
 #include "common/Logger.h"
 #include "common/RuntimeMLIR.h"
 #include "cudaq/Optimizer/Builder/Intrinsics.h"
@@ -950,7 +951,19 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
   // Tag as an entrypoint if it is one
   tagEntryPoint(builder, module, StringRef{});
 
-  {
+  // A previous process may have lowered the same kernel already. Skip the MLIR
+  // pipelines and the translation to LLVM IR then.
+  auto &moduleCache = cudaq::JITModuleCache::get();
+  std::string moduleKey;
+  std::unique_ptr<llvm::MemoryBuffer> cachedModule;
+  if (moduleCache.enabled()) {
+    moduleKey = cudaq::JITModuleCache::getKey(
+        module, stateVectorStorage.empty() ? "builder-jit"
+                                           : "builder-jit;state-vectors");
+    cachedModule = moduleCache.lookup(moduleKey);
+  }
+
+  if (!cachedModule) {
     PassManager pm(context);
     pm.addNestedPass<func::FuncOp>(cudaq::opt::createUnwindLoweringPass());
     cudaq::opt::addAggressiveEarlyInlining(pm);
@@ -973,7 +986,7 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
       throw std::runtime_error(
           "cudaq::builder failed to JIT compile the Quake representation.");
   }
-  {
+  if (!cachedModule) {
     // Start a new pipeline. We want the above pipeline to completely flush it's
     // rewrites before lowering to a raw CFG form. Loop unrolling depends on the
     // cc.loop op and GKE generates new code which may have cc.loop ops, etc.
@@ -1018,15 +1031,19 @@ jitCode(ImplicitLocOpBuilder &builder, ExecutionEngine *jit,
   }
   opts.sharedLibPaths = sharedLibs;
   opts.llvmModuleBuilder =
-      [](Operation *module,
-         llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
+      [&](Operation *module,
+          llvm::LLVMContext &llvmContext) -> std::unique_ptr<llvm::Module> {
     llvmContext.setOpaquePointers(false);
+    if (cachedModule)
+      return cudaq::JITModuleCache::load(*cachedModule, llvmContext);
     auto llvmModule = translateModuleToLLVMIR(module, llvmContext);
     if (!llvmModule) {
       llvm::errs() << "Failed to emit LLVM IR\n";
       return nullptr;
     }
     ExecutionEngine::setupTargetTriple(llvmModule.get());
+    if (!moduleKey.empty())
+      moduleCache.insert(moduleKey, *llvmModule);
     return llvmModule;
   };
 
@@ -64,6 +64,14 @@ private:
   template <typename EvalTy>
   EvalTy evaluate(operator_arithmetics<EvalTy> arithmetics) const;
 
+  // multiplies the sums in a bit-packed representation of their terms,
+  // expects is_default to be false and all coefficients to be constant
+  HANDLER_SPECIFIC_TEMPLATE(spin_handler)
+  sum_op<HandlerTy> packed_product(const sum_op<HandlerTy> &other) const;
+
+  // whether all coefficients are constant
+  bool has_constant_coefficients() const;
+
 protected:
   std::unordered_map<std::string, std::size_t>
       term_map; // quick access to term index given its id (used for aggregating
@@ -491,6 +499,26 @@ public:
                        &parameters = {},
                    bool invert_order = false) const;
 
+  /// @brief Apply the operator to a state vector without constructing its
+  /// matrix, i.e. compute `to_matrix(dimensions, parameters, invert_order)`
+  /// times `state` term by term. This is meant for iterative eigensolvers and
+  /// expectation values of operators whose matrix is too large to build.
+  /// @arg `state` : The state vector, ordered like the rows of the matrix
+  ///                returned by `to_matrix`.
+  /// @arg `dimensions` : A mapping that specifies the number of levels,
+  ///                      that is, the dimension of each degree of freedom
+  ///                      that the operator acts on.
+  /// @arg `parameters` : A map of the parameter names to their concrete,
+  /// complex values.
+  /// @arg `invert_order`: if set to true, the ordering convention is reversed.
+  HANDLER_SPECIFIC_TEMPLATE(spin_handler)
+  std::vector<std::complex<double>>
+  apply(const std::vector<std::complex<double>> &state,
+        std::unordered_map<std::size_t, int64_t> dimensions = {},
+        const std::unordered_map<std::string, std::complex<double>>
+            &parameters = {},
+        bool invert_order = false) const;
+
   HANDLER_SPECIFIC_TEMPLATE(spin_handler)
   std::vector<double> get_data_representation() const;
 
@@ -943,6 +971,11 @@ public:
   HANDLER_SPECIFIC_TEMPLATE(spin_handler)
   std::vector<bool> get_binary_symplectic_form() const;
 
+  /// @brief Return true if the Pauli products of this operator and `other`
+  /// commute, regardless of their coefficients.
+  HANDLER_SPECIFIC_TEMPLATE(spin_handler)
+  bool commutes_with(const product_op<HandlerTy> &other) const;
+
   /// @brief Return the matrix representation of the operator.
   /// By default, the matrix is ordered according to the convention (endianness)
   /// used in CUDA-Q, and the ordering returned by `degrees`. See
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <unordered_set>
+
+#include "packed_pauli.h"
+
+namespace cudaq::detail {
+
+packed_pauli_terms::packed_pauli_terms(std::size_t num_degrees)
+    : num_words((num_degrees + 63) / 64) {}
+
+void packed_pauli_terms::push_back(const std::vector<spin_handler> &ops,
+                                   std::complex<double> coefficient) {
+  const auto offset = words.size();
+  words.resize(offset + 3 * num_words, 0);
+  auto *support = words.data() + offset;
+  auto *x = support + num_words;
+  auto *z = x + num_words;
+  for (const auto &op : ops) {
+    const auto degree = op.target();
+    const auto word = degree / 64;
+    const auto bit = std::uint64_t(1) << (degree % 64);
+    assert(word < num_words && !(support[word] & bit));
+    support[word] |= bit;
+    const auto pauli = op.as_pauli();
+    if (pauli == pauli::X || pauli == pauli::Y)
+      x[word] |= bit;
+    if (pauli == pauli::Z || pauli == pauli::Y)
+      z[word] |= bit;
+  }
+  coefficients.push_back(coefficient);
+}
+
+std::vector<spin_handler>
+packed_pauli_terms::get_operators(std::size_t term) const {
+  const auto *support = term_words(term);
+  const auto *x = support + num_words;
+  const auto *z = x + num_words;
+  std::vector<spin_handler> ops;
+  for (std::size_t word = 0; word < num_words; ++word)
+    for (auto bits = support[word]; bits != 0; bits &= bits - 1) {
+      const auto idx = std::countr_zero(bits);
+      const bool has_x = (x[word] >> idx) & 1;
+      const bool has_z = (z[word] >> idx) & 1;
+      const auto pauli = has_x ? (has_z ? pauli::Y : pauli::X)
+                               : (has_z ? pauli::Z : pauli::I);
+      ops.emplace_back(pauli, 64 * word + idx);
+    }
+  return ops;
+}
+
+packed_pauli_terms
+packed_pauli_terms::multiply(const packed_pauli_terms &lhs,
+                             const packed_pauli_terms &rhs) {
+  const std::size_t num_words = std::max(lhs.num_words, rhs.num_words);
+  const std::size_t stride = 3 * num_words;
+  packed_pauli_terms product(64 * num_words);
+  product.words.reserve(stride * lhs.num_terms() * rhs.num_terms());
+
+  // The index of the terms of the product, hashed and compared by their words.
+  const auto term_hash = [&product, stride](std::size_t term) {
+    const auto *data = product.words.data() + stride * term;
+    std::size_t hash = stride;
+    for (std::size_t i = 0; i < stride; ++i)
+      hash ^= data[i] + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    return hash;
+  };
+  const auto term_equal = [&product, stride](std::size_t t1, std::size_t t2) {
+    const auto *data = product.words.data();
+    return std::equal(data + stride * t1, data + stride * (t1 + 1),
+                      data + stride * t2);
+  };
+  std::unordered_set<std::size_t, decltype(term_hash), decltype(term_equal)>
+      index(lhs.num_terms() * rhs.num_terms(), term_hash, term_equal);
+
+  // Loads the bit sets of a term, padding them to `num_words` words.
+  const auto load = [num_words](const packed_pauli_terms &terms,
+                                std::size_t term, std::size_t set,
+                                std::size_t word) -> std::uint64_t {
+    return word < terms.num_words
+               ? terms.term_words(term)[set * terms.num_words + word]
+               : 0;
+  };
+
+  for (std::size_t i = 0; i < lhs.num_terms(); ++i) {
+    for (std::size_t j = 0; j < rhs.num_terms(); ++j) {
+      // Append the product as candidate term, and drop it again if it is
+      // equal to an existing term.
+      const auto candidate = product.coefficients.size();
+      product.words.resize(stride * (candidate + 1));
+      auto *support = product.words.data() + stride * candidate;
+      auto *x = support + num_words;
+      auto *z = x + num_words;
+      // Power of `i` of the phase: `ZX = iY`, `XY = iZ` and `YZ = iX`, and the
+      // inverse for the reversed products.
+      int phase = 0;
+      for (std::size_t word = 0; word < num_words; ++word) {
+        const auto x1 = load(lhs, i, 1, word), z1 = load(lhs, i, 2, word);
+        const auto x2 = load(rhs, j, 1, word), z2 = load(rhs, j, 2, word);
+        const auto onlyX1 = x1 & ~z1, onlyZ1 = z1 & ~x1, y1 = x1 & z1;
+        const auto onlyX2 = x2 & ~z2, onlyZ2 = z2 & ~x2, y2 = x2 & z2;
+        const auto positive =
+            (onlyZ1 & onlyX2) | (onlyX1 & y2) | (y1 & onlyZ2);
+        const auto negative =
+            (onlyX1 & onlyZ2) | (y1 & onlyX2) | (onlyZ1 & y2);
+        phase += std::popcount(positive) - std::popcount(negative);
+        support[word] = load(lhs, i, 0, word) | load(rhs, j, 0, word);
+        x[word] = x1 ^ x2;
+        z[word] = z1 ^ z2;
+      }
+
+      auto coefficient = lhs.coefficients[i] * rhs.coefficients[j];
+      switch (phase & 3) {
+      case 1:
+        coefficient *= std::complex<double>(0., 1.);
+        break;
+      case 2:
+        coefficient *= -1.;
+        break;
+      case 3:
+        coefficient *= std::complex<double>(0., -1.);
+        break;
+      }
+
+      auto [it, inserted] = index.insert(candidate);
+      if (inserted)
+        product.coefficients.push_back(coefficient);
+      else {
+        product.coefficients[*it] += coefficient;
+        product.words.resize(stride * candidate);
+      }
+    }
+  }
+  return product;
+}
+
+bool packed_pauli_terms::commute(const packed_pauli_terms &lhs,
+                                 std::size_t lhs_term,
+                                 const packed_pauli_terms &rhs,
+                                 std::size_t rhs_term) {
+  // Two Pauli products commute if and only if the symplectic inner product
+  // of their X and Z parts is even.
+  const auto *x1 = lhs.term_words(lhs_term) + lhs.num_words;
+  const auto *z1 = x1 + lhs.num_words;
+  const auto *x2 = rhs.term_words(rhs_term) + rhs.num_words;
+  const auto *z2 = x2 + rhs.num_words;
+  int parity = 0;
+  for (std::size_t word = 0; word < std::min(lhs.num_words, rhs.num_words);
+       ++word)
+    parity ^= std::popcount((x1[word] & z2[word]) ^ (z1[word] & x2[word])) & 1;
+  return parity == 0;
+}
+
+} // namespace cudaq::detail
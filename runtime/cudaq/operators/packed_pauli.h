@@ -0,0 +1,67 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "cudaq/spin_op.h"
+
+namespace cudaq::detail {
+
+/// @brief A sum of Pauli products stored in a bit-packed symplectic form.
+/// Each term is given by three bit sets over the degrees of freedom, packed
+/// into 64-bit words: the degrees the term acts on (`product_op<spin_handler>`
+/// keeps identities that result from multiplications, so these are part of
+/// the term), and the X and Z parts of the Pauli operator on each degree,
+/// i.e. `I = (0, 0)`, `X = (1, 0)`, `Z = (0, 1)` and `Y = (1, 1)`.
+class packed_pauli_terms {
+public:
+  /// Creates an empty sum for operators on the degrees `0, ..., num_degrees-1`.
+  explicit packed_pauli_terms(std::size_t num_degrees);
+
+  /// Appends a term; the operators must act on distinct degrees.
+  void push_back(const std::vector<spin_handler> &ops,
+                 std::complex<double> coefficient);
+
+  std::size_t num_terms() const { return coefficients.size(); }
+
+  std::complex<double> get_coefficient(std::size_t term) const {
+    return coefficients[term];
+  }
+
+  /// Returns the operators of a term, ordered by increasing degree.
+  std::vector<spin_handler> get_operators(std::size_t term) const;
+
+  /// Returns the product of two sums, where products of terms that are equal
+  /// are aggregated into a single term. The terms of the result are in the
+  /// order of their first occurrence when multiplying each term of `lhs` with
+  /// all terms of `rhs` in turn.
+  static packed_pauli_terms multiply(const packed_pauli_terms &lhs,
+                                     const packed_pauli_terms &rhs);
+
+  /// Returns true if the Pauli products `lhs_term` of `lhs` and `rhs_term` of
+  /// `rhs` commute.
+  static bool commute(const packed_pauli_terms &lhs, std::size_t lhs_term,
+                      const packed_pauli_terms &rhs, std::size_t rhs_term);
+
+private:
+  // the number of words of each of the three bit sets
+  std::size_t num_words;
+  // support, X and Z words of the terms, one term after the other
+  std::vector<std::uint64_t> words;
+  std::vector<std::complex<double>> coefficients;
+
+  const std::uint64_t *term_words(std::size_t term) const {
+    return words.data() + 3 * num_words * term;
+  }
+};
+
+} // namespace cudaq::detail
@@ -18,6 +18,7 @@
 #include "cudaq/operators.h"
 #include "evaluation.h"
 #include "helpers.h"
+#include "packed_pauli.h"
 
 namespace cudaq {
 
@@ -1439,6 +1440,19 @@ std::vector<bool> product_op<HandlerTy>::get_binary_symplectic_form() const {
   return bsf; // always little endian order by definition of the bsf
 }
 
+HANDLER_SPECIFIC_TEMPLATE_DEFINITION(spin_handler)
+bool product_op<HandlerTy>::commutes_with(
+    const product_op<HandlerTy> &other) const {
+  std::size_t num_degrees = 0;
+  for (const auto *prod : {this, &other})
+    for (const auto &op : prod->operators)
+      num_degrees = std::max(num_degrees, op.target() + 1);
+  detail::packed_pauli_terms lhs(num_degrees), rhs(num_degrees);
+  lhs.push_back(this->operators, 1.);
+  rhs.push_back(other.operators, 1.);
+  return detail::packed_pauli_terms::commute(lhs, 0, rhs, 0);
+}
+
 HANDLER_SPECIFIC_TEMPLATE_DEFINITION(spin_handler)
 csr_spmatrix product_op<HandlerTy>::to_sparse_matrix(
     std::unordered_map<std::size_t, int64_t> dimensions,
@@ -1460,6 +1474,8 @@ template std::string
 product_op<spin_handler>::get_pauli_word(std::size_t pad_identities) const;
 template std::vector<bool>
 product_op<spin_handler>::get_binary_symplectic_form() const;
+template bool product_op<spin_handler>::commutes_with(
+    const product_op<spin_handler> &other) const;
 template csr_spmatrix product_op<spin_handler>::to_sparse_matrix(
     std::unordered_map<std::size_t, int64_t> dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
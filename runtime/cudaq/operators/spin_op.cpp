@@ -6,7 +6,11 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include <algorithm>
+#include <bit>
 #include <complex>
+#include <cstdint>
+#include <map>
 #include <unordered_map>
 #include <vector>
 
@@ -173,6 +177,138 @@ complex_matrix spin_handler::to_matrix(const std::string &pauli_word,
   return matrix;
 }
 
+namespace {
+// Minimal matrix dimension for which the rows are processed in parallel.
+constexpr std::size_t min_parallel_dimension = 1ul << 12;
+
+// The Pauli strings with the same X-mask. A Pauli string `c * P` maps the
+// basis state `col` to `col ^ x_mask`, with the entry
+// `c * i^{#Y} * (-1)^popcount(col & z_mask)`, where `z_mask` marks the Z and
+// Y factors; the factor `i^{#Y}` is included in the coefficients.
+struct pauli_group {
+  std::uint64_t x_mask = 0;
+  std::vector<std::uint64_t> z_masks;
+  std::vector<std::complex<double>> coefficients;
+
+  std::complex<double> entry(std::uint64_t col) const {
+    std::complex<double> value = 0.;
+    for (std::size_t i = 0; i < z_masks.size(); ++i)
+      if (std::popcount(col & z_masks[i]) & 1)
+        value -= coefficients[i];
+      else
+        value += coefficients[i];
+    return value;
+  }
+};
+
+// Returns the Pauli strings grouped by X-mask, with increasing X-masks, and
+// the number of degrees the strings act on.
+std::pair<std::vector<pauli_group>, std::size_t> group_pauli_terms(
+    const std::vector<std::pair<std::complex<double>, std::string>> &terms,
+    bool invert_order) {
+  const std::size_t nr_deg = terms.empty() ? 0 : terms[0].second.size();
+  if (nr_deg >= 64)
+    throw std::runtime_error("cannot compute the matrix of a spin operator "
+                             "acting on more than 63 degrees of freedom");
+
+  std::map<std::uint64_t, pauli_group> groups;
+  for (const auto &[coeff, pauli_word] : terms) {
+    if (pauli_word.size() != nr_deg)
+      throw std::runtime_error("Pauli strings must have the same length");
+    std::uint64_t x_mask = 0, z_mask = 0;
+    std::complex<double> coefficient = coeff;
+    for (std::size_t degree = 0; degree < nr_deg; ++degree) {
+      const auto bit = std::uint64_t(1) << degree;
+      const auto op = pauli_word[invert_order ? nr_deg - 1 - degree : degree];
+      if (op == 'X')
+        x_mask |= bit;
+      else if (op == 'Z')
+        z_mask |= bit;
+      else if (op == 'Y') {
+        x_mask |= bit;
+        z_mask |= bit;
+        coefficient *= std::complex<double>(0., 1.);
+      }
+    }
+    auto &group = groups[x_mask];
+    group.x_mask = x_mask;
+    group.z_masks.push_back(z_mask);
+    group.coefficients.push_back(coefficient);
+  }
+
+  std::vector<pauli_group> result;
+  result.reserve(groups.size());
+  for (auto &[x_mask, group] : groups)
+    result.push_back(std::move(group));
+  return std::make_pair(std::move(result), nr_deg);
+}
+} // namespace
+
+csr_spmatrix spin_handler::to_sparse_matrix(
+    const std::vector<std::pair<std::complex<double>, std::string>> &terms,
+    bool invert_order) {
+  const auto grouped = group_pauli_terms(terms, invert_order);
+  const auto &groups = grouped.first;
+  // Every row has exactly one entry per group, at distinct columns.
+  const std::size_t dim = 1ul << grouped.second;
+  const std::size_t row_size = groups.size();
+  std::vector<std::complex<double>> values(dim * row_size);
+  std::vector<std::size_t> rows(dim * row_size), cols(dim * row_size);
+
+#pragma omp parallel if (dim >= min_parallel_dimension)
+  {
+    std::vector<std::pair<std::uint64_t, std::size_t>> row_entries(row_size);
+#pragma omp for
+    for (std::int64_t row = 0; row < static_cast<std::int64_t>(dim); ++row) {
+      for (std::size_t g = 0; g < row_size; ++g)
+        row_entries[g] = std::make_pair(row ^ groups[g].x_mask, g);
+      std::sort(row_entries.begin(), row_entries.end());
+      const std::size_t offset = row * row_size;
+      for (std::size_t k = 0; k < row_size; ++k) {
+        const auto [col, g] = row_entries[k];
+        values[offset + k] = groups[g].entry(col);
+        rows[offset + k] = row;
+        cols[offset + k] = col;
+      }
+    }
+  }
+  return std::make_tuple(std::move(values), std::move(rows), std::move(cols));
+}
+
+complex_matrix spin_handler::to_matrix(
+    const std::vector<std::pair<std::complex<double>, std::string>> &terms,
+    bool invert_order) {
+  const auto grouped = group_pauli_terms(terms, invert_order);
+  const auto &groups = grouped.first;
+  const std::size_t dim = 1ul << grouped.second;
+  complex_matrix matrix(dim, dim);
+#pragma omp parallel for if (dim >= min_parallel_dimension)
+  for (std::int64_t row = 0; row < static_cast<std::int64_t>(dim); ++row)
+    for (const auto &group : groups) {
+      const std::uint64_t col = row ^ group.x_mask;
+      matrix(row, col) = group.entry(col);
+    }
+  return matrix;
+}
+
+void spin_handler::apply(
+    const std::vector<std::pair<std::complex<double>, std::string>> &terms,
+    const std::complex<double> *input, std::complex<double> *output,
+    bool invert_order) {
+  const auto grouped = group_pauli_terms(terms, invert_order);
+  const auto &groups = grouped.first;
+  const std::size_t dim = 1ul << grouped.second;
+#pragma omp parallel for if (dim >= min_parallel_dimension)
+  for (std::int64_t row = 0; row < static_cast<std::int64_t>(dim); ++row) {
+    std::complex<double> value = 0.;
+    for (const auto &group : groups) {
+      const std::uint64_t col = row ^ group.x_mask;
+      value += group.entry(col) * input[col];
+    }
+    output[row] = value;
+  }
+}
+
 complex_matrix spin_handler::to_matrix(
     std::unordered_map<std::size_t, int64_t> &dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters)
@@ -17,6 +17,7 @@
 #include "cudaq/operators.h"
 #include "evaluation.h"
 #include "helpers.h"
+#include "packed_pauli.h"
 
 namespace cudaq {
 
@@ -108,8 +109,18 @@ sum_op<HandlerTy>::evaluate(operator_arithmetics<EvalTy> arithmetics) const {
   }
 }
 
+template <typename HandlerTy>
+bool sum_op<HandlerTy>::has_constant_coefficients() const {
+  return std::all_of(this->coefficients.cbegin(), this->coefficients.cend(),
+                     [](const scalar_operator &coeff) {
+                       return coeff.is_constant();
+                     });
+}
+
 #define INSTANTIATE_SUM_PRIVATE_METHODS(HandlerTy)                             \
                                                                                \
+  template bool sum_op<HandlerTy>::has_constant_coefficients() const;          \
+                                                                               \
   template void sum_op<HandlerTy>::insert(product_op<HandlerTy> &&other);      \
                                                                                \
   template void sum_op<HandlerTy>::insert(const product_op<HandlerTy> &other); \
@@ -476,12 +487,7 @@ complex_matrix sum_op<spin_handler>::to_matrix(
   if (evaluated.terms.size() == 0)
     return cudaq::complex_matrix(0, 0);
 
-  auto matrix = spin_handler::to_matrix(evaluated.terms[0].second,
-                                        evaluated.terms[0].first, invert_order);
-  for (auto i = 1; i < terms.size(); ++i)
-    matrix += spin_handler::to_matrix(evaluated.terms[i].second,
-                                      evaluated.terms[i].first, invert_order);
-  return matrix;
+  return spin_handler::to_matrix(evaluated.terms, invert_order);
 }
 
 #define INSTANTIATE_SUM_EVALUATIONS(HandlerTy)                                 \
@@ -777,6 +783,9 @@ sum_op<HandlerTy>::operator*(const sum_op<HandlerTy> &other) const {
     return *this;
   if (this->is_default)
     return other;
+  if constexpr (std::is_same<HandlerTy, spin_handler>::value)
+    if (this->has_constant_coefficients() && other.has_constant_coefficients())
+      return this->packed_product(other);
 
   sum_op<HandlerTy> sum(false); // the entire sum needs to be rebuilt
   auto max_size = this->terms.size() * other.terms.size();
@@ -996,6 +1005,12 @@ sum_op<HandlerTy>::operator*=(const sum_op<HandlerTy> &other) {
     *this = other;
     return *this;
   }
+  if constexpr (std::is_same<HandlerTy, spin_handler>::value)
+    if (this->has_constant_coefficients() &&
+        other.has_constant_coefficients()) {
+      *this = this->packed_product(other);
+      return *this;
+    }
 
   sum_op<HandlerTy> sum(false); // the entire sum needs to be rebuilt
   auto max_size = this->terms.size() * other.terms.size();
@@ -1792,13 +1807,58 @@ csr_spmatrix sum_op<HandlerTy>::to_sparse_matrix(
                            std::vector<std::size_t>, std::vector<std::size_t>>(
         {}, {}, {});
 
-  auto matrix = spin_handler::to_sparse_matrix(
-      evaluated.terms[0].second, evaluated.terms[0].first, invert_order);
-  for (auto i = 1; i < terms.size(); ++i)
-    matrix += spin_handler::to_sparse_matrix(
-        evaluated.terms[i].second, evaluated.terms[i].first, invert_order);
-  return cudaq::detail::to_csr_spmatrix(
-      matrix, 1ul << evaluated.terms[0].second.size());
+  return spin_handler::to_sparse_matrix(evaluated.terms, invert_order);
+}
+
+HANDLER_SPECIFIC_TEMPLATE_DEFINITION(spin_handler)
+sum_op<HandlerTy>
+sum_op<HandlerTy>::packed_product(const sum_op<HandlerTy> &other) const {
+  assert(!this->is_default && !other.is_default);
+  std::size_t num_degrees = 0;
+  for (const auto *sum : {this, &other})
+    for (const auto &term : sum->terms)
+      if (!term.empty())
+        num_degrees = std::max(num_degrees, term.back().target() + 1);
+
+  const auto pack = [num_degrees](const sum_op<HandlerTy> &sum) {
+    detail::packed_pauli_terms packed(num_degrees);
+    for (std::size_t i = 0; i < sum.terms.size(); ++i)
+      packed.push_back(sum.terms[i], sum.coefficients[i].evaluate());
+    return packed;
+  };
+  auto product =
+      detail::packed_pauli_terms::multiply(pack(*this), pack(other));
+
+  sum_op<HandlerTy> sum(false);
+  sum.coefficients.reserve(product.num_terms());
+  sum.term_map.reserve(product.num_terms());
+  sum.terms.reserve(product.num_terms());
+  for (std::size_t i = 0; i < product.num_terms(); ++i)
+    sum.insert(product_op<HandlerTy>(product.get_coefficient(i),
+                                     product.get_operators(i)));
+  return sum;
+}
+
+HANDLER_SPECIFIC_TEMPLATE_DEFINITION(spin_handler)
+std::vector<std::complex<double>> sum_op<HandlerTy>::apply(
+    const std::vector<std::complex<double>> &state,
+    std::unordered_map<std::size_t, int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const {
+  auto evaluated = this->evaluate(
+      operator_arithmetics<operator_handler::canonical_evaluation>(dimensions,
+                                                                   parameters));
+  const std::size_t nr_deg =
+      evaluated.terms.size() == 0 ? 0 : evaluated.terms[0].second.size();
+  if (state.size() != (1ul << nr_deg))
+    throw std::invalid_argument(
+        "state size does not match the dimension of the operator");
+
+  std::vector<std::complex<double>> result(state.size());
+  if (evaluated.terms.size() != 0)
+    spin_handler::apply(evaluated.terms, state.data(), result.data(),
+                        invert_order);
+  return result;
 }
 
 HANDLER_SPECIFIC_TEMPLATE_DEFINITION(spin_handler)
@@ -1842,6 +1902,13 @@ template csr_spmatrix sum_op<spin_handler>::to_sparse_matrix(
     std::unordered_map<std::size_t, int64_t> dimensions,
     const std::unordered_map<std::string, std::complex<double>> &parameters,
     bool invert_order) const;
+template sum_op<spin_handler>
+sum_op<spin_handler>::packed_product(const sum_op<spin_handler> &other) const;
+template std::vector<std::complex<double>> sum_op<spin_handler>::apply(
+    const std::vector<std::complex<double>> &state,
+    std::unordered_map<std::size_t, int64_t> dimensions,
+    const std::unordered_map<std::string, std::complex<double>> &parameters,
+    bool invert_order) const;
 template std::vector<double>
 sum_op<spin_handler>::get_data_representation() const;
 
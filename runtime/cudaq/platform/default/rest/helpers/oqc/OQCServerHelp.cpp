@@ -13,6 +13,7 @@
 #include <regex>
 #include <sstream>
 #include <thread>
+#include <unordered_map>
 
 namespace cudaq {
 
@@ -41,6 +42,10 @@ private:
   /// shots
   std::string makeConfig(int shots);
 
+  /// @brief Return the maximum number of tasks per submission and, if enabled,
+  /// per bulk results request.
+  std::size_t getMaxBatchSize() const;
+
 public:
   RestClient client;
 
@@ -62,6 +67,10 @@ public:
   /// @brief Extracts the job ID from the server's response to a job submission.
   std::string extractJobId(ServerMessage &postResponse) override;
 
+  /// @brief Returns the IDs of all tasks of a batch submission.
+  std::vector<std::string> extractJobIds(ServerMessage &postResponse,
+                                         ServerMessage &job) override;
+
   /// @brief Constructs the URL for retrieving a job based on the server's
   /// response to a job submission.
   std::string constructGetJobPath(ServerMessage &postResponse) override;
@@ -69,6 +78,26 @@ public:
   /// @brief Constructs the URL for retrieving a job based on a job ID.
   std::string constructGetJobPath(std::string &jobId) override;
 
+  /// @brief Returns the maximum number of tasks retrieved in one request. Bulk
+  /// retrieval is opt-in, with the `bulk_results` option, otherwise each task
+  /// is retrieved separately.
+  std::size_t getMaxJobsPerResultsRequest() override {
+    const auto iter = backendConfig.find("bulk_results");
+    if (iter == backendConfig.end() || iter->second != "true")
+      return 1;
+    return getMaxBatchSize();
+  }
+
+  /// @brief Constructs the URL for retrieving several tasks at once.
+  std::string
+  constructGetJobsPath(const std::vector<std::string> &jobIds) override;
+
+  /// @brief Splits the response of a bulk retrieval into one response per
+  /// task.
+  std::vector<ServerMessage>
+  splitJobsResponse(ServerMessage &getJobsResponse,
+                    const std::vector<std::string> &jobIds) override;
+
   /// @brief Constructs the URL for retrieving the results of a job based on the
   /// server's response to a job submission.
   std::string constructGetResultsPath(ServerMessage &postResponse);
@@ -180,6 +209,10 @@ void OQCServerHelper::initialize(BackendConfig config) {
 
   // Construct the API job path
   config["job_path"] = std::string("/") + dev_id + "/tasks";
+  config["max_batch_size"] = get_from_config(
+      config, "max_batch_size", make_env_functor("OQC_MAX_BATCH_SIZE", "100"));
+  config["bulk_results"] = get_from_config(
+      config, "bulk_results", make_env_functor("OQC_BULK_RESULTS", "false"));
   parseConfigForCommonParams(config);
 
   // Move the passed config into the member variable backendConfig
@@ -252,29 +285,54 @@ std::string OQCServerHelper::makeConfig(int shots) {
          "\"$value\": 30}}}}}";
 }
 
+std::size_t OQCServerHelper::getMaxBatchSize() const {
+  const auto iter = backendConfig.find("max_batch_size");
+  if (iter == backendConfig.end())
+    return 1;
+  try {
+    return std::max<std::size_t>(std::stoul(iter->second), 1);
+  } catch (...) {
+    throw std::runtime_error("Invalid OQC max_batch_size value " +
+                             iter->second + ", must be a positive integer.");
+  }
+}
+
 // Create a job for the OQC quantum computer
 ServerJobPayload
 OQCServerHelper::createJob(std::vector<KernelExecution> &circuitCodes) {
   // Check if the necessary keys exist in the configuration
   if (!keyExists("target") || !keyExists("qubits") || !keyExists("job_path"))
     throw std::runtime_error("Key doesn't exist in backendConfig.");
-  std::vector<ServerMessage> jobs(circuitCodes.size());
   std::vector<std::string> task_ids =
       OQCServerHelper::createNTasks(static_cast<int>(circuitCodes.size()));
-
+  if (task_ids.size() != circuitCodes.size())
+    throw std::runtime_error("Expected " +
+                             std::to_string(circuitCodes.size()) +
+                             " OQC task ids, got " +
+                             std::to_string(task_ids.size()) + ".");
+
+  // Pack the circuits into as few submissions as allowed, all sharing the
+  // same compiler config.
+  const std::size_t maxBatchSize = getMaxBatchSize();
+  const std::string config = makeConfig(static_cast<int>(shots));
+  std::vector<ServerMessage> jobs;
   for (size_t i = 0; i < circuitCodes.size(); ++i) {
-    nlohmann::json j;
-    j["tasks"] = std::vector<nlohmann::json>();
-    // Construct the job message
+    if (i % maxBatchSize == 0) {
+      nlohmann::json j;
+      j["tasks"] = std::vector<nlohmann::json>();
+      jobs.push_back(std::move(j));
+    }
+    // Construct the task message
     nlohmann::json job;
     job["task_id"] = task_ids[i];
-    job["config"] = makeConfig(static_cast<int>(shots));
+    job["config"] = config;
     job["program"] = circuitCodes[i].code;
     job["qpu_id"] = backendConfig.at("target");
     job["tag"] = "";
-    j["tasks"].push_back(job);
-    jobs[i] = j;
+    jobs.back()["tasks"].push_back(std::move(job));
   }
+  cudaq::info("Submitting {} OQC tasks in {} batches.", circuitCodes.size(),
+              jobs.size());
 
   // Return a tuple containing the job path, headers, and the job message
   return std::make_tuple(backendConfig.at("url") +
@@ -292,6 +350,17 @@ std::string OQCServerHelper::extractJobId(ServerMessage &postResponse) {
   return postResponse.at("task_id");
 }
 
+// The task ids are created before the submission, so take them from the
+// submitted tasks in order
+std::vector<std::string>
+OQCServerHelper::extractJobIds(ServerMessage &postResponse,
+                               ServerMessage &job) {
+  std::vector<std::string> ids;
+  for (auto &task : job.at("tasks"))
+    ids.push_back(task.at("task_id").get<std::string>());
+  return ids;
+}
+
 // Construct the path to get a job
 std::string OQCServerHelper::constructGetJobPath(ServerMessage &postResponse) {
   return backendConfig.at("job_path") + "/" +
@@ -310,6 +379,43 @@ std::string OQCServerHelper::constructGetJobPath(std::string &jobId) {
   return res;
 }
 
+// Construct the path to get several jobs in one request
+std::string OQCServerHelper::constructGetJobsPath(
+    const std::vector<std::string> &jobIds) {
+  if (!keyExists("job_path"))
+    throw std::runtime_error("Key 'job_path' doesn't exist in backendConfig.");
+
+  std::string ids;
+  for (auto &jobId : jobIds)
+    ids += (ids.empty() ? "" : ",") + jobId;
+  return backendConfig.at("url") + backendConfig.at("job_path") +
+         "/all_info?task_ids=" + ids;
+}
+
+// Split the response to a bulk request, of the form
+//   {"tasks":[{"task_id":"...","results":{...},"task_error":null},...]}
+// into the response for each task
+std::vector<ServerMessage>
+OQCServerHelper::splitJobsResponse(ServerMessage &getJobsResponse,
+                                   const std::vector<std::string> &jobIds) {
+  if (!getJobsResponse.contains("tasks"))
+    throw std::runtime_error("ServerMessage doesn't contain 'tasks' key.");
+
+  std::unordered_map<std::string, ServerMessage *> tasks;
+  for (auto &task : getJobsResponse.at("tasks"))
+    tasks[task.at("task_id").get<std::string>()] = &task;
+
+  std::vector<ServerMessage> responses;
+  responses.reserve(jobIds.size());
+  for (auto &jobId : jobIds) {
+    auto iter = tasks.find(jobId);
+    if (iter == tasks.end())
+      throw std::runtime_error("OQC response is missing task " + jobId);
+    responses.push_back(std::move(*iter->second));
+  }
+  return responses;
+}
+
 // Construct the path to get the results of a job
 std::string
 OQCServerHelper::constructGetResultsPath(ServerMessage &postResponse) {
@@ -463,8 +569,25 @@ void OQCServerHelper::updatePassPipeline(
   check_machine_allowed(machine);
   std::string pathToFile = platformPath / std::string("mapping/oqc") /
                            (machine + std::string(".txt"));
-  passPipeline =
-      std::regex_replace(passPipeline, std::regex("%QPU_ARCH%"), pathToFile);
+
+  // Optionally weigh the mapping by calibration data, and search for the
+  // initial placement.
+  std::string mappingOptions;
+  auto calibration = backendConfig.find("calibration");
+  if (calibration != backendConfig.end() && !calibration->second.empty()) {
+    // Quote the path, which may contain spaces or pipeline delimiters.
+    if (calibration->second.find('"') != std::string::npos)
+      throw std::runtime_error("Invalid OQC calibration file path " +
+                               calibration->second +
+                               ", must not contain double quotes.");
+    mappingOptions += " calibration=\"" + calibration->second + "\"";
+  }
+  auto placementTrials = backendConfig.find("placement_trials");
+  if (placementTrials != backendConfig.end() &&
+      !placementTrials->second.empty())
+    mappingOptions += " placementTrials=" + placementTrials->second;
+  passPipeline = std::regex_replace(passPipeline, std::regex("%QPU_ARCH%\\)"),
+                                    pathToFile + ")" + mappingOptions);
 }
 
 } // namespace cudaq
@@ -6,6 +6,7 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include "RestWorkerPool.h"
 #include "common/JIT.h"
 #include "common/JsonConvert.h"
 #include "common/Logger.h"
@@ -50,6 +51,7 @@
 #include <cxxabi.h>
 #include <filesystem>
 #include <fstream>
+#include <list>
 #include <streambuf>
 
 extern "C" {
@@ -86,8 +88,82 @@ void clearRegOpsAndDestroyJIT(std::unique_ptr<llvm::orc::LLJIT> &jit) {
   jit.reset();
 }
 
+// A parsed MLIR kernel module and its JIT compilation.
+struct JitKernel {
+  OwningOpRef<ModuleOp> module;
+  std::unique_ptr<ExecutionEngine> engine;
+  // The passes that were applied to the module before JIT compilation.
+  std::vector<std::string> passes;
+};
+
+// Bounded cache of the kernel modules submitted to the server, keyed by the
+// hash of their (Base64-encoded) code. Clients send the code of a module once
+// and then only its hash, e.g., in a variational loop calling the same kernel
+// many times. Besides the decoded code, an entry keeps the JIT compilation of
+// the module, so that it is also created once: the parsed module and its JIT
+// engine for MLIR code, or the JIT compiled kernel for library mode (LLVM)
+// code, whose arguments are sent separately from the code. The least recently
+// used entry is evicted when the cache is full.
+class KernelModuleCache {
+public:
+  struct Entry {
+    // The decoded code.
+    std::string code;
+    // Parsed and JIT compiled module, if the code has been executed as MLIR.
+    JitKernel kernel;
+    // JIT compiled kernel, and its name, if the code has been executed as
+    // LLVM.
+    cudaq::JitWrappedKernel libraryKernel;
+    std::string libraryKernelName;
+  };
+
+  explicit KernelModuleCache(std::size_t capacity = 0) : capacity(capacity) {}
+
+  bool enabled() const { return capacity > 0; }
+
+  // Return the entry for `codeHash`, or null if it is not cached.
+  Entry *lookup(const std::string &codeHash) {
+    auto iter = index.find(codeHash);
+    if (iter == index.end())
+      return nullptr;
+    entries.splice(entries.begin(), entries, iter->second);
+    return &iter->second->second;
+  }
+
+  // Add an entry for `codeHash`, evicting the least recently used one if the
+  // cache is full.
+  Entry &insert(const std::string &codeHash, std::string code) {
+    if (auto *entry = lookup(codeHash))
+      return *entry;
+    if (entries.size() >= capacity) {
+      cudaq::info("Evicting kernel module {} from the module cache.",
+                  entries.back().first);
+      index.erase(entries.back().first);
+      entries.pop_back();
+    }
+    entries.emplace_front(codeHash, Entry{std::move(code), {}});
+    index[codeHash] = entries.begin();
+    return entries.front().second;
+  }
+
+  // Drop the JIT engines of all entries, keeping the code.
+  void clearKernels() {
+    for (auto &[codeHash, entry] : entries) {
+      entry.kernel = JitKernel();
+      entry.libraryKernel = cudaq::JitWrappedKernel();
+    }
+  }
+
+private:
+  std::size_t capacity;
+  std::list<std::pair<std::string, Entry>> entries;
+  std::unordered_map<std::string, decltype(entries)::iterator> index;
+};
+
 class RemoteRestRuntimeServer : public cudaq::RemoteRuntimeServer {
   int m_port = -1;
+  // Worker processes executing the jobs, if the server dispatches them.
+  std::unique_ptr<cudaq::RestWorkerPool> m_workerPool;
   std::unique_ptr<cudaq::RestServer> m_server;
   std::unique_ptr<MLIRContext> m_mlirContext;
   bool m_hasMpi = false;
@@ -96,6 +172,14 @@ class RemoteRestRuntimeServer : public cudaq::RemoteRuntimeServer {
     std::vector<std::string> passes;
   };
   std::unordered_map<std::size_t, CodeTransformInfo> m_codeTransform;
+  // Kernel modules submitted by the clients.
+  KernelModuleCache m_moduleCache;
+  // Cached module of the request being processed, if any.
+  KernelModuleCache::Entry *m_requestModule = nullptr;
+  // Default capacity of the module cache.
+  static constexpr std::size_t DEFAULT_MODULE_CACHE_SIZE = 16;
+  // Default number of jobs waiting for a worker process.
+  static constexpr std::size_t DEFAULT_MAX_QUEUED_REQUESTS = 64;
   // Currently-loaded NVQIR simulator.
   SimulatorHandle m_simHandle;
   // Default backend for initialization.
@@ -145,7 +229,38 @@ public:
     if (!portValid)
       throw std::runtime_error(
           "Invalid TCP/IP port requested. Valid range: [1024, 65535].");
-    m_server = std::make_unique<cudaq::RestServer>(m_port);
+    std::size_t moduleCacheSize = DEFAULT_MODULE_CACHE_SIZE;
+    const auto cacheSizeIter = configs.find("module-cache-size");
+    if (cacheSizeIter != configs.end())
+      moduleCacheSize = stoul(cacheSizeIter->second);
+    m_moduleCache = KernelModuleCache(moduleCacheSize);
+
+    // With more than one worker, this process only dispatches the jobs to
+    // worker processes (each one handling a job at a time), holding up to
+    // `max-queued-requests` further jobs until a worker is available.
+    std::size_t numWorkers = 1;
+    const auto workersIter = configs.find("workers");
+    if (workersIter != configs.end())
+      numWorkers = stoul(workersIter->second);
+    std::size_t maxQueuedRequests = DEFAULT_MAX_QUEUED_REQUESTS;
+    const auto maxQueuedIter = configs.find("max-queued-requests");
+    if (maxQueuedIter != configs.end())
+      maxQueuedRequests = stoul(maxQueuedIter->second);
+    unsigned int numServerThreads = 1;
+    if (numWorkers > 1) {
+      if (exitAfterJob || cudaq::mpi::is_initialized())
+        throw std::runtime_error(
+            "Worker processes are not supported by this server type.");
+      m_workerPool = std::make_unique<cudaq::RestWorkerPool>(
+          numWorkers, maxQueuedRequests,
+          std::vector<std::string>{"--module-cache-size",
+                                   std::to_string(moduleCacheSize)});
+      // A thread per executing or queued job, plus some to answer pings and
+      // metrics queries (and reject jobs) when the pool is full.
+      numServerThreads = m_workerPool->getCapacity() + 2;
+    }
+    m_server =
+        std::make_unique<cudaq::RestServer>(m_port, "cudaq", numServerThreads);
     m_server->addRoute(
         cudaq::RestServer::Method::GET, "/",
         [](const std::string &reqBody,
@@ -155,11 +270,23 @@ public:
           return json();
         });
 
+    // Load of the worker pool.
+    if (m_workerPool)
+      m_server->addRoute(
+          cudaq::RestServer::Method::GET, "/metrics",
+          [&](const std::string &reqBody,
+              const std::unordered_multimap<std::string, std::string>
+                  &headers) { return m_workerPool->getMetrics(); });
+
     // New simulation request.
     m_server->addRoute(
         cudaq::RestServer::Method::POST, "/job",
         [&](const std::string &reqBody,
             const std::unordered_multimap<std::string, std::string> &headers) {
+          // Jobs are executed by the worker processes, if any.
+          if (m_workerPool)
+            return m_workerPool->submit(reqBody);
+
           requestStart = std::chrono::high_resolution_clock::now();
           auto shutdownAfterHandlingRequest = llvm::make_scope_exit([&] {
             if (this->exitAfterJob)
@@ -282,6 +409,8 @@ public:
 
       m_simHandle =
           SimulatorHandle(backendSimName, loadNvqirSimLib(backendSimName));
+      // Do not reuse kernels compiled while another backend was loaded.
+      m_moduleCache.clearKernels();
     }
 
     if (seed != 0)
@@ -293,13 +422,11 @@ public:
       throw std::runtime_error("CodeFormat::LLVM is not supported with VQE. "
                                "Use CodeFormat::MLIR instead.");
     } else {
-      llvm::SourceMgr sourceMgr;
-      sourceMgr.AddNewSourceBuffer(llvm::MemoryBuffer::getMemBufferCopy(ir),
-                                   llvm::SMLoc());
-      auto module = parseSourceFile<ModuleOp>(sourceMgr, m_mlirContext.get());
-      if (!module)
-        throw std::runtime_error("Failed to parse the input MLIR code");
-      auto engine = jitMlirCode(*module, requestInfo.passes);
+      JitKernel uncachedKernel;
+      auto &engine =
+          loadMlirKernel(m_mlirContext.get(), ir, requestInfo.passes,
+                         uncachedKernel)
+              .engine;
       const std::string entryPointFunc =
           std::string(cudaq::runtime::cudaqGenPrefixName) +
           std::string(kernelName);
@@ -356,24 +483,27 @@ public:
 
       m_simHandle =
           SimulatorHandle(backendSimName, loadNvqirSimLib(backendSimName));
+      // Do not reuse kernels compiled while another backend was loaded.
+      m_moduleCache.clearKernels();
     }
     if (seed != 0)
       cudaq::set_random_seed(seed);
     auto &platform = cudaq::get_platform();
     auto &requestInfo = m_codeTransform[reqId];
 
-    // The lifetime of this pointer should be just as long as `platform` because
+    // The lifetime of this JIT should be just as long as `platform` because
     // any calls to `platform` functions could invoke code that relies on the
     // JIT being present.
-    std::unique_ptr<llvm::orc::LLJIT> llvmJit;
+    cudaq::JitWrappedKernel uncachedKernel;
     if (requestInfo.format == cudaq::CodeFormat::LLVM) {
+      const auto &kernel =
+          loadLibraryKernel(ir, std::string(kernelName), uncachedKernel);
       if (io_context.name == "sample") {
         // In library mode (LLVM), check to see if we have mid-circuit measures
         // by tracing the kernel function.
         cudaq::ExecutionContext context("tracer");
         platform.set_exec_ctx(&context);
-        llvmJit = cudaq::invokeWrappedKernel(ir, std::string(kernelName),
-                                             kernelArgs, argsSize);
+        cudaq::invokeWrappedKernel(kernel, kernelArgs, argsSize);
         platform.reset_exec_ctx();
         // In trace mode, if we have a measure result
         // that is passed to an if statement, then
@@ -387,14 +517,12 @@ public:
           // Need to run simulation shot-by-shot
           cudaq::sample_result counts;
           platform.set_exec_ctx(&io_context);
-          // Since registered operations may contain pointers to classes defined
-          // in an LLVM JIT, we must clear them before any prior LLVM JIT gets
-          // deleted.
-          clearRegOpsAndDestroyJIT(llvmJit);
+          // Clear the operations registered by the trace.
+          cudaq::getExecutionManager()->clearRegisteredOperations();
           // If it has conditionals, loop over individual circuit executions
-          llvmJit = cudaq::invokeWrappedKernel(
-              ir, std::string(kernelName), kernelArgs, argsSize,
-              io_context.shots, [&](std::size_t i) {
+          cudaq::invokeWrappedKernel(
+              kernel, kernelArgs, argsSize, io_context.shots,
+              [&](std::size_t i) {
                 // Reset the context and get the single
                 // measure result, add it to the
                 // sample_result and clear the context
@@ -409,18 +537,14 @@ public:
         } else {
           // If no conditionals, nothing special to do for library mode
           platform.set_exec_ctx(&io_context);
-          // Since registered operations may contain pointers to classes defined
-          // in an LLVM JIT, we must clear them before any prior LLVM JIT gets
-          // deleted.
-          clearRegOpsAndDestroyJIT(llvmJit);
-          llvmJit = cudaq::invokeWrappedKernel(ir, std::string(kernelName),
-                                               kernelArgs, argsSize);
+          // Clear the operations registered by the trace.
+          cudaq::getExecutionManager()->clearRegisteredOperations();
+          cudaq::invokeWrappedKernel(kernel, kernelArgs, argsSize);
           platform.reset_exec_ctx();
         }
       } else {
         platform.set_exec_ctx(&io_context);
-        llvmJit = cudaq::invokeWrappedKernel(ir, std::string(kernelName),
-                                             kernelArgs, argsSize);
+        cudaq::invokeWrappedKernel(kernel, kernelArgs, argsSize);
         platform.reset_exec_ctx();
       }
     } else {
@@ -449,10 +573,11 @@ public:
         platform.reset_exec_ctx();
       }
     }
-    // Clear the registered operations before the `llvmJit` goes out of scope
-    // so that destruction of registered operations doesn't cause segfaults
-    // during shutdown.
-    clearRegOpsAndDestroyJIT(llvmJit);
+    // Clear the registered operations before any JIT gets deleted (the
+    // uncached one goes out of scope, a cached one may be evicted later) so
+    // that destruction of registered operations doesn't cause segfaults during
+    // shutdown.
+    clearRegOpsAndDestroyJIT(uncachedKernel.jit);
     simulationEnd = std::chrono::high_resolution_clock::now();
   }
 
@@ -544,6 +669,59 @@ protected:
     return uniqueJit;
   }
 
+  // Return the parsed and JIT compiled MLIR module of `irString`. The kernel of
+  // the cached module of the current request is compiled once and reused by
+  // later requests (with the same passes), any other code is compiled into
+  // `uncachedKernel`.
+  JitKernel &loadMlirKernel(MLIRContext *context, std::string_view irString,
+                            const std::vector<std::string> &passes,
+                            JitKernel &uncachedKernel) {
+    if (m_requestModule && m_requestModule->kernel.engine &&
+        m_requestModule->kernel.passes == passes) {
+      cudaq::info("Reusing the JIT compiled kernel module.");
+      return m_requestModule->kernel;
+    }
+
+    auto &kernel = m_requestModule ? m_requestModule->kernel : uncachedKernel;
+    kernel = JitKernel();
+    llvm::SourceMgr sourceMgr;
+    sourceMgr.AddNewSourceBuffer(llvm::MemoryBuffer::getMemBufferCopy(irString),
+                                 llvm::SMLoc());
+    auto module = parseSourceFile<ModuleOp>(sourceMgr, context);
+    if (!module)
+      throw std::runtime_error("Failed to parse the input MLIR code");
+    auto engine = jitMlirCode(*module, passes);
+    kernel.module = std::move(module);
+    kernel.engine = std::move(engine);
+    kernel.passes = passes;
+    return kernel;
+  }
+
+  // Return the JIT compiled library mode kernel `kernelName` of `irString`.
+  // The kernel of the cached module of the current request is compiled once
+  // and reused by later requests, with any arguments, any other code is
+  // compiled into `uncachedKernel`.
+  const cudaq::JitWrappedKernel &
+  loadLibraryKernel(std::string_view irString, const std::string &kernelName,
+                    cudaq::JitWrappedKernel &uncachedKernel) {
+    if (m_requestModule && m_requestModule->libraryKernel.jit &&
+        m_requestModule->libraryKernelName == kernelName) {
+      cudaq::info("Reusing the JIT compiled kernel module.");
+      return m_requestModule->libraryKernel;
+    }
+
+    if (!m_requestModule) {
+      uncachedKernel = cudaq::compileWrappedKernel(irString, kernelName);
+      return uncachedKernel;
+    }
+    // Registered operations may point into the JIT being replaced.
+    cudaq::getExecutionManager()->clearRegisteredOperations();
+    m_requestModule->libraryKernel =
+        cudaq::compileWrappedKernel(irString, kernelName);
+    m_requestModule->libraryKernelName = kernelName;
+    return m_requestModule->libraryKernel;
+  }
+
   void
   invokeMlirKernel(cudaq::ExecutionContext &io_context,
                    std::unique_ptr<MLIRContext> &contextPtr,
@@ -551,13 +729,11 @@ protected:
                    const std::vector<std::string> &passes,
                    const std::string &entryPointFn, std::size_t numTimes = 1,
                    std::function<void(std::size_t)> postExecCallback = {}) {
-    llvm::SourceMgr sourceMgr;
-    sourceMgr.AddNewSourceBuffer(llvm::MemoryBuffer::getMemBufferCopy(irString),
-                                 llvm::SMLoc());
-    auto module = parseSourceFile<ModuleOp>(sourceMgr, contextPtr.get());
-    if (!module)
-      throw std::runtime_error("Failed to parse the input MLIR code");
-    auto engine = jitMlirCode(*module, passes);
+    JitKernel uncachedKernel;
+    auto &kernel =
+        loadMlirKernel(contextPtr.get(), irString, passes, uncachedKernel);
+    auto &module = kernel.module;
+    auto &engine = kernel.engine;
     llvm::SmallVector<void *> returnArg;
     const std::string entryPointFunc =
         std::string(cudaq::runtime::cudaqGenPrefixName) + entryPointFn;
@@ -710,17 +886,50 @@ protected:
         return resultJson;
       }
 
-      const auto reqId = g_requestCounter++;
-      m_codeTransform[reqId] =
-          CodeTransformInfo(request.format, request.passes);
+      // Resolve the code of the request, which is omitted if the client knows
+      // that this server holds the module.
       json resultJson;
       std::vector<char> decodedCodeIr;
-      auto errorCode = llvm::decodeBase64(request.code, decodedCodeIr);
-      if (errorCode) {
-        LLVMConsumeError(llvm::wrap(std::move(errorCode)));
-        throw std::runtime_error("Failed to decode input IR");
+      std::string_view codeStr;
+      auto releaseRequestModule =
+          llvm::make_scope_exit([&] { m_requestModule = nullptr; });
+      if (request.codeHash.has_value() && request.code.empty()) {
+        m_requestModule = m_moduleCache.lookup(*request.codeHash);
+        if (!m_requestModule) {
+          resultJson["status"] = "Kernel module not found";
+          resultJson["errorMessage"] =
+              fmt::format("The server does not hold the kernel module {}.",
+                          *request.codeHash);
+          resultJson[cudaq::RestRequest::MISSING_CODE_HASH_KEY] =
+              *request.codeHash;
+          return resultJson;
+        }
+        cudaq::info("Using the cached kernel module {}.", *request.codeHash);
+        codeStr = m_requestModule->code;
+      } else {
+        auto errorCode = llvm::decodeBase64(request.code, decodedCodeIr);
+        if (errorCode) {
+          LLVMConsumeError(llvm::wrap(std::move(errorCode)));
+          throw std::runtime_error("Failed to decode input IR (request.code)");
+        }
+        codeStr = std::string_view(decodedCodeIr.data(), decodedCodeIr.size());
+        if (request.codeHash.has_value() && m_moduleCache.enabled()) {
+          if (cudaq::RestRequest::getCodeHash(request.code) !=
+              *request.codeHash)
+            throw std::runtime_error(
+                "The code hash does not match the code of the request.");
+          m_requestModule = &m_moduleCache.insert(
+              *request.codeHash, std::string(codeStr.begin(), codeStr.end()));
+          codeStr = m_requestModule->code;
+        }
       }
-      std::string_view codeStr(decodedCodeIr.data(), decodedCodeIr.size());
+      if (m_requestModule)
+        resultJson[cudaq::RestRequest::CACHED_CODE_HASH_KEY] =
+            *request.codeHash;
+
+      const auto reqId = g_requestCounter++;
+      m_codeTransform[reqId] =
+          CodeTransformInfo(request.format, request.passes);
 
       if (request.opt.has_value() && request.opt->optimizer) {
         if (!request.opt->optimizer_n_params.has_value())
@@ -735,24 +944,20 @@ protected:
       } else if (request.executionContext.name == "state-overlap") {
         if (!request.overlapKernel.has_value())
           throw std::runtime_error("Missing overlap kernel data.");
-        std::vector<char> decodedCodeIr1, decodedCodeIr2;
-        auto errorCode1 = llvm::decodeBase64(request.code, decodedCodeIr1);
+        std::vector<char> decodedCodeIr2;
         auto errorCode2 =
             llvm::decodeBase64(request.overlapKernel->ir, decodedCodeIr2);
-        if (errorCode1) {
-          LLVMConsumeError(llvm::wrap(std::move(errorCode1)));
-          throw std::runtime_error("Failed to decode input IR (request.code)");
-        }
         if (errorCode2) {
           LLVMConsumeError(llvm::wrap(std::move(errorCode2)));
           throw std::runtime_error(
               "Failed to decode input IR (request.overlapKernel->ir)");
         }
-        std::string_view codeStr1(decodedCodeIr1.data(), decodedCodeIr1.size());
         cudaq::ExecutionContext stateContext1("extract-state");
-        handleRequest(reqId, stateContext1, request.simulator, codeStr1,
+        handleRequest(reqId, stateContext1, request.simulator, codeStr,
                       request.entryPoint, request.args.data(),
                       request.args.size(), request.seed);
+        // The second kernel is not cached.
+        m_requestModule = nullptr;
         std::string_view codeStr2(decodedCodeIr2.data(), decodedCodeIr2.size());
         cudaq::ExecutionContext stateContext2("extract-state");
         handleRequest(reqId, stateContext2, request.simulator, codeStr2,
@@ -767,13 +972,6 @@ protected:
         if (request.overlapKernel.has_value())
           throw std::runtime_error("Unexpected data: overlap kernel is "
                                    "provided in non-overlap compute mode.");
-        std::vector<char> decodedCodeIr;
-        auto errorCode = llvm::decodeBase64(request.code, decodedCodeIr);
-        if (errorCode) {
-          LLVMConsumeError(llvm::wrap(std::move(errorCode)));
-          throw std::runtime_error("Failed to decode input IR (request.code)");
-        }
-        std::string_view codeStr(decodedCodeIr.data(), decodedCodeIr.size());
         handleRequest(reqId, request.executionContext, request.simulator,
                       codeStr, request.entryPoint, request.args.data(),
                       request.args.size(), request.seed);
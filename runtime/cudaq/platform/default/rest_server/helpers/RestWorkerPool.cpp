@@ -0,0 +1,299 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "RestWorkerPool.h"
+#include "common/FmtCore.h"
+#include "common/JsonConvert.h"
+#include "common/Logger.h"
+#include "common/RestClient.h"
+#include "llvm/ADT/ScopeExit.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Program.h"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+// Return a TCP/IP port on the loopback interface that is currently unused,
+// as assigned by the OS when binding to port 0.
+std::optional<int> getAvailablePort() {
+  int sock = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (sock < 0)
+    return std::nullopt;
+  struct sockaddr_in addr;
+  ::bzero((char *)&addr, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t addrLen = sizeof(addr);
+  std::optional<int> port;
+  if (::bind(sock, (struct sockaddr *)&addr, sizeof(addr)) == 0 &&
+      ::getsockname(sock, (struct sockaddr *)&addr, &addrLen) == 0)
+    port = ntohs(addr.sin_port);
+  ::close(sock);
+  return port;
+}
+
+// Return true if the worker process `pid` has terminated (reaping it).
+bool hasTerminated(int pid) {
+  if (pid <= 0)
+    return true;
+  int status = 0;
+  const int result = ::waitpid(pid, &status, WNOHANG);
+  return result == pid || (result < 0 && errno == ECHILD);
+}
+
+// Return true if the worker process `pid` terminates (reaping it) within
+// `timeout`.
+bool waitForTermination(int pid, std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!hasTerminated(pid)) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
+// Time given to a worker process to exit after a failed exchange with it,
+// e.g., because it is crashing.
+constexpr std::chrono::milliseconds WORKER_EXIT_TIMEOUT(2000);
+
+// Bound on the number of kernel modules whose worker is remembered.
+constexpr std::size_t MAX_CODE_HASH_WORKERS = 4096;
+} // namespace
+
+namespace cudaq {
+
+RestWorkerPool::RestWorkerPool(std::size_t numWorkers,
+                               std::size_t maxQueuedRequests,
+                               const std::vector<std::string> &workerArgs,
+                               const std::string &executable)
+    : executable(executable.empty()
+                     ? llvm::sys::fs::getMainExecutable(nullptr, nullptr)
+                     : executable),
+      workerArgs(workerArgs), workers(numWorkers),
+      maxQueuedRequests(maxQueuedRequests) {
+  if (numWorkers == 0)
+    throw std::runtime_error("The worker pool needs at least one worker.");
+  for (auto &worker : workers)
+    launch(worker);
+}
+
+RestWorkerPool::~RestWorkerPool() {
+  for (auto &worker : workers)
+    terminate(worker);
+}
+
+void RestWorkerPool::launch(Worker &worker) {
+  constexpr std::size_t PORT_MAX_RETRIES = 10;
+  for (std::size_t j = 0; j < PORT_MAX_RETRIES; j++) {
+    const auto port = getAvailablePort();
+    if (!port.has_value())
+      throw std::runtime_error(
+          "Unable to find a TCP/IP port for a worker process.");
+
+    // Workers handle one request at a time and must not launch workers.
+    const std::string portStr = std::to_string(*port);
+    std::vector<llvm::StringRef> argv{executable, "--port", portStr,
+                                      "--workers", "1"};
+    for (const auto &arg : workerArgs)
+      argv.emplace_back(arg);
+    std::string errorMsg;
+    bool executionFailed = false;
+    auto processInfo =
+        llvm::sys::ExecuteNoWait(executable, argv, std::nullopt, {}, 0,
+                                 &errorMsg, &executionFailed);
+    if (executionFailed)
+      throw std::runtime_error("Failed to launch a worker process at port " +
+                               portStr + ": " + errorMsg);
+    worker.pid = processInfo.Pid;
+    worker.url = fmt::format("localhost:{}", portStr);
+    worker.client = std::make_unique<RestClient>();
+
+    // Ping the worker until it is ready, waiting longer and longer.
+    constexpr std::size_t MAX_RETRIES = 100;
+    constexpr std::size_t POLL_INTERVAL_MAX_MS = 1000;
+    constexpr std::size_t POLL_INTERVAL_MIN_MS = 10;
+    for (std::size_t i = 0; i < MAX_RETRIES && !hasTerminated(worker.pid);
+         ++i) {
+      try {
+        std::map<std::string, std::string> headers;
+        [[maybe_unused]] auto pingResult =
+            RestClient().get(worker.url, "", headers);
+        cudaq::info("Worker process {} is serving at http://{}.", worker.pid,
+                    worker.url);
+        return;
+      } catch (...) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(
+            POLL_INTERVAL_MIN_MS +
+            (POLL_INTERVAL_MAX_MS - POLL_INTERVAL_MIN_MS) * i / MAX_RETRIES));
+      }
+    }
+    cudaq::info("No response from the worker process {}, retrying with "
+                "another port.",
+                worker.pid);
+    terminate(worker);
+  }
+  throw std::runtime_error("Unable to launch a worker process.");
+}
+
+void RestWorkerPool::terminate(Worker &worker) {
+  if (worker.pid <= 0)
+    return;
+  cudaq::info("Shutting down worker process {}", worker.pid);
+  ::kill(worker.pid, SIGKILL);
+  ::waitpid(worker.pid, nullptr, 0);
+  worker.pid = -1;
+}
+
+std::optional<std::size_t>
+RestWorkerPool::acquire(const std::optional<std::string> &codeHash) {
+  std::unique_lock<std::mutex> lock(mutex);
+  // Prefer the worker holding the kernel module, otherwise take any idle one.
+  const auto findIdleWorker = [&]() -> std::optional<std::size_t> {
+    if (codeHash.has_value())
+      if (auto iter = codeHashWorkers.find(*codeHash);
+          iter != codeHashWorkers.end() && !workers[iter->second].busy)
+        return iter->second;
+    for (std::size_t i = 0; i < workers.size(); ++i)
+      if (!workers[i].busy)
+        return i;
+    return std::nullopt;
+  };
+
+  auto workerIdx = findIdleWorker();
+  if (!workerIdx.has_value()) {
+    if (numQueuedRequests >= maxQueuedRequests) {
+      ++numRejectedRequests;
+      return std::nullopt;
+    }
+    ++numQueuedRequests;
+    peakQueuedRequests = std::max(peakQueuedRequests, numQueuedRequests);
+    cudaq::info("All workers are busy, queuing the request ({} queued).",
+                numQueuedRequests);
+    workerReleased.wait(lock, [&] {
+      workerIdx = findIdleWorker();
+      return workerIdx.has_value();
+    });
+    --numQueuedRequests;
+  }
+  workers[*workerIdx].busy = true;
+  ++numBusyWorkers;
+  return workerIdx;
+}
+
+void RestWorkerPool::release(std::size_t workerIdx, bool failed) {
+  {
+    std::scoped_lock lock(mutex);
+    workers[workerIdx].busy = false;
+    --numBusyWorkers;
+    if (failed)
+      ++numFailedRequests;
+    else
+      ++numCompletedRequests;
+  }
+  workerReleased.notify_one();
+}
+
+nlohmann::json RestWorkerPool::submit(const std::string &requestBody) {
+  nlohmann::json requestJs;
+  std::optional<std::string> codeHash;
+  try {
+    requestJs = nlohmann::json::parse(requestBody);
+    if (requestJs.contains("codeHash"))
+      codeHash = requestJs["codeHash"].get<std::string>();
+  } catch (std::exception &e) {
+    {
+      std::scoped_lock lock(mutex);
+      ++numFailedRequests;
+    }
+    nlohmann::json resultJs;
+    resultJs["status"] = "Failed to process incoming request";
+    resultJs["errorMessage"] = e.what();
+    return resultJs;
+  }
+
+  const auto workerIdx = acquire(codeHash);
+  if (!workerIdx.has_value()) {
+    nlohmann::json resultJs;
+    resultJs["status"] = "Server busy";
+    resultJs["errorMessage"] =
+        fmt::format("All {} workers are busy and {} requests are queued.",
+                    workers.size(), maxQueuedRequests);
+    return resultJs;
+  }
+
+  auto &worker = workers[*workerIdx];
+  bool failed = true;
+  auto releaseWorker =
+      llvm::make_scope_exit([&] { release(*workerIdx, failed); });
+  try {
+    // Relaunch the worker if it did not survive its previous request.
+    if (hasTerminated(worker.pid)) {
+      worker.pid = -1;
+      launch(worker);
+      std::scoped_lock lock(mutex);
+      ++numWorkerRestarts;
+    }
+    std::map<std::string, std::string> headers{
+        {"Expect:", ""}, {"Content-type", "application/json"}};
+    auto resultJs = worker.client->post(worker.url, "job", requestJs, headers,
+                                        /*enableLogging=*/false);
+    if (codeHash.has_value() &&
+        resultJs.contains(cudaq::RestRequest::CACHED_CODE_HASH_KEY)) {
+      std::scoped_lock lock(mutex);
+      if (codeHashWorkers.size() >= MAX_CODE_HASH_WORKERS)
+        codeHashWorkers.clear();
+      codeHashWorkers[*codeHash] = *workerIdx;
+    }
+    failed = !resultJs.contains("executionContext");
+    return resultJs;
+  } catch (std::exception &e) {
+    nlohmann::json resultJs;
+    resultJs["status"] = "Failed to process incoming request";
+    // The worker may still be exiting when the connection drops, and one that
+    // survives a failed exchange is in an unknown state, so it is shut down.
+    // Either way, it is relaunched by the next request it is assigned.
+    const int pid = worker.pid;
+    if (waitForTermination(pid, WORKER_EXIT_TIMEOUT)) {
+      resultJs["errorMessage"] =
+          fmt::format("The worker process {} terminated unexpectedly.", pid);
+      worker.pid = -1;
+    } else {
+      resultJs["errorMessage"] = fmt::format(
+          "The worker process {} failed to handle the request ({}), and was "
+          "shut down.",
+          pid, e.what());
+      terminate(worker);
+    }
+    return resultJs;
+  }
+}
+
+nlohmann::json RestWorkerPool::getMetrics() const {
+  std::scoped_lock lock(mutex);
+  nlohmann::json metrics;
+  metrics["workers"] = workers.size();
+  metrics["busyWorkers"] = numBusyWorkers;
+  metrics["queuedRequests"] = numQueuedRequests;
+  metrics["maxQueuedRequests"] = maxQueuedRequests;
+  metrics["peakQueuedRequests"] = peakQueuedRequests;
+  metrics["completedRequests"] = numCompletedRequests;
+  metrics["failedRequests"] = numFailedRequests;
+  metrics["rejectedRequests"] = numRejectedRequests;
+  metrics["workerRestarts"] = numWorkerRestarts;
+  return metrics;
+}
+
+} // namespace cudaq
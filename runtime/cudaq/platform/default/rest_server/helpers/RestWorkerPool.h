@@ -0,0 +1,93 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "nlohmann/json.hpp"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cudaq {
+class RestClient;
+
+/// @brief A pool of `cudaq-qpud` worker processes executing job requests
+/// concurrently.
+///
+/// The server process handling requests cannot run several jobs at once: the
+/// execution context of the platform, the loaded simulator library, the
+/// registered custom operations and the MLIR context are all process-wide
+/// state. Instead, the pool launches worker servers on local ports and
+/// forwards each job to an idle worker, so that every job runs in isolation in
+/// its own process. A crashed (or timed out) worker is relaunched.
+///
+/// Jobs arriving while all workers are busy wait in a bounded admission queue,
+/// further jobs are rejected. Jobs carrying the hash of a kernel module are
+/// preferably sent to the worker that holds the module in its module cache.
+class RestWorkerPool {
+public:
+  /// @brief Launch `numWorkers` worker processes of `executable` (the running
+  /// `cudaq-qpud` by default) with the extra command line arguments
+  /// `workerArgs`.
+  RestWorkerPool(std::size_t numWorkers, std::size_t maxQueuedRequests,
+                 const std::vector<std::string> &workerArgs = {},
+                 const std::string &executable = {});
+  ~RestWorkerPool();
+  RestWorkerPool(const RestWorkerPool &) = delete;
+  RestWorkerPool &operator=(const RestWorkerPool &) = delete;
+
+  /// @brief Execute the job request `requestBody` on a worker and return its
+  /// response. Blocks while the job is queued.
+  nlohmann::json submit(const std::string &requestBody);
+
+  /// @brief Return the pool metrics: the number of workers, busy workers and
+  /// queued requests, as well as request and worker restart counters.
+  nlohmann::json getMetrics() const;
+
+  /// @brief Return the number of requests that can be in flight at once, i.e.,
+  /// executing or queued.
+  std::size_t getCapacity() const {
+    return workers.size() + maxQueuedRequests;
+  }
+
+private:
+  struct Worker {
+    int pid = -1;
+    std::string url;
+    std::unique_ptr<RestClient> client;
+    bool busy = false;
+  };
+
+  void launch(Worker &worker);
+  void terminate(Worker &worker);
+  std::optional<std::size_t>
+  acquire(const std::optional<std::string> &codeHash);
+  void release(std::size_t workerIdx, bool failed);
+
+  std::string executable;
+  std::vector<std::string> workerArgs;
+  std::vector<Worker> workers;
+  std::size_t maxQueuedRequests;
+
+  mutable std::mutex mutex;
+  std::condition_variable workerReleased;
+  std::size_t numBusyWorkers = 0;
+  std::size_t numQueuedRequests = 0;
+  std::size_t peakQueuedRequests = 0;
+  std::size_t numCompletedRequests = 0;
+  std::size_t numFailedRequests = 0;
+  std::size_t numRejectedRequests = 0;
+  std::size_t numWorkerRestarts = 0;
+  // Worker that last cached each kernel module.
+  std::unordered_map<std::string, std::size_t> codeHashWorkers;
+};
+} // namespace cudaq
@@ -35,7 +35,8 @@ struct cudaq::RestServer::impl {
   crow::SimpleApp app;
 };
 
-cudaq::RestServer::RestServer(int port, const std::string &name) {
+cudaq::RestServer::RestServer(int port, const std::string &name,
+                              unsigned int numThreads) {
   m_impl = std::make_unique<impl>();
   m_impl->app.port(port);
   m_impl->app.server_name(name);
@@ -45,8 +46,10 @@ cudaq::RestServer::RestServer(int port, const std::string &name) {
   // susceptible to corruption if the app is shut down right after handling a
   // request.
   m_impl->app.stream_threshold(0);
-  // Note: don't enable multi-threading (`m_impl->app.multithreaded()`) since
-  // we're handling requests sequentially.
+  // Note: only enable multi-threading when asked for, since the job request
+  // handler of a single server process handles requests sequentially.
+  if (numThreads > 1)
+    m_impl->app.concurrency(numThreads);
 }
 void cudaq::RestServer::start() { m_impl->app.run(); }
 void cudaq::RestServer::stop() { m_impl->app.stop(); }
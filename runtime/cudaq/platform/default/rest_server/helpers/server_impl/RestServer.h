@@ -27,8 +27,10 @@ public:
       const std::string &,
       const std::unordered_multimap<std::string, std::string> &)>;
   enum class Method { GET, POST };
-  // Create a REST server serving at a specific port.
-  RestServer(int port, const std::string &name = "cudaq");
+  // Create a REST server serving at a specific port. Requests are handled by
+  // `numThreads` threads, i.e., sequentially by default.
+  RestServer(int port, const std::string &name = "cudaq",
+             unsigned int numThreads = 1);
   // Add a route (endpoint) handler.
   void addRoute(Method routeMethod, const char *route, RouteHandler handler);
   // Start the server.
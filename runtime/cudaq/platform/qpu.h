@@ -10,6 +10,7 @@
 
 #include "QuantumExecutionQueue.h"
 #include "common/Logger.h"
+#include "common/MeasurementGrouping.h"
 #include "common/Registry.h"
 #include "common/ThunkInterface.h"
 #include "common/Timing.h"
@@ -86,18 +87,34 @@ protected:
         localContext->result = data;
       } else {
 
-        // Loop over each term and compute coeff * <term>
-        for (const auto &term : H) {
+        for (const auto &term : H)
           if (term.is_identity())
             sum += term.evaluate_coefficient().real();
-          else {
+
+        // Loop over each set of qubit-wise commuting terms, measure all of
+        // them with a single change of basis and compute coeff * <term>
+        for (const auto &group : cudaq::groupCommutingTerms(H)) {
+          if (group.terms.size() == 1) {
             // This takes a longer time for the first iteration unless
             // flushGateQueue() is called above.
+            const auto &term = group.terms.front();
             auto [exp, data] = cudaq::measure(term);
             results.emplace_back(data.to_map(), term.get_term_id(), exp);
             sum += term.evaluate_coefficient().real() * exp;
+            continue;
+          }
+
+          auto groupOp = cudaq::spin_op::empty();
+          for (const auto &term : group.terms)
+            groupOp += term;
+          auto [groupExp, data] = cudaq::measure(groupOp);
+          for (const auto &term : group.terms) {
+            auto termId = term.get_term_id();
+            auto exp = data.expectation(termId);
+            results.emplace_back(data.to_map(termId), termId, exp);
+            sum += term.evaluate_coefficient().real() * exp;
           }
-        };
+        }
 
         localContext->expectationValue = sum;
         localContext->result = cudaq::sample_result(sum, results);
@@ -81,6 +81,35 @@ public:
                                   std::complex<double> coeff = 1.,
                                   bool invert_order = false);
 
+  /// @brief Computes the sparse matrix representation of a sum of Pauli
+  /// strings of equal length, given as pairs of coefficient and Pauli string.
+  /// Each Pauli string maps every basis state to a single basis state, so the
+  /// entries of all rows are computed independently (and in parallel) from
+  /// the bit masks of the strings rather than by summing sparse matrices.
+  /// By default, the ordering of the matrix matches the ordering of the Pauli
+  /// strings.
+  static csr_spmatrix to_sparse_matrix(
+      const std::vector<std::pair<std::complex<double>, std::string>> &terms,
+      bool invert_order = false);
+
+  /// @brief Computes the matrix representation of a sum of Pauli strings of
+  /// equal length, given as pairs of coefficient and Pauli string.
+  /// By default, the ordering of the matrix matches the ordering of the Pauli
+  /// strings.
+  static complex_matrix
+  to_matrix(const std::vector<std::pair<std::complex<double>, std::string>>
+                &terms,
+            bool invert_order = false);
+
+  /// @brief Computes `output = H * input` for the sum `H` of Pauli strings of
+  /// equal length, without constructing the matrix of `H`. Both vectors must
+  /// hold `2^n` elements for Pauli strings of length `n`, and are ordered like
+  /// the matrix returned by `to_matrix`.
+  static void
+  apply(const std::vector<std::pair<std::complex<double>, std::string>> &terms,
+        const std::complex<double> *input, std::complex<double> *output,
+        bool invert_order = false);
+
   /// @brief Return the `matrix_handler` as a matrix.
   /// @arg  `dimensions` : A map specifying the number of levels,
   ///                      that is, the dimension of each degree of freedom
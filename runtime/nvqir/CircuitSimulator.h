@@ -8,17 +8,21 @@
 
 #pragma once
 
+#include "GateFusion.h"
+#include "GateQueue.h"
 #include "Gates.h"
 #include "QIRTypes.h"
 #include "common/Environment.h"
 #include "common/Logger.h"
 #include "common/MeasureCounts.h"
+#include "common/MeasurementGrouping.h"
 #include "common/NoiseModel.h"
 #include "common/Timing.h"
 #include "cudaq/host_config.h"
+#include <array>
 #include <cstdarg>
 #include <cstddef>
-#include <queue>
+#include <span>
 #include <sstream>
 #include <string>
 #include <variant>
@@ -455,11 +459,12 @@ protected:
   /// matrix describing the quantum operation, a set of
   /// possible control qubit indices, and a set of target indices.
   struct GateApplicationTask {
-    const std::string operationName;
-    const std::vector<std::complex<ScalarType>> matrix;
-    const std::vector<std::size_t> controls;
-    const std::vector<std::size_t> targets;
-    const std::vector<ScalarType> parameters;
+    std::string operationName;
+    std::vector<std::complex<ScalarType>> matrix;
+    std::vector<std::size_t> controls;
+    std::vector<std::size_t> targets;
+    std::vector<ScalarType> parameters;
+    GateApplicationTask() = default;
     GateApplicationTask(const std::string &name,
                         const std::vector<std::complex<ScalarType>> &m,
                         const std::vector<std::size_t> &c,
@@ -467,10 +472,76 @@ protected:
                         const std::vector<ScalarType> &params)
         : operationName(name), matrix(m), controls(c), targets(t),
           parameters(params) {}
+
+    /// @brief Overwrite this task in place. The members keep their storage,
+    /// so this does not allocate when a previous task was at least as large
+    /// (gate names of builtin operations fit the small string buffer).
+    void assign(std::string_view name,
+                std::span<const std::complex<ScalarType>> m,
+                std::span<const std::size_t> c, std::span<const std::size_t> t,
+                std::span<const ScalarType> params) {
+      operationName.assign(name);
+      matrix.assign(m.begin(), m.end());
+      controls.assign(c.begin(), c.end());
+      targets.assign(t.begin(), t.end());
+      parameters.assign(params.begin(), params.end());
+    }
   };
 
   /// @brief The current queue of operations to execute
-  std::queue<GateApplicationTask> gateQueue;
+  GateQueue<GateApplicationTask> gateQueue;
+
+  /// @brief Scratch queue used by gate fusion, retained to reuse its storage.
+  GateQueue<GateApplicationTask> fusedGateQueue;
+
+  /// @brief The maximum number of qubits a fused gate may act on. Gate fusion
+  /// is disabled if this is less than 2. Subtypes opt in by setting it.
+  std::size_t gateFusionMaxQubits = 0;
+
+  /// @brief Only fuse gates once the state has at least this many qubits.
+  /// Below that, the state fits in cache and sweeping it is cheap.
+  std::size_t gateFusionMinStateQubits = 14;
+
+  /// @brief Environment variable name that allows a programmer to
+  /// specify the maximum number of qubits for gate fusion.
+  static constexpr const char fusionMaxQubitsEnvVar[] =
+      "CUDAQ_FUSION_MAX_QUBITS";
+
+  /// @brief Environment variable name that allows a programmer to turn off
+  /// shot branching, see `cudaq::ExecutionContext::shotBranching`.
+  static constexpr const char shotBranchingEnvVar[] = "CUDAQ_SHOT_BRANCHING";
+
+  /// @brief Name of the execution context computing the gradient of an
+  /// expectation value with the adjoint method.
+  static constexpr const char adjointGradientContextName[] =
+      "adjoint-gradient";
+
+  /// @brief The gates applied under the "adjoint-gradient" context, before
+  /// gate fusion, and whether the tape is still valid (no measurement or
+  /// reset).
+  std::vector<GateApplicationTask> gradientTape;
+  bool recordingGradientTape = false;
+  bool gradientTapeValid = false;
+
+  /// @brief Stop the adjoint gradient computation for the current context,
+  /// e.g., because the kernel measures or resets a qubit.
+  void invalidateGradientTape() {
+    if (recordingGradientTape)
+      cudaq::info("The adjoint gradient does not support measurements or "
+                  "resets in the kernel.");
+    gradientTapeValid = false;
+  }
+
+  /// @brief Given the final state of the gates recorded in `gradientTape`,
+  /// compute the expectation value of `executionContext->spin` and its
+  /// derivatives with respect to the gate parameters (see
+  /// `cudaq::ExecutionContext::gateParameterGradient`). Return false if the
+  /// simulator does not support the adjoint method.
+  virtual bool computeAdjointGradient() { return false; }
+
+  /// @brief The number of measurements of the current shot-branching
+  /// execution, i.e., the position in `executionContext->branchOutcomes`.
+  std::size_t numBranchMeasurements = 0;
 
   /// @brief Get the name of the current circuit being executed.
   std::string getCircuitName() const { return currentCircuitName; }
@@ -481,7 +552,9 @@ protected:
     if (!executionContext)
       return 1;
     if (executionContext->hasConditionalsOnMeasureResults)
-      return 1;
+      return isShotBranching()
+                 ? static_cast<int>(executionContext->branchShots)
+                 : 1;
     if (executionContext->explicitMeasurements && !supportsBufferedSample)
       return 1;
     return static_cast<int>(executionContext->shots);
@@ -512,6 +585,69 @@ protected:
   /// left as a task for concrete subtypes.
   virtual bool measureQubit(const std::size_t qubitIdx) = 0;
 
+  /// @brief Return true if this simulator implements `probabilityOfOne`,
+  /// `collapseQubit` and `sampleNumOnes`, so that the shots of kernels with
+  /// conditional feedback can be branched at each measurement.
+  virtual bool supportsShotBranching() const { return false; }
+
+  /// @brief Return the probability of measuring the qubit in the |1> state.
+  virtual double probabilityOfOne(const std::size_t qubitIdx) {
+    throw std::runtime_error("Shot branching is not supported by this "
+                             "simulator backend.");
+  }
+
+  /// @brief Project the qubit onto the given measurement `outcome`, which has
+  /// the given probability, and renormalize the state.
+  virtual void collapseQubit(const std::size_t qubitIdx, bool outcome,
+                             double probability) {
+    throw std::runtime_error("Shot branching is not supported by this "
+                             "simulator backend.");
+  }
+
+  /// @brief Return how many of `shots` measurements with probability
+  /// `probOne` of measuring one do so, i.e., a binomial sample drawn with the
+  /// simulator's random number generator.
+  virtual std::size_t sampleNumOnes(std::size_t shots, double probOne) {
+    throw std::runtime_error("Shot branching is not supported by this "
+                             "simulator backend.");
+  }
+
+  /// @brief Return true if the shots of the current sampling task are
+  /// branched at each measurement.
+  bool isShotBranching() const {
+    return executionContext && executionContext->name == "sample" &&
+           executionContext->hasConditionalsOnMeasureResults &&
+           executionContext->shotBranching;
+  }
+
+  /// @brief Measure the qubit on the current branch of a shot-branching
+  /// sampling task. If the measurement is already on the branch, collapse the
+  /// qubit to the recorded outcome. Otherwise, split the shots of the branch
+  /// between the two outcomes, continue with the outcome that got more shots
+  /// and leave the other one as a pending branch.
+  bool measureShotBranch(const std::size_t qubitIdx) {
+    auto &ctx = *executionContext;
+    const double probOne = probabilityOfOne(qubitIdx);
+    const auto k = numBranchMeasurements++;
+    if (k == ctx.branchOutcomes.size()) {
+      const auto numOnes = sampleNumOnes(ctx.branchShots, probOne);
+      const bool outcome = 2 * numOnes >= ctx.branchShots;
+      const auto otherShots = outcome ? ctx.branchShots - numOnes : numOnes;
+      if (otherShots > 0) {
+        auto otherOutcomes = ctx.branchOutcomes;
+        otherOutcomes.push_back(!outcome);
+        ctx.pendingBranches.emplace_back(std::move(otherOutcomes), otherShots);
+      }
+      ctx.branchOutcomes.push_back(outcome);
+      ctx.branchShots -= otherShots;
+    }
+    const bool outcome = ctx.branchOutcomes[k];
+    collapseQubit(qubitIdx, outcome, outcome ? probOne : 1. - probOne);
+    cudaq::info("Measured qubit {} -> {} on a branch of {} shots", qubitIdx,
+                outcome, ctx.branchShots);
+    return outcome;
+  }
+
   /// @brief Return true if this CircuitSimulator can
   /// handle <psi | H | psi> instead of NVQIR applying measure
   /// basis quantum gates to change to the Z basis and sample.
@@ -623,9 +759,9 @@ protected:
   /// @brief Utility function that returns a string-view of the current
   /// quantum instruction, intended for logging purposes.
   std::string gateToString(const std::string_view gateName,
-                           const std::vector<std::size_t> &controls,
-                           const std::vector<ScalarType> &parameters,
-                           const std::vector<std::size_t> &targets) {
+                           std::span<const std::size_t> controls,
+                           std::span<const ScalarType> parameters,
+                           std::span<const std::size_t> targets) {
     std::string angleStr = "";
     if (!parameters.empty()) {
       angleStr = std::to_string(parameters[0]);
@@ -768,12 +904,14 @@ protected:
     registerNameToMeasuredQubit.clear();
   }
 
-  /// @brief Add a new gate application task to the queue
-  void enqueueGate(const std::string name,
-                   const std::vector<std::complex<ScalarType>> &matrix,
-                   const std::vector<std::size_t> &controls,
-                   const std::vector<std::size_t> &targets,
-                   const std::vector<ScalarType> &params) {
+  /// @brief Add a new gate application task to the queue. The task data is
+  /// copied into a pooled queue slot, so this does not allocate in steady
+  /// state.
+  void enqueueGate(const std::string_view name,
+                   std::span<const std::complex<ScalarType>> matrix,
+                   std::span<const std::size_t> controls,
+                   std::span<const std::size_t> targets,
+                   std::span<const ScalarType> params) {
     if (isInTracerMode()) {
       std::vector<cudaq::QuditInfo> controlsInfo, targetsInfo;
       for (auto &c : controls)
@@ -781,13 +919,7 @@ protected:
       for (auto &t : targets)
         targetsInfo.emplace_back(2, t);
 
-      std::vector<double> anglesProcessed;
-      if constexpr (std::is_same_v<ScalarType, double>)
-        anglesProcessed = params;
-      else {
-        for (auto &a : params)
-          anglesProcessed.push_back(static_cast<ScalarType>(a));
-      }
+      std::vector<double> anglesProcessed(params.begin(), params.end());
 
       executionContext->kernelTrace.appendInstruction(
           name, anglesProcessed, controlsInfo, targetsInfo);
@@ -807,6 +939,14 @@ protected:
       cudaq::log("{}: matrix={}, controls={}, targets={}, params={}", name,
                  matrix, controls, targets, params);
 
+    if (recordingGradientTape)
+      gradientTape.emplace_back(
+          std::string(name),
+          std::vector<std::complex<ScalarType>>(matrix.begin(), matrix.end()),
+          std::vector<std::size_t>(controls.begin(), controls.end()),
+          std::vector<std::size_t>(targets.begin(), targets.end()),
+          std::vector<ScalarType>(params.begin(), params.end()));
+
     gateQueue.emplace(name, matrix, controls, targets, params);
   }
 
@@ -826,9 +966,87 @@ protected:
                                  const std::vector<std::size_t> &targets,
                                  const std::vector<double> &params) {}
 
+  /// @brief Return true if the given queued gate triggers noise channels under
+  /// the current noise model, in which case it must not be fused with any
+  /// subsequent gates.
+  bool hasNoiseChannels(const GateApplicationTask &task) {
+    if (!executionContext || !executionContext->noiseModel)
+      return false;
+    std::vector<double> params(task.parameters.begin(), task.parameters.end());
+    return !executionContext->noiseModel
+                ->get_channels(task.operationName, task.targets, task.controls,
+                               params)
+                .empty();
+  }
+
+  /// @brief Merge runs of queued gates acting on at most `gateFusionMaxQubits`
+  /// qubits into a single dense gate, so that the state is swept once per run
+  /// rather than once per gate. The queue only ever holds unitary operations,
+  /// measurements and resets flush it, so those act as natural barriers. Gates
+  /// with noise channels attached are never fused so that the noise is applied
+  /// at the right point of the circuit.
+  void fuseGateQueue() {
+    if (gateFusionMaxQubits < 2 || gateQueue.size() < 2 ||
+        nQubitsAllocated < gateFusionMinStateQubits)
+      return;
+
+    // The fused queue is built in a separate pooled queue. The fusion block
+    // references the matrices of the tasks of the current run, which stay in
+    // `gateQueue` untouched until the queues are swapped.
+    fusedGateQueue.clear();
+    GateFusionBlock<ScalarType> block;
+    const bool msbOrdering = getQubitOrdering() == QubitOrdering::msb;
+    std::size_t numFused = 0;
+    // Index in `gateQueue` of the first gate of the current run.
+    std::size_t runStart = 0;
+
+    const auto emitTask = [&](GateApplicationTask &task) {
+      fusedGateQueue.emplace(task.operationName, task.matrix, task.controls,
+                             task.targets, task.parameters);
+    };
+    const auto emitBlock = [&]() {
+      if (block.size() == 1) {
+        emitTask(gateQueue[runStart]);
+      } else if (!block.empty()) {
+        numFused += block.size();
+        fusedGateQueue.emplace(fusedGateName, block.getMatrix(msbOrdering),
+                               std::span<const std::size_t>{},
+                               block.getQubits(),
+                               std::span<const ScalarType>{});
+      }
+      block.clear();
+    };
+
+    for (std::size_t i = 0; i < gateQueue.size(); ++i) {
+      auto &next = gateQueue[i];
+      const bool tooWide =
+          next.controls.size() + next.targets.size() > gateFusionMaxQubits;
+      if (tooWide || hasNoiseChannels(next)) {
+        // Applied on its own, so that any noise channels still follow it.
+        emitBlock();
+        emitTask(next);
+      } else {
+        if (!block.canAdd(next.controls, next.targets, gateFusionMaxQubits))
+          emitBlock();
+        if (block.empty())
+          runStart = i;
+        block.add(next.matrix, next.controls, next.targets);
+      }
+    }
+    emitBlock();
+
+    if (numFused > 0)
+      cudaq::info("[{}] fused {} gates, {} gate applications remaining.",
+                  name(), numFused, fusedGateQueue.size());
+    std::swap(gateQueue, fusedGateQueue);
+    fusedGateQueue.clear();
+  }
+
   /// @brief Flush the gate queue, run all queued gate
   /// application tasks.
   void flushGateQueueImpl() override {
+    if (isStateVectorSimulator())
+      fuseGateQueue();
     while (!gateQueue.empty()) {
       auto &next = gateQueue.front();
       if (isStateVectorSimulator() && summaryData.enabled)
@@ -838,13 +1056,11 @@ protected:
       try {
         applyGate(next);
       } catch (std::exception &e) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
+        gateQueue.clear();
         throw std::runtime_error(std::string("Exception in applyGate: ") +
                                  e.what());
       } catch (...) {
-        while (!gateQueue.empty())
-          gateQueue.pop();
+        gateQueue.clear();
         throw std::runtime_error("Unknown exception in applyGate");
       }
       if (executionContext && executionContext->noiseModel) {
@@ -881,6 +1097,72 @@ protected:
   /// @brief Return this simulator's qubit ordering.
   virtual QubitOrdering getQubitOrdering() const { return QubitOrdering::lsb; }
 
+  /// @brief Measure a sum of qubit-wise commuting spin operators with a single
+  /// change of basis (and, with shots, a single sampling of the state). The
+  /// result of each term is stored under its term id, the expectation value
+  /// is the weighted sum over all terms.
+  void measureCommutingTerms(const cudaq::spin_op &op) {
+    auto groups =
+        cudaq::groupCommutingTerms(op, cudaq::GroupingStrategy::greedy);
+    if (groups.size() > 1)
+      // more than one basis needs to be directly supported by the backend
+      throw std::runtime_error("measuring a sum of spin operators that do not "
+                               "commute qubit-wise is not supported");
+
+    cudaq::info("Measure {}", op.to_string());
+    std::vector<cudaq::ExecutionResult> results;
+    if (!groups.empty()) {
+      const auto &group = groups.front();
+      const auto qubitsToMeasure = group.measuredQubits();
+      const auto changeBasis = [&](bool reverse) {
+        for (auto target : qubitsToMeasure)
+          if (group.basis[target] == 'X')
+            h(target);
+          else if (group.basis[target] == 'Y')
+            rx(!reverse ? M_PI_2 : -M_PI_2, target);
+        flushGateQueue();
+      };
+
+      changeBasis(false);
+      // As in `measureSpinOp`, the shots are converted to an int, so that the
+      // "no shots" value (-1 as a size_t) selects the exact computation.
+      int shots = 0;
+      if (executionContext->shots > 0)
+        shots = executionContext->shots;
+      if (shots >= 1) {
+        results = cudaq::expandGroupResult(group,
+                                           sample(qubitsToMeasure, shots));
+      } else {
+        // Without shots, the <Z...Z> value of each term is computed exactly.
+        for (const auto &term : group.terms) {
+          std::vector<std::size_t> termQubits;
+          for (const auto &p : term)
+            if (p.as_pauli() != cudaq::pauli::I)
+              termQubits.push_back(p.target());
+          std::sort(termQubits.begin(), termQubits.end());
+          auto termResult = sample(termQubits, 0);
+          results.emplace_back(cudaq::CountsDictionary{}, term.get_term_id(),
+                               termResult.expectationValue.value_or(0.0));
+        }
+      }
+      // Restore the state.
+      changeBasis(true);
+    }
+
+    std::unordered_map<std::string, double> termExpVals;
+    for (const auto &result : results)
+      termExpVals.emplace(result.registerName,
+                          result.expectationValue.value_or(0.0));
+    double sum = 0.0;
+    for (const auto &term : op) {
+      auto coeff = term.evaluate_coefficient().real();
+      sum += term.is_identity() ? coeff
+                                : coeff * termExpVals.at(term.get_term_id());
+    }
+    executionContext->expectationValue = sum;
+    executionContext->result = cudaq::sample_result(sum, results);
+  }
+
 public:
   /// @brief The constructor
   CircuitSimulatorBase() = default;
@@ -1070,8 +1352,7 @@ public:
       cudaq::info("Deallocated all qubits, reseting state vector.");
       // all qubits deallocated,
       deallocateState();
-      while (!gateQueue.empty())
-        gateQueue.pop();
+      gateQueue.clear();
     }
   }
 
@@ -1133,7 +1414,9 @@ public:
       // Flush any queued up sampling tasks
       flushAnySamplingTasks(/*force this*/ true);
 
-      // Handle the processing for any mid circuit measurements
+      // Handle the processing for any mid circuit measurements, which are
+      // shared by all the shots of this execution
+      const std::size_t numShots = getNumShotsToExec();
       for (auto &m : midCircuitSampleResults) {
         // Get the register name and the vector of bit results
         auto regName = m.first;
@@ -1147,12 +1430,12 @@ public:
           for (std::size_t j = 0; j < bitResults.size(); j++)
             bitStr += bitResults[j];
 
-          counts.appendResult(bitStr, 1);
+          counts.appendResult(bitStr, numShots);
 
         } else {
           // Not a vector, collate all bits into a 1 qubit counts dict
           for (std::size_t j = 0; j < bitResults.size(); j++) {
-            counts.appendResult(bitResults[j], 1);
+            counts.appendResult(bitResults[j], numShots);
           }
         }
         executionContext->result.append(counts);
@@ -1173,6 +1456,33 @@ public:
       currentCircuitName = "";
     }
 
+    if (recordingGradientTape) {
+      flushGateQueue();
+      if (gradientTapeValid && executionContext->spin &&
+          !executionContext->noiseModel) {
+        if (computeAdjointGradient()) {
+          // Expose the gate tape, whose parameters are differentiated.
+          for (const auto &task : gradientTape) {
+            std::vector<cudaq::QuditInfo> controlsInfo, targetsInfo;
+            for (auto c : task.controls)
+              controlsInfo.emplace_back(2, c);
+            for (auto t : task.targets)
+              targetsInfo.emplace_back(2, t);
+            executionContext->kernelTrace.appendInstruction(
+                task.operationName,
+                std::vector<double>(task.parameters.begin(),
+                                    task.parameters.end()),
+                controlsInfo, targetsInfo);
+          }
+        } else {
+          cudaq::info("The adjoint gradient is not supported by this "
+                      "simulator backend.");
+        }
+      }
+      recordingGradientTape = false;
+      gradientTape.clear();
+    }
+
     // Set the state data if requested.
     if (executionContext->name == "extract-state") {
       flushGateQueue();
@@ -1210,6 +1520,18 @@ public:
     executionContext->canHandleObserve = canHandleObserve();
     currentCircuitName = context->kernelName;
     cudaq::info("Setting current circuit name to {}", currentCircuitName);
+    numBranchMeasurements = 0;
+    recordingGradientTape = gradientTapeValid =
+        context->name == adjointGradientContextName;
+    gradientTape.clear();
+    // Shot branching needs the noise-free, pure state evolution to be shared by
+    // all the shots of a branch.
+    if (context->shotBranching &&
+        (!supportsShotBranching() || context->noiseModel ||
+         !cudaq::getEnvBool(shotBranchingEnvVar, true))) {
+      cudaq::info("Shot branching not available, executing shot by shot.");
+      context->shotBranching = false;
+    }
   }
 
   /// @brief Return the current execution context
@@ -1225,8 +1547,22 @@ public:
     flushAnySamplingTasks();
     auto numRows = std::sqrt(matrix.size());
     auto numQubits = std::log2(numRows);
+    const std::string_view opName =
+        customName.empty() ? std::string_view("unknown op") : customName;
+    const bool reorder =
+        numQubits > 1 && getQubitOrdering() != QubitOrdering::msb;
+    if constexpr (std::is_same_v<double, ScalarType>) {
+      // No conversion needed, enqueue the matrix data as is.
+      if (!reorder) {
+        if (cudaq::details::should_log(cudaq::details::LogLevel::info))
+          cudaq::info(gateToString(opName, controls, {}, targets) + " = {}",
+                      matrix);
+        enqueueGate(opName, matrix, controls, targets, {});
+        return;
+      }
+    }
     std::vector<std::complex<ScalarType>> actual;
-    if (numQubits > 1 && getQubitOrdering() != QubitOrdering::msb) {
+    if (reorder) {
       // Convert the matrix to LSB qubit ordering
       auto convertOrdering = [](std::size_t numQubits, std::size_t idx) {
         std::size_t newIdx = 0;
@@ -1262,25 +1598,27 @@ public:
                      });
     }
     if (cudaq::details::should_log(cudaq::details::LogLevel::info))
-      cudaq::info(gateToString(customName.empty() ? "unknown op" : customName,
-                               controls, {}, targets) +
-                      " = {}",
+      cudaq::info(gateToString(opName, controls, {}, targets) + " = {}",
                   matrix);
-    enqueueGate(customName.empty() ? "unknown op" : customName.data(), actual,
-                controls, targets, {});
+    enqueueGate(opName, actual, controls, targets, {});
   }
 
+  /// @brief Enqueue a builtin single-target operation. The gate matrix is
+  /// generated on the stack and the operands are only viewed, so nothing is
+  /// allocated on this (hot) path besides the pooled queue slot.
   template <typename QuantumOperation>
-  void enqueueQuantumOperation(const std::vector<ScalarType> &angles,
-                               const std::vector<std::size_t> &controls,
-                               const std::vector<std::size_t> &targets) {
+  void enqueueQuantumOperation(std::span<const ScalarType> angles,
+                               std::span<const std::size_t> controls,
+                               std::span<const std::size_t> targets) {
     flushAnySamplingTasks();
     QuantumOperation gate;
     // This is a very hot section of code. Don't form the log string unless
     // we're actually going to use it.
     if (cudaq::details::should_log(cudaq::details::LogLevel::info))
       cudaq::info(gateToString(gate.name(), controls, angles, targets));
-    enqueueGate(gate.name(), gate.getGate(angles), controls, targets, angles);
+    const auto matrix =
+        getGateMatrixByName<ScalarType>(QuantumOperation::kind, angles);
+    enqueueGate(gate.name(), matrix, controls, targets, angles);
   }
 
 #define CIRCUIT_SIMULATOR_ONE_QUBIT(NAME)                                      \
@@ -1288,16 +1626,17 @@ public:
   void NAME(const std::vector<std::size_t> &controls,                          \
             const std::size_t qubitIdx) override {                             \
     enqueueQuantumOperation<nvqir::NAME<ScalarType>>(                          \
-        {}, controls, std::vector<std::size_t>{qubitIdx});                     \
+        {}, controls, std::span<const std::size_t>(&qubitIdx, 1));             \
   }
 
 #define CIRCUIT_SIMULATOR_ONE_QUBIT_ONE_PARAM(NAME)                            \
   using CircuitSimulator::NAME;                                                \
   void NAME(const double angle, const std::vector<std::size_t> &controls,      \
             const std::size_t qubitIdx) override {                             \
+    const ScalarType param = static_cast<ScalarType>(angle);                   \
     enqueueQuantumOperation<nvqir::NAME<ScalarType>>(                          \
-        {static_cast<ScalarType>(angle)}, controls,                            \
-        std::vector<std::size_t>{qubitIdx});                                   \
+        std::span<const ScalarType>(&param, 1), controls,                      \
+        std::span<const std::size_t>(&qubitIdx, 1));                           \
   }
 
   /// @brief The X gate
@@ -1335,32 +1674,31 @@ public:
   void u2(const double phi, const double lambda,
           const std::vector<std::size_t> &controls,
           const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
-
+    const std::array<ScalarType, 2> tmp{static_cast<ScalarType>(phi),
+                                        static_cast<ScalarType>(lambda)};
     enqueueQuantumOperation<nvqir::u2<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+        tmp, controls, std::span<const std::size_t>(&qubitIdx, 1));
   }
 
   using CircuitSimulator::u3;
   void u3(const double theta, const double phi, const double lambda,
           const std::vector<std::size_t> &controls,
           const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(theta),
-                                static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
+    const std::array<ScalarType, 3> tmp{static_cast<ScalarType>(theta),
+                                        static_cast<ScalarType>(phi),
+                                        static_cast<ScalarType>(lambda)};
     enqueueQuantumOperation<nvqir::u3<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+        tmp, controls, std::span<const std::size_t>(&qubitIdx, 1));
   }
 
   using CircuitSimulator::phased_rx;
   void phased_rx(const double phi, const double lambda,
                  const std::vector<std::size_t> &controls,
                  const std::size_t qubitIdx) override {
-    std::vector<ScalarType> tmp{static_cast<ScalarType>(phi),
-                                static_cast<ScalarType>(lambda)};
+    const std::array<ScalarType, 2> tmp{static_cast<ScalarType>(phi),
+                                        static_cast<ScalarType>(lambda)};
     enqueueQuantumOperation<nvqir::phased_rx<ScalarType>>(
-        tmp, controls, std::vector<std::size_t>{qubitIdx});
+        tmp, controls, std::span<const std::size_t>(&qubitIdx, 1));
   }
 
   using CircuitSimulator::swap;
@@ -1368,13 +1706,14 @@ public:
   void swap(const std::vector<std::size_t> &ctrlBits, const std::size_t srcIdx,
             const std::size_t tgtIdx) override {
     flushAnySamplingTasks();
-    cudaq::info(gateToString("swap", ctrlBits, {}, {srcIdx, tgtIdx}));
-    std::vector<std::complex<ScalarType>> matrix{
+    const std::array<std::size_t, 2> targets{srcIdx, tgtIdx};
+    if (cudaq::details::should_log(cudaq::details::LogLevel::info))
+      cudaq::info(gateToString("swap", ctrlBits, {}, targets));
+    static constexpr std::array<std::complex<ScalarType>, 16> matrix{{
         {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0},
         {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0},
-        {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}};
-    enqueueGate("swap", matrix, ctrlBits,
-                std::vector<std::size_t>{srcIdx, tgtIdx}, {});
+        {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {1.0, 0.0}}};
+    enqueueGate("swap", matrix, ctrlBits, targets, {});
   }
 
   bool mz(const std::size_t qubitIdx) override { return mz(qubitIdx, ""); }
@@ -1405,8 +1744,12 @@ public:
     if (isInTracerMode())
       return true;
 
-    // Get the actual measurement from the subtype measureQubit implementation
-    auto measureResult = measureQubit(qubitIdx);
+    invalidateGradientTape();
+
+    // Get the actual measurement from the subtype measureQubit implementation,
+    // or follow the current branch if branching the shots
+    auto measureResult = isShotBranching() ? measureShotBranch(qubitIdx)
+                                           : measureQubit(qubitIdx);
     auto bitResult = measureResult == true ? "1" : "0";
 
     // If this CUDA-Q kernel has conditional statements on measure results
@@ -1430,10 +1773,10 @@ public:
       return;
     }
 
-    if (op.num_terms() != 1)
-      // more than one term needs to be directly supported by the backend
-      throw std::runtime_error(
-          "measuring a sum of spin operators is not supported");
+    if (op.num_terms() != 1) {
+      measureCommutingTerms(op);
+      return;
+    }
 
     cudaq::info("Measure {}", op.to_string());
     std::vector<std::size_t> qubitsToMeasure;
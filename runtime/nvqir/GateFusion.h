@@ -0,0 +1,184 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief Name given to the gate application tasks produced by gate fusion.
+static constexpr const char fusedGateName[] = "fused";
+
+/// @brief Return the qubit index bit of a gate matrix row/column index `idx`
+/// that corresponds to the `i`-th of `numQubits` gate targets. If
+/// `msbOrdering` is set, the first target is the most significant bit of the
+/// matrix index (Q++ convention), else it is the least significant bit.
+inline std::size_t gateMatrixBit(std::size_t idx, std::size_t i,
+                                 std::size_t numQubits, bool msbOrdering) {
+  return msbOrdering ? (idx >> (numQubits - 1 - i)) & 1ULL : (idx >> i) & 1ULL;
+}
+
+/// @brief Left-multiply the dense, row-major `2^numQubits x 2^numQubits`
+/// matrix `fused` by the (possibly controlled) gate `gate`. The `controls` and
+/// `targets` are positions in the local `numQubits`-qubit register, where local
+/// qubit `j` is bit `j` of a row/column index of `fused`. The ordering of the
+/// gate matrix with respect to its `targets` is given by `msbOrdering`.
+template <typename ScalarType>
+void applyGateToFusedMatrix(std::vector<std::complex<ScalarType>> &fused,
+                            std::size_t numQubits,
+                            const std::vector<std::complex<ScalarType>> &gate,
+                            const std::vector<std::size_t> &controls,
+                            const std::vector<std::size_t> &targets,
+                            bool msbOrdering) {
+  const std::size_t dim = 1ULL << numQubits;
+  const std::size_t nTargets = targets.size();
+  const std::size_t gateDim = 1ULL << nTargets;
+  assert(fused.size() == dim * dim && "Invalid fused matrix size");
+  assert(gate.size() == gateDim * gateDim && "Invalid gate matrix size");
+
+  std::size_t controlMask = 0;
+  for (auto c : controls)
+    controlMask |= (1ULL << c);
+  std::size_t targetMask = 0;
+  for (auto t : targets)
+    targetMask |= (1ULL << t);
+
+  // Row index (in the local register) of every gate basis state, relative to
+  // a base index with all target bits cleared.
+  std::vector<std::size_t> offsets(gateDim, 0);
+  for (std::size_t r = 0; r < gateDim; ++r)
+    for (std::size_t i = 0; i < nTargets; ++i)
+      if (gateMatrixBit(r, i, nTargets, msbOrdering))
+        offsets[r] |= (1ULL << targets[i]);
+
+  std::vector<std::complex<ScalarType>> in(gateDim), out(gateDim);
+  for (std::size_t base = 0; base < dim; ++base) {
+    if ((base & targetMask) || (base & controlMask) != controlMask)
+      continue;
+    for (std::size_t col = 0; col < dim; ++col) {
+      for (std::size_t r = 0; r < gateDim; ++r)
+        in[r] = fused[(base | offsets[r]) * dim + col];
+      for (std::size_t r = 0; r < gateDim; ++r) {
+        std::complex<ScalarType> sum = 0.;
+        for (std::size_t s = 0; s < gateDim; ++s)
+          sum += gate[r * gateDim + s] * in[s];
+        out[r] = sum;
+      }
+      for (std::size_t r = 0; r < gateDim; ++r)
+        fused[(base | offsets[r]) * dim + col] = out[r];
+    }
+  }
+}
+
+/// @brief Accumulates a run of gates into a single dense unitary acting on
+/// the union of their qubits.
+template <typename ScalarType>
+class GateFusionBlock {
+  /// @brief The gates in this block, in application order.
+  struct Gate {
+    const std::vector<std::complex<ScalarType>> *matrix;
+    std::vector<std::size_t> controls;
+    std::vector<std::size_t> targets;
+  };
+  std::vector<Gate> gates;
+
+  /// @brief The (global) qubit indices this block acts on.
+  std::vector<std::size_t> qubits;
+
+  /// @brief Return the number of qubits the block would act on if a gate on
+  /// the given qubits was added to it.
+  std::size_t unionSize(const std::vector<std::size_t> &controls,
+                        const std::vector<std::size_t> &targets) const {
+    std::size_t count = qubits.size();
+    for (const auto *qs : {&controls, &targets})
+      for (auto q : *qs)
+        if (std::find(qubits.begin(), qubits.end(), q) == qubits.end())
+          ++count;
+    return count;
+  }
+
+  std::size_t localIndex(std::size_t qubit) const {
+    return std::distance(qubits.begin(),
+                         std::find(qubits.begin(), qubits.end(), qubit));
+  }
+
+public:
+  /// @brief Return true if a gate on the given qubits fits into this block
+  /// without exceeding `maxQubits`.
+  bool canAdd(const std::vector<std::size_t> &controls,
+              const std::vector<std::size_t> &targets,
+              std::size_t maxQubits) const {
+    return unionSize(controls, targets) <= maxQubits;
+  }
+
+  /// @brief Append a gate to the block. The matrix data is referenced, not
+  /// copied, and must outlive the call to `getMatrix()`.
+  void add(const std::vector<std::complex<ScalarType>> &matrix,
+           const std::vector<std::size_t> &controls,
+           const std::vector<std::size_t> &targets) {
+    for (const auto *qs : {&controls, &targets})
+      for (auto q : *qs)
+        if (std::find(qubits.begin(), qubits.end(), q) == qubits.end())
+          qubits.push_back(q);
+    gates.push_back({&matrix, controls, targets});
+  }
+
+  std::size_t size() const { return gates.size(); }
+  bool empty() const { return gates.empty(); }
+  const std::vector<std::size_t> &getQubits() const { return qubits; }
+
+  /// @brief Compute the row-major unitary of the block, ordered with respect
+  /// to `getQubits()` according to `msbOrdering`.
+  std::vector<std::complex<ScalarType>> getMatrix(bool msbOrdering) const {
+    const std::size_t numQubits = qubits.size();
+    const std::size_t dim = 1ULL << numQubits;
+    std::vector<std::complex<ScalarType>> fused(dim * dim, 0.);
+    for (std::size_t i = 0; i < dim; ++i)
+      fused[i * dim + i] = 1.;
+
+    for (const auto &gate : gates) {
+      std::vector<std::size_t> localControls, localTargets;
+      for (auto c : gate.controls)
+        localControls.push_back(localIndex(c));
+      for (auto t : gate.targets)
+        localTargets.push_back(localIndex(t));
+      applyGateToFusedMatrix(fused, numQubits, *gate.matrix, localControls,
+                             localTargets, msbOrdering);
+    }
+
+    if (!msbOrdering)
+      return fused;
+
+    // The local register is LSB ordered, reverse the bits of the row and
+    // column indices to match a MSB ordered simulator.
+    const auto reverseBits = [numQubits](std::size_t idx) {
+      std::size_t newIdx = 0;
+      for (std::size_t i = 0; i < numQubits; ++i)
+        if (idx & (1ULL << i))
+          newIdx |= (1ULL << ((numQubits - 1) - i));
+      return newIdx;
+    };
+    std::vector<std::complex<ScalarType>> reordered(dim * dim);
+    for (std::size_t i = 0; i < dim; ++i)
+      for (std::size_t j = 0; j < dim; ++j)
+        reordered[reverseBits(i) * dim + reverseBits(j)] = fused[i * dim + j];
+    return reordered;
+  }
+
+  void clear() {
+    gates.clear();
+    qubits.clear();
+  }
+};
+
+} // namespace nvqir
@@ -0,0 +1,86 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace nvqir {
+
+/// @brief A FIFO queue of gate application tasks backed by a pooled ring
+/// buffer. Popped slots are not destroyed, they keep the storage of their
+/// members and are overwritten in place by later pushes. Once the queue has
+/// reached the depth of a typical flush, enqueuing a gate therefore does not
+/// allocate. `Task` must be default constructible and provide an `assign`
+/// member function taking the arguments given to `emplace`.
+///
+/// Note: growing the buffer moves the queued tasks, so references obtained
+/// from `front()` or `operator[]` are invalidated by `emplace`.
+template <typename Task>
+class GateQueue {
+  /// @brief The pooled task slots, the queued tasks are the `count` slots
+  /// starting at `head`, wrapping around.
+  std::vector<Task> slots;
+  std::size_t head = 0;
+  std::size_t count = 0;
+
+  /// @brief Number of slots allocated on the first push.
+  static constexpr std::size_t initialCapacity = 64;
+
+  void grow() {
+    // Unwrap the queued tasks so that they are contiguous from slot 0, then
+    // append new (empty) slots.
+    std::rotate(slots.begin(), slots.begin() + head, slots.end());
+    head = 0;
+    slots.resize(std::max(initialCapacity, 2 * slots.size()));
+  }
+
+public:
+  bool empty() const { return count == 0; }
+  std::size_t size() const { return count; }
+
+  /// @brief Return the `i`-th queued task, `0` being the front of the queue.
+  Task &operator[](std::size_t i) {
+    assert(i < count && "GateQueue index out of range");
+    return slots[(head + i) % slots.size()];
+  }
+
+  Task &front() { return (*this)[0]; }
+
+  /// @brief Append a task to the back of the queue, reusing the storage of a
+  /// previously popped task when possible.
+  template <typename... Args>
+  Task &emplace(Args &&...args) {
+    if (count == slots.size())
+      grow();
+    auto &slot = slots[(head + count) % slots.size()];
+    slot.assign(std::forward<Args>(args)...);
+    ++count;
+    return slot;
+  }
+
+  /// @brief Remove the task at the front of the queue. Its slot is retained
+  /// for reuse.
+  void pop() {
+    assert(count > 0 && "pop() called on an empty GateQueue");
+    head = (head + 1) % slots.size();
+    --count;
+  }
+
+  /// @brief Remove all queued tasks, retaining the slots for reuse.
+  void clear() {
+    head = 0;
+    count = 0;
+  }
+};
+
+} // namespace nvqir
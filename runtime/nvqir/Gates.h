@@ -17,6 +17,12 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <array>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace nvqir {
@@ -47,96 +53,195 @@ enum class GateName {
   PhasedRx
 };
 
-/// @brief Given the gate name (an element of the GateName enum),
-/// return the matrix data, optionally parameterized by a rotation angle.
+/// @brief Given the gate name (an element of the GateName enum), return the
+/// 2x2 matrix data, optionally parameterized by rotation angles. Unlike
+/// `getGateByName`, this does not allocate and is meant for the gate dispatch
+/// hot path.
 template <typename Scalar>
-std::vector<std::complex<Scalar>>
-getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
+std::array<std::complex<Scalar>, 4>
+getGateMatrixByName(GateName name, std::span<const Scalar> angles = {}) {
   Scalar two = 2.;
   switch (name) {
   case (GateName::X):
-    return {{0., 0.}, {1.0, 0.}, {1.0, 0.0}, {0., 0.}};
+    return {{{0., 0.}, {1.0, 0.}, {1.0, 0.0}, {0., 0.}}};
   case (GateName::Y):
-    return {{0., 0.}, {0.0, -1.0}, {0.0, 1.0}, {0., 0.}};
+    return {{{0., 0.}, {0.0, -1.0}, {0.0, 1.0}, {0., 0.}}};
   case (GateName::Z):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {-1., 0.}};
+    return {{{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {-1., 0.}}};
   case (GateName::H): {
     Scalar oneOverSqrt2 = 1 / std::sqrt(2.);
-    return {oneOverSqrt2, oneOverSqrt2, oneOverSqrt2, -oneOverSqrt2};
+    return {{oneOverSqrt2, oneOverSqrt2, oneOverSqrt2, -oneOverSqrt2}};
   }
   case (GateName::S):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., 1.}};
+    return {{{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., 1.}}};
   case (GateName::Sdg):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., -1.}};
+    return {{{1., 0.}, {0.0, 0.}, {0.0, 0.0}, {0., -1.}}};
   case (GateName::T):
-    return {{1., 0.},
-            {0.0, 0.},
-            {0.0, 0.0},
-            std::exp(im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    return {{{1., 0.},
+             {0.0, 0.},
+             {0.0, 0.0},
+             std::exp(im<Scalar> * static_cast<Scalar>(M_PI_4))}};
   case (GateName::Tdg):
-    return {{1., 0.},
-            {0.0, 0.},
-            {0.0, 0.0},
-            std::exp(-im<Scalar> * static_cast<Scalar>(M_PI_4))};
+    return {{{1., 0.},
+             {0.0, 0.},
+             {0.0, 0.0},
+             std::exp(-im<Scalar> * static_cast<Scalar>(M_PI_4))}};
   case (GateName::Rx): {
     auto angle = angles[0];
-    return {{std::cos(angle / two), 0.},
-            {0., -1 * std::sin(angle / two)},
-            {0, -1 * std::sin(angle / two)},
-            {std::cos(angle / two), 0.}};
+    return {{{std::cos(angle / two), 0.},
+             {0., -1 * std::sin(angle / two)},
+             {0, -1 * std::sin(angle / two)},
+             {std::cos(angle / two), 0.}}};
   }
   case (GateName::Ry): {
     auto angle = angles[0];
-    return {std::cos(angle / two), -std::sin(angle / two),
-            std::sin(angle / two), std::cos(angle / two)};
+    return {{std::cos(angle / two), -std::sin(angle / two),
+             std::sin(angle / two), std::cos(angle / two)}};
   }
   case (GateName::Rz): {
     auto angle = angles[0];
-    return {std::exp(-im<Scalar> * angle / two), 0, 0,
-            std::exp(im<Scalar> * angle / two)};
+    return {{std::exp(-im<Scalar> * angle / two), 0, 0,
+             std::exp(im<Scalar> * angle / two)}};
   }
   case (GateName::R1):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])};
+    return {
+        {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])}};
   case (GateName::U1):
-    return {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])};
+    return {
+        {{1., 0.}, {0.0, 0.}, {0.0, 0.0}, std::exp(im<Scalar> * angles[0])}};
   case (GateName::U2): {
     Scalar oneOverSqrt2 = 1 / std::sqrt(2.);
     auto phi = angles[0];
     auto lambda = angles[1];
-    return {{oneOverSqrt2, 0.},
-            -oneOverSqrt2 * std::exp(lambda * nvqir::im<Scalar>),
-            oneOverSqrt2 * std::exp(nvqir::im<Scalar> * phi),
-            oneOverSqrt2 * std::exp(nvqir::im<Scalar> * (phi + lambda))};
+    return {{{oneOverSqrt2, 0.},
+             -oneOverSqrt2 * std::exp(lambda * nvqir::im<Scalar>),
+             oneOverSqrt2 * std::exp(nvqir::im<Scalar> * phi),
+             oneOverSqrt2 * std::exp(nvqir::im<Scalar> * (phi + lambda))}};
   }
   case (GateName::U3): {
     auto theta = angles[0];
     auto phi = angles[1];
     auto lambda = angles[2];
-    return {{std::cos(theta / 2), 0.},
-            -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
-            std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
-            std::exp(nvqir::im<Scalar> * (phi + lambda)) * std::cos(theta / 2)};
+    return {{{std::cos(theta / 2), 0.},
+             -std::exp(nvqir::im<Scalar> * lambda) * std::sin(theta / 2),
+             std::exp(nvqir::im<Scalar> * phi) * std::sin(theta / 2),
+             std::exp(nvqir::im<Scalar> * (phi + lambda)) *
+                 std::cos(theta / 2)}};
   }
   case (GateName::PhasedRx): {
     Scalar two = 2.;
     auto phi = angles[0];
     auto lambda = angles[1];
-    return {{std::cos(phi / two), 0.},
-            -nvqir::im<Scalar> * std::exp(-nvqir::im<Scalar> * lambda) *
-                std::complex<Scalar>{std::sin(phi / two), 0.},
-            -nvqir::im<Scalar> * std::exp(nvqir::im<Scalar> * lambda) *
-                std::sin(phi / two),
-            std::cos(phi / two)};
+    return {{{std::cos(phi / two), 0.},
+             -nvqir::im<Scalar> * std::exp(-nvqir::im<Scalar> * lambda) *
+                 std::complex<Scalar>{std::sin(phi / two), 0.},
+             -nvqir::im<Scalar> * std::exp(nvqir::im<Scalar> * lambda) *
+                 std::sin(phi / two),
+             std::cos(phi / two)}};
   }
   }
 
-  throw std::runtime_error("Invalid gate provided to getGateByName.");
+  throw std::runtime_error("Invalid gate provided to getGateMatrixByName.");
+}
+
+/// @brief Given the gate name (an element of the GateName enum),
+/// return the matrix data, optionally parameterized by a rotation angle.
+template <typename Scalar>
+std::vector<std::complex<Scalar>>
+getGateByName(GateName name, const std::vector<Scalar> angles = {}) {
+  const auto matrix = getGateMatrixByName<Scalar>(name, angles);
+  return {matrix.begin(), matrix.end()};
+}
+
+/// @brief Return the GateName of the parameterized operation with the given
+/// (lower case) name, or std::nullopt if there is none.
+inline std::optional<GateName>
+getParameterizedGateName(std::string_view name) {
+  static const std::pair<std::string_view, GateName> names[] = {
+      {"rx", GateName::Rx}, {"ry", GateName::Ry},
+      {"rz", GateName::Rz}, {"r1", GateName::R1},
+      {"u1", GateName::U1}, {"u2", GateName::U2},
+      {"u3", GateName::U3}, {"phased_rx", GateName::PhasedRx}};
+  for (auto &[gateName, kind] : names)
+    if (gateName == name)
+      return kind;
+  return std::nullopt;
+}
+
+/// @brief Return the derivative of the matrix of the given gate with respect to
+/// its `paramIdx`-th angle. The derivatives are analytic: a rotation
+/// `R_P(theta) = exp(-i theta P / 2)` has the derivative `-i/2 P R_P(theta)`,
+/// and a phase `exp(i phi)` in an entry contributes a factor `i`. The
+/// derivative of a controlled gate is the derivative of its target matrix
+/// restricted to the subspace where all controls are set.
+template <typename Scalar>
+std::vector<std::complex<Scalar>>
+getGateDerivativeByName(GateName name, const std::vector<Scalar> &angles,
+                        std::size_t paramIdx) {
+  using C = std::complex<Scalar>;
+  const auto m = getGateMatrixByName<Scalar>(name, angles);
+  const C i = im<Scalar>;
+  const Scalar half = 0.5;
+  // Left-multiply by `-i/2 P` for the Pauli generator `P` of a rotation.
+  const auto rotation = [&](const std::array<C, 4> &pauli) {
+    std::vector<C> result(4);
+    for (std::size_t r = 0; r < 2; ++r)
+      for (std::size_t c = 0; c < 2; ++c)
+        result[2 * r + c] =
+            -i * half *
+            (pauli[2 * r] * m[c] + pauli[2 * r + 1] * m[2 + c]);
+    return result;
+  };
+
+  switch (name) {
+  case GateName::Rx:
+    return rotation(getGateMatrixByName<Scalar>(GateName::X));
+  case GateName::Ry:
+    return rotation(getGateMatrixByName<Scalar>(GateName::Y));
+  case GateName::Rz:
+    return rotation(getGateMatrixByName<Scalar>(GateName::Z));
+  case GateName::R1:
+  case GateName::U1:
+    // diag(1, exp(i theta))
+    return {0, 0, 0, i * m[3]};
+  case GateName::U2:
+    // The first row is independent of `phi`, the first column of `lambda`.
+    if (paramIdx == 0)
+      return {0, 0, i * m[2], i * m[3]};
+    return {0, i * m[1], 0, i * m[3]};
+  case GateName::U3: {
+    if (paramIdx == 0) {
+      const Scalar c = std::cos(angles[0] / 2), s = std::sin(angles[0] / 2);
+      const C eLambda = std::exp(i * angles[2]), ePhi = std::exp(i * angles[1]);
+      return {-half * s, -half * eLambda * c, half * ePhi * c,
+              -half * ePhi * eLambda * s};
+    }
+    if (paramIdx == 1)
+      return {0, 0, i * m[2], i * m[3]};
+    return {0, i * m[1], 0, i * m[3]};
+  }
+  case GateName::PhasedRx: {
+    if (paramIdx == 0) {
+      // cos(phi / 2) I - i sin(phi / 2) (cos(lambda) X + sin(lambda) Y)
+      const Scalar c = std::cos(angles[0] / 2), s = std::sin(angles[0] / 2);
+      const C eLambda = std::exp(i * angles[1]);
+      return {-half * s, -i * half * std::conj(eLambda) * c,
+              -i * half * eLambda * c, -half * s};
+    }
+    // The off-diagonal entries carry exp(-i lambda) and exp(i lambda).
+    return {0, -i * m[1], i * m[2], 0};
+  }
+  default:
+    throw std::runtime_error(
+        "Invalid gate provided to getGateDerivativeByName.");
+  }
 }
 
 /// @brief The X operation as a type. Can instantiate and request
 /// its matrix data.
 template <typename ScalarType = double>
 struct x {
+  static constexpr GateName kind = GateName::X;
   auto getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::X);
   }
@@ -146,6 +251,7 @@ struct x {
 /// The Y Gate
 template <typename ScalarType = double>
 struct y {
+  static constexpr GateName kind = GateName::Y;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Y);
@@ -156,6 +262,7 @@ struct y {
 /// The Z Gate
 template <typename ScalarType = double>
 struct z {
+  static constexpr GateName kind = GateName::Z;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Z);
@@ -166,6 +273,7 @@ struct z {
 /// The Hadamard Gate
 template <typename ScalarType = double>
 struct h {
+  static constexpr GateName kind = GateName::H;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::H);
@@ -176,6 +284,7 @@ struct h {
 /// The S Gate
 template <typename ScalarType = double>
 struct s {
+  static constexpr GateName kind = GateName::S;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::S);
@@ -186,6 +295,7 @@ struct s {
 /// The T Gate
 template <typename ScalarType = double>
 struct t {
+  static constexpr GateName kind = GateName::T;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::T);
@@ -196,6 +306,7 @@ struct t {
 /// The `Sdg` (S†) Gate
 template <typename ScalarType = double>
 struct sdg {
+  static constexpr GateName kind = GateName::Sdg;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Sdg);
@@ -206,6 +317,7 @@ struct sdg {
 /// The `Tdg` (T†) Gate
 template <typename ScalarType = double>
 struct tdg {
+  static constexpr GateName kind = GateName::Tdg;
   std::vector<ComplexT<ScalarType>>
   getGate(std::vector<ScalarType> angles = {}) {
     return getGateByName<ScalarType>(GateName::Tdg);
@@ -216,6 +328,7 @@ struct tdg {
 /// The RX Rotation Gate
 template <typename ScalarType = double>
 struct rx {
+  static constexpr GateName kind = GateName::Rx;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Rx, {angles[0]});
   }
@@ -225,6 +338,7 @@ struct rx {
 /// The RY Rotation Gate
 template <typename ScalarType = double>
 struct ry {
+  static constexpr GateName kind = GateName::Ry;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Ry, {angles[0]});
   }
@@ -234,6 +348,7 @@ struct ry {
 /// The RZ Rotation Gate
 template <typename ScalarType = double>
 struct rz {
+  static constexpr GateName kind = GateName::Rz;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::Rz, {angles[0]});
   }
@@ -243,6 +358,7 @@ struct rz {
 /// @brief The R1 operation as a type. Arbitrary rotation about |1>
 template <typename ScalarType = double>
 struct r1 {
+  static constexpr GateName kind = GateName::R1;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::R1, {angles[0]});
   }
@@ -253,6 +369,7 @@ struct r1 {
 /// (IBMs version)
 template <typename ScalarType = double>
 struct u1 {
+  static constexpr GateName kind = GateName::U1;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U1, {angles[0]});
   }
@@ -261,6 +378,7 @@ struct u1 {
 
 template <typename ScalarType = double>
 struct u2 {
+  static constexpr GateName kind = GateName::U2;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U2, {angles[0], angles[1]});
   }
@@ -269,6 +387,7 @@ struct u2 {
 
 template <typename ScalarType = double>
 struct u3 {
+  static constexpr GateName kind = GateName::U3;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::U3,
                                      {angles[0], angles[1], angles[2]});
@@ -278,6 +397,7 @@ struct u3 {
 
 template <typename ScalarType = double>
 struct phased_rx {
+  static constexpr GateName kind = GateName::PhasedRx;
   std::vector<ComplexT<ScalarType>> getGate(std::vector<ScalarType> angles) {
     return getGateByName<ScalarType>(GateName::PhasedRx,
                                      {angles[0], angles[1]});
@@ -125,10 +125,11 @@ Array *vectorSizetToArray(std::vector<std::size_t> &idxs) {
   return nvqir::allocatedArrays.back().get();
 }
 
-/// @brief Utility function mapping a QIR Array pointer to a vector of ids
-std::vector<std::size_t> arrayToVectorSizeT(Array *arr) {
+/// @brief Utility function mapping a QIR Array pointer to a vector of ids,
+/// written to `ret` so that its storage can be reused across calls.
+void arrayToVectorSizeT(Array *arr, std::vector<std::size_t> &ret) {
   assert(arr && "array must not be null");
-  std::vector<std::size_t> ret;
+  ret.clear();
   const auto arrSize = arr->size();
   for (std::size_t i = 0; i < arrSize; ++i) {
     auto arrayPtr = (*arr)[i];
@@ -138,9 +139,33 @@ std::vector<std::size_t> arrayToVectorSizeT(Array *arr) {
     else
       ret.push_back(idxVal->idx);
   }
+}
+
+/// @brief Utility function mapping a QIR Array pointer to a vector of ids
+std::vector<std::size_t> arrayToVectorSizeT(Array *arr) {
+  std::vector<std::size_t> ret;
+  arrayToVectorSizeT(arr, ret);
   return ret;
 }
 
+/// @brief Reusable storage for the control qubit ids of the gate being
+/// dispatched, so that controlled gates do not allocate on every call.
+thread_local static std::vector<std::size_t> controlIdxScratch;
+
+/// @brief Map the QIR Array of control qubits to their ids. The returned
+/// reference is only valid until the next call to one of the `controlIdxs`
+/// functions on this thread.
+const std::vector<std::size_t> &controlIdxs(Array *ctrls) {
+  arrayToVectorSizeT(ctrls, controlIdxScratch);
+  return controlIdxScratch;
+}
+
+/// @brief Single control qubit version of `controlIdxs`.
+const std::vector<std::size_t> &controlIdxs(std::size_t ctrl) {
+  controlIdxScratch.assign(1, ctrl);
+  return controlIdxScratch;
+}
+
 /// @brief Utility function mapping a QIR Qubit pointer to its id
 std::size_t qubitToSizeT(Qubit *q) {
   if (qubitPtrIsIndex)
@@ -414,7 +439,7 @@ void __quantum__rt__deallocate_all(const std::size_t numQubits,
     nvqir::getCircuitSimulatorInternal()->GATENAME(targetIdx);                 \
   }                                                                            \
   void QIS_FUNCTION_CTRL_NAME(GATENAME)(Array * ctrlQubits, Qubit * qubit) {   \
-    auto ctrlIdxs = arrayToVectorSizeT(ctrlQubits);                            \
+    const auto &ctrlIdxs = controlIdxs(ctrlQubits);                            \
     auto targetIdx = qubitToSizeT(qubit);                                      \
     ScopedTraceWithContext("NVQIR::ctrl-" + std::string(#GATENAME), ctrlIdxs,  \
                            targetIdx);                                         \
@@ -455,7 +480,7 @@ void __quantum__qis__s__adj(Qubit *qubit) {
   }                                                                            \
   void QIS_FUNCTION_CTRL_NAME(GATENAME)(double param, Array *ctrlQubits,       \
                                         Qubit *qubit) {                        \
-    auto ctrlIdxs = arrayToVectorSizeT(ctrlQubits);                            \
+    const auto &ctrlIdxs = controlIdxs(ctrlQubits);                            \
     auto targetIdx = qubitToSizeT(qubit);                                      \
     ScopedTraceWithContext("NVQIR::" + std::string(#GATENAME), param,          \
                            ctrlIdxs, targetIdx);                               \
@@ -476,7 +501,7 @@ void __quantum__qis__swap(Qubit *q, Qubit *r) {
 }
 
 void __quantum__qis__swap__ctl(Array *ctrls, Qubit *q, Qubit *r) {
-  auto ctrlIdxs = arrayToVectorSizeT(ctrls);
+  const auto &ctrlIdxs = controlIdxs(ctrls);
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   nvqir::getCircuitSimulatorInternal()->swap(ctrlIdxs, qI, rI);
@@ -489,8 +514,7 @@ void __quantum__qis__swap__body(Qubit *q, Qubit *r) {
 void __quantum__qis__cphase(double d, Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
-  std::vector<std::size_t> ctrls{qI};
-  nvqir::getCircuitSimulatorInternal()->r1(d, ctrls, rI);
+  nvqir::getCircuitSimulatorInternal()->r1(d, controlIdxs(qI), rI);
 }
 
 void __quantum__qis__phased_rx(double theta, double phi, Qubit *q) {
@@ -522,7 +546,7 @@ void __quantum__qis__u3(double theta, double phi, double lambda, Qubit *q) {
 
 void __quantum__qis__u3__ctl(double theta, double phi, double lambda,
                              Array *ctrls, Qubit *q) {
-  auto ctrlIdxs = arrayToVectorSizeT(ctrls);
+  const auto &ctrlIdxs = controlIdxs(ctrls);
   auto qI = qubitToSizeT(q);
   nvqir::getCircuitSimulatorInternal()->u3(theta, phi, lambda, ctrlIdxs, qI);
 }
@@ -533,24 +557,21 @@ void __quantum__qis__cnot(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   ScopedTraceWithContext("NVQIR::cnot", qI, rI);
-  std::vector<std::size_t> controls{qI};
-  nvqir::getCircuitSimulatorInternal()->x(controls, rI);
+  nvqir::getCircuitSimulatorInternal()->x(controlIdxs(qI), rI);
 }
 
 void __quantum__qis__cnot__body(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   ScopedTraceWithContext("NVQIR::cnot", qI, rI);
-  std::vector<std::size_t> controls{qI};
-  nvqir::getCircuitSimulatorInternal()->x(controls, rI);
+  nvqir::getCircuitSimulatorInternal()->x(controlIdxs(qI), rI);
 }
 
 void __quantum__qis__cz__body(Qubit *q, Qubit *r) {
   auto qI = qubitToSizeT(q);
   auto rI = qubitToSizeT(r);
   ScopedTraceWithContext("NVQIR::cz", qI, rI);
-  std::vector<std::size_t> controls{qI};
-  nvqir::getCircuitSimulatorInternal()->z(controls, rI);
+  nvqir::getCircuitSimulatorInternal()->z(controlIdxs(qI), rI);
 }
 
 void __quantum__qis__reset(Qubit *q) {
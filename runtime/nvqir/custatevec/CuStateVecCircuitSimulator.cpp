@@ -16,6 +16,7 @@
 #include "device_launch_parameters.h"
 #include <bitset>
 #include <complex>
+#include <deque>
 #include <iostream>
 #include <random>
 #include <set>
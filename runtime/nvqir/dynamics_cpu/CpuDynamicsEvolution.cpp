@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsState.h"
+#include "CpuSuperOperator.h"
+#include "cudaq/algorithms/evolve_internal.h"
+#include "cudaq/algorithms/integrator.h"
+#include <map>
+#include <stdexcept>
+
+namespace cudaq::__internal__ {
+/// @brief Evolve the system for a single initial state on the CPU.
+/// @param hamiltonian Hamiltonian operator.
+/// @param dimensionsMap Dimension of the system.
+/// @param schedule Time schedule.
+/// @param initialState Initial state.
+/// @param integrator Integrator.
+/// @param collapseOperators Collapse operators.
+/// @param observables Observables.
+/// @param storeIntermediateResults Store intermediate results.
+/// @param shotsCount Number of shots.
+/// @return evolve_result Result of the evolution.
+evolve_result evolveSingle(
+    const sum_op<cudaq::matrix_handler> &hamiltonian,
+    const cudaq::dimension_map &dimensionsMap, const schedule &schedule,
+    const state &initialState, base_integrator &integrator,
+    const std::vector<sum_op<cudaq::matrix_handler>> &collapseOperators,
+    const std::vector<sum_op<cudaq::matrix_handler>> &observables,
+    bool storeIntermediateResults, std::optional<int> shotsCount) {
+  const std::map<std::size_t, int64_t> dimensions(dimensionsMap.begin(),
+                                                  dimensionsMap.end());
+  std::vector<int64_t> dims;
+  for (const auto &[id, dim] : dimensions) {
+    if (id != dims.size())
+      throw std::invalid_argument(
+          "The degrees of freedom of the system must be numbered "
+          "consecutively from 0.");
+    dims.emplace_back(dim);
+  }
+
+  const auto &cpuState = getCpuDynamicsState(initialState);
+  auto initialCopy = std::make_unique<CpuDynamicsState>(
+      cpuState.getData(), cpuState.is_density_matrix());
+  initialCopy->setHilbertSpaceDims(dims);
+  state initial_State = [&]() {
+    if (!collapseOperators.empty() && !initialCopy->is_density_matrix())
+      return state(initialCopy->to_density_matrix().release());
+    return state(initialCopy.release());
+  }();
+
+  SystemDynamics system(dims, hamiltonian, collapseOperators);
+  cudaq::integrator_helper::init_system_dynamics(integrator, system, schedule);
+  integrator.setState(initial_State, 0.0);
+
+  const auto computeExpectations = [&](const state &currentState, double t) {
+    const auto &cpuState = getCpuDynamicsState(currentState);
+    dynamics::ParameterMap params;
+    for (const auto &param : schedule.get_parameters())
+      params[param] = schedule.get_value_function()(param, t);
+    std::vector<double> expVals;
+    for (const auto &obs : observables)
+      expVals.emplace_back(
+          dynamics::computeExpectation(
+              dynamics::toSparseMatrix(obs, dims, params), cpuState.getData(),
+              cpuState.is_density_matrix())
+              .real());
+    return expVals;
+  };
+
+  std::vector<std::vector<double>> expectationVals;
+  std::vector<cudaq::state> intermediateStates;
+  for (const auto &step : schedule) {
+    integrator.integrate(step.real());
+    if (storeIntermediateResults) {
+      auto [t, currentState] = integrator.getState();
+      expectationVals.emplace_back(computeExpectations(currentState, t));
+      intermediateStates.emplace_back(currentState);
+    }
+  }
+
+  if (storeIntermediateResults)
+    return evolve_result(intermediateStates, expectationVals);
+
+  // Only final state is needed
+  auto [finalTime, finalState] = integrator.getState();
+  return evolve_result(finalState, computeExpectations(finalState, finalTime));
+}
+} // namespace cudaq::__internal__
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CircuitSimulator.h"
+#include "CpuDynamicsState.h"
+
+namespace {
+
+/// @brief Simulator of the `dynamics-cpu` target. Like the `dynamics` target,
+/// it only provides the simulation state, the time evolution is implemented
+/// by `evolve` with the CPU integrators.
+class CpuDynamicsSim : public nvqir::CircuitSimulatorBase<double> {
+public:
+  /// @brief The constructor
+  CpuDynamicsSim() = default;
+
+  /// The destructor
+  virtual ~CpuDynamicsSim() {}
+
+  std::unique_ptr<cudaq::SimulationState> getSimulationState() override {
+    return std::make_unique<cudaq::CpuDynamicsState>();
+  }
+
+  void addQubitToState() override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+  }
+  void deallocateStateImpl() override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+  }
+  bool measureQubit(const std::size_t qubitIdx) override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+    return false;
+  }
+  void applyGate(const GateApplicationTask &task) override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+  }
+  void setToZeroState() override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+  }
+  void resetQubit(const std::size_t qubitIdx) override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+  }
+  cudaq::ExecutionResult sample(const std::vector<std::size_t> &qubitIdxs,
+                                const int shots) override {
+    throw std::runtime_error(
+        "[dynamics-cpu target] Quantum gate simulation is not supported.");
+    return cudaq::ExecutionResult();
+  }
+  std::string name() const override { return "dynamics-cpu"; }
+  NVQIR_SIMULATOR_CLONE_IMPL(CpuDynamicsSim)
+};
+} // namespace
+
+NVQIR_REGISTER_SIMULATOR(CpuDynamicsSim, dynamics_cpu)
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include "CpuDynamicsState.h"
+#include "cudaq/utils/cudaq_utils.h"
+#include <numeric>
+
+namespace cudaq {
+
+std::complex<double>
+CpuDynamicsState::overlap(const cudaq::SimulationState &other) {
+  if (getTensor().extents != other.getTensor().extents)
+    throw std::runtime_error("[CpuDynamicsState] overlap error - other state "
+                             "dimension not equal to this state dimension.");
+
+  if (other.getPrecision() != getPrecision())
+    throw std::runtime_error(
+        "[CpuDynamicsState] overlap error - precision mismatch.");
+
+  Eigen::Map<const Eigen::VectorXcd> otherData(
+      reinterpret_cast<const std::complex<double> *>(other.getTensor().data),
+      data.size());
+  if (!isDensityMatrix)
+    return std::abs(otherData.dot(data));
+
+  // Tr(A^dagger B), which is the dot product of the flattened matrices.
+  return data.dot(otherData);
+}
+
+std::complex<double>
+CpuDynamicsState::getAmplitude(const std::vector<int> &basisState) {
+  throw std::runtime_error(
+      "[CpuDynamicsState] getAmplitude by basis states is not supported. "
+      "Please use direct indexing access instead.");
+}
+
+// Dump the state to the given output stream
+void CpuDynamicsState::dump(std::ostream &os) const {
+  os << Eigen::Map<const Eigen::MatrixXcd>(data.data(), dimension,
+                                           isDensityMatrix ? dimension : 1)
+     << std::endl;
+}
+
+std::unique_ptr<SimulationState>
+CpuDynamicsState::createFromSizeAndPtr(std::size_t size, void *dataPtr,
+                                       std::size_t type) {
+  bool isDm = false;
+  if (type == cudaq::detail::variant_index<cudaq::state_data,
+                                           cudaq::TensorStateData>()) {
+    if (size != 1)
+      throw std::runtime_error("[CpuDynamicsState]: createFromSizeAndPtr "
+                               "expects a single tensor");
+    auto *casted =
+        reinterpret_cast<cudaq::TensorStateData::value_type *>(dataPtr);
+
+    auto [ptr, extents] = casted[0];
+    if (extents.size() > 2)
+      throw std::runtime_error("[CpuDynamicsState]: createFromSizeAndPtr only "
+                               "accept 1D or 2D arrays");
+
+    isDm = extents.size() == 2;
+    size = std::reduce(extents.begin(), extents.end(), 1, std::multiplies());
+    dataPtr = const_cast<void *>(ptr);
+  }
+
+  return std::make_unique<CpuDynamicsState>(
+      Eigen::Map<Eigen::VectorXcd>(
+          reinterpret_cast<std::complex<double> *>(dataPtr), size),
+      isDm);
+}
+
+// Return the tensor at the given index. Throws
+// for an invalid tensor index.
+cudaq::SimulationState::Tensor
+CpuDynamicsState::getTensor(std::size_t tensorIdx) const {
+  if (tensorIdx != 0)
+    throw std::runtime_error(
+        "CpuDynamicsState state only supports a single tensor");
+
+  const std::vector<std::size_t> extents =
+      isDensityMatrix ? std::vector<std::size_t>{dimension, dimension}
+                      : std::vector<std::size_t>{dimension};
+  return Tensor{const_cast<std::complex<double> *>(data.data()), extents,
+                precision::fp64};
+}
+
+std::complex<double>
+CpuDynamicsState::operator()(std::size_t tensorIdx,
+                             const std::vector<std::size_t> &indices) {
+  if (tensorIdx != 0)
+    throw std::runtime_error(
+        "CpuDynamicsState state only supports a single tensor");
+  if (isDensityMatrix) {
+    if (indices.size() != 2)
+      throw std::runtime_error("CpuDynamicsState holding a density matrix "
+                               "supports only 2-dimensional indices");
+    if (indices[0] >= dimension || indices[1] >= dimension)
+      throw std::runtime_error("CpuDynamicsState indices out of range");
+    return data[indices[0] + indices[1] * dimension];
+  }
+  if (indices.size() != 1)
+    throw std::runtime_error("CpuDynamicsState holding a state vector supports "
+                             "only 1-dimensional indices");
+  if (indices[0] >= dimension)
+    throw std::runtime_error("Index out of bounds");
+  return data[indices[0]];
+}
+
+// Copy the state data to the user-provided data pointer.
+void CpuDynamicsState::toHost(std::complex<double> *userData,
+                              std::size_t numElements) const {
+  if (numElements != static_cast<std::size_t>(data.size()))
+    throw std::runtime_error("Number of elements in user data does not match "
+                             "the size of the state");
+  std::copy(data.begin(), data.end(), userData);
+}
+
+// Copy the state data to the user-provided data pointer.
+void CpuDynamicsState::toHost(std::complex<float> *userData,
+                              std::size_t numElements) const {
+  throw std::runtime_error(
+      "CpuDynamicsState: Data type mismatches - expecting "
+      "double-precision array.");
+}
+
+void CpuDynamicsState::destroyState() {
+  data.resize(0);
+  dimension = 0;
+  isDensityMatrix = false;
+  hilbertSpaceDims.clear();
+}
+
+void CpuDynamicsState::setHilbertSpaceDims(const std::vector<int64_t> &dims) {
+  const std::size_t vectorSize = std::reduce(
+      dims.begin(), dims.end(), std::size_t(1), std::multiplies<>());
+  const std::size_t size = data.size();
+  if (size != vectorSize && size != vectorSize * vectorSize)
+    throw std::invalid_argument("Invalid hilbertSpaceDims for the state data");
+
+  isDensityMatrix = size != vectorSize;
+  dimension = vectorSize;
+  hilbertSpaceDims = dims;
+}
+
+std::unique_ptr<CpuDynamicsState> CpuDynamicsState::to_density_matrix() const {
+  if (isDensityMatrix)
+    throw std::runtime_error("State is already a density matrix.");
+
+  Eigen::MatrixXcd densityMatrix = data * data.adjoint();
+  auto dm = std::make_unique<CpuDynamicsState>(
+      Eigen::Map<Eigen::VectorXcd>(densityMatrix.data(), densityMatrix.size()),
+      /*isDm=*/true);
+  dm->hilbertSpaceDims = hilbertSpaceDims;
+  return dm;
+}
+
+} // namespace cudaq
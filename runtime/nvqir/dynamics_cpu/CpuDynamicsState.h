@@ -0,0 +1,118 @@
+/*************************************************************** -*- C++ -*- ***
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "common/EigenDense.h"
+#include "common/SimulationState.h"
+#include "cudaq/qis/state.h"
+#include <cmath>
+
+namespace cudaq {
+/// @cond
+// This is an internal class, no API documentation.
+// Host memory simulation state of the `dynamics-cpu` target. Density matrices
+// are stored in column-major order, like on the `dynamics` target.
+class CpuDynamicsState : public cudaq::SimulationState {
+private:
+  bool isDensityMatrix = false;
+  // Dimension of the Hilbert space.
+  std::size_t dimension = 0;
+  Eigen::VectorXcd data;
+  std::vector<int64_t> hilbertSpaceDims;
+
+public:
+  CpuDynamicsState(Eigen::VectorXcd stateData, bool isDm)
+      : isDensityMatrix(isDm),
+        dimension(isDm ? std::llround(std::sqrt(stateData.size()))
+                       : stateData.size()),
+        data(std::move(stateData)) {}
+
+  CpuDynamicsState() {}
+
+  std::size_t getNumQubits() const override { return std::log2(dimension); }
+
+  std::complex<double> overlap(const cudaq::SimulationState &other) override;
+
+  std::complex<double>
+  getAmplitude(const std::vector<int> &basisState) override;
+
+  // Dump the state to the given output stream
+  void dump(std::ostream &os) const override;
+
+  // Return the precision of the state data elements.
+  precision getPrecision() const override {
+    return cudaq::SimulationState::precision::fp64;
+  }
+
+  std::unique_ptr<SimulationState>
+  createFromSizeAndPtr(std::size_t size, void *dataPtr,
+                       std::size_t type) override;
+
+  // Return the tensor at the given index. Throws
+  // for an invalid tensor index.
+  Tensor getTensor(std::size_t tensorIdx = 0) const override;
+
+  // Return all tensors that represent this state
+  std::vector<Tensor> getTensors() const override { return {getTensor()}; }
+
+  // Return the number of tensors that represent this state.
+  std::size_t getNumTensors() const override { return 1; }
+
+  std::complex<double>
+  operator()(std::size_t tensorIdx,
+             const std::vector<std::size_t> &indices) override;
+
+  // Copy the state data to the user-provided data pointer.
+  void toHost(std::complex<double> *userData,
+              std::size_t numElements) const override;
+
+  // Copy the state data to the user-provided data pointer.
+  void toHost(std::complex<float> *userData,
+              std::size_t numElements) const override;
+
+  // Free the state data.
+  void destroyState() override;
+
+  /// @brief Set the `hilbert` space dimensions of the state. The data is a
+  /// density matrix if its size is the square of the `hilbert` space
+  /// dimension.
+  void setHilbertSpaceDims(const std::vector<int64_t> &dims);
+
+  /// @brief Get the `hilbert` space dimensions of the state.
+  const std::vector<int64_t> &getHilbertSpaceDims() const {
+    return hilbertSpaceDims;
+  }
+
+  /// @brief Check if the state is a density matrix.
+  bool is_density_matrix() const { return isDensityMatrix; }
+
+  /// @brief Return the dimension of the `hilbert` space.
+  std::size_t getDimension() const { return dimension; }
+
+  /// @brief Convert the state vector to a density matrix.
+  /// @return A new state representing the density matrix.
+  std::unique_ptr<CpuDynamicsState> to_density_matrix() const;
+
+  /// @brief Access the state data, the column-major flattened density matrix
+  /// or the state vector.
+  Eigen::VectorXcd &getData() { return data; }
+  const Eigen::VectorXcd &getData() const { return data; }
+};
+
+/// @brief Return the `CpuDynamicsState` of `state`, or throw if it is a state
+/// of another simulator.
+inline CpuDynamicsState &getCpuDynamicsState(const cudaq::state &state) {
+  auto *simState = cudaq::state_helper::getSimulationState(
+      const_cast<cudaq::state *>(&state));
+  auto *castSimState = dynamic_cast<CpuDynamicsState *>(simState);
+  if (!castSimState)
+    throw std::runtime_error("Invalid state.");
+  return *castSimState;
+}
+/// @endcond
+} // namespace cudaq
@@ -0,0 +1,391 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsState.h"
+#include "CpuTimeStepper.h"
+#include "common/Logger.h"
+#include "cudaq/algorithms/integrator.h"
+
+namespace cudaq {
+namespace integrators {
+namespace {
+/// @brief Return a copy of `state`, which the integrators evolve in place.
+std::shared_ptr<cudaq::state> copyState(const cudaq::state &state) {
+  const auto &cpuState = getCpuDynamicsState(state);
+  auto *copy = new CpuDynamicsState(cpuState.getData(),
+                                    cpuState.is_density_matrix());
+  if (!cpuState.getHilbertSpaceDims().empty())
+    copy->setHilbertSpaceDims(cpuState.getHilbertSpaceDims());
+  return std::make_shared<cudaq::state>(copy);
+}
+
+/// @brief Return the state of the integration and the time stepper, which is
+/// created on first use.
+std::pair<CpuDynamicsState &, CpuTimeStepper &>
+prepare(cudaq::state *state, std::unique_ptr<base_time_stepper> &stepper,
+        const SystemDynamics &system, const cudaq::schedule &schedule) {
+  if (!state)
+    throw std::runtime_error("Initial state has not been set.");
+  auto &cpuState = getCpuDynamicsState(*state);
+  if (cpuState.getHilbertSpaceDims().empty())
+    cpuState.setHilbertSpaceDims(system.modeExtents);
+  if (!stepper)
+    stepper = std::make_unique<CpuTimeStepper>(system, schedule,
+                                               cpuState.is_density_matrix());
+  return {cpuState, static_cast<CpuTimeStepper &>(*stepper)};
+}
+
+/// @brief Return the RMS norm of `error` scaled by the tolerances.
+double scaledErrorNorm(const Eigen::VectorXcd &error,
+                       const Eigen::VectorXcd &current,
+                       const Eigen::VectorXcd &next, double rtol, double atol) {
+  const Eigen::ArrayXd scale =
+      atol + rtol * current.cwiseAbs().array().max(next.cwiseAbs().array());
+  return std::sqrt((error.cwiseAbs().array() / scale).square().mean());
+}
+
+/// @brief Return the exponential of the small dense matrix `a`, computed with
+/// the [6/6] `Pade` approximant and scaling and squaring.
+Eigen::MatrixXcd expm(const Eigen::MatrixXcd &a) {
+  const double norm = a.cwiseAbs().colwise().sum().maxCoeff();
+  const int squarings =
+      norm > 0.5 ? static_cast<int>(std::ceil(std::log2(norm / 0.5))) : 0;
+  const Eigen::MatrixXcd x = a / std::ldexp(1.0, squarings);
+  constexpr double coefficients[] = {1.,          1. / 2.,    5. / 44.,
+                                     1. / 66.,    1. / 792.,  1. / 15840.,
+                                     1. / 665280.};
+  const auto identity = Eigen::MatrixXcd::Identity(a.rows(), a.cols());
+  Eigen::MatrixXcd power = identity;
+  Eigen::MatrixXcd numerator = identity;
+  Eigen::MatrixXcd denominator = identity;
+  for (int k = 1; k <= 6; ++k) {
+    power = power * x;
+    numerator += coefficients[k] * power;
+    denominator += (k % 2 ? -coefficients[k] : coefficients[k]) * power;
+  }
+  Eigen::MatrixXcd result = denominator.partialPivLu().solve(numerator);
+  for (int i = 0; i < squarings; ++i)
+    result = result * result;
+  return result;
+}
+} // namespace
+
+runge_kutta::runge_kutta(int order, const std::optional<double> &max_step_size)
+    : m_t(0.0), m_order(order), m_dt(max_step_size) {
+  if (m_order != 1 && m_order != 2 && m_order != 4)
+    throw std::invalid_argument(
+        "runge_kutta integrator only supports integration order 1, 2, or 4.");
+}
+
+std::shared_ptr<base_integrator> runge_kutta::clone() {
+  auto clone = std::make_shared<cudaq::integrators::runge_kutta>();
+  clone->m_order = this->m_order;
+  clone->m_dt = this->m_dt;
+  clone->m_t = this->m_t;
+  clone->m_state = m_state ? copyState(*m_state) : nullptr;
+  clone->m_system = this->m_system;
+  clone->m_schedule = this->m_schedule;
+  return clone;
+}
+
+void runge_kutta::setState(const cudaq::state &initial_state, double t0) {
+  m_state = copyState(initial_state);
+  m_t = t0;
+}
+
+std::pair<double, cudaq::state> runge_kutta::getState() {
+  return std::make_pair(m_t, *copyState(*m_state));
+}
+
+void runge_kutta::integrate(double targetTime) {
+  auto [cpuState, stepper] = prepare(m_state.get(), m_stepper, m_system,
+                                     m_schedule);
+  auto &x = cpuState.getData();
+  Eigen::VectorXcd k1, k2, k3, k4, tmp;
+  while (m_t < targetTime) {
+    const double step_size =
+        std::min(m_dt.value_or(targetTime - m_t), targetTime - m_t);
+
+    cudaq::debug("Runge-Kutta step at time {} with step size {}", m_t,
+                 step_size);
+
+    stepper.computeDerivative(m_t, x, k1);
+    if (m_order == 1) {
+      // Euler method (1st order)
+      x += step_size * k1;
+    } else if (m_order == 2) {
+      // Midpoint method (2nd order)
+      tmp = x + (step_size / 2.0) * k1;
+      stepper.computeDerivative(m_t + step_size / 2.0, tmp, k2);
+      x += step_size * k2;
+    } else if (m_order == 4) {
+      // Runge-Kutta method (4th order)
+      tmp = x + (step_size / 2.0) * k1;
+      stepper.computeDerivative(m_t + step_size / 2.0, tmp, k2);
+      tmp = x + (step_size / 2.0) * k2;
+      stepper.computeDerivative(m_t + step_size / 2.0, tmp, k3);
+      tmp = x + step_size * k3;
+      stepper.computeDerivative(m_t + step_size, tmp, k4);
+      x += (step_size / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
+    } else {
+      throw std::runtime_error("Invalid integrator order");
+    }
+
+    // Update time
+    m_t += step_size;
+  }
+}
+
+dormand_prince::dormand_prince(double relative_tolerance,
+                               double absolute_tolerance,
+                               const std::optional<double> &max_step_size)
+    : m_t(0.0), m_rtol(relative_tolerance), m_atol(absolute_tolerance),
+      m_dt(max_step_size) {
+  if (m_rtol <= 0.0 || m_atol <= 0.0)
+    throw std::invalid_argument(
+        "dormand_prince integrator requires positive tolerances.");
+}
+
+std::shared_ptr<base_integrator> dormand_prince::clone() {
+  auto clone = std::make_shared<cudaq::integrators::dormand_prince>();
+  clone->m_rtol = this->m_rtol;
+  clone->m_atol = this->m_atol;
+  clone->m_dt = this->m_dt;
+  clone->m_nextStepSize = this->m_nextStepSize;
+  clone->m_t = this->m_t;
+  clone->m_state = m_state ? copyState(*m_state) : nullptr;
+  clone->m_system = this->m_system;
+  clone->m_schedule = this->m_schedule;
+  return clone;
+}
+
+void dormand_prince::setState(const cudaq::state &initial_state, double t0) {
+  m_state = copyState(initial_state);
+  m_t = t0;
+  m_nextStepSize.reset();
+}
+
+std::pair<double, cudaq::state> dormand_prince::getState() {
+  return std::make_pair(m_t, *copyState(*m_state));
+}
+
+void dormand_prince::integrate(double targetTime) {
+  // Butcher tableau of the Dormand-Prince 5(4) method.
+  constexpr double c2 = 1. / 5., c3 = 3. / 10., c4 = 4. / 5., c5 = 8. / 9.;
+  constexpr double a21 = 1. / 5.;
+  constexpr double a31 = 3. / 40., a32 = 9. / 40.;
+  constexpr double a41 = 44. / 45., a42 = -56. / 15., a43 = 32. / 9.;
+  constexpr double a51 = 19372. / 6561., a52 = -25360. / 2187.,
+                   a53 = 64448. / 6561., a54 = -212. / 729.;
+  constexpr double a61 = 9017. / 3168., a62 = -355. / 33.,
+                   a63 = 46732. / 5247., a64 = 49. / 176.,
+                   a65 = -5103. / 18656.;
+  // 5th order weights (also the last row of the tableau, FSAL).
+  constexpr double b1 = 35. / 384., b3 = 500. / 1113., b4 = 125. / 192.,
+                   b5 = -2187. / 6784., b6 = 11. / 84.;
+  // Difference between the 5th and 4th order weights.
+  constexpr double e1 = 71. / 57600., e3 = -71. / 16695., e4 = 71. / 1920.,
+                   e5 = -17253. / 339200., e6 = 22. / 525., e7 = -1. / 40.;
+  // Step size control.
+  constexpr double safety = 0.9, minFactor = 0.2, maxFactor = 5.0;
+
+  if (m_t >= targetTime)
+    return;
+  auto [cpuState, stepper] = prepare(m_state.get(), m_stepper, m_system,
+                                     m_schedule);
+  auto &x = cpuState.getData();
+  Eigen::VectorXcd k1, k2, k3, k4, k5, k6, k7, tmp, next, error;
+  stepper.computeDerivative(m_t, x, k1);
+
+  double h = [&]() {
+    if (m_nextStepSize)
+      return *m_nextStepSize;
+    // Initial guess from the scale of the state and its derivative.
+    const Eigen::VectorXcd zero = Eigen::VectorXcd::Zero(x.size());
+    const double d0 = scaledErrorNorm(x, x, zero, m_rtol, m_atol);
+    const double d1 = scaledErrorNorm(k1, x, zero, m_rtol, m_atol);
+    return (d0 < 1e-5 || d1 < 1e-5) ? 1e-6 : 0.01 * d0 / d1;
+  }();
+  if (m_dt)
+    h = std::min(h, *m_dt);
+
+  while (m_t < targetTime) {
+    const double remaining = targetTime - m_t;
+    const bool lastStep = h >= remaining;
+    const double step_size = lastStep ? remaining : h;
+
+    tmp = x + step_size * (a21 * k1);
+    stepper.computeDerivative(m_t + c2 * step_size, tmp, k2);
+    tmp = x + step_size * (a31 * k1 + a32 * k2);
+    stepper.computeDerivative(m_t + c3 * step_size, tmp, k3);
+    tmp = x + step_size * (a41 * k1 + a42 * k2 + a43 * k3);
+    stepper.computeDerivative(m_t + c4 * step_size, tmp, k4);
+    tmp = x + step_size * (a51 * k1 + a52 * k2 + a53 * k3 + a54 * k4);
+    stepper.computeDerivative(m_t + c5 * step_size, tmp, k5);
+    tmp = x + step_size * (a61 * k1 + a62 * k2 + a63 * k3 + a64 * k4 +
+                           a65 * k5);
+    stepper.computeDerivative(m_t + step_size, tmp, k6);
+    next = x + step_size * (b1 * k1 + b3 * k3 + b4 * k4 + b5 * k5 + b6 * k6);
+    stepper.computeDerivative(m_t + step_size, next, k7);
+    error = step_size * (e1 * k1 + e3 * k3 + e4 * k4 + e5 * k5 + e6 * k6 +
+                         e7 * k7);
+
+    const double errorNorm = scaledErrorNorm(error, x, next, m_rtol, m_atol);
+    const double factor =
+        errorNorm == 0.0
+            ? maxFactor
+            : std::clamp(safety * std::pow(errorNorm, -0.2), minFactor,
+                         maxFactor);
+    if (errorNorm <= 1.0) {
+      cudaq::debug("Dormand-Prince step at time {} with step size {}", m_t,
+                   step_size);
+      m_t = lastStep ? targetTime : m_t + step_size;
+      x.swap(next);
+      k1.swap(k7);
+      // A step shortened to hit the target does not shrink the next one.
+      h = lastStep ? std::max(h, step_size * factor) : step_size * factor;
+    } else {
+      h = step_size * factor;
+    }
+    if (m_dt)
+      h = std::min(h, *m_dt);
+    if (h < 1e-14 * std::max(1.0, std::abs(m_t)))
+      throw std::runtime_error(
+          "dormand_prince integrator: step size underflow at time " +
+          std::to_string(m_t) + ".");
+  }
+  m_nextStepSize = h;
+}
+
+krylov::krylov(int subspace_dimension, double tolerance,
+               const std::optional<double> &max_step_size)
+    : m_t(0.0), m_subspaceDim(subspace_dimension), m_tol(tolerance),
+      m_dt(max_step_size) {
+  if (m_subspaceDim < 1)
+    throw std::invalid_argument(
+        "krylov integrator requires a positive subspace dimension.");
+  if (m_tol <= 0.0)
+    throw std::invalid_argument(
+        "krylov integrator requires a positive tolerance.");
+}
+
+std::shared_ptr<base_integrator> krylov::clone() {
+  auto clone = std::make_shared<cudaq::integrators::krylov>();
+  clone->m_subspaceDim = this->m_subspaceDim;
+  clone->m_tol = this->m_tol;
+  clone->m_dt = this->m_dt;
+  clone->m_nextStepSize = this->m_nextStepSize;
+  clone->m_t = this->m_t;
+  clone->m_state = m_state ? copyState(*m_state) : nullptr;
+  clone->m_system = this->m_system;
+  clone->m_schedule = this->m_schedule;
+  return clone;
+}
+
+void krylov::setState(const cudaq::state &initial_state, double t0) {
+  m_state = copyState(initial_state);
+  m_t = t0;
+  m_nextStepSize.reset();
+}
+
+std::pair<double, cudaq::state> krylov::getState() {
+  return std::make_pair(m_t, *copyState(*m_state));
+}
+
+void krylov::integrate(double targetTime) {
+  if (m_t >= targetTime)
+    return;
+  auto [cpuState, stepper] = prepare(m_state.get(), m_stepper, m_system,
+                                     m_schedule);
+  const auto &liouvillian = stepper.getLiouvillian();
+  auto &x = cpuState.getData();
+  const auto size = x.size();
+  const auto maxDim =
+      static_cast<Eigen::Index>(std::min<std::size_t>(m_subspaceDim, size));
+  // Orthonormal basis of the Krylov subspace and the projection of the
+  // generator (upper Hessenberg).
+  Eigen::MatrixXcd basis(size, maxDim + 1);
+  Eigen::MatrixXcd hessenberg(maxDim + 1, maxDim);
+  Eigen::VectorXcd w;
+
+  double h = m_nextStepSize.value_or(targetTime - m_t);
+  while (m_t < targetTime) {
+    double step_size = std::min(h, targetTime - m_t);
+    if (m_dt)
+      step_size = std::min(step_size, *m_dt);
+    const double beta = x.norm();
+    if (beta == 0.0) {
+      m_t += step_size;
+      continue;
+    }
+
+    // Arnoldi iteration with the generator at the midpoint of the step.
+    const auto params = stepper.getParameters(m_t + step_size / 2.0);
+    hessenberg.setZero();
+    basis.col(0) = x / beta;
+    Eigen::Index dim = maxDim;
+    bool invariant = false;
+    for (Eigen::Index j = 0; j < maxDim; ++j) {
+      liouvillian.apply(basis.col(j), w, params);
+      for (Eigen::Index i = 0; i <= j; ++i) {
+        hessenberg(i, j) = basis.col(i).dot(w);
+        w -= hessenberg(i, j) * basis.col(i);
+      }
+      const double norm = w.norm();
+      hessenberg(j + 1, j) = norm;
+      // The subspace is invariant, the projection is exact.
+      if (norm <= 1e-12 * beta) {
+        dim = j + 1;
+        invariant = true;
+        break;
+      }
+      basis.col(j + 1) = w / norm;
+    }
+
+    // Shorten the step until the error estimate of the projected exponential,
+    // `beta * h_{m+1,m} * |[exp(h H_m)]_{m,1}|`, is below the tolerance. The
+    // basis only depends on the step size through the midpoint of a
+    // time-dependent generator, in which case it is rebuilt.
+    const Eigen::MatrixXcd projected = hessenberg.topLeftCorner(dim, dim);
+    Eigen::MatrixXcd exponential;
+    double error = 0.0;
+    bool accepted = false;
+    for (;;) {
+      exponential = expm(step_size * projected);
+      error = invariant ? 0.0
+                        : beta * std::abs(hessenberg(dim, dim - 1)) *
+                              std::abs(exponential(dim - 1, 0));
+      if (error <= m_tol) {
+        accepted = true;
+        break;
+      }
+      step_size /= 2.0;
+      h = step_size;
+      if (step_size < 1e-14 * std::max(1.0, std::abs(m_t)))
+        throw std::runtime_error(
+            "krylov integrator: step size underflow at time " +
+            std::to_string(m_t) + ". Increase the subspace dimension.");
+      if (liouvillian.isTimeDependent())
+        break;
+    }
+    if (!accepted)
+      continue;
+
+    cudaq::debug("Krylov step at time {} with step size {} (subspace "
+                 "dimension {}, error estimate {})",
+                 m_t, step_size, dim, error);
+    x = beta * (basis.leftCols(dim) * exponential.col(0));
+    m_t += step_size;
+    // Try a longer step next if this one was very accurate.
+    if (error < m_tol / 100.0)
+      h = std::max(h, 2.0 * step_size);
+  }
+  m_nextStepSize = h;
+}
+} // namespace integrators
+} // namespace cudaq
@@ -0,0 +1,406 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuSuperOperator.h"
+#include "common/Logger.h"
+#include <algorithm>
+#include <numeric>
+
+namespace cudaq::dynamics {
+namespace {
+using Complex = std::complex<double>;
+
+/// @brief The minimum number of output elements for which the sparse products
+/// are computed in parallel.
+constexpr std::int64_t minParallelSize = 1 << 12;
+
+std::vector<std::size_t> getStrides(const std::vector<int64_t> &modeExtents) {
+  std::vector<std::size_t> strides(modeExtents.size());
+  std::size_t stride = 1;
+  for (std::size_t i = 0; i < modeExtents.size(); ++i) {
+    strides[i] = stride;
+    stride *= modeExtents[i];
+  }
+  return strides;
+}
+
+SparseMatrix identity(std::size_t dimension) {
+  SparseMatrix matrix(dimension, dimension);
+  matrix.setIdentity();
+  return matrix;
+}
+
+/// @brief Return true if the matrix of `op` may depend on the parameters.
+bool isParametric(const matrix_handler &op, const ParameterMap &parameters) {
+  if (parameters.empty())
+    return false;
+  static const std::vector<std::string> knownNonParametricOps = []() {
+    std::vector<std::string> opNames;
+    opNames.emplace_back(
+        cudaq::boson_op::identity(0).begin()->to_string(false));
+    opNames.emplace_back(cudaq::boson_op::create(0).begin()->to_string(false));
+    opNames.emplace_back(
+        cudaq::boson_op::annihilate(0).begin()->to_string(false));
+    opNames.emplace_back(cudaq::boson_op::number(0).begin()->to_string(false));
+    opNames.emplace_back(cudaq::spin_op::i(0).begin()->to_string(false));
+    opNames.emplace_back(cudaq::spin_op::x(0).begin()->to_string(false));
+    opNames.emplace_back(cudaq::spin_op::y(0).begin()->to_string(false));
+    opNames.emplace_back(cudaq::spin_op::z(0).begin()->to_string(false));
+    for (auto &&op :
+         {matrix_handler::number(0), matrix_handler::parity(0),
+          matrix_handler::position(0), matrix_handler::momentum(0)})
+      opNames.emplace_back(op.to_string(false));
+    return opNames;
+  }();
+  return std::find(knownNonParametricOps.begin(), knownNonParametricOps.end(),
+                   op.to_string(false)) == knownNonParametricOps.end();
+}
+
+/// @brief Return the matrix of the elementary operator `op` on the full
+/// `hilbert` space, i.e., its Kronecker product with the identity on all other
+/// modes, built directly in the compressed row format.
+SparseMatrix embed(const matrix_handler &op,
+                   const std::vector<int64_t> &modeExtents,
+                   const ParameterMap &parameters) {
+  const auto degrees = op.degrees();
+  cudaq::dimension_map dimensions;
+  for (std::size_t i = 0; i < modeExtents.size(); ++i)
+    dimensions[i] = modeExtents[i];
+  for (auto degree : degrees)
+    if (degree >= modeExtents.size())
+      throw std::invalid_argument(
+          "Operator acts on degree " + std::to_string(degree) +
+          ", which is not part of the system dimensions.");
+
+  const auto local = op.to_matrix(dimensions, parameters);
+  const auto strides = getStrides(modeExtents);
+  const std::size_t dimension =
+      std::reduce(modeExtents.begin(), modeExtents.end(), std::size_t(1),
+                  std::multiplies<>());
+
+  // Index of the local basis state of a basis state of the full space, and
+  // offset of a local basis state in the full space. The first degree is the
+  // fastest varying one in both.
+  const auto localIndex = [&](std::size_t index) {
+    std::size_t result = 0, localStride = 1;
+    for (auto degree : degrees) {
+      result += ((index / strides[degree]) % modeExtents[degree]) * localStride;
+      localStride *= modeExtents[degree];
+    }
+    return result;
+  };
+  std::vector<std::size_t> offsets(local.rows(), 0);
+  for (std::size_t l = 0; l < local.rows(); ++l) {
+    std::size_t localStride = 1;
+    for (auto degree : degrees) {
+      offsets[l] += ((l / localStride) % modeExtents[degree]) * strides[degree];
+      localStride *= modeExtents[degree];
+    }
+  }
+
+  std::vector<std::vector<std::pair<std::size_t, Complex>>> localRows(
+      local.rows());
+  for (std::size_t a = 0; a < local.rows(); ++a)
+    for (std::size_t b = 0; b < local.cols(); ++b)
+      if (const auto value = local[{a, b}]; value != Complex(0.))
+        localRows[a].emplace_back(b, value);
+
+  std::vector<long> outer(dimension + 1, 0);
+  for (std::size_t row = 0; row < dimension; ++row)
+    outer[row + 1] = outer[row] + localRows[localIndex(row)].size();
+  std::vector<long> inner(outer.back());
+  std::vector<Complex> values(outer.back());
+  const std::int64_t numRows = dimension;
+#pragma omp parallel for if (numRows >= minParallelSize)
+  for (std::int64_t row = 0; row < numRows; ++row) {
+    const auto a = localIndex(row);
+    const auto base = row - offsets[a];
+    auto pos = outer[row];
+    // The offsets increase with the local index, so the columns are sorted.
+    for (const auto &[b, value] : localRows[a]) {
+      inner[pos] = base + offsets[b];
+      values[pos++] = value;
+    }
+  }
+  return Eigen::Map<const SparseMatrix>(dimension, dimension, outer.back(),
+                                        outer.data(), inner.data(),
+                                        values.data());
+}
+
+/// @brief Return the matrix of `op`, without its coefficient, on the full
+/// `hilbert` space.
+SparseMatrix productMatrix(const product_op<matrix_handler> &op,
+                           const std::vector<int64_t> &modeExtents,
+                           const ParameterMap &parameters) {
+  std::optional<SparseMatrix> result;
+  for (const auto &elementaryOp : op) {
+    auto matrix = embed(elementaryOp, modeExtents, parameters);
+    if (result)
+      *result = (*result * matrix).pruned();
+    else
+      result = std::move(matrix);
+  }
+  if (!result)
+    return identity(std::reduce(modeExtents.begin(), modeExtents.end(),
+                                std::size_t(1), std::multiplies<>()));
+  return std::move(*result);
+}
+
+// out[:, j] += c * A * in[:, j] for the `numCols` columns of `in`.
+void addLeftProduct(const SparseMatrix &a, const Complex *in, Complex *out,
+                    std::int64_t numCols, Complex c) {
+  if (a.nonZeros() == 0)
+    return;
+  const std::int64_t n = a.rows();
+  const auto *outer = a.outerIndexPtr();
+  const auto *inner = a.innerIndexPtr();
+  const auto *values = a.valuePtr();
+  const std::int64_t size = n * numCols;
+#pragma omp parallel for if (size >= minParallelSize)
+  for (std::int64_t idx = 0; idx < size; ++idx) {
+    const auto col = idx / n;
+    const auto row = idx % n;
+    const Complex *x = in + col * n;
+    Complex sum = 0.;
+    for (auto k = outer[row]; k < outer[row + 1]; ++k)
+      sum += values[k] * x[inner[k]];
+    out[idx] += c * sum;
+  }
+}
+
+// out += c * in * B for the n x n column-major matrix `in`, given `B^T`.
+void addRightProduct(const SparseMatrix &bT, const Complex *in, Complex *out,
+                     std::int64_t n, Complex c) {
+  if (bT.nonZeros() == 0)
+    return;
+  const auto *outer = bT.outerIndexPtr();
+  const auto *inner = bT.innerIndexPtr();
+  const auto *values = bT.valuePtr();
+  const std::int64_t size = n * n;
+#pragma omp parallel for if (size >= minParallelSize)
+  for (std::int64_t idx = 0; idx < size; ++idx) {
+    const auto col = idx / n;
+    const auto row = idx % n;
+    Complex sum = 0.;
+    for (auto k = outer[col]; k < outer[col + 1]; ++k)
+      sum += values[k] * in[inner[k] * n + row];
+    out[idx] += c * sum;
+  }
+}
+} // namespace
+
+SparseMatrix toSparseMatrix(const sum_op<matrix_handler> &op,
+                            const std::vector<int64_t> &modeExtents,
+                            const ParameterMap &parameters) {
+  const std::size_t dimension =
+      std::reduce(modeExtents.begin(), modeExtents.end(), std::size_t(1),
+                  std::multiplies<>());
+  SparseMatrix result(dimension, dimension);
+  for (const auto &term : op) {
+    const auto coefficient = term.evaluate_coefficient(parameters);
+    if (coefficient != Complex(0.))
+      result += coefficient * productMatrix(term, modeExtents, parameters);
+  }
+  result.makeCompressed();
+  return result;
+}
+
+std::complex<double> computeExpectation(const SparseMatrix &op,
+                                        const Eigen::VectorXcd &state,
+                                        bool isDensityMatrix) {
+  const std::int64_t n = op.rows();
+  if (state.size() != (isDensityMatrix ? n * n : n))
+    throw std::runtime_error("The dimension of the observable does not match "
+                             "the dimension of the state.");
+  const auto *outer = op.outerIndexPtr();
+  const auto *inner = op.innerIndexPtr();
+  const auto *values = op.valuePtr();
+  double real = 0., imag = 0.;
+#pragma omp parallel for reduction(+ : real, imag) if (n >= minParallelSize)
+  for (std::int64_t row = 0; row < n; ++row) {
+    Complex sum = 0.;
+    if (isDensityMatrix) {
+      // Tr(O rho) = sum_{r, k} O[r, k] rho[k, r]
+      const Complex *rhoCol = state.data() + row * n;
+      for (auto k = outer[row]; k < outer[row + 1]; ++k)
+        sum += values[k] * rhoCol[inner[k]];
+    } else {
+      for (auto k = outer[row]; k < outer[row + 1]; ++k)
+        sum += values[k] * state[inner[k]];
+      sum *= std::conj(state[row]);
+    }
+    real += sum.real();
+    imag += sum.imag();
+  }
+  return {real, imag};
+}
+
+CpuSuperOperator::CpuSuperOperator(
+    const sum_op<matrix_handler> &hamiltonian,
+    const std::vector<sum_op<matrix_handler>> &collapseOps,
+    const std::vector<int64_t> &modeExtents, const ParameterMap &parameters,
+    bool isMasterEquation)
+    : modeExtents(modeExtents),
+      dimension(std::reduce(modeExtents.begin(), modeExtents.end(),
+                            std::size_t(1), std::multiplies<>())),
+      masterEquation(isMasterEquation || !collapseOps.empty()),
+      constantLeft(dimension, dimension),
+      constantRightTransposed(dimension, dimension) {
+  const Complex minusI(0., -1.);
+  for (const auto &term : hamiltonian) {
+    const auto coefficient = term.get_coefficient();
+    // -i H rho
+    Term left;
+    left.coefficient = [coefficient, minusI](const ParameterMap &params) {
+      return minusI * coefficient.evaluate(params);
+    };
+    left.isConstant = coefficient.is_constant();
+    left.left = Factor{{{term, false}}};
+    addTerm(std::move(left), parameters);
+    if (!masterEquation)
+      continue;
+    // +i rho H
+    Term right;
+    right.coefficient = [coefficient, minusI](const ParameterMap &params) {
+      return -minusI * coefficient.evaluate(params);
+    };
+    right.isConstant = coefficient.is_constant();
+    right.right = Factor{{{term, false}}, /*transpose=*/true};
+    addTerm(std::move(right), parameters);
+  }
+
+  // For `C = sum_a c_a P_a`, the dissipator is the sum over the pairs (a, b)
+  // of `c_a c_b^* (P_a rho P_b^dag - {P_b^dag P_a, rho} / 2)`.
+  for (const auto &collapseOp : collapseOps) {
+    for (const auto &termA : collapseOp) {
+      for (const auto &termB : collapseOp) {
+        const auto coeffA = termA.get_coefficient();
+        const auto coeffB = termB.get_coefficient();
+        const bool isConstant = coeffA.is_constant() && coeffB.is_constant();
+        const auto pairCoefficient = [coeffA, coeffB](const ParameterMap &p) {
+          return coeffA.evaluate(p) * std::conj(coeffB.evaluate(p));
+        };
+
+        Term sandwich;
+        sandwich.coefficient = pairCoefficient;
+        sandwich.isConstant = isConstant;
+        sandwich.left = Factor{{{termA, false}}};
+        sandwich.right = Factor{{{termB, true}}, /*transpose=*/true};
+        addTerm(std::move(sandwich), parameters);
+
+        const auto anticommutatorCoefficient =
+            [pairCoefficient](const ParameterMap &p) {
+              return -0.5 * pairCoefficient(p);
+            };
+        Term left;
+        left.coefficient = anticommutatorCoefficient;
+        left.isConstant = isConstant;
+        left.left = Factor{{{termB, true}, {termA, false}}};
+        addTerm(std::move(left), parameters);
+
+        Term right;
+        right.coefficient = anticommutatorCoefficient;
+        right.isConstant = isConstant;
+        right.right =
+            Factor{{{termB, true}, {termA, false}}, /*transpose=*/true};
+        addTerm(std::move(right), parameters);
+      }
+    }
+  }
+
+  constantLeft.makeCompressed();
+  constantRightTransposed.makeCompressed();
+  cudaq::info("Constructed {} Liouvillian of dimension {} with {} constant "
+              "and {} time-dependent terms.",
+              masterEquation ? "density matrix" : "state vector", dimension,
+              constantLeft.nonZeros() + constantRightTransposed.nonZeros(),
+              terms.size());
+}
+
+void CpuSuperOperator::addTerm(Term &&term, const ParameterMap &parameters) {
+  for (auto *factor : {term.left ? &*term.left : nullptr,
+                       term.right ? &*term.right : nullptr}) {
+    if (!factor)
+      continue;
+    for (const auto &[op, adjoint] : factor->ops)
+      for (const auto &elementaryOp : op)
+        factor->parametric |= isParametric(elementaryOp, parameters);
+    if (!factor->parametric) {
+      SparseMatrix scratch;
+      factor->matrix = evaluate(*factor, parameters, scratch);
+    }
+  }
+
+  const bool isParametricTerm = (term.left && term.left->parametric) ||
+                                (term.right && term.right->parametric);
+  timeDependent |= !term.isConstant || isParametricTerm;
+  if (term.isConstant && !isParametricTerm && !(term.left && term.right)) {
+    const auto coefficient = term.coefficient(parameters);
+    if (term.left)
+      constantLeft += coefficient * term.left->matrix;
+    else
+      constantRightTransposed += coefficient * term.right->matrix;
+    return;
+  }
+  terms.emplace_back(std::move(term));
+}
+
+const SparseMatrix &
+CpuSuperOperator::evaluate(const Factor &factor, const ParameterMap &parameters,
+                           SparseMatrix &scratch) const {
+  if (!factor.parametric && factor.matrix.rows() != 0)
+    return factor.matrix;
+
+  scratch = identity(dimension);
+  for (const auto &[op, adjoint] : factor.ops) {
+    auto matrix = productMatrix(op, modeExtents, parameters);
+    if (adjoint)
+      scratch = (scratch * SparseMatrix(matrix.adjoint())).pruned();
+    else
+      scratch = (scratch * matrix).pruned();
+  }
+  if (factor.transpose)
+    scratch = SparseMatrix(scratch.transpose());
+  scratch.makeCompressed();
+  return scratch;
+}
+
+void CpuSuperOperator::apply(const Eigen::VectorXcd &in, Eigen::VectorXcd &out,
+                             const ParameterMap &parameters) const {
+  const std::int64_t n = dimension;
+  const std::int64_t numCols = masterEquation ? n : 1;
+  if (in.size() != n * numCols)
+    throw std::runtime_error("The dimension of the state does not match the "
+                             "dimension of the Liouvillian.");
+
+  out.setZero(in.size());
+  addLeftProduct(constantLeft, in.data(), out.data(), numCols, 1.);
+  if (masterEquation)
+    addRightProduct(constantRightTransposed, in.data(), out.data(), n, 1.);
+
+  SparseMatrix leftScratch, rightScratch;
+  for (const auto &term : terms) {
+    const auto coefficient = term.coefficient(parameters);
+    if (coefficient == Complex(0.))
+      continue;
+    if (term.left && term.right) {
+      scratch.setZero(in.size());
+      addLeftProduct(evaluate(*term.left, parameters, leftScratch), in.data(),
+                     scratch.data(), numCols, 1.);
+      addRightProduct(evaluate(*term.right, parameters, rightScratch),
+                      scratch.data(), out.data(), n, coefficient);
+    } else if (term.left) {
+      addLeftProduct(evaluate(*term.left, parameters, leftScratch), in.data(),
+                     out.data(), numCols, coefficient);
+    } else {
+      addRightProduct(evaluate(*term.right, parameters, rightScratch),
+                      in.data(), out.data(), n, coefficient);
+    }
+  }
+}
+} // namespace cudaq::dynamics
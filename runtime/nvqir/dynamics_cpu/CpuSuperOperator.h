@@ -0,0 +1,107 @@
+/*************************************************************** -*- C++ -*- ***
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "common/EigenDense.h"
+#include "common/EigenSparse.h"
+#include "cudaq/operators.h"
+#include <functional>
+#include <optional>
+
+namespace cudaq::dynamics {
+using ParameterMap = std::unordered_map<std::string, std::complex<double>>;
+
+/// @brief Row-major sparse matrix on the `hilbert` space of the system.
+using SparseMatrix =
+    Eigen::SparseMatrix<std::complex<double>, Eigen::RowMajor, long>;
+
+/// @brief Return the sparse matrix of `op` on the `hilbert` space with the
+/// given mode extents. Mode `i` is the degree of freedom `i`, and the first
+/// mode is the fastest varying one, as in `product_op::to_matrix`.
+SparseMatrix toSparseMatrix(const sum_op<matrix_handler> &op,
+                            const std::vector<int64_t> &modeExtents,
+                            const ParameterMap &parameters);
+
+/// @brief Return the expectation value of `op` in `state`, which is either a
+/// state vector or a column-major flattened density matrix.
+std::complex<double> computeExpectation(const SparseMatrix &op,
+                                        const Eigen::VectorXcd &state,
+                                        bool isDensityMatrix);
+
+/// @brief The generator `L(t)` of the time evolution `d/dt x = L(t) x` on the
+/// CPU, i.e., `-iH` for the Schrodinger equation or the `Lindbladian`
+///   `L(rho) = -i[H, rho] + sum_k (C_k rho C_k^dag - {C_k^dag C_k, rho} / 2)`
+/// for the master equation.
+///
+/// Each term of the super-operator is kept as a scaled product `c(t) A rho B`
+/// of sparse matrices on the `hilbert` space, rather than as the Kronecker
+/// product `B^T (x) A` acting on the flattened density matrix, which would
+/// take `dim` times more memory. The terms with constant coefficients are
+/// folded into a single left and a single right matrix when the operator is
+/// built, so that a time-independent system costs two sparse products per
+/// application (plus one per collapse operator term pair). The sparse
+/// products are parallelized with OpenMP.
+class CpuSuperOperator {
+public:
+  CpuSuperOperator(const sum_op<matrix_handler> &hamiltonian,
+                   const std::vector<sum_op<matrix_handler>> &collapseOps,
+                   const std::vector<int64_t> &modeExtents,
+                   const ParameterMap &parameters, bool isMasterEquation);
+
+  /// @brief Compute `out = L(t) in`, where the time-dependent coefficients are
+  /// evaluated with `parameters`.
+  void apply(const Eigen::VectorXcd &in, Eigen::VectorXcd &out,
+             const ParameterMap &parameters) const;
+
+  /// @brief Return true if this is the generator of the master equation, which
+  /// acts on density matrices.
+  bool isMasterEquation() const { return masterEquation; }
+
+  /// @brief Return the dimension of the `hilbert` space.
+  std::size_t getDimension() const { return dimension; }
+
+  /// @brief Return true if the generator depends on the parameters.
+  bool isTimeDependent() const { return timeDependent; }
+
+private:
+  /// @brief A product of product operators without coefficient (or their
+  /// adjoints). The matrix is built once, unless one of the operators depends
+  /// on parameters.
+  struct Factor {
+    std::vector<std::pair<product_op<matrix_handler>, bool>> ops;
+    bool transpose = false;
+    bool parametric = false;
+    SparseMatrix matrix;
+  };
+
+  /// @brief The term `c(t) A x B`. Right factors store `B^T`.
+  struct Term {
+    std::function<std::complex<double>(const ParameterMap &)> coefficient;
+    bool isConstant = true;
+    std::optional<Factor> left;
+    std::optional<Factor> right;
+  };
+
+  void addTerm(Term &&term, const ParameterMap &parameters);
+  const SparseMatrix &evaluate(const Factor &factor,
+                               const ParameterMap &parameters,
+                               SparseMatrix &scratch) const;
+
+  std::vector<int64_t> modeExtents;
+  std::size_t dimension = 0;
+  bool masterEquation = false;
+  bool timeDependent = false;
+  // Folded constant terms, `A rho` and `rho B` (stored as `B^T`).
+  SparseMatrix constantLeft;
+  SparseMatrix constantRightTransposed;
+  // Remaining (time-dependent, parametric or two-sided) terms.
+  std::vector<Term> terms;
+  // Scratch space for two-sided terms.
+  mutable Eigen::VectorXcd scratch;
+};
+} // namespace cudaq::dynamics
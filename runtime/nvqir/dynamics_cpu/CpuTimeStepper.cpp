@@ -0,0 +1,52 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuTimeStepper.h"
+
+namespace cudaq {
+CpuTimeStepper::CpuTimeStepper(const SystemDynamics &system,
+                               const cudaq::schedule &schedule,
+                               bool isMasterEquation)
+    : m_schedule(schedule), m_modeExtents(system.modeExtents),
+      m_liouvillian(system.hamiltonian, system.collapseOps, system.modeExtents,
+                    getParameters(0.0), isMasterEquation) {}
+
+dynamics::ParameterMap CpuTimeStepper::getParameters(double t) const {
+  dynamics::ParameterMap params;
+  for (const auto &param : m_schedule.get_parameters())
+    params[param] = m_schedule.get_value_function()(param, t);
+  return params;
+}
+
+void CpuTimeStepper::computeDerivative(double t, const Eigen::VectorXcd &in,
+                                       Eigen::VectorXcd &out) const {
+  m_liouvillian.apply(in, out, getParameters(t));
+}
+
+state CpuTimeStepper::compute(
+    const state &inputState, double t, double step_size,
+    const std::unordered_map<std::string, std::complex<double>> &parameters) {
+  if (step_size == 0.0)
+    throw std::runtime_error("Step size cannot be zero.");
+
+  const auto &cpuState = getCpuDynamicsState(inputState);
+  if (cpuState.is_density_matrix() != m_liouvillian.isMasterEquation())
+    throw std::runtime_error(
+        "The Liouvillian was constructed for a " +
+        std::string(m_liouvillian.isMasterEquation() ? "density matrix"
+                                                     : "state vector") +
+        ", the operator cannot act on the state.");
+
+  Eigen::VectorXcd derivative;
+  m_liouvillian.apply(cpuState.getData(), derivative, parameters);
+  auto *result = new CpuDynamicsState(std::move(derivative),
+                                      cpuState.is_density_matrix());
+  result->setHilbertSpaceDims(m_modeExtents);
+  return cudaq::state(result);
+}
+} // namespace cudaq
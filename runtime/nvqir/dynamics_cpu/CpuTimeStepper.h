@@ -0,0 +1,45 @@
+/*************************************************************** -*- C++ -*- ***
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#pragma once
+
+#include "CpuDynamicsState.h"
+#include "CpuSuperOperator.h"
+#include "cudaq/algorithms/base_integrator.h"
+#include "cudaq/algorithms/base_time_stepper.h"
+
+namespace cudaq {
+/// @brief Time stepper of the `dynamics-cpu` target: `compute` returns the
+/// time derivative `L(t) x` of the state `x`.
+class CpuTimeStepper : public base_time_stepper {
+public:
+  CpuTimeStepper(const SystemDynamics &system, const cudaq::schedule &schedule,
+                 bool isMasterEquation);
+
+  state compute(const state &inputState, double t, double step_size,
+                const std::unordered_map<std::string, std::complex<double>>
+                    &parameters) override;
+
+  /// @brief Compute `out = L(t) in`, with the parameters of the schedule at
+  /// time `t`. This is the allocation free version of `compute` used by the
+  /// integrators.
+  void computeDerivative(double t, const Eigen::VectorXcd &in,
+                         Eigen::VectorXcd &out) const;
+
+  /// @brief Return the values of the schedule parameters at time `t`.
+  dynamics::ParameterMap getParameters(double t) const;
+
+  const dynamics::CpuSuperOperator &getLiouvillian() const {
+    return m_liouvillian;
+  }
+
+private:
+  cudaq::schedule m_schedule;
+  std::vector<int64_t> m_modeExtents;
+  dynamics::CpuSuperOperator m_liouvillian;
+};
+} // namespace cudaq
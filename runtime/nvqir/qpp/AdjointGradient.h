@@ -0,0 +1,153 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "StateVectorKernels.h"
+
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+/// Adjoint-method differentiation of an expectation value <psi|H|psi>, where
+/// |psi> = U_n ... U_1 |0>, with respect to the parameters of the gates.
+///
+/// Starting from |phi> = |psi> and |lambda> = H |psi>, the gates are undone in
+/// reverse order. Before undoing gate `U_k`, |phi> is the state right after
+/// `U_k` and |lambda> is H |psi> propagated back to the same point, so that
+/// after |phi> <- U_k^dagger |phi>, the derivative with respect to a
+/// parameter `theta` of `U_k` is 2 Re <lambda| dU_k/dtheta |phi>. All
+/// derivatives are therefore obtained in a single backward sweep over two
+/// states, instead of two circuit simulations per parameter. Qubit indices and
+/// matrix ordering follow StateVectorKernels.h.
+namespace nvqir::sv {
+
+/// @brief A gate of the circuit to differentiate.
+struct AdjointGate {
+  /// @brief The row-major gate matrix.
+  std::vector<complex> matrix;
+  std::vector<std::size_t> controls;
+  std::vector<std::size_t> targets;
+  /// @brief The derivative of the matrix with respect to each parameter of
+  /// the gate, in parameter order.
+  std::vector<std::vector<complex>> derivatives;
+};
+
+/// @brief A term `coefficient * P` of the observable, where the Pauli string
+/// `P` has an X or Y on the qubits of `xMask`, and a Z or Y on the qubits of
+/// `zMask`.
+struct PauliTerm {
+  complex coefficient;
+  std::size_t xMask = 0;
+  std::size_t zMask = 0;
+};
+
+/// @brief Add `term` applied to `in` to `out`. Throws if the term acts on a
+/// qubit outside of the `numQubits` qubits of the states.
+inline void addPauliTerm(const complex *in, complex *out, std::size_t numQubits,
+                         const PauliTerm &term) {
+  if (numQubits < 64 && ((term.xMask | term.zMask) >> numQubits) != 0)
+    throw std::runtime_error("Pauli term acts on a qubit outside of the " +
+                             std::to_string(numQubits) + "-qubit state.");
+  // Y = i X Z, so every Y contributes a factor i on top of its X and Z bits.
+  static const complex powersOfI[] = {1., {0., 1.}, -1., {0., -1.}};
+  const complex coefficient =
+      term.coefficient *
+      powersOfI[std::popcount(term.xMask & term.zMask) % 4];
+  const std::int64_t dim = 1LL << numQubits;
+#if defined(_OPENMP)
+#pragma omp parallel for if (numQubits >= minParallelQubits)
+#endif
+  for (std::int64_t i = 0; i < dim; ++i) {
+    const auto index = static_cast<std::size_t>(i);
+    const bool negate = std::popcount(index & term.zMask) % 2;
+    out[index ^ term.xMask] += negate ? -coefficient * in[i]
+                                      : coefficient * in[i];
+  }
+}
+
+/// @brief Return Re <bra| M |ket> for the (possibly controlled) gate matrix
+/// `M`. The matrix only acts where all controls are set, and is zero
+/// elsewhere, as is the derivative of a controlled gate.
+inline double realMatrixElement(const complex *bra, const complex *ket,
+                                std::size_t numQubits,
+                                const std::vector<complex> &matrix,
+                                const std::vector<std::size_t> &controls,
+                                const std::vector<std::size_t> &targets) {
+  const KernelIndexing indexing(numQubits, controls, targets);
+  const auto offsets = targetOffsets(targets);
+  const std::size_t dim = offsets.size();
+  const std::int64_t numIter = indexing.numBase;
+  double result = 0.;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : result) if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+  for (std::int64_t k = 0; k < numIter; ++k) {
+    const std::size_t base = indexing.base(k);
+    for (std::size_t r = 0; r < dim; ++r) {
+      complex row = 0.;
+      for (std::size_t c = 0; c < dim; ++c)
+        row += matrix[r * dim + c] * ket[base + offsets[c]];
+      result += (std::conj(bra[base + offsets[r]]) * row).real();
+    }
+  }
+  return result;
+}
+
+/// @brief Return the conjugate transpose of a square row-major matrix.
+inline std::vector<complex> adjointMatrix(const std::vector<complex> &matrix) {
+  const auto dim = static_cast<std::size_t>(std::sqrt(matrix.size()));
+  std::vector<complex> result(matrix.size());
+  for (std::size_t r = 0; r < dim; ++r)
+    for (std::size_t c = 0; c < dim; ++c)
+      result[c * dim + r] = std::conj(matrix[r * dim + c]);
+  return result;
+}
+
+/// @brief Given the final state of the circuit `gates`, return the expectation
+/// value of the observable `terms`, and set `gradient` to its derivatives with
+/// respect to all gate parameters, in gate and parameter order.
+inline double adjointGradient(const complex *state, std::size_t numQubits,
+                              const std::vector<PauliTerm> &terms,
+                              const std::vector<AdjointGate> &gates,
+                              std::vector<double> &gradient) {
+  const std::size_t dim = 1ULL << numQubits;
+  std::vector<complex> phi(state, state + dim);
+  std::vector<complex> lambda(dim, 0.);
+  for (const auto &term : terms)
+    addPauliTerm(phi.data(), lambda.data(), numQubits, term);
+
+  double expVal = 0.;
+  for (std::size_t i = 0; i < dim; ++i)
+    expVal += (std::conj(phi[i]) * lambda[i]).real();
+
+  std::size_t numParams = 0;
+  for (const auto &gate : gates)
+    numParams += gate.derivatives.size();
+  gradient.assign(numParams, 0.);
+
+  auto param = numParams;
+  for (auto gate = gates.rbegin(); gate != gates.rend(); ++gate) {
+    const auto inverse = adjointMatrix(gate->matrix);
+    applyGate(phi.data(), numQubits, inverse, gate->controls, gate->targets);
+    param -= gate->derivatives.size();
+    for (std::size_t p = 0; p < gate->derivatives.size(); ++p)
+      gradient[param + p] =
+          2. * realMatrixElement(lambda.data(), phi.data(), numQubits,
+                                 gate->derivatives[p], gate->controls,
+                                 gate->targets);
+    // The gates before the first parameter do not contribute.
+    if (param == 0)
+      break;
+    applyGate(lambda.data(), numQubits, inverse, gate->controls,
+              gate->targets);
+  }
+  return expVal;
+}
+
+} // namespace nvqir::sv
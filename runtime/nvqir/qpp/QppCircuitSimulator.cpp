@@ -6,12 +6,18 @@
  * the terms of the Apache License 2.0 which accompanies this distribution.    *
  ******************************************************************************/
 
+#include "AdjointGradient.h"
+#include "Trajectories.h"
+#include "common/PackedCounts.h"
 #include "nvqir/CircuitSimulator.h"
 #include "nvqir/Gates.h"
 
 #include <bit>
+#include <charconv>
 #include <iostream>
+#include <map>
 #include <qpp.h>
+#include <random>
 #include <set>
 #include <span>
 
@@ -128,6 +134,18 @@ protected:
   /// The QPP state representation (qpp::ket or qpp::cmat)
   StateType state;
 
+  /// @brief The noisy circuit executed in the current context. For the state
+  /// vector, the live state is a single noise trajectory, the recorded
+  /// circuit is replayed to generate the other ones at sampling time.
+  sv::TrajectoryProgram trajectoryProgram;
+
+  /// @brief Work buffer for the application of general noise channels.
+  std::vector<std::complex<double>> noiseScratch;
+
+  /// @brief Number of trajectories used to compute expectation values in the
+  /// presence of noise, unless specified in the execution context.
+  static constexpr std::size_t defaultNumTrajectoriesForObserve = 1000;
+
   /// @brief Convert internal qubit index to Q++ qubit index.
   ///
   /// In Q++, qubits are indexed from left to right, and thus q0 is the leftmost
@@ -143,6 +161,185 @@ protected:
     return std::log2(stateDimension) - qubitIndex - 1;
   }
 
+  /// @brief Return the number of qubits in the current state.
+  std::size_t numStateQubits() const {
+    return std::countr_zero(static_cast<std::size_t>(state.rows()));
+  }
+
+  /// @brief Return true if the circuit executed in the current context must
+  /// be recorded for trajectory-based noise simulation. Kernels with
+  /// conditionals on measurement results (or explicit measurements) are
+  /// executed shot by shot, so that every execution already is an
+  /// independent trajectory.
+  bool shouldRecordTrajectories() const {
+    if constexpr (!std::is_same_v<StateType, qpp::ket>)
+      return false;
+    return executionContext && executionContext->noiseModel &&
+           (executionContext->name == "sample" ||
+            executionContext->name == "observe") &&
+           !executionContext->hasConditionalsOnMeasureResults &&
+           !executionContext->explicitMeasurements;
+  }
+
+  /// @brief Return the trajectory program to record the next operation into,
+  /// or a null pointer if not recording. The current state is captured on the
+  /// first recorded operation.
+  sv::TrajectoryProgram *getTrajectoryRecorder() {
+    if (!shouldRecordTrajectories())
+      return nullptr;
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      if (trajectoryProgram.empty() && state.size() > 0)
+        trajectoryProgram.addQubits(numStateQubits(), state(0) == 1.0
+                                                          ? nullptr
+                                                          : state.data());
+    }
+    return &trajectoryProgram;
+  }
+
+  /// @brief Return true if sampling must aggregate results over noise
+  /// trajectories.
+  bool hasNoiseTrajectories() {
+    if (!shouldRecordTrajectories() || !trajectoryProgram.hasNoise())
+      return false;
+    if (trajectoryProgram.numQubits() == numStateQubits())
+      return true;
+    cudaq::warn("[qpp] Unable to replay the noisy circuit, results are "
+                "computed from a single noise trajectory.");
+    return false;
+  }
+
+  /// @brief Record the gate for trajectory replay, if requested.
+  void recordGate(const GateApplicationTask &task) {
+    if (auto *recorder = getTrajectoryRecorder())
+      recorder->addGate(task.matrix, task.controls, task.targets);
+  }
+
+  /// @brief Record the measurement for trajectory replay, if requested.
+  void recordMeasurement(std::size_t index) {
+    if (auto *recorder = getTrajectoryRecorder())
+      recorder->addMeasurement(index);
+  }
+
+  /// @brief Apply a single Kraus operator of the channel, sampled with the
+  /// Born rule, to the state vector.
+  void applyTrajectoryChannel(const cudaq::kraus_channel &channel,
+                              const std::vector<std::size_t> &qubits) {
+    sv::TrajectoryChannel trajectoryChannel;
+    for (const auto &op : channel.get_ops())
+      trajectoryChannel.krausOps.emplace_back(op.data.begin(), op.data.end());
+    trajectoryChannel.unitaryOps = channel.unitary_ops;
+    trajectoryChannel.probabilities = channel.probabilities;
+
+    if (auto *recorder = getTrajectoryRecorder())
+      recorder->addChannel(trajectoryChannel, qubits);
+
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      [[maybe_unused]] const auto k = sv::applyChannel(
+          state.data(), numStateQubits(), trajectoryChannel, qubits,
+          qpp::RandomDevices::get_instance().get_prng(), noiseScratch);
+      cudaq::info("Applied Kraus operator {} of channel {} to qubits {}", k,
+                  channel.get_type_name(), qubits);
+    }
+  }
+
+  /// @brief Generate the noise trajectories `1, ..., numTrajectories - 1` by
+  /// replaying the recorded circuit, and invoke `callback(t, trajectory, rng)`
+  /// for each of them, where `rng` is the random stream of trajectory `t`.
+  /// Small states are distributed over the threads, one trajectory per thread
+  /// at a time, whereas large states are generated one after the other with
+  /// kernels parallelized over the amplitudes. `callback` may therefore be
+  /// invoked concurrently, for distinct trajectories.
+  template <typename Callback>
+  void runTrajectories(std::size_t numTrajectories, Callback &&callback) {
+    // Seed the trajectory streams from the simulator random number generator,
+    // so that results are reproducible with `cudaq::set_random_seed`.
+    const auto baseSeed = static_cast<std::uint32_t>(
+        qpp::RandomDevices::get_instance().get_prng()());
+    const std::int64_t numIter = numTrajectories;
+    const bool parallelTrajectories =
+        trajectoryProgram.numQubits() < sv::minParallelQubits;
+    cudaq::info("[qpp] Generating {} noise trajectories ({}).",
+                numTrajectories - 1,
+                parallelTrajectories ? "parallel" : "sequential");
+#if defined(_OPENMP)
+#pragma omp parallel if (parallelTrajectories)
+#endif
+    {
+      std::vector<std::complex<double>> trajectory, scratch;
+#if defined(_OPENMP)
+#pragma omp for schedule(dynamic)
+#endif
+      for (std::int64_t t = 1; t < numIter; ++t) {
+        std::seed_seq seq{baseSeed, static_cast<std::uint32_t>(t),
+                          static_cast<std::uint32_t>(t >> 32)};
+        std::mt19937_64 rng(seq);
+        trajectoryProgram.run(trajectory, rng, scratch);
+        callback(static_cast<std::size_t>(t), trajectory, rng);
+      }
+    }
+  }
+
+  /// @brief Sample the qubits over independent noise trajectories. The shots
+  /// are split evenly between the trajectories, by default one trajectory per
+  /// shot. Expectation values (`shots < 1`) are averaged over the trajectories.
+  cudaq::ExecutionResult
+  sampleTrajectories(const std::vector<std::size_t> &qubits, const int shots) {
+    const auto numQubits = numStateQubits();
+    if (shots < 1) {
+      std::size_t mask = 0;
+      for (auto q : qubits)
+        mask |= (1ULL << q);
+      const auto numTrajectories = std::max<std::size_t>(
+          1, executionContext->numberTrajectories.value_or(
+                 defaultNumTrajectoriesForObserve));
+      std::vector<double> expVals(numTrajectories);
+      expVals[0] = sv::parityExpectation(state.data(), numQubits, mask);
+      runTrajectories(numTrajectories,
+                      [&](std::size_t t, const auto &trajectory, auto &) {
+                        expVals[t] = sv::parityExpectation(trajectory.data(),
+                                                           numQubits, mask);
+                      });
+      // Accumulate in trajectory order to ensure repeatability
+      const double expectationValue =
+          std::accumulate(expVals.begin(), expVals.end(), 0.0) /
+          numTrajectories;
+      cudaq::info("Computed expectation value over {} trajectories = {}",
+                  numTrajectories, expectationValue);
+      return cudaq::ExecutionResult{{}, expectationValue};
+    }
+
+    const std::size_t numShots = shots;
+    const auto numTrajectories = std::clamp<std::size_t>(
+        executionContext->numberTrajectories.value_or(numShots), 1, numShots);
+    std::vector<std::vector<std::size_t>> samples(numTrajectories);
+    const auto shotsOf = [&](std::size_t t) {
+      return numShots / numTrajectories + (t < numShots % numTrajectories);
+    };
+    sv::sampleBasisStates(state.data(), numQubits, shotsOf(0),
+                          qpp::RandomDevices::get_instance().get_prng(),
+                          samples[0]);
+    runTrajectories(numTrajectories, [&](std::size_t t,
+                                         const auto &trajectory, auto &rng) {
+      sv::sampleBasisStates(trajectory.data(), numQubits, shotsOf(t), rng,
+                            samples[t]);
+    });
+
+    // Gather the measured bits of every sampled basis state, in shot order.
+    cudaq::PackedCounts counts(qubits.size());
+    std::vector<std::uint64_t> words(counts.numWords());
+    for (const auto &trajectorySamples : samples)
+      for (auto idx : trajectorySamples) {
+        std::fill(words.begin(), words.end(), 0);
+        for (std::size_t i = 0; i < qubits.size(); ++i)
+          words[i / 64] |= ((idx >> qubits[i]) & 1ULL) << (i % 64);
+        counts.add(words.data());
+      }
+
+    auto result = counts.toExecutionResult();
+    result.expectationValue = counts.expectationZ();
+    return result;
+  }
+
   /// @brief Compute the expectation value <Z...Z> over the given qubit indices.
   double calculateExpectationValue(const std::vector<std::size_t> &qubits) {
     std::size_t bitmask = 0;
@@ -199,6 +396,9 @@ protected:
     auto *stateData = reinterpret_cast<std::complex<double> *>(
         const_cast<void *>(stateDataIn));
 
+    if (auto *recorder = getTrajectoryRecorder())
+      recorder->addQubits(qubitCount, stateData);
+
     if (state.size() == 0) {
       // If this is the first time, allocate the state
       if (stateData == nullptr) {
@@ -228,6 +428,9 @@ protected:
       throw std::invalid_argument(
           "[QppCircuitSimulator] Incompatible state input");
 
+    if (auto *recorder = getTrajectoryRecorder())
+      recorder->addQubits(casted->getNumQubits(), casted->state.data());
+
     if (state.size() == 0)
       state = casted->state;
     else
@@ -238,9 +441,11 @@ protected:
   void deallocateStateImpl() override {
     StateType tmp;
     state = tmp;
+    trajectoryProgram.clear();
   }
 
   void applyGate(const GateApplicationTask &task) override {
+    recordGate(task);
     auto matrix = toQppMatrix(task.matrix, task.targets.size());
     // First, convert all of the qubit indices to big endian.
     std::vector<std::size_t> controls;
@@ -263,11 +468,13 @@ protected:
   void setToZeroState() override {
     state = qpp::ket::Zero(stateDimension);
     state(0) = 1.0;
+    trajectoryProgram.clear();
   }
 
   /// @brief Measure the qubit and return the result. Collapse the
   /// state vector.
   bool measureQubit(const std::size_t index) override {
+    recordMeasurement(index);
     const auto qubitIdx = convertQubitIndex(index);
     // If here, then we care about the result bit, so compute it.
     const auto measurement_tuple =
@@ -290,11 +497,128 @@ protected:
 
   QubitOrdering getQubitOrdering() const override { return QubitOrdering::msb; }
 
+  /// @brief Shot branching is supported by the state vector simulator, whose
+  /// qubit `q` is bit `q` of a state index (see `convertQubitIndex`).
+  bool supportsShotBranching() const override {
+    return std::is_same_v<StateType, qpp::ket>;
+  }
+
+  double probabilityOfOne(const std::size_t index) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      return sv::probabilityOfOne(state.data(), numStateQubits(), index);
+    return CircuitSimulatorBase::probabilityOfOne(index);
+  }
+
+  void collapseQubit(const std::size_t index, bool outcome,
+                     double probability) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      sv::collapse(state.data(), numStateQubits(), index, outcome,
+                   probability);
+    else
+      CircuitSimulatorBase::collapseQubit(index, outcome, probability);
+  }
+
+  /// @brief Differentiate the expectation value of the state vector with the
+  /// adjoint method (see AdjointGradient.h).
+  bool computeAdjointGradient() override {
+    if constexpr (!std::is_same_v<StateType, qpp::ket>)
+      return false;
+
+    std::vector<sv::PauliTerm> terms;
+    for (const auto &term : executionContext->spin.value()) {
+      sv::PauliTerm pauliTerm{term.evaluate_coefficient()};
+      for (const auto &op : term) {
+        if (op.target() >= numStateQubits()) {
+          cudaq::info("[qpp] The observable acts on qubit {}, but the state "
+                      "only has {} qubits.",
+                      op.target(), numStateQubits());
+          return false;
+        }
+        const auto pauli = op.as_pauli();
+        const std::size_t mask = 1ULL << op.target();
+        if (pauli == cudaq::pauli::X || pauli == cudaq::pauli::Y)
+          pauliTerm.xMask |= mask;
+        if (pauli == cudaq::pauli::Z || pauli == cudaq::pauli::Y)
+          pauliTerm.zMask |= mask;
+      }
+      terms.push_back(pauliTerm);
+    }
+
+    std::vector<sv::AdjointGate> gates;
+    gates.reserve(gradientTape.size());
+    for (const auto &task : gradientTape) {
+      sv::AdjointGate gate{task.matrix, task.controls, task.targets, {}};
+      if (!task.parameters.empty()) {
+        const auto kind = nvqir::getParameterizedGateName(task.operationName);
+        if (!kind)
+          return false;
+        for (std::size_t p = 0; p < task.parameters.size(); ++p)
+          gate.derivatives.push_back(
+              nvqir::getGateDerivativeByName(*kind, task.parameters, p));
+      }
+      gates.push_back(std::move(gate));
+    }
+
+    cudaq::info("[qpp] Computing the adjoint gradient of {} gates.",
+                gates.size());
+    executionContext->expectationValue =
+        sv::adjointGradient(state.data(), numStateQubits(), terms, gates,
+                            executionContext->gateParameterGradient);
+    return true;
+  }
+
+  std::size_t sampleNumOnes(std::size_t shots, double probOne) override {
+    std::binomial_distribution<std::size_t> dist(shots,
+                                                 std::clamp(probOne, 0., 1.));
+    return dist(qpp::RandomDevices::get_instance().get_prng());
+  }
+
+  /// @brief Apply the noise channels of the noise model for the given gate,
+  /// sampling one Kraus operator per channel (state vector only, the density
+  /// matrix simulator applies the full channels).
+  void applyNoiseChannel(const std::string_view gateName,
+                         const std::vector<std::size_t> &controls,
+                         const std::vector<std::size_t> &targets,
+                         const std::vector<double> &params) override {
+    if (!executionContext || !executionContext->noiseModel)
+      return;
+
+    auto krausChannels = executionContext->noiseModel->get_channels(
+        std::string(gateName), targets, controls, params);
+    if (krausChannels.empty())
+      return;
+
+    std::vector<std::size_t> qubits{controls.begin(), controls.end()};
+    qubits.insert(qubits.end(), targets.begin(), targets.end());
+    cudaq::info("Applying {} kraus channels to qubits {}", krausChannels.size(),
+                qubits);
+    for (auto &channel : krausChannels)
+      applyTrajectoryChannel(channel, qubits);
+  }
+
 public:
   QppCircuitSimulator() {
     // Populate the correct name so it is printed correctly during
     // deconstructor.
     summaryData.name = name();
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      // Default number of qubits for gate fusion.
+      constexpr std::size_t DEFAULT_FUSION_MAX_QUBITS = 4;
+      gateFusionMaxQubits = DEFAULT_FUSION_MAX_QUBITS;
+      if (auto envVal = std::getenv(fusionMaxQubitsEnvVar)) {
+        const std::string_view envStr(envVal);
+        int val = -1;
+        const auto [ptr, ec] =
+            std::from_chars(envStr.data(), envStr.data() + envStr.size(), val);
+        if (ec != std::errc() || ptr != envStr.data() + envStr.size() ||
+            val < 0)
+          throw std::runtime_error(
+              fmt::format("Invalid {} environment variable value: {}.",
+                          fusionMaxQubitsEnvVar, envVal));
+        cudaq::info("[qpp] Setting gate fusion max qubit count to {}.", val);
+        gateFusionMaxQubits = val;
+      }
+    }
   }
   virtual ~QppCircuitSimulator() = default;
 
@@ -302,6 +626,28 @@ public:
     qpp::RandomDevices::get_instance().get_prng().seed(seed);
   }
 
+  void setExecutionContext(cudaq::ExecutionContext *context) override {
+    trajectoryProgram.clear();
+    CircuitSimulatorBase::setExecutionContext(context);
+  }
+
+  /// @brief The state vector simulator supports all noise channels, by
+  /// sampling their Kraus operators (quantum trajectories).
+  bool isValidNoiseChannel(const cudaq::noise_model_type &type) const override {
+    return std::is_same_v<StateType, qpp::ket>;
+  }
+
+  void applyNoise(const cudaq::kraus_channel &channel,
+                  const std::vector<std::size_t> &qubits) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>) {
+      flushGateQueue();
+      cudaq::info("[qpp] apply kraus channel {}", channel.get_type_name());
+      applyTrajectoryChannel(channel, qubits);
+    } else {
+      CircuitSimulatorBase::applyNoise(channel, qubits);
+    }
+  }
+
   bool canHandleObserve() override {
     // Do not compute <H> from matrix if shots based sampling requested
     if (executionContext &&
@@ -319,16 +665,51 @@ public:
     // The op is on the following target bits.
     auto targets = op.degrees();
 
-    // Get the matrix as an Eigen matrix
-    auto matrix = op.to_matrix();
-    qpp::cmat asEigen = matrix.as_eigen();
-
     // Compute the expected value
     double ee = 0.0;
     if constexpr (std::is_same_v<StateType, qpp::ket>) {
-      qpp::ket k = qpp::apply(state, asEigen, targets, 2);
-      ee = state.dot(k).real();
+      // If the operator acts on the whole register, apply its Pauli strings
+      // to the state directly rather than building its (dense) matrix.
+      const auto numQubits = numStateQubits();
+      const bool matrixFree = !targets.empty() &&
+                              targets.size() == numQubits &&
+                              targets.back() == numQubits - 1;
+      std::vector<std::pair<std::complex<double>, std::string>> terms;
+      qpp::cmat asEigen;
+      if (matrixFree)
+        for (const auto &term : op)
+          terms.emplace_back(term.evaluate_coefficient(),
+                             term.get_pauli_word(numQubits));
+      else
+        asEigen = op.to_matrix().as_eigen();
+
+      const auto expectation = [&](const auto &psi) {
+        if (matrixFree) {
+          qpp::ket k(psi.size());
+          cudaq::spin_handler::apply(terms, psi.data(), k.data());
+          return psi.dot(k).real();
+        }
+        qpp::ket k = qpp::apply(psi, asEigen, targets, 2);
+        return psi.dot(k).real();
+      };
+      ee = expectation(state);
+      if (hasNoiseTrajectories()) {
+        // Average over the noise trajectories, the live state being the first.
+        const auto numTrajectories = std::max<std::size_t>(
+            1, executionContext->numberTrajectories.value_or(
+                   defaultNumTrajectoriesForObserve));
+        std::vector<double> expVals(numTrajectories);
+        expVals[0] = ee;
+        runTrajectories(numTrajectories, [&](std::size_t t,
+                                             const auto &trajectory, auto &) {
+          expVals[t] = expectation(Eigen::Map<const qpp::ket>(
+              trajectory.data(), trajectory.size()));
+        });
+        ee = std::accumulate(expVals.begin(), expVals.end(), 0.0) /
+             numTrajectories;
+      }
     } else {
+      qpp::cmat asEigen = op.to_matrix().as_eigen();
       ee = qpp::apply(asEigen, state, targets).trace().real();
     }
 
@@ -342,13 +723,26 @@ public:
   void resetQubit(const std::size_t index) override {
     flushGateQueue();
     flushAnySamplingTasks();
+    if (auto *recorder = getTrajectoryRecorder())
+      recorder->addReset(index);
+    invalidateGradientTape();
     const auto qubitIdx = convertQubitIndex(index);
+    if (isShotBranching()) {
+      // A reset measures the qubit, so its outcome is branched as well.
+      if (measureShotBranch(index))
+        state = qpp::apply(state, qpp::Gates::get_instance().X, {qubitIdx});
+      return;
+    }
     state = qpp::reset(state, {qubitIdx});
   }
 
   /// @brief Sample the multi-qubit state.
   cudaq::ExecutionResult sample(const std::vector<std::size_t> &qubits,
                                 const int shots) override {
+    if constexpr (std::is_same_v<StateType, qpp::ket>)
+      if (hasNoiseTrajectories())
+        return sampleTrajectories(qubits, shots);
+
     if (shots < 1) {
       double expectationValue = calculateExpectationValue(qubits);
       cudaq::info("Computed expectation value = {}", expectationValue);
@@ -361,35 +755,19 @@ public:
     }
 
     auto sampleResult = qpp::sample(shots, state, measuredBits, 2);
-    // Convert to what we expect
-    std::stringstream bitstream;
-    cudaq::ExecutionResult counts;
-
-    // Expectation value from the counts
-    double expVal = 0.0;
-    for (auto [result, count] : sampleResult) {
-      // Push back each term in the vector of bits to the bitstring.
-      for (const auto &bit : result) {
-        bitstream << bit;
-      }
-
-      // Add to the sample result
-      // in mid-circ sampling mode this will append 1 bitstring
-      auto bitstring = bitstream.str();
-      counts.appendResult(bitstring, count);
-      auto par = cudaq::sample_result::has_even_parity(bitstring);
-      auto p = count / (double)shots;
-      if (!par) {
-        p = -p;
-      }
-      expVal += p;
-      // Reset the state.
-      bitstream.str("");
-      bitstream.clear();
+    // Convert to what we expect, forming each bit string once.
+    cudaq::PackedCounts counts(qubits.size());
+    std::vector<std::uint64_t> words(counts.numWords());
+    for (auto &[result, count] : sampleResult) {
+      std::fill(words.begin(), words.end(), 0);
+      for (std::size_t i = 0; i < result.size(); ++i)
+        words[i / 64] |= static_cast<std::uint64_t>(result[i] & 1) << (i % 64);
+      counts.add(words.data(), count);
     }
 
-    counts.expectationValue = expVal;
-    return counts;
+    auto result = counts.toExecutionResult();
+    result.expectationValue = counts.expectationZ();
+    return result;
   }
 
   std::unique_ptr<cudaq::SimulationState> getSimulationState() override {
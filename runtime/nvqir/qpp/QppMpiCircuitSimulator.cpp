@@ -0,0 +1,705 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#define __NVQIR_QPP_TOGGLE_CREATE
+
+#include "QppCircuitSimulator.cpp"
+#include "StateVectorKernels.h"
+#include "cudaq/distributed/mpi_plugin.h"
+
+#include <limits>
+#include <numeric>
+#include <random>
+
+using namespace cudaq;
+
+namespace {
+
+/// @brief The number of amplitudes sent per message in pairwise exchanges,
+/// which bounds the size of the communication buffers.
+constexpr std::size_t exchangeChunkSize = 1ULL << 20;
+
+/// @brief States are only distributed once every rank holds at least this
+/// many qubits. Smaller states are replicated on all ranks.
+constexpr std::size_t minLocalQubits = 4;
+
+/// @brief The QppMpiCircuitSimulator distributes the state vector over the
+/// ranks of the MPI communicator, so that the number of qubits is no longer
+/// bounded by the memory of a single node. With `2^k` ranks, each rank holds
+/// the `2^(n-k)` amplitudes whose `k` most significant (global) bits are the
+/// rank, and applies gates on its local amplitudes with the in-place kernels
+/// of StateVectorKernels.h.
+///
+/// The logical qubits are mapped to physical bits of the amplitude index.
+/// Gates controlled by a global qubit only run on the ranks where it is set,
+/// and diagonal gates on global qubits are reduced to local ones. Before any
+/// other gate on a global qubit, that qubit is swapped with a local qubit, by
+/// exchanging half of the local amplitudes with the partner rank, and the
+/// mapping is updated (the qubits are not swapped back). Measurements,
+/// sampling and expectation values use reductions over the ranks, with the
+/// random numbers drawn on rank 0, so that all ranks obtain the same results.
+///
+/// Without MPI, or with a single rank, this is the `qpp-simd` simulator.
+class QppMpiCircuitSimulator : public nvqir::QppCircuitSimulator<qpp::ket> {
+protected:
+  using complex = std::complex<double>;
+
+  /// @brief The MPI plugin, or null until the first allocation and without
+  /// MPI.
+  cudaqDistributedInterface_t *mpi = nullptr;
+  cudaqDistributedCommunicator_t *comm = nullptr;
+  bool commInitialized = false;
+  std::size_t rank = 0;
+  std::size_t numRanks = 1;
+  /// @brief `log2(numRanks)`, the number of global qubits of a distributed
+  /// state.
+  std::size_t numRankQubits = 0;
+
+  /// @brief The number of qubits in the state, and how many of them are
+  /// global (zero while the state is replicated on all ranks).
+  std::size_t numQubits = 0;
+  std::size_t numGlobalQubits = 0;
+  /// @brief The physical bit of each logical qubit, and the reverse mapping.
+  std::vector<std::size_t> physicalQubit;
+  std::vector<std::size_t> logicalQubit;
+
+  /// @brief Communication buffers of the pairwise exchanges.
+  std::vector<complex> sendBuffer, recvBuffer;
+
+  void checkMpi(int status, const char *call) {
+    if (status != 0)
+      throw std::runtime_error(
+          fmt::format("[qpp-mpi] MPI {} failed with error {}.", call, status));
+  }
+
+  /// @brief Retrieve the MPI communicator on first use, since MPI is
+  /// initialized after the simulator is created.
+  void initializeCommunicator() {
+    if (commInitialized)
+      return;
+    commInitialized = true;
+    auto *plugin = cudaq::mpi::getMpiPlugin(/*unsafe=*/true);
+    if (!plugin || !plugin->is_initialized()) {
+      cudaq::info("[qpp-mpi] MPI is not initialized, simulating on a single "
+                  "process.");
+      return;
+    }
+    mpi = plugin->get();
+    comm = plugin->getComm();
+    rank = plugin->rank();
+    numRanks = plugin->num_ranks();
+    if (!std::has_single_bit(numRanks))
+      throw std::runtime_error(fmt::format(
+          "[qpp-mpi] The number of MPI ranks must be a power of 2, got {}.",
+          numRanks));
+    numRankQubits = std::countr_zero(numRanks);
+    cudaq::info("[qpp-mpi] Distributing the state vector over {} ranks.",
+                numRanks);
+  }
+
+  bool isDistributed() const { return numGlobalQubits > 0; }
+  std::size_t numLocalQubits() const { return numQubits - numGlobalQubits; }
+
+  /// @brief Return the value of the global physical bit on this rank.
+  bool rankBit(std::size_t physical) const {
+    return (rank >> (physical - numLocalQubits())) & 1ULL;
+  }
+
+  /// @brief Return the sum of `value` over the ranks of a distributed state.
+  double reduceSum(double value) {
+    if (!isDistributed())
+      return value;
+    double sum = 0.;
+    checkMpi(mpi->Allreduce(comm, &value, &sum, 1, FLOAT_64, SUM),
+             "Allreduce");
+    return sum;
+  }
+
+  /// @brief Return the value of rank 0. Random numbers are drawn on rank 0
+  /// and broadcast, since ranks need not be seeded identically.
+  template <typename T>
+  T broadcastFromRoot(T value, DataType type) {
+    if (numRanks > 1)
+      checkMpi(mpi->Bcast(comm, &value, 1, type, 0), "Bcast");
+    return value;
+  }
+
+  double drawUniform() {
+    std::uniform_real_distribution<double> dist(0., 1.);
+    const double draw =
+        rank == 0 ? dist(qpp::RandomDevices::get_instance().get_prng()) : 0.;
+    return broadcastFromRoot(draw, FLOAT_64);
+  }
+
+  void updateLogicalQubits() {
+    logicalQubit.assign(numQubits, 0);
+    for (std::size_t q = 0; q < numQubits; ++q)
+      logicalQubit[physicalQubit[q]] = q;
+  }
+
+  /// @brief Grow the state by `count` qubits, initialized to `init` (or
+  /// |0>). All qubits of a replicated state are in identity order, and the
+  /// state is distributed once it is large enough. The new qubits of a
+  /// distributed state are mapped to new local bits, above the existing local
+  /// ones, so that the amplitudes of each rank stay in place.
+  void growState(std::size_t count, const complex *init) {
+    const auto newAmplitude = [&](std::size_t j) -> complex {
+      return init ? init[j] : (j == 0 ? 1. : 0.);
+    };
+
+    if (isDistributed()) {
+      const auto oldNumLocal = numLocalQubits();
+      for (auto &p : physicalQubit)
+        if (p >= oldNumLocal)
+          p += count;
+      for (std::size_t i = 0; i < count; ++i)
+        physicalQubit.push_back(oldNumLocal + i);
+      numQubits += count;
+      updateLogicalQubits();
+
+      const std::size_t oldSize = state.size();
+      qpp::ket grown(1ULL << numLocalQubits());
+      const std::int64_t newSize = grown.size();
+#if defined(_OPENMP)
+#pragma omp parallel for if (numLocalQubits() >= nvqir::sv::minParallelQubits)
+#endif
+      for (std::int64_t i = 0; i < newSize; ++i)
+        grown[i] = newAmplitude(i >> oldNumLocal) * state[i % oldSize];
+      state = std::move(grown);
+      return;
+    }
+
+    if (state.size() == 0) {
+      state = qpp::ket::Ones(1);
+      numQubits = 0;
+    }
+    const auto oldNumQubits = numQubits;
+    for (std::size_t i = 0; i < count; ++i)
+      physicalQubit.push_back(oldNumQubits + i);
+    numQubits += count;
+    updateLogicalQubits();
+    if (numRanks > 1 && numQubits >= numRankQubits + minLocalQubits) {
+      numGlobalQubits = numRankQubits;
+      cudaq::info("[qpp-mpi] Distributing {} qubits, {} local qubits per "
+                  "rank.",
+                  numQubits, numLocalQubits());
+    }
+
+    // Only compute this rank's part of the new state.
+    const std::size_t oldSize = state.size();
+    const std::size_t offset = isDistributed() ? rank << numLocalQubits() : 0;
+    qpp::ket grown(1ULL << numLocalQubits());
+    const std::int64_t newSize = grown.size();
+#if defined(_OPENMP)
+#pragma omp parallel for if (numLocalQubits() >= nvqir::sv::minParallelQubits)
+#endif
+    for (std::int64_t i = 0; i < newSize; ++i) {
+      const std::size_t index = offset + i;
+      grown[i] = newAmplitude(index >> oldNumQubits) * state[index % oldSize];
+    }
+    state = std::move(grown);
+  }
+
+  void addQubitToState() override { addQubitsToState(1); }
+
+  void addQubitsToState(std::size_t qubitCount,
+                        const void *stateDataIn = nullptr) override {
+    if (qubitCount == 0)
+      return;
+    initializeCommunicator();
+    growState(qubitCount, reinterpret_cast<const complex *>(stateDataIn));
+  }
+
+  void addQubitsToState(const cudaq::SimulationState &in_state) override {
+    const auto *casted = dynamic_cast<const nvqir::QppState *>(&in_state);
+    if (!casted)
+      throw std::invalid_argument(
+          "[QppMpiCircuitSimulator] Incompatible state input");
+    addQubitsToState(casted->getNumQubits(), casted->state.data());
+  }
+
+  void deallocateStateImpl() override {
+    state = qpp::ket();
+    numQubits = 0;
+    numGlobalQubits = 0;
+    physicalQubit.clear();
+    logicalQubit.clear();
+    sendBuffer = {};
+    recvBuffer = {};
+  }
+
+  void setToZeroState() override {
+    state.setZero();
+    if (!isDistributed() || rank == 0)
+      state(0) = 1.;
+  }
+
+  /// @brief Swap the global physical bit `global` with the local physical bit
+  /// `local`. This rank keeps its amplitudes whose local bit equals its global
+  /// bit, and exchanges the other half with the rank that differs in the
+  /// global bit.
+  void swapGlobalQubit(std::size_t global, std::size_t local) {
+    const auto numLocal = numLocalQubits();
+    const std::size_t rankMask = 1ULL << (global - numLocal);
+    const int partner = static_cast<int>(rank ^ rankMask);
+    const std::size_t sentBit = (rank & rankMask) ? 0 : (1ULL << local);
+    const std::size_t half = 1ULL << (numLocal - 1);
+    const std::size_t chunk = std::min(exchangeChunkSize, half);
+    sendBuffer.resize(chunk);
+    recvBuffer.resize(chunk);
+    for (std::size_t start = 0; start < half; start += chunk) {
+      const std::int64_t n = std::min(chunk, half - start);
+      const auto indexOf = [&](std::size_t k) {
+        return nvqir::sv::insertZeroBits(start + k, &local, 1) | sentBit;
+      };
+#if defined(_OPENMP)
+#pragma omp parallel for if (n >= (1LL << nvqir::sv::minParallelQubits))
+#endif
+      for (std::int64_t k = 0; k < n; ++k)
+        sendBuffer[k] = state[indexOf(k)];
+      checkMpi(mpi->SendRecvAsync(comm, sendBuffer.data(), recvBuffer.data(),
+                                  n, DOUBLE_COMPLEX, partner, 0),
+               "SendRecvAsync");
+      checkMpi(mpi->Synchronize(comm), "Synchronize");
+#if defined(_OPENMP)
+#pragma omp parallel for if (n >= (1LL << nvqir::sv::minParallelQubits))
+#endif
+      for (std::int64_t k = 0; k < n; ++k)
+        state[indexOf(k)] = recvBuffer[k];
+    }
+    std::swap(physicalQubit[logicalQubit[global]],
+              physicalQubit[logicalQubit[local]]);
+    std::swap(logicalQubit[global], logicalQubit[local]);
+  }
+
+  /// @brief Apply a gate on logical qubits.
+  void applyLogicalGate(const std::vector<complex> &matrix,
+                        const std::vector<std::size_t> &controls,
+                        const std::vector<std::size_t> &targets) {
+    const auto numLocal = numLocalQubits();
+    if (!isDistributed()) {
+      nvqir::sv::applyGate(state.data(), numLocal, matrix, controls, targets);
+      return;
+    }
+    if (targets.size() > numLocal)
+      throw std::runtime_error(fmt::format(
+          "[qpp-mpi] Gates on {} qubits are not supported with {} local "
+          "qubits per rank.",
+          targets.size(), numLocal));
+
+    std::vector<std::size_t> physTargets;
+    for (auto t : targets)
+      physTargets.push_back(physicalQubit[t]);
+    const bool diagonal = nvqir::sv::isDiagonal(matrix, 1ULL << targets.size());
+    if (!diagonal) {
+      // Bring the global targets to the highest local bits not used by the
+      // gate, preferably not controls either.
+      const auto isUsed = [&](std::size_t p, bool withControls) {
+        if (std::find(physTargets.begin(), physTargets.end(), p) !=
+            physTargets.end())
+          return true;
+        return withControls &&
+               std::any_of(controls.begin(), controls.end(),
+                           [&](auto c) { return physicalQubit[c] == p; });
+      };
+      for (auto &t : physTargets) {
+        if (t < numLocal)
+          continue;
+        std::optional<std::size_t> local;
+        for (bool withControls : {true, false}) {
+          for (std::size_t p = numLocal; p-- > 0 && !local;)
+            if (!isUsed(p, withControls))
+              local = p;
+          if (local)
+            break;
+        }
+        swapGlobalQubit(t, *local);
+        t = *local;
+      }
+    }
+
+    std::vector<std::size_t> localControls;
+    for (auto c : controls) {
+      const auto p = physicalQubit[c];
+      if (p < numLocal)
+        localControls.push_back(p);
+      else if (!rankBit(p))
+        // The control is not set on any amplitude of this rank.
+        return;
+    }
+
+    if (std::all_of(physTargets.begin(), physTargets.end(),
+                    [&](auto p) { return p < numLocal; })) {
+      nvqir::sv::applyGate(state.data(), numLocal, matrix, localControls,
+                           physTargets);
+      return;
+    }
+
+    // A diagonal gate on global qubits is the diagonal gate on the local
+    // targets (possibly none) given the global bits of this rank.
+    std::vector<std::size_t> localTargets;
+    for (auto p : physTargets)
+      if (p < numLocal)
+        localTargets.push_back(p);
+    const std::size_t dim = 1ULL << targets.size();
+    const std::size_t localDim = 1ULL << localTargets.size();
+    std::vector<complex> localMatrix(localDim * localDim, 0.);
+    for (std::size_t r = 0; r < localDim; ++r) {
+      std::size_t row = 0;
+      std::size_t nextLocal = 0;
+      for (auto p : physTargets) {
+        const bool bit =
+            p < numLocal
+                ? (r >> (localTargets.size() - 1 - nextLocal++)) & 1ULL
+                : rankBit(p);
+        row = (row << 1) | bit;
+      }
+      localMatrix[r * localDim + r] = matrix[row * dim + row];
+    }
+    nvqir::sv::applyGate(state.data(), numLocal, localMatrix, localControls,
+                         localTargets);
+  }
+
+  void applyGate(const GateApplicationTask &task) override {
+    applyLogicalGate(task.matrix, task.controls, task.targets);
+  }
+
+  double probabilityOfOne(const std::size_t index) override {
+    const auto p = physicalQubit[index];
+    const auto numLocal = numLocalQubits();
+    double prob = 0.;
+    if (p < numLocal)
+      prob = nvqir::sv::probabilityOfOne(state.data(), numLocal, p);
+    else if (rankBit(p))
+      prob = nvqir::sv::normSquared(state.data(), numLocal);
+    return reduceSum(prob);
+  }
+
+  void collapseQubit(const std::size_t index, bool outcome,
+                     double probability) override {
+    const auto p = physicalQubit[index];
+    const auto numLocal = numLocalQubits();
+    if (p < numLocal)
+      nvqir::sv::collapse(state.data(), numLocal, p, outcome, probability);
+    else if (rankBit(p) == outcome)
+      state *= 1. / std::sqrt(probability);
+    else
+      state.setZero();
+  }
+
+  bool measureQubit(const std::size_t index) override {
+    const double probOne = probabilityOfOne(index);
+    const bool result = drawUniform() < probOne;
+    collapseQubit(index, result, result ? probOne : 1. - probOne);
+    cudaq::info("Measured qubit {} -> {}", index, result);
+    return result;
+  }
+
+  std::size_t sampleNumOnes(std::size_t shots, double probOne) override {
+    std::int64_t numOnes = 0;
+    if (rank == 0)
+      numOnes = QppCircuitSimulator::sampleNumOnes(shots, probOne);
+    return broadcastFromRoot(numOnes, INT_64);
+  }
+
+  bool computeAdjointGradient() override {
+    if (isDistributed())
+      return false;
+    return QppCircuitSimulator::computeAdjointGradient();
+  }
+
+  /// @brief Return `<P>` for the Pauli string `P`, which has an X or Y on
+  /// the physical bits of `xMask` and a Z or Y on those of `zMask`, on the
+  /// local amplitudes. The amplitudes `P` maps them to are on the rank that
+  /// differs in the global bits of `xMask`, and are received block by block.
+  double localPauliExpectation(std::size_t xMask, std::size_t zMask) {
+    static const complex powersOfI[] = {1., {0., 1.}, -1., {0., -1.}};
+    const complex phase = powersOfI[std::popcount(xMask & zMask) % 4];
+    const auto numLocal = numLocalQubits();
+    const std::size_t localMask = (1ULL << numLocal) - 1;
+    const std::size_t xLocal = xMask & localMask;
+    const std::size_t zLocal = zMask & localMask;
+    const std::size_t xRank = xMask >> numLocal;
+    const bool rankSign = std::popcount(rank & (zMask >> numLocal)) % 2;
+
+    const auto blockSum = [&](std::size_t start, std::size_t n,
+                              const complex *partner, std::size_t xBlock) {
+      double sum = 0.;
+      const std::int64_t numIter = n;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : sum) if (numLocal >= nvqir::sv::minParallelQubits)
+#endif
+      for (std::int64_t k = 0; k < numIter; ++k) {
+        const std::size_t i = start + k;
+        const bool negate = (std::popcount(i & zLocal) % 2) != rankSign;
+        const auto term = std::conj(partner[k ^ xBlock]) * phase * state[i];
+        sum += negate ? -term.real() : term.real();
+      }
+      return sum;
+    };
+
+    const std::size_t size = state.size();
+    if (xRank == 0) {
+      // The partner amplitudes are local: P maps `i` to `i ^ xLocal`.
+      double sum = 0.;
+      const std::int64_t numIter = size;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : sum) if (numLocal >= nvqir::sv::minParallelQubits)
+#endif
+      for (std::int64_t k = 0; k < numIter; ++k) {
+        const std::size_t i = k;
+        const bool negate = (std::popcount(i & zLocal) % 2) != rankSign;
+        const auto term = std::conj(state[i ^ xLocal]) * phase * state[i];
+        sum += negate ? -term.real() : term.real();
+      }
+      return sum;
+    }
+
+    // Block `b` needs the partner's block `b ^ (xLocal / chunk)`, which is
+    // also the block the partner needs from this rank at the same step.
+    const std::size_t chunk = std::min(exchangeChunkSize, size);
+    const std::size_t xBlocks = xLocal / chunk;
+    const std::size_t xInBlock = xLocal % chunk;
+    const int partner = static_cast<int>(rank ^ xRank);
+    recvBuffer.resize(chunk);
+    double sum = 0.;
+    for (std::size_t block = 0; block < size / chunk; ++block) {
+      const std::size_t sentBlock = block ^ xBlocks;
+      checkMpi(mpi->SendRecvAsync(comm, state.data() + sentBlock * chunk,
+                                  recvBuffer.data(), chunk, DOUBLE_COMPLEX,
+                                  partner, 0),
+               "SendRecvAsync");
+      checkMpi(mpi->Synchronize(comm), "Synchronize");
+      sum += blockSum(block * chunk, chunk, recvBuffer.data(), xInBlock);
+    }
+    return sum;
+  }
+
+  /// @brief Draw `shots` basis states, and return the measured bits of the
+  /// sampled states of this rank, `numWords` words per shot.
+  std::vector<std::uint64_t>
+  sampleLocalBits(const std::vector<std::size_t> &qubits, std::size_t shots,
+                  std::size_t numWords) {
+    const auto numLocal = numLocalQubits();
+    // All ranks draw the same shots, from a seed shared by rank 0.
+    const auto seed = broadcastFromRoot<std::int64_t>(
+        rank == 0 ? qpp::RandomDevices::get_instance().get_prng()() : 0,
+        INT_64);
+    std::mt19937_64 rng(seed);
+
+    const double localNorm = nvqir::sv::normSquared(state.data(), numLocal);
+    std::vector<double> norms{localNorm};
+    if (isDistributed()) {
+      norms.resize(numRanks);
+      checkMpi(mpi->Allgather(comm, &localNorm, norms.data(), 1, FLOAT_64),
+               "Allgather");
+    }
+    const double totalNorm = std::accumulate(norms.begin(), norms.end(), 0.);
+    std::uniform_real_distribution<double> dist(0., 1.);
+    std::vector<double> draws(shots);
+    for (auto &r : draws)
+      r = dist(rng) * totalNorm;
+    std::sort(draws.begin(), draws.end());
+
+    // This rank's shots are the draws within its part of the cumulative
+    // distribution. Rounding may leave the largest draws above the total,
+    // they go to the last rank with a nonzero norm.
+    const std::size_t self = isDistributed() ? rank : 0;
+    std::size_t lastRank = 0;
+    for (std::size_t r = 0; r < norms.size(); ++r)
+      if (norms[r] > 0.)
+        lastRank = r;
+    const double offset =
+        std::accumulate(norms.begin(), norms.begin() + self, 0.);
+    auto draw = std::lower_bound(draws.begin(), draws.end(), offset);
+    const auto end = self == lastRank
+                         ? draws.end()
+                         : std::lower_bound(draw, draws.end(),
+                                            offset + localNorm);
+    if (self > lastRank)
+      draw = end;
+
+    std::vector<std::uint64_t> bits;
+    bits.reserve(numWords * (end - draw));
+    const auto appendShot = [&](std::size_t index) {
+      bits.resize(bits.size() + numWords, 0);
+      auto *words = bits.data() + bits.size() - numWords;
+      for (std::size_t i = 0; i < qubits.size(); ++i) {
+        const auto p = physicalQubit[qubits[i]];
+        const std::uint64_t bit =
+            p < numLocal ? (index >> p) & 1ULL : rankBit(p);
+        words[i / 64] |= bit << (i % 64);
+      }
+    };
+    std::size_t lastNonZero = 0;
+    double cumulative = offset;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(state.size()) &&
+                            draw != end;
+         ++i) {
+      const double prob = std::norm(state[i]);
+      if (prob == 0.)
+        continue;
+      lastNonZero = i;
+      cumulative += prob;
+      for (; draw != end && *draw < cumulative; ++draw)
+        appendShot(i);
+    }
+    for (; draw != end; ++draw)
+      appendShot(lastNonZero);
+    return bits;
+  }
+
+public:
+  QppMpiCircuitSimulator() { summaryData.name = name(); }
+  virtual ~QppMpiCircuitSimulator() = default;
+
+  /// @brief Noise is not supported, since the noise trajectories are
+  /// recorded and replayed on a full state vector.
+  bool isValidNoiseChannel(const cudaq::noise_model_type &type) const override {
+    return false;
+  }
+
+  void applyNoise(const cudaq::kraus_channel &channel,
+                  const std::vector<std::size_t> &qubits) override {
+    throw std::runtime_error(
+        "[qpp-mpi] Noise simulation is not supported by this backend.");
+  }
+
+  void applyNoiseChannel(const std::string_view gateName,
+                         const std::vector<std::size_t> &controls,
+                         const std::vector<std::size_t> &targets,
+                         const std::vector<double> &params) override {
+    if (!executionContext || !executionContext->noiseModel ||
+        executionContext->noiseModel->empty())
+      return;
+    throw std::runtime_error(
+        "[qpp-mpi] Noise simulation is not supported by this backend.");
+  }
+
+  cudaq::observe_result observe(const cudaq::spin_op &op) override {
+    assert(cudaq::spin_op::canonicalize(op) == op);
+    flushGateQueue();
+
+    double ee = 0.;
+    for (const auto &term : op) {
+      std::size_t xMask = 0, zMask = 0;
+      for (const auto &pauli : term) {
+        const auto type = pauli.as_pauli();
+        const std::size_t mask = 1ULL << physicalQubit[pauli.target()];
+        if (type == cudaq::pauli::X || type == cudaq::pauli::Y)
+          xMask |= mask;
+        if (type == cudaq::pauli::Z || type == cudaq::pauli::Y)
+          zMask |= mask;
+      }
+      ee += term.evaluate_coefficient().real() *
+            localPauliExpectation(xMask, zMask);
+    }
+    ee = reduceSum(ee);
+
+    return cudaq::observe_result(
+        ee, op,
+        cudaq::sample_result(cudaq::ExecutionResult({}, op.to_string(), ee)));
+  }
+
+  void resetQubit(const std::size_t index) override {
+    flushGateQueue();
+    flushAnySamplingTasks();
+    invalidateGradientTape();
+    static const std::vector<complex> xMatrix{0., 1., 1., 0.};
+    const bool isOne =
+        isShotBranching() ? measureShotBranch(index) : measureQubit(index);
+    if (isOne)
+      applyLogicalGate(xMatrix, {}, {index});
+  }
+
+  cudaq::ExecutionResult sample(const std::vector<std::size_t> &qubits,
+                                const int shots) override {
+    const auto numLocal = numLocalQubits();
+    if (shots < 1) {
+      std::size_t localMask = 0;
+      bool negate = false;
+      for (auto q : qubits) {
+        const auto p = physicalQubit[q];
+        if (p < numLocal)
+          localMask |= (1ULL << p);
+        else
+          negate ^= rankBit(p);
+      }
+      double expectationValue =
+          nvqir::sv::parityExpectation(state.data(), numLocal, localMask);
+      expectationValue =
+          reduceSum(negate ? -expectationValue : expectationValue);
+      cudaq::info("Computed expectation value = {}", expectationValue);
+      return cudaq::ExecutionResult{{}, expectationValue};
+    }
+
+    cudaq::PackedCounts counts(qubits.size());
+    const auto numWords = counts.numWords();
+    auto bits = sampleLocalBits(qubits, shots, numWords);
+    if (isDistributed()) {
+      // Gather the shots of all ranks, in rank order.
+      std::int32_t localCount = bits.size();
+      std::vector<std::int32_t> sizes(numRanks), offsets(numRanks, 0);
+      checkMpi(mpi->Allgather(comm, &localCount, sizes.data(), 1, INT_32),
+               "Allgather");
+      std::partial_sum(sizes.begin(), sizes.end() - 1, offsets.begin() + 1);
+      std::vector<std::uint64_t> allBits(offsets.back() + sizes.back());
+      checkMpi(mpi->AllgatherV(comm, bits.data(), localCount, allBits.data(),
+                               sizes.data(), offsets.data(), INT_64),
+               "AllgatherV");
+      bits = std::move(allBits);
+    }
+    for (std::size_t i = 0; i < bits.size(); i += numWords)
+      counts.add(bits.data() + i);
+
+    auto result = counts.toExecutionResult();
+    result.expectationValue = counts.expectationZ();
+    return result;
+  }
+
+  /// @brief Return the state vector. A distributed state is gathered on every
+  /// rank, and must therefore fit in the memory of a single node.
+  std::unique_ptr<cudaq::SimulationState> getSimulationState() override {
+    flushGateQueue();
+    if (!isDistributed())
+      return std::make_unique<nvqir::QppState>(qpp::ket(state));
+
+    const std::size_t localSize = state.size();
+    if (localSize > static_cast<std::size_t>(
+                        std::numeric_limits<std::int32_t>::max()))
+      throw std::runtime_error(
+          "[qpp-mpi] The state vector is too large to be gathered.");
+    qpp::ket gathered(localSize * numRanks);
+    checkMpi(mpi->Allgather(comm, state.data(), gathered.data(), localSize,
+                            DOUBLE_COMPLEX),
+             "Allgather");
+    // Reorder the physical bits of the amplitude indices into logical ones.
+    qpp::ket full(gathered.size());
+    const std::int64_t dim = gathered.size();
+#if defined(_OPENMP)
+#pragma omp parallel for if (numQubits >= nvqir::sv::minParallelQubits)
+#endif
+    for (std::int64_t i = 0; i < dim; ++i) {
+      std::size_t index = 0;
+      for (std::size_t p = 0; p < numQubits; ++p)
+        index |= ((static_cast<std::size_t>(i) >> p) & 1ULL)
+                 << logicalQubit[p];
+      full[index] = gathered[i];
+    }
+    return std::make_unique<nvqir::QppState>(std::move(full));
+  }
+
+  std::string name() const override { return "qpp-mpi"; }
+  NVQIR_SIMULATOR_CLONE_IMPL(QppMpiCircuitSimulator)
+};
+
+} // namespace
+
+/// Register this Simulator with NVQIR.
+NVQIR_REGISTER_SIMULATOR(QppMpiCircuitSimulator, qpp_mpi)
+#undef __NVQIR_QPP_TOGGLE_CREATE
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#define __NVQIR_QPP_TOGGLE_CREATE
+
+#include "QppCircuitSimulator.cpp"
+#include "StateVectorKernels.h"
+
+#include <random>
+
+using namespace cudaq;
+
+namespace {
+
+/// @brief The QppSimdCircuitSimulator further specializes the state vector
+/// QppCircuitSimulator to apply gates and measurements in place, using the
+/// SIMD (AVX2 / AVX-512) and OpenMP kernels from StateVectorKernels.h rather
+/// than `qpp::apply`, which allocates and copies the full state for every gate.
+class QppSimdCircuitSimulator : public nvqir::QppCircuitSimulator<qpp::ket> {
+protected:
+  void applyGate(const GateApplicationTask &task) override {
+    recordGate(task);
+    // The task matrix is MSB ordered with respect to its targets (see
+    // getQubitOrdering()), and CUDA-Q qubit `q` is bit `q` of a state index,
+    // which is the convention of the kernels.
+    nvqir::sv::applyGate(state.data(), numStateQubits(), task.matrix,
+                         task.controls, task.targets);
+  }
+
+  /// @brief Measure the qubit and collapse the state vector in place.
+  bool measureQubit(const std::size_t index) override {
+    recordMeasurement(index);
+    const auto numQubits = numStateQubits();
+    const double probOne =
+        nvqir::sv::probabilityOfOne(state.data(), numQubits, index);
+    std::uniform_real_distribution<double> dist(0., 1.);
+    const bool result =
+        dist(qpp::RandomDevices::get_instance().get_prng()) < probOne;
+    nvqir::sv::collapse(state.data(), numQubits, index, result,
+                        result ? probOne : 1. - probOne);
+    cudaq::info("Measured qubit {} -> {}", index, result);
+    return result;
+  }
+
+public:
+  QppSimdCircuitSimulator() { summaryData.name = name(); }
+  virtual ~QppSimdCircuitSimulator() = default;
+  std::string name() const override { return "qpp-simd"; }
+  NVQIR_SIMULATOR_CLONE_IMPL(QppSimdCircuitSimulator)
+};
+
+} // namespace
+
+/// Register this Simulator with NVQIR.
+NVQIR_REGISTER_SIMULATOR(QppSimdCircuitSimulator, qpp_simd)
+#undef __NVQIR_QPP_TOGGLE_CREATE
@@ -0,0 +1,317 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NVQIR_SV_KERNELS_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/// In-place gate application kernels for a double precision state vector.
+///
+/// Qubit `q` corresponds to bit `q` of a state vector index. Gate matrices are
+/// row-major and MSB ordered with respect to their targets, i.e., the first
+/// target is the most significant bit of a gate matrix row/column index. Every
+/// kernel only visits the amplitudes where all control bits are set, and
+/// updates them without allocating a new state.
+namespace nvqir::sv {
+
+using complex = std::complex<double>;
+
+/// @brief Only parallelize over amplitudes for states at least this large.
+/// Below that, the OpenMP fork/join overhead outweighs the gain.
+static constexpr std::size_t minParallelQubits = 14;
+
+/// @brief Insert a zero bit at each of the `numPositions` (ascending)
+/// positions into `k`.
+inline std::size_t insertZeroBits(std::size_t k, const std::size_t *positions,
+                                  std::size_t numPositions) {
+  for (std::size_t i = 0; i < numPositions; ++i) {
+    const std::size_t low = k & ((1ULL << positions[i]) - 1);
+    k = ((k ^ low) << 1) | low;
+  }
+  return k;
+}
+
+/// @brief Bookkeeping shared by all kernels: the sorted qubit positions that
+/// are fixed by the gate, the control mask, and the number of base indices
+/// to iterate over.
+struct KernelIndexing {
+  std::vector<std::size_t> positions;
+  std::size_t controlMask = 0;
+  std::size_t numBase = 0;
+
+  KernelIndexing(std::size_t numQubits,
+                 const std::vector<std::size_t> &controls,
+                 const std::vector<std::size_t> &targets) {
+    positions.insert(positions.end(), controls.begin(), controls.end());
+    positions.insert(positions.end(), targets.begin(), targets.end());
+    std::sort(positions.begin(), positions.end());
+    for (auto c : controls)
+      controlMask |= (1ULL << c);
+    assert(positions.size() <= numQubits && "Invalid gate qubits");
+    numBase = 1ULL << (numQubits - positions.size());
+  }
+
+  /// @brief Return the state index of the `k`-th base amplitude, i.e., with
+  /// all controls set and all targets cleared.
+  std::size_t base(std::size_t k) const {
+    return insertZeroBits(k, positions.data(), positions.size()) | controlMask;
+  }
+
+  /// @brief Return the number of consecutive base amplitudes that are also
+  /// consecutive in the state vector.
+  std::size_t contiguousRun() const {
+    return positions.empty() ? numBase : (1ULL << positions.front());
+  }
+};
+
+/// @brief Return the offsets (relative to a base amplitude) of each row of a
+/// gate matrix acting on the given targets.
+inline std::vector<std::size_t>
+targetOffsets(const std::vector<std::size_t> &targets) {
+  const std::size_t nTargets = targets.size();
+  std::vector<std::size_t> offsets(1ULL << nTargets, 0);
+  for (std::size_t r = 0; r < offsets.size(); ++r)
+    for (std::size_t i = 0; i < nTargets; ++i)
+      if ((r >> (nTargets - 1 - i)) & 1ULL)
+        offsets[r] |= (1ULL << targets[i]);
+  return offsets;
+}
+
+/// @brief Return true if the (square, row-major) matrix is diagonal.
+inline bool isDiagonal(const std::vector<complex> &matrix, std::size_t dim) {
+  for (std::size_t r = 0; r < dim; ++r)
+    for (std::size_t c = 0; c < dim; ++c)
+      if (r != c && matrix[r * dim + c] != 0.)
+        return false;
+  return true;
+}
+
+#ifdef NVQIR_SV_KERNELS_X86_SIMD
+/// @brief Supported SIMD instruction sets, in increasing order of width.
+enum class SimdLevel { none, avx2, avx512 };
+
+/// @brief Detect the widest SIMD instruction set supported by the host CPU.
+inline SimdLevel hostSimdLevel() {
+  static const SimdLevel level = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+      return SimdLevel::avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return SimdLevel::avx2;
+    return SimdLevel::none;
+  }();
+  return level;
+}
+
+/// @brief Multiply two packed complex numbers by a broadcast complex number.
+__attribute__((target("avx2,fma"))) inline __m256d
+cmul(__m256d v, __m256d re, __m256d im) {
+  return _mm256_fmaddsub_pd(v, re,
+                            _mm256_mul_pd(_mm256_permute_pd(v, 0x5), im));
+}
+
+/// @brief Multiply four packed complex numbers by a broadcast complex number.
+__attribute__((target("avx512f"))) inline __m512d cmul(__m512d v, __m512d re,
+                                                       __m512d im) {
+  return _mm512_fmaddsub_pd(v, re,
+                            _mm512_mul_pd(_mm512_shuffle_pd(v, v, 0x55), im));
+}
+
+/// @brief Dense 1- or 2-qubit kernel, processing 2 consecutive base amplitudes
+/// per iteration. Requires `contiguousRun() >= 2`.
+template <std::size_t NumTargets>
+__attribute__((target("avx2,fma"))) void
+applyDenseAvx2(complex *state, const KernelIndexing &indexing,
+               const std::vector<std::size_t> &offsets,
+               const std::vector<complex> &matrix) {
+  constexpr std::size_t dim = 1ULL << NumTargets;
+  __m256d re[dim * dim], im[dim * dim];
+  for (std::size_t i = 0; i < dim * dim; ++i) {
+    re[i] = _mm256_set1_pd(matrix[i].real());
+    im[i] = _mm256_set1_pd(matrix[i].imag());
+  }
+  const std::int64_t numIter = indexing.numBase / 2;
+  auto *data = reinterpret_cast<double *>(state);
+#if defined(_OPENMP)
+#pragma omp parallel for if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+  for (std::int64_t k = 0; k < numIter; ++k) {
+    const std::size_t base = indexing.base(2 * k);
+    __m256d in[dim];
+    for (std::size_t r = 0; r < dim; ++r)
+      in[r] = _mm256_loadu_pd(data + 2 * (base + offsets[r]));
+    for (std::size_t r = 0; r < dim; ++r) {
+      __m256d out = cmul(in[0], re[r * dim], im[r * dim]);
+      for (std::size_t c = 1; c < dim; ++c)
+        out = _mm256_add_pd(out,
+                            cmul(in[c], re[r * dim + c], im[r * dim + c]));
+      _mm256_storeu_pd(data + 2 * (base + offsets[r]), out);
+    }
+  }
+}
+
+/// @brief Dense 1- or 2-qubit kernel, processing 4 consecutive base amplitudes
+/// per iteration. Requires `contiguousRun() >= 4`.
+template <std::size_t NumTargets>
+__attribute__((target("avx512f"))) void
+applyDenseAvx512(complex *state, const KernelIndexing &indexing,
+                 const std::vector<std::size_t> &offsets,
+                 const std::vector<complex> &matrix) {
+  constexpr std::size_t dim = 1ULL << NumTargets;
+  __m512d re[dim * dim], im[dim * dim];
+  for (std::size_t i = 0; i < dim * dim; ++i) {
+    re[i] = _mm512_set1_pd(matrix[i].real());
+    im[i] = _mm512_set1_pd(matrix[i].imag());
+  }
+  const std::int64_t numIter = indexing.numBase / 4;
+  auto *data = reinterpret_cast<double *>(state);
+#if defined(_OPENMP)
+#pragma omp parallel for if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+  for (std::int64_t k = 0; k < numIter; ++k) {
+    const std::size_t base = indexing.base(4 * k);
+    __m512d in[dim];
+    for (std::size_t r = 0; r < dim; ++r)
+      in[r] = _mm512_loadu_pd(data + 2 * (base + offsets[r]));
+    for (std::size_t r = 0; r < dim; ++r) {
+      __m512d out = cmul(in[0], re[r * dim], im[r * dim]);
+      for (std::size_t c = 1; c < dim; ++c)
+        out = _mm512_add_pd(out,
+                            cmul(in[c], re[r * dim + c], im[r * dim + c]));
+      _mm512_storeu_pd(data + 2 * (base + offsets[r]), out);
+    }
+  }
+}
+#endif
+
+/// @brief Portable dense kernel for any number of targets.
+inline void applyDenseScalar(complex *state, const KernelIndexing &indexing,
+                             const std::vector<std::size_t> &offsets,
+                             const std::vector<complex> &matrix) {
+  const std::size_t dim = offsets.size();
+  const std::int64_t numIter = indexing.numBase;
+#if defined(_OPENMP)
+#pragma omp parallel if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+  {
+    std::vector<complex> in(dim);
+#if defined(_OPENMP)
+#pragma omp for
+#endif
+    for (std::int64_t k = 0; k < numIter; ++k) {
+      const std::size_t base = indexing.base(k);
+      for (std::size_t r = 0; r < dim; ++r)
+        in[r] = state[base + offsets[r]];
+      for (std::size_t r = 0; r < dim; ++r) {
+        complex out = 0.;
+        for (std::size_t c = 0; c < dim; ++c)
+          out += matrix[r * dim + c] * in[c];
+        state[base + offsets[r]] = out;
+      }
+    }
+  }
+}
+
+/// @brief Diagonal kernel: scale every amplitude by the matching diagonal
+/// entry. Entries equal to one are skipped, so that, e.g., phase gates only
+/// touch the amplitudes they change.
+inline void applyDiagonal(complex *state, const KernelIndexing &indexing,
+                          const std::vector<std::size_t> &offsets,
+                          const std::vector<complex> &matrix) {
+  const std::size_t dim = offsets.size();
+  const std::int64_t numIter = indexing.numBase;
+  for (std::size_t r = 0; r < dim; ++r) {
+    const complex d = matrix[r * dim + r];
+    if (d == 1.)
+      continue;
+    const std::size_t offset = offsets[r];
+#if defined(_OPENMP)
+#pragma omp parallel for if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+    for (std::int64_t k = 0; k < numIter; ++k)
+      state[indexing.base(k) + offset] *= d;
+  }
+}
+
+/// @brief Apply the (possibly controlled) gate `matrix` to `state` in place.
+inline void applyGate(complex *state, std::size_t numQubits,
+                      const std::vector<complex> &matrix,
+                      const std::vector<std::size_t> &controls,
+                      const std::vector<std::size_t> &targets) {
+  const KernelIndexing indexing(numQubits, controls, targets);
+  const auto offsets = targetOffsets(targets);
+  assert(matrix.size() == offsets.size() * offsets.size() &&
+         "Invalid gate matrix size");
+
+  if (isDiagonal(matrix, offsets.size()))
+    return applyDiagonal(state, indexing, offsets, matrix);
+
+#ifdef NVQIR_SV_KERNELS_X86_SIMD
+  const auto simd = hostSimdLevel();
+  const auto run = indexing.contiguousRun();
+  if (targets.size() == 1) {
+    if (simd == SimdLevel::avx512 && run >= 4)
+      return applyDenseAvx512<1>(state, indexing, offsets, matrix);
+    if (simd != SimdLevel::none && run >= 2)
+      return applyDenseAvx2<1>(state, indexing, offsets, matrix);
+  } else if (targets.size() == 2) {
+    if (simd == SimdLevel::avx512 && run >= 4)
+      return applyDenseAvx512<2>(state, indexing, offsets, matrix);
+    if (simd != SimdLevel::none && run >= 2)
+      return applyDenseAvx2<2>(state, indexing, offsets, matrix);
+  }
+#endif
+
+  applyDenseScalar(state, indexing, offsets, matrix);
+}
+
+/// @brief Return the probability of measuring the given qubit in |1>.
+inline double probabilityOfOne(const complex *state, std::size_t numQubits,
+                               std::size_t qubit) {
+  const KernelIndexing indexing(numQubits, {}, {qubit});
+  const std::size_t mask = 1ULL << qubit;
+  const std::int64_t numIter = indexing.numBase;
+  double prob = 0.;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : prob) if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+  for (std::int64_t k = 0; k < numIter; ++k)
+    prob += std::norm(state[indexing.base(k) | mask]);
+  return prob;
+}
+
+/// @brief Collapse the state onto the given measurement outcome of a qubit,
+/// whose probability is `prob`, and renormalize.
+inline void collapse(complex *state, std::size_t numQubits, std::size_t qubit,
+                     bool result, double prob) {
+  const KernelIndexing indexing(numQubits, {}, {qubit});
+  const std::size_t mask = 1ULL << qubit;
+  const double scale = 1. / std::sqrt(prob);
+  const std::int64_t numIter = indexing.numBase;
+#if defined(_OPENMP)
+#pragma omp parallel for if (indexing.numBase >= (1ULL << minParallelQubits))
+#endif
+  for (std::int64_t k = 0; k < numIter; ++k) {
+    const std::size_t base = indexing.base(k);
+    state[result ? base : base | mask] = 0.;
+    state[result ? base | mask : base] *= scale;
+  }
+}
+
+} // namespace nvqir::sv
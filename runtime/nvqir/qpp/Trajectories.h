@@ -0,0 +1,292 @@
+/****************************************************************-*- C++ -*-****
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#pragma once
+
+#include "StateVectorKernels.h"
+
+#include <algorithm>
+#include <bit>
+#include <random>
+
+/// Quantum trajectory (Monte-Carlo wave function) noise simulation on top of
+/// the in-place state vector kernels.
+///
+/// A noisy circuit is recorded once as a `TrajectoryProgram`. Each replay of
+/// the program with an independent random number stream yields one pure-state
+/// trajectory, in which every noise channel has been replaced by one of its
+/// Kraus operators, chosen with the Born probability of that operator.
+/// Averaging observables over trajectories converges to the density matrix
+/// result. Qubit indices and matrix ordering follow StateVectorKernels.h.
+namespace nvqir::sv {
+
+/// @brief A noise channel, in the form consumed by the trajectory kernels.
+struct TrajectoryChannel {
+  /// @brief The row-major Kraus operators of the channel.
+  std::vector<std::vector<complex>> krausOps;
+  /// @brief If all Kraus operators are scaled unitaries, the unitaries and
+  /// their probabilities. Sampling those does not depend on the state.
+  std::vector<std::vector<complex>> unitaryOps;
+  std::vector<double> probabilities;
+};
+
+/// @brief Return the squared norm of the state.
+inline double normSquared(const complex *state, std::size_t numQubits) {
+  const std::int64_t dim = 1LL << numQubits;
+  double norm = 0.;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : norm) if (numQubits >= minParallelQubits)
+#endif
+  for (std::int64_t i = 0; i < dim; ++i)
+    norm += std::norm(state[i]);
+  return norm;
+}
+
+/// @brief Return the expectation value of the Z...Z operator on the qubits
+/// set in `mask`.
+inline double parityExpectation(const complex *state, std::size_t numQubits,
+                                std::size_t mask) {
+  const std::int64_t dim = 1LL << numQubits;
+  double expVal = 0.;
+#if defined(_OPENMP)
+#pragma omp parallel for reduction(+ : expVal) if (numQubits >= minParallelQubits)
+#endif
+  for (std::int64_t i = 0; i < dim; ++i) {
+    const double prob = std::norm(state[i]);
+    const auto parity = std::popcount(static_cast<std::size_t>(i) & mask) % 2;
+    expVal += parity == 0 ? prob : -prob;
+  }
+  return expVal;
+}
+
+/// @brief Draw `shots` basis state indices from the Born distribution of the
+/// state, in increasing order.
+template <typename RandomEngine>
+void sampleBasisStates(const complex *state, std::size_t numQubits,
+                       std::size_t shots, RandomEngine &rng,
+                       std::vector<std::size_t> &indices) {
+  indices.clear();
+  if (shots == 0)
+    return;
+  // Sorting the uniform draws lets a single sweep of the cumulative
+  // distribution serve all shots.
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const double norm = normSquared(state, numQubits);
+  std::vector<double> draws(shots);
+  for (auto &r : draws)
+    r = dist(rng) * norm;
+  std::sort(draws.begin(), draws.end());
+
+  const std::size_t dim = 1ULL << numQubits;
+  std::size_t lastNonZero = 0;
+  double cumulative = 0.;
+  auto draw = draws.begin();
+  for (std::size_t i = 0; i < dim && draw != draws.end(); ++i) {
+    const double prob = std::norm(state[i]);
+    if (prob == 0.)
+      continue;
+    lastNonZero = i;
+    cumulative += prob;
+    for (; draw != draws.end() && *draw < cumulative; ++draw)
+      indices.push_back(i);
+  }
+  // Rounding may leave the largest draws just above the accumulated norm.
+  indices.resize(shots, lastNonZero);
+}
+
+/// @brief Replace the noise channel acting on `qubits` by one of its Kraus
+/// operators, sampled according to the current state, and renormalize.
+/// `scratch` is resized to the state size for general (non-unitary mixture)
+/// channels. Return the index of the chosen operator.
+template <typename RandomEngine>
+std::size_t applyChannel(complex *state, std::size_t numQubits,
+                         const TrajectoryChannel &channel,
+                         const std::vector<std::size_t> &qubits,
+                         RandomEngine &rng, std::vector<complex> &scratch) {
+  static const std::vector<std::size_t> noControls;
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const double r = dist(rng);
+
+  if (!channel.unitaryOps.empty()) {
+    std::size_t k = 0;
+    double cumulative = channel.probabilities[0];
+    while (r >= cumulative && k + 1 < channel.unitaryOps.size())
+      cumulative += channel.probabilities[++k];
+    applyGate(state, numQubits, channel.unitaryOps[k], noControls, qubits);
+    return k;
+  }
+
+  // General channel: the probability of K_i is || K_i |psi> ||^2.
+  const std::size_t dim = 1ULL << numQubits;
+  scratch.resize(dim);
+  const auto applyKraus = [&](std::size_t k) {
+    std::copy(state, state + dim, scratch.begin());
+    applyGate(scratch.data(), numQubits, channel.krausOps[k], noControls,
+              qubits);
+    return normSquared(scratch.data(), numQubits);
+  };
+  double cumulative = 0.;
+  double prob = 0.;
+  std::size_t chosen = channel.krausOps.size();
+  bool inScratch = false;
+  for (std::size_t k = 0; k < channel.krausOps.size(); ++k) {
+    const double p = applyKraus(k);
+    inScratch = p > 0.;
+    if (!inScratch)
+      continue;
+    chosen = k;
+    prob = p;
+    cumulative += p;
+    if (r < cumulative)
+      break;
+  }
+  assert(chosen < channel.krausOps.size() && "Invalid Kraus channel");
+
+  // Rounding may leave `r` above the accumulated probability, in which case
+  // the last operator with a non-zero probability is chosen.
+  if (!inScratch)
+    prob = applyKraus(chosen);
+  const double scale = 1. / std::sqrt(prob);
+  std::transform(scratch.begin(), scratch.end(), state,
+                 [scale](complex a) { return a * scale; });
+  return chosen;
+}
+
+/// @brief Measure the qubit, sampling the result with `rng`, and collapse the
+/// state. Return the measurement result.
+template <typename RandomEngine>
+bool measure(complex *state, std::size_t numQubits, std::size_t qubit,
+             RandomEngine &rng) {
+  const double probOne = probabilityOfOne(state, numQubits, qubit);
+  std::uniform_real_distribution<double> dist(0., 1.);
+  const bool result = dist(rng) < probOne;
+  collapse(state, numQubits, qubit, result, result ? probOne : 1. - probOne);
+  return result;
+}
+
+/// @brief A recorded noisy circuit that can be replayed to generate
+/// trajectories.
+class TrajectoryProgram {
+  struct Operation {
+    enum class Kind { allocate, gate, channel, measure, reset };
+    Kind kind;
+    /// @brief Number of qubits added (allocate).
+    std::size_t numQubits = 0;
+    /// @brief Initial state of the added qubits, empty for |0...0>
+    /// (allocate), or the gate matrix (gate).
+    std::vector<complex> data;
+    std::vector<std::size_t> controls;
+    /// @brief The gate targets, channel qubits or measured qubit.
+    std::vector<std::size_t> targets;
+    /// @brief Index into `channels` (channel).
+    std::size_t channel = 0;
+  };
+
+  std::vector<Operation> operations;
+  std::vector<TrajectoryChannel> channels;
+  std::size_t totalQubits = 0;
+
+public:
+  bool empty() const { return operations.empty(); }
+  bool hasNoise() const { return !channels.empty(); }
+  std::size_t numQubits() const { return totalQubits; }
+
+  void clear() {
+    operations.clear();
+    channels.clear();
+    totalQubits = 0;
+  }
+
+  /// @brief Add `count` qubits as the most significant qubits of the state,
+  /// initialized to `data` if provided, to |0...0> otherwise.
+  void addQubits(std::size_t count, const complex *data = nullptr) {
+    Operation op{Operation::Kind::allocate};
+    op.numQubits = count;
+    if (data)
+      op.data.assign(data, data + (1ULL << count));
+    operations.push_back(std::move(op));
+    totalQubits += count;
+  }
+
+  void addGate(const std::vector<complex> &matrix,
+               const std::vector<std::size_t> &controls,
+               const std::vector<std::size_t> &targets) {
+    operations.push_back(
+        {Operation::Kind::gate, 0, matrix, controls, targets});
+  }
+
+  void addChannel(TrajectoryChannel channel,
+                  const std::vector<std::size_t> &qubits) {
+    Operation op{Operation::Kind::channel};
+    op.targets = qubits;
+    op.channel = channels.size();
+    channels.push_back(std::move(channel));
+    operations.push_back(std::move(op));
+  }
+
+  void addMeasurement(std::size_t qubit) {
+    Operation op{Operation::Kind::measure};
+    op.targets = {qubit};
+    operations.push_back(std::move(op));
+  }
+
+  void addReset(std::size_t qubit) {
+    Operation op{Operation::Kind::reset};
+    op.targets = {qubit};
+    operations.push_back(std::move(op));
+  }
+
+  /// @brief Generate one trajectory into `state`, drawing every random choice
+  /// from `rng`. `scratch` is a work buffer of the same size as the state.
+  template <typename RandomEngine>
+  void run(std::vector<complex> &state, RandomEngine &rng,
+           std::vector<complex> &scratch) const {
+    static const std::vector<complex> pauliX{0., 1., 1., 0.};
+    static const std::vector<std::size_t> noControls;
+    state.reserve(1ULL << totalQubits);
+    scratch.reserve(1ULL << totalQubits);
+    state.assign(1, 1.);
+    std::size_t n = 0;
+    for (const auto &op : operations) {
+      switch (op.kind) {
+      case Operation::Kind::allocate: {
+        // |new> (x) |state>: the new qubits are the high bits of the index.
+        const std::size_t oldDim = 1ULL << n;
+        const std::size_t newDim = 1ULL << op.numQubits;
+        scratch.assign(oldDim * newDim, 0.);
+        for (std::size_t j = 0; j < newDim; ++j) {
+          const complex a = op.data.empty() ? (j == 0 ? 1. : 0.) : op.data[j];
+          if (a == 0.)
+            continue;
+          for (std::size_t i = 0; i < oldDim; ++i)
+            scratch[(j << n) | i] = a * state[i];
+        }
+        state.swap(scratch);
+        n += op.numQubits;
+        break;
+      }
+      case Operation::Kind::gate:
+        applyGate(state.data(), n, op.data, op.controls, op.targets);
+        break;
+      case Operation::Kind::channel:
+        applyChannel(state.data(), n, channels[op.channel], op.targets, rng,
+                     scratch);
+        break;
+      case Operation::Kind::measure:
+        measure(state.data(), n, op.targets[0], rng);
+        break;
+      case Operation::Kind::reset:
+        if (measure(state.data(), n, op.targets[0], rng))
+          applyGate(state.data(), n, pauliX, noControls, op.targets);
+        break;
+      }
+    }
+  }
+};
+
+} // namespace nvqir::sv
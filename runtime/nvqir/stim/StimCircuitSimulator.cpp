@@ -27,6 +27,11 @@ protected:
   // Follow Stim naming convention (W) for bit width (required for templates).
   static constexpr std::size_t W = stim::MAX_BITWORD_WIDTH;
 
+  /// @brief Number of frames (shots) of the sample simulator used to estimate
+  /// noisy expectation values, unless the execution context specifies the
+  /// number of trajectories.
+  static constexpr std::size_t defaultNumTrajectoriesForObserve = 1000;
+
   /// @brief Number of measurements performed so far.
   std::size_t num_measurements = 0;
 
@@ -40,6 +45,15 @@ protected:
   /// @brief Stim Frame/Flip simulator (used to generate multiple shots)
   std::unique_ptr<stim::FrameSimulator<W>> sampleSim;
 
+  /// @brief Operations not yet applied to the Tableau simulator. Operations
+  /// are accumulated into one circuit and only applied, in a single pass, when
+  /// a measurement result is needed (see `flushPendingOps`).
+  stim::Circuit pendingTableauOps;
+
+  /// @brief Operations, including noise, not yet applied to the sample
+  /// simulator.
+  stim::Circuit pendingSampleOps;
+
   std::optional<std::string>
   isValidStimNoiseChannel(const kraus_channel &channel) const {
 
@@ -82,6 +96,12 @@ protected:
     if (getExecutionContext() && getExecutionContext()->name == "sample" &&
         !getExecutionContext()->hasConditionalsOnMeasureResults)
       batch_size = getExecutionContext()->shots;
+    // Noisy expectation values are averaged over the frames of the batch.
+    if (getExecutionContext() && getExecutionContext()->name == "observe" &&
+        getExecutionContext()->noiseModel && canHandleObserve())
+      batch_size = std::max<std::size_t>(
+          1, getExecutionContext()->numberTrajectories.value_or(
+                 defaultNumTrajectoriesForObserve));
     return batch_size;
   }
 
@@ -126,19 +146,32 @@ protected:
     if (sampleSim)
       randomEngine = std::move(sampleSim->rng);
     sampleSim.reset();
+    pendingTableauOps.clear();
+    pendingSampleOps.clear();
     num_measurements = 0;
   }
 
-  /// @brief Apply operation to all Stim simulators.
+  /// @brief Queue an operation for all Stim simulators.
   void applyOpToSims(const std::string &gate_name,
                      const std::vector<uint32_t> &targets) {
     if (targets.empty())
       return;
-    stim::Circuit tempCircuit;
     cudaq::info("Calling applyOpToSims {} - {}", gate_name, targets);
-    tempCircuit.safe_append_u(gate_name, targets);
-    tableau->safe_do_circuit(tempCircuit);
-    sampleSim->safe_do_circuit(tempCircuit);
+    pendingTableauOps.safe_append_u(gate_name, targets);
+    pendingSampleOps.safe_append_u(gate_name, targets);
+  }
+
+  /// @brief Apply the queued operations to the Stim simulators. The sample
+  /// simulator runs the whole circuit over all shots of the batch at once.
+  void flushPendingOps() {
+    if (!pendingTableauOps.operations.empty()) {
+      tableau->safe_do_circuit(pendingTableauOps);
+      pendingTableauOps.clear();
+    }
+    if (!pendingSampleOps.operations.empty()) {
+      sampleSim->safe_do_circuit(pendingSampleOps);
+      pendingSampleOps.clear();
+    }
   }
 
   /// @brief Apply the noise channel on \p qubits
@@ -176,15 +209,13 @@ protected:
     cudaq::info("Applying {} kraus channels to qubits {}", krausChannels.size(),
                 stimTargets);
 
-    stim::Circuit noiseOps;
+    // Only apply the noise operations to the sample simulator (not the Tableau
+    // simulator).
     for (auto &channel : krausChannels) {
       if (auto stimName = isValidStimNoiseChannel(channel))
-        noiseOps.safe_append_u(stimName.value(), stimTargets,
-                               channel.parameters);
+        pendingSampleOps.safe_append_u(stimName.value(), stimTargets,
+                                       channel.parameters);
     }
-    // Only apply the noise operations to the sample simulator (not the Tableau
-    // simulator).
-    sampleSim->safe_do_circuit(noiseOps);
   }
 
   bool isValidNoiseChannel(const cudaq::noise_model_type &type) const override {
@@ -197,17 +228,15 @@ protected:
                   const std::vector<std::size_t> &qubits) override {
     flushGateQueue();
     cudaq::info("[stim] apply kraus channel {}", channel.get_type_name());
-    stim::Circuit noiseOps;
     std::vector<std::uint32_t> stimTargets;
     stimTargets.reserve(qubits.size());
     for (auto q : qubits)
       stimTargets.push_back(static_cast<std::uint32_t>(q));
 
-    // If we have a valid operation, apply it
-    if (auto stimName = isValidStimNoiseChannel(channel)) {
-      noiseOps.safe_append_u(stimName.value(), stimTargets, channel.parameters);
-      sampleSim->safe_do_circuit(noiseOps);
-    }
+    // If we have a valid operation, queue it for the sample simulator
+    if (auto stimName = isValidStimNoiseChannel(channel))
+      pendingSampleOps.safe_append_u(stimName.value(), stimTargets,
+                                     channel.parameters);
   }
 
   void applyGate(const GateApplicationTask &task) override {
@@ -261,6 +290,7 @@ protected:
     // Perform measurement
     applyOpToSims(
         "M", std::vector<std::uint32_t>{static_cast<std::uint32_t>(index)});
+    flushPendingOps();
     num_measurements++;
 
     // Get the tableau bit that was just generated.
@@ -295,7 +325,67 @@ public:
     randomEngine = std::mt19937_64(seed);
   }
 
-  bool canHandleObserve() override { return false; }
+  bool canHandleObserve() override {
+    // Do not compute <H> from the tableau if shots based sampling requested
+    if (executionContext &&
+        executionContext->shots != static_cast<std::size_t>(-1))
+      return false;
+    return !shouldObserveFromSampling(/*defaultConfig=*/false);
+  }
+
+  /// @brief Compute the expectation value of each Pauli term of \p op. On a
+  /// stabilizer state, the value is exactly 0 or +/-1 and is read from the
+  /// Tableau simulator. With noise, the value is scaled by the average sign of
+  /// the term over the frames of the sample simulator, a frame flipping the
+  /// sign if its Pauli error anticommutes with the term.
+  cudaq::observe_result observe(const cudaq::spin_op &op) override {
+    assert(cudaq::spin_op::canonicalize(op) == op);
+    flushGateQueue();
+    if (!tableau)
+      return cudaq::observe_result{};
+    flushPendingOps();
+
+    const bool noisy = executionContext && executionContext->noiseModel;
+    const std::size_t numFrames = sampleSim->batch_size;
+    const std::size_t numFrameQubits = sampleSim->num_qubits;
+    std::complex<double> expVal = 0.0;
+    std::vector<cudaq::ExecutionResult> results;
+    results.reserve(op.num_terms());
+    for (const auto &term : op) {
+      std::size_t numQubits = tableau->inv_state.num_qubits;
+      for (const auto &p : term)
+        numQubits = std::max(numQubits, p.target() + 1);
+      stim::PauliString<W> pauli(numQubits);
+      stim::simd_bits<W> flips(numFrames);
+      for (const auto &p : term) {
+        const auto target = p.target();
+        const auto type = p.as_pauli();
+        const bool hasX = type == cudaq::pauli::X || type == cudaq::pauli::Y;
+        const bool hasZ = type == cudaq::pauli::Z || type == cudaq::pauli::Y;
+        pauli.xs[target] = hasX;
+        pauli.zs[target] = hasZ;
+        if (!noisy || target >= numFrameQubits)
+          continue;
+        if (hasZ)
+          flips ^= sampleSim->x_table[target];
+        if (hasX)
+          flips ^= sampleSim->z_table[target];
+      }
+
+      double termExpVal = tableau->peek_observable_expectation(pauli);
+      if (noisy && termExpVal != 0.0) {
+        std::size_t numFlips = 0;
+        for (std::size_t frame = 0; frame < numFrames; ++frame)
+          numFlips += flips[frame];
+        termExpVal *= 1.0 - 2.0 * numFlips / numFrames;
+      }
+      expVal += term.evaluate_coefficient() * termExpVal;
+      results.emplace_back(
+          cudaq::ExecutionResult({}, term.get_term_id(), termExpVal));
+    }
+    cudaq::sample_result perTermData(expVal.real(), results);
+    return cudaq::observe_result(expVal.real(), op, perTermData);
+  }
 
   /// @brief Reset the qubit
   /// @param index 0-based index of qubit to reset
@@ -330,6 +420,8 @@ public:
     if (!populateResult)
       return cudaq::ExecutionResult();
 
+    flushPendingOps();
+
     // Generate a reference sample
     const std::vector<bool> &v = tableau->measurement_record.storage;
     stim::simd_bits<W> ref(v.size());
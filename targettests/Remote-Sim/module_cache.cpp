@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// REQUIRES: remote-sim
+
+// clang-format off
+// RUN: nvq++ %cpp_std --target remote-mqpu --remote-mqpu-auto-launch 1 %s -o %t && CUDAQ_LOG_LEVEL=info %t | grep "Sending the hash of the kernel module" | wc -l | FileCheck %s
+// RUN: nvq++ %cpp_std --enable-mlir --target remote-mqpu --remote-mqpu-auto-launch 1 %s -o %t && CUDAQ_LOG_LEVEL=info %t | grep "Sending the hash of the kernel module" | wc -l | FileCheck %s
+// RUN: nvq++ %cpp_std --target remote-mqpu --remote-mqpu-auto-launch 1 %s -o %t && %t
+// clang-format on
+
+#include "remote_test_assert.h"
+#include <cudaq.h>
+
+struct ghz {
+  auto operator()() __qpu__ {
+    cudaq::qvector q(5);
+    h(q[0]);
+    for (int i = 0; i < 4; i++)
+      cx(q[i], q[i + 1]);
+    mz(q);
+  }
+};
+
+int main() {
+  // The code of the kernel is only sent with the first request, the following
+  // ones only carry its hash.
+  for (int i = 0; i < 5; i++) {
+    auto counts = cudaq::sample(ghz{});
+    REMOTE_TEST_ASSERT(counts.size() == 2);
+    REMOTE_TEST_ASSERT(counts.count("00000") + counts.count("11111") == 1000);
+  }
+  return 0;
+}
+
+// CHECK: 4
@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// REQUIRES: remote-sim
+
+// In library mode, the arguments are sent separately from the kernel module,
+// so that the module cached by the server is reused for every set of
+// parameters, without sending or JIT compiling it again.
+// clang-format off
+// RUN: nvq++ %cpp_std --target remote-mqpu --remote-mqpu-auto-launch 1 %s -o %t && CUDAQ_LOG_LEVEL=info %t | grep "Sending the hash of the kernel module" | wc -l | FileCheck %s
+// RUN: nvq++ %cpp_std --target remote-mqpu --remote-mqpu-auto-launch 1 %s -o %t && CUDAQ_LOG_LEVEL=info %t | grep "Reusing the JIT compiled kernel module" | wc -l | FileCheck %s
+// RUN: nvq++ %cpp_std --target remote-mqpu --remote-mqpu-auto-launch 1 %s -o %t && %t
+// clang-format on
+
+#include "remote_test_assert.h"
+#include <cmath>
+#include <cudaq.h>
+
+struct ansatz {
+  void operator()(double theta) __qpu__ {
+    cudaq::qubit q;
+    ry(theta, q);
+  }
+};
+
+int main() {
+  cudaq::spin_op h = cudaq::spin_op::z(0);
+  for (int i = 0; i < 5; i++) {
+    const double theta = 0.3 * i;
+    const double energy = cudaq::observe(ansatz{}, h, theta);
+    REMOTE_TEST_ASSERT(std::abs(energy - std::cos(theta)) < 1e-6);
+  }
+  return 0;
+}
+
+// CHECK: 4
@@ -32,6 +32,23 @@ constexpr const char *DEFAULT_SERVER_IMPL = "rest";
 static llvm::cl::opt<std::string> serverSubType(
     "type", llvm::cl::desc("HTTP server subtype handling incoming requests."),
     llvm::cl::init(DEFAULT_SERVER_IMPL));
+static llvm::cl::opt<unsigned> moduleCacheSize(
+    "module-cache-size",
+    llvm::cl::desc("Maximum number of kernel modules (and their JIT "
+                   "compilations) that the server keeps for reuse by later "
+                   "requests. Zero disables the cache."),
+    llvm::cl::init(16));
+static llvm::cl::opt<unsigned> numWorkers(
+    "workers",
+    llvm::cl::desc("Number of worker processes executing jobs concurrently. "
+                   "With more than one worker, this process dispatches the "
+                   "jobs to the workers."),
+    llvm::cl::init(1));
+static llvm::cl::opt<unsigned> maxQueuedRequests(
+    "max-queued-requests",
+    llvm::cl::desc("Maximum number of jobs waiting for a worker process, "
+                   "further jobs are rejected."),
+    llvm::cl::init(64));
 static llvm::cl::opt<bool> printRestPayloadVersion(
     "schema-version",
     llvm::cl::desc(
@@ -89,7 +106,11 @@ int main(int argc, char **argv) {
     return 0;
   }
 
-  restServer->init({{"port", std::to_string(port)}});
+  restServer->init(
+      {{"port", std::to_string(port)},
+       {"module-cache-size", std::to_string(moduleCacheSize)},
+       {"workers", std::to_string(numWorkers)},
+       {"max-queued-requests", std::to_string(maxQueuedRequests)}});
   restServer->start();
   if (cudaq::mpi::available())
     cudaq::mpi::finalize();
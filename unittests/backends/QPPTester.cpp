@@ -1236,3 +1236,51 @@ CUDAQ_TEST(QPPTester, checkReset) {
     EXPECT_EQ(1, qppBackend.mz(q1));
   }
 }
+
+// Simulator that fuses gates regardless of the state size.
+template <std::size_t MaxQubits>
+class FusingQppCircuitSimulator : public QppCircuitSimulator<qpp::ket> {
+public:
+  FusingQppCircuitSimulator() {
+    gateFusionMaxQubits = MaxQubits;
+    gateFusionMinStateQubits = 0;
+  }
+};
+
+template <typename Simulator>
+qpp::ket runFusionCircuit() {
+  Simulator qppBackend;
+  const int num_qubits = 5;
+  std::vector<std::size_t> q;
+  for (int i = 0; i < num_qubits; i++)
+    q.push_back(qppBackend.allocateQubit());
+
+  for (int i = 0; i < num_qubits; i++)
+    qppBackend.h(q[i]);
+  qppBackend.rx(0.3, q[0]);
+  qppBackend.ry(1.2, {q[0]}, q[1]);
+  qppBackend.x({q[1], q[2]}, q[3]);
+  qppBackend.u3(0.1, 0.2, 0.3, q[4]);
+  qppBackend.swap(q[0], q[4]);
+  qppBackend.rz(-0.7, {q[3]}, q[2]);
+  qppBackend.t(q[1]);
+  // Non-symmetric two-qubit custom operation.
+  std::vector<std::complex<double>> iswap{1., 0.,  0.,  0., 0., 0., {0., 1.},
+                                          0., 0., {0., 1.}, 0., 0., 0.,
+                                          0., 0., 1.};
+  qppBackend.applyCustomOperation(iswap, {}, {q[1], q[3]}, "iswap");
+  std::vector<std::complex<double>> cnot{1., 0., 0., 0., 0., 1., 0., 0.,
+                                         0., 0., 0., 1., 0., 0., 1., 0.};
+  qppBackend.applyCustomOperation(cnot, {}, {q[4], q[2]}, "cnot");
+  qppBackend.s({q[0], q[1], q[2], q[3]}, q[4]);
+  qppBackend.phased_rx(0.4, 0.5, q[3]);
+  return qppBackend.getStateVector();
+}
+
+// Checks that fused gate application matches gate-by-gate application.
+CUDAQ_TEST(QPPTester, checkGateFusion) {
+  auto want_state = runFusionCircuit<FusingQppCircuitSimulator<0>>();
+  EXPECT_EQ_KETS(want_state, runFusionCircuit<FusingQppCircuitSimulator<2>>());
+  EXPECT_EQ_KETS(want_state, runFusionCircuit<FusingQppCircuitSimulator<3>>());
+  EXPECT_EQ_KETS(want_state, runFusionCircuit<FusingQppCircuitSimulator<5>>());
+}
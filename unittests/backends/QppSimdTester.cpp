@@ -0,0 +1,183 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "StateVectorKernels.h"
+#include <qpp.h>
+#include <random>
+
+namespace {
+using SvKernel = void (*)(nvqir::sv::complex *,
+                          const nvqir::sv::KernelIndexing &,
+                          const std::vector<std::size_t> &,
+                          const std::vector<nvqir::sv::complex> &);
+
+qpp::ket randomState(std::size_t numQubits, std::mt19937 &gen) {
+  std::normal_distribution<double> dist;
+  qpp::ket state(1ULL << numQubits);
+  for (Eigen::Index i = 0; i < state.size(); ++i)
+    state[i] = {dist(gen), dist(gen)};
+  return state.normalized();
+}
+
+qpp::cmat randomDiagonal(std::size_t numTargets, std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(0., 2. * M_PI);
+  const std::size_t dim = 1ULL << numTargets;
+  qpp::cmat matrix = qpp::cmat::Identity(dim, dim);
+  // Keep the first entry equal to one, which the diagonal kernel skips.
+  for (Eigen::Index i = 1; i < matrix.rows(); ++i)
+    matrix(i, i) = std::polar(1., dist(gen));
+  return matrix;
+}
+
+/// @brief Row-major entries of `matrix`, as expected by the kernels.
+std::vector<nvqir::sv::complex> toRowMajor(const qpp::cmat &matrix) {
+  std::vector<nvqir::sv::complex> entries;
+  for (Eigen::Index r = 0; r < matrix.rows(); ++r)
+    for (Eigen::Index c = 0; c < matrix.cols(); ++c)
+      entries.push_back(matrix(r, c));
+  return entries;
+}
+
+/// @brief Apply the gate with `qpp`, whose qubit 0 is the most significant
+/// bit of a state index, unlike in the kernels.
+qpp::ket applyReference(const qpp::ket &state, std::size_t numQubits,
+                        const qpp::cmat &matrix,
+                        const std::vector<std::size_t> &controls,
+                        const std::vector<std::size_t> &targets) {
+  const auto toQpp = [&](const std::vector<std::size_t> &qubits) {
+    std::vector<qpp::idx> indices;
+    for (auto q : qubits)
+      indices.push_back(numQubits - 1 - q);
+    return indices;
+  };
+  if (controls.empty())
+    return qpp::apply(state, matrix, toQpp(targets));
+  return qpp::applyCTRL(state, matrix, toQpp(controls), toQpp(targets));
+}
+
+/// @brief Check that `kernel` (or the dispatching `applyGate` if null) matches
+/// `qpp::apply` on a random state.
+void checkKernel(SvKernel kernel, std::size_t numQubits,
+                 const qpp::cmat &matrix,
+                 const std::vector<std::size_t> &controls,
+                 const std::vector<std::size_t> &targets, std::mt19937 &gen) {
+  const auto state = randomState(numQubits, gen);
+  const auto expected =
+      applyReference(state, numQubits, matrix, controls, targets);
+  qpp::ket got = state;
+  const auto entries = toRowMajor(matrix);
+  if (kernel)
+    kernel(got.data(), nvqir::sv::KernelIndexing(numQubits, controls, targets),
+           nvqir::sv::targetOffsets(targets), entries);
+  else
+    nvqir::sv::applyGate(got.data(), numQubits, entries, controls, targets);
+  EXPECT_LT((got - expected).norm(), 1e-12)
+      << "numQubits " << numQubits << ", " << controls.size()
+      << " controls, " << targets.size() << " targets";
+}
+
+struct GateQubits {
+  std::vector<std::size_t> controls;
+  std::vector<std::size_t> targets;
+};
+
+// Gates on 1 and 2 targets, with and without controls, on qubits above 1 so
+// that consecutive base amplitudes are contiguous (as the vectorized kernels
+// require), as well as in MSB-first target order.
+const std::vector<GateQubits> denseGateQubits{
+    {{}, {2}}, {{4}, {3}}, {{}, {2, 5}}, {{}, {5, 2}}, {{3}, {6, 2}},
+    {{2, 6}, {4}}};
+
+// Gates also acting on qubits 0 and 1, only supported by the scalar kernel.
+const std::vector<GateQubits> lowGateQubits{
+    {{}, {0}}, {{0}, {1}}, {{1}, {0, 3}}, {{}, {0, 1, 4}}, {{0, 2}, {5, 1}}};
+} // namespace
+
+CUDAQ_TEST(QppSimdTester, checkScalarKernel) {
+  std::mt19937 gen(13);
+  for (std::size_t numQubits : {7, 16})
+    for (const auto &qubits : {denseGateQubits, lowGateQubits})
+      for (const auto &[controls, targets] : qubits)
+        checkKernel(nvqir::sv::applyDenseScalar, numQubits,
+                    qpp::randU(1ULL << targets.size()), controls, targets,
+                    gen);
+}
+
+CUDAQ_TEST(QppSimdTester, checkVectorizedKernels) {
+#ifdef NVQIR_SV_KERNELS_X86_SIMD
+  using nvqir::sv::SimdLevel;
+  const auto simd = nvqir::sv::hostSimdLevel();
+  if (simd == SimdLevel::none)
+    GTEST_SKIP() << "The host CPU supports neither AVX2 nor AVX-512.";
+  std::mt19937 gen(17);
+  for (std::size_t numQubits : {7, 16})
+    for (const auto &[controls, targets] : denseGateQubits) {
+      const auto matrix = qpp::randU(1ULL << targets.size());
+      const bool twoTargets = targets.size() == 2;
+      checkKernel(twoTargets ? nvqir::sv::applyDenseAvx2<2>
+                             : nvqir::sv::applyDenseAvx2<1>,
+                  numQubits, matrix, controls, targets, gen);
+      if (simd == SimdLevel::avx512)
+        checkKernel(twoTargets ? nvqir::sv::applyDenseAvx512<2>
+                               : nvqir::sv::applyDenseAvx512<1>,
+                    numQubits, matrix, controls, targets, gen);
+    }
+#else
+  GTEST_SKIP() << "The vectorized kernels are only built for x86-64.";
+#endif
+}
+
+CUDAQ_TEST(QppSimdTester, checkDiagonalKernel) {
+  std::mt19937 gen(19);
+  for (std::size_t numQubits : {7, 16})
+    for (const auto &qubits : {denseGateQubits, lowGateQubits})
+      for (const auto &[controls, targets] : qubits)
+        checkKernel(nvqir::sv::applyDiagonal, numQubits,
+                    randomDiagonal(targets.size(), gen), controls, targets,
+                    gen);
+}
+
+CUDAQ_TEST(QppSimdTester, checkApplyGate) {
+  // The dispatch picks the diagonal, vectorized or scalar kernel.
+  std::mt19937 gen(23);
+  for (std::size_t numQubits : {7, 16})
+    for (const auto &qubits : {denseGateQubits, lowGateQubits})
+      for (const auto &[controls, targets] : qubits) {
+        checkKernel(nullptr, numQubits, qpp::randU(1ULL << targets.size()),
+                    controls, targets, gen);
+        checkKernel(nullptr, numQubits, randomDiagonal(targets.size(), gen),
+                    controls, targets, gen);
+      }
+}
+
+CUDAQ_TEST(QppSimdTester, checkMeasurementKernels) {
+  std::mt19937 gen(29);
+  constexpr std::size_t numQubits = 7;
+  for (std::size_t qubit = 0; qubit < numQubits; ++qubit) {
+    const auto state = randomState(numQubits, gen);
+    double expectedProbOne = 0.;
+    for (Eigen::Index i = 0; i < state.size(); ++i)
+      if ((i >> qubit) & 1)
+        expectedProbOne += std::norm(state[i]);
+    const double probOne =
+        nvqir::sv::probabilityOfOne(state.data(), numQubits, qubit);
+    EXPECT_NEAR(probOne, expectedProbOne, 1e-12);
+
+    for (bool outcome : {false, true}) {
+      const double prob = outcome ? probOne : 1. - probOne;
+      qpp::ket got = state;
+      nvqir::sv::collapse(got.data(), numQubits, qubit, outcome, prob);
+      qpp::ket expected = state / std::sqrt(prob);
+      for (Eigen::Index i = 0; i < expected.size(); ++i)
+        if (((i >> qubit) & 1) != outcome)
+          expected[i] = 0.;
+      EXPECT_LT((got - expected).norm(), 1e-12);
+    }
+  }
+}
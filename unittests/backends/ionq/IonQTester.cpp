@@ -7,7 +7,9 @@
  ******************************************************************************/
 
 #include "CUDAQTestUtils.h"
+#include "common/Executor.h"
 #include "common/FmtCore.h"
+#include "common/RestClient.h"
 #include "cudaq/algorithm.h"
 #include <fstream>
 #include <gtest/gtest.h>
@@ -178,6 +180,56 @@ CUDAQ_TEST(IonQTester, checkObserveAsyncLoadFromFile) {
   EXPECT_TRUE(isValidExpVal(result.expectation()));
 }
 
+CUDAQ_TEST(IonQTester, checkObserveConcurrentJobs) {
+  auto backendString =
+      fmt::format(fmt::runtime(backendStringTemplate), mockPort);
+
+  auto &platform = cudaq::get_platform();
+  platform.setTargetBackend(backendString);
+
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(2);
+  kernel.x(qubit[0]);
+  kernel.ry(theta, qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[0]);
+
+  // The XX, YY and ZZ measurement groups are posted as three jobs, which are
+  // in flight at the same time (up to the bound on concurrent submissions)
+  // and polled together.
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  // The mock server holds the job posts until the expected number of them
+  // are in flight at once, so that the overlap does not depend on timing.
+  const std::size_t maxConcurrentSubmissions =
+      cudaq::Executor::getMaxConcurrentSubmissions();
+  const std::size_t expectedInFlight =
+      std::min<std::size_t>(3, maxConcurrentSubmissions);
+  cudaq::RestClient client;
+  std::map<std::string, std::string> headers;
+  const std::string mockUrl = "http://localhost:" + mockPort + "/";
+  const std::string maxInFlightPath = "v0.3/test/max_in_flight_job_posts";
+  client.get(mockUrl,
+             "v0.3/test/expect_concurrent_job_posts/" +
+                 std::to_string(expectedInFlight),
+             headers);
+
+  // Launch two observe calls at once, which share the submission pool.
+  auto future0 = cudaq::observe_async(kernel, h, .59);
+  auto future1 = cudaq::observe_async(kernel, h, .59);
+  auto result0 = future0.get();
+  auto result1 = future1.get();
+  EXPECT_TRUE(isValidExpVal(result0.expectation()));
+  EXPECT_TRUE(isValidExpVal(result1.expectation()));
+
+  const std::size_t maxInFlight =
+      client.get(mockUrl, maxInFlightPath, headers)["count"].get<std::size_t>();
+  EXPECT_GE(maxInFlight, expectedInFlight);
+  EXPECT_LE(maxInFlight, maxConcurrentSubmissions);
+}
+
 int main(int argc, char **argv) {
   setenv("IONQ_API_KEY", "00000000000000000000000000000000", 0);
   ::testing::InitGoogleTest(&argc, argv);
@@ -9,6 +9,7 @@
 #include "CUDAQTestUtils.h"
 #include "common/FmtCore.h"
 #include "cudaq/algorithm.h"
+#include <cmath>
 #include <fstream>
 #include <gtest/gtest.h>
 
@@ -180,6 +181,64 @@ CUDAQ_TEST(OQCTester, checkObserveAsyncLoadFromFile) {
   EXPECT_TRUE(isValidExpVal(result.expectation()));
 }
 
+CUDAQ_TEST(OQCTester, checkObserveParameterized) {
+  auto backendString = fmt::format(fmt::runtime(backendStringTemplate),
+                                   mockPort, auth_token, device_id);
+
+  auto &platform = cudaq::get_platform();
+  platform.setTargetBackend(backendString);
+
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(2);
+  kernel.x(qubit[0]);
+  kernel.ry(theta, qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[0]);
+
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  // The later calls bind new angles into the lowering of the first call.
+  EXPECT_TRUE(isValidExpVal(cudaq::observe(kernel, h, .59).expectation()));
+  EXPECT_FALSE(isValidExpVal(cudaq::observe(kernel, h, 0.).expectation()));
+  EXPECT_TRUE(isValidExpVal(cudaq::observe(kernel, h, .59).expectation()));
+}
+
+CUDAQ_TEST(OQCTester, checkObserveBatches) {
+  auto [kernel, theta] = cudaq::make_kernel<double>();
+  auto qubit = kernel.qalloc(2);
+  kernel.x(qubit[0]);
+  kernel.ry(theta, qubit[1]);
+  kernel.x<cudaq::ctrl>(qubit[1], qubit[0]);
+
+  auto xx = cudaq::spin_op::x(0) * cudaq::spin_op::x(1);
+  auto yy = cudaq::spin_op::y(0) * cudaq::spin_op::y(1);
+  auto z0 = cudaq::spin_op::z(0);
+  auto z1 = cudaq::spin_op::z(1);
+  cudaq::spin_op h =
+      5.907 - 2.1433 * xx - 2.1433 * yy + .21829 * z0 - 6.125 * z1;
+
+  // Split the terms over several submissions, and retrieve their results per
+  // task and in bulk. The state is cos(t/2)|10> + sin(t/2)|01>.
+  const double angle = .59;
+  for (std::string bulk : {"false", "true"}) {
+    auto backendString =
+        fmt::format(fmt::runtime(backendStringTemplate), mockPort, auth_token,
+                    device_id) +
+        "max_batch_size;2;bulk_results;" + bulk + ";";
+    auto &platform = cudaq::get_platform();
+    platform.setTargetBackend(backendString);
+
+    auto result = cudaq::observe(kernel, h, angle);
+    EXPECT_NEAR(result.expectation(xx), std::sin(angle), 0.15);
+    EXPECT_NEAR(result.expectation(yy), std::sin(angle), 0.15);
+    EXPECT_NEAR(result.expectation(z0), -std::cos(angle), 0.15);
+    EXPECT_NEAR(result.expectation(z1), std::cos(angle), 0.15);
+    EXPECT_TRUE(isValidExpVal(result.expectation()));
+  }
+}
+
 int main(int argc, char **argv) {
   setenv("OQC_URL", entry_url.c_str(), 0);
   setenv("OQC_AUTH_TOKEN", auth_token.c_str(), 0);
@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/CompiledKernelCache.h"
+#include <filesystem>
+#include <unistd.h>
+
+using namespace cudaq;
+
+namespace {
+std::vector<KernelExecution> makeCodes(const std::string &code) {
+  std::string name = "kernel";
+  std::string codeStr = code;
+  nlohmann::json outputNames = {{"0", "r00000"}};
+  std::vector<std::size_t> reorderIdx = {1, 0};
+  return {KernelExecution(name, codeStr, outputNames, reorderIdx)};
+}
+} // namespace
+
+CUDAQ_TEST(CompiledKernelCacheTester, checkLRU) {
+  CompiledKernelCache cache(2);
+  EXPECT_FALSE(cache.lookup("a").has_value());
+  cache.insert("a", makeCodes("A"));
+  cache.insert("b", makeCodes("B"));
+  // Touch "a", so that "b" is the least recently used entry.
+  EXPECT_EQ("A", cache.lookup("a")->front().code);
+  cache.insert("c", makeCodes("C"));
+  EXPECT_EQ(2, cache.size());
+  EXPECT_TRUE(cache.lookup("a").has_value());
+  EXPECT_FALSE(cache.lookup("b").has_value());
+  EXPECT_TRUE(cache.lookup("c").has_value());
+
+  CompiledKernelCache disabled(0);
+  disabled.insert("a", makeCodes("A"));
+  EXPECT_FALSE(disabled.lookup("a").has_value());
+}
+
+CUDAQ_TEST(CompiledKernelCacheTester, checkDiskLayer) {
+  auto directory = std::filesystem::temp_directory_path() /
+                   ("cudaq_kernel_cache_test_" + std::to_string(::getpid()));
+  {
+    CompiledKernelCache writer(4, directory);
+    writer.insert("key", makeCodes("CODE"));
+  }
+
+  // A new cache (e.g., in another process) finds the entry on disk.
+  CompiledKernelCache reader(4, directory);
+  auto codes = reader.lookup("key");
+  ASSERT_TRUE(codes.has_value());
+  ASSERT_EQ(1, codes->size());
+  EXPECT_EQ("kernel", codes->front().name);
+  EXPECT_EQ("CODE", codes->front().code);
+  EXPECT_EQ("r00000", codes->front().output_names["0"]);
+  EXPECT_EQ((std::vector<std::size_t>{1, 0}),
+            codes->front().mapping_reorder_idx);
+  EXPECT_EQ(1, reader.size());
+  EXPECT_FALSE(reader.lookup("other key").has_value());
+
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "common/JITModuleCache.h"
+#include "common/RuntimeMLIR.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Parser/Parser.h"
+#include "mlir/Target/LLVMIR/Export.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace cudaq;
+
+namespace {
+const char *kernelIR = R"#(
+  llvm.func @answer() -> i32 {
+    %0 = llvm.mlir.constant(42 : i32) : i32
+    llvm.return %0 : i32
+  }
+)#";
+
+std::filesystem::path getTestDirectory() {
+  return std::filesystem::temp_directory_path() /
+         ("cudaq_jit_cache_test_" + std::to_string(::getpid()));
+}
+} // namespace
+
+TEST(JITModuleCacheTester, checkKey) {
+  auto context = cudaq::initializeMLIR();
+  auto module = mlir::parseSourceString<mlir::ModuleOp>(kernelIR, &*context);
+  ASSERT_TRUE(module);
+
+  // The key does not depend on the context, unlike the operation hashes.
+  auto otherContext = cudaq::initializeMLIR();
+  auto sameModule =
+      mlir::parseSourceString<mlir::ModuleOp>(kernelIR, &*otherContext);
+  EXPECT_EQ(JITModuleCache::getKey(*module, "pipeline"),
+            JITModuleCache::getKey(*sameModule, "pipeline"));
+  EXPECT_NE(JITModuleCache::getKey(*module, "pipeline"),
+            JITModuleCache::getKey(*module, "other pipeline"));
+
+  auto otherModule = mlir::parseSourceString<mlir::ModuleOp>(
+      "llvm.func @answer() -> i32 {\n"
+      "  %0 = llvm.mlir.constant(43 : i32) : i32\n"
+      "  llvm.return %0 : i32\n"
+      "}\n",
+      &*context);
+  EXPECT_NE(JITModuleCache::getKey(*module, "pipeline"),
+            JITModuleCache::getKey(*otherModule, "pipeline"));
+}
+
+TEST(JITModuleCacheTester, checkDiskLayer) {
+  auto context = cudaq::initializeMLIR();
+  auto module = mlir::parseSourceString<mlir::ModuleOp>(kernelIR, &*context);
+  ASSERT_TRUE(module);
+  auto key = JITModuleCache::getKey(*module, "pipeline");
+
+  JITModuleCache disabled;
+  EXPECT_FALSE(disabled.enabled());
+  EXPECT_EQ(nullptr, disabled.lookup(key));
+
+  auto directory = getTestDirectory();
+  {
+    JITModuleCache writer(directory);
+    ASSERT_TRUE(writer.enabled());
+    EXPECT_EQ(nullptr, writer.lookup(key));
+    llvm::LLVMContext llvmContext;
+    auto llvmModule = mlir::translateModuleToLLVMIR(*module, llvmContext);
+    ASSERT_TRUE(llvmModule);
+    writer.insert(key, *llvmModule);
+  }
+
+  // A new cache (e.g., in another process) finds the entry on disk.
+  JITModuleCache reader(directory);
+  auto bitcode = reader.lookup(key);
+  ASSERT_NE(nullptr, bitcode);
+  llvm::LLVMContext llvmContext;
+  auto llvmModule = JITModuleCache::load(*bitcode, llvmContext);
+  ASSERT_NE(nullptr, llvmModule);
+  EXPECT_NE(nullptr, llvmModule->getFunction("answer"));
+  EXPECT_EQ(nullptr,
+            reader.lookup(JITModuleCache::getKey(*module, "other pipeline")));
+
+  // Entries that are not bitcode are ignored.
+  std::ofstream(directory / (key + ".bc")) << "not bitcode";
+  EXPECT_EQ(nullptr, reader.lookup(key));
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(JITModuleCacheTester, checkEviction) {
+  auto context = cudaq::initializeMLIR();
+  llvm::LLVMContext llvmContext;
+  std::vector<std::string> keys;
+  std::vector<std::unique_ptr<llvm::Module>> llvmModules;
+  for (int value : {1, 2, 3}) {
+    auto module = mlir::parseSourceString<mlir::ModuleOp>(
+        "llvm.func @answer() -> i32 {\n"
+        "  %0 = llvm.mlir.constant(" +
+            std::to_string(value) +
+            " : i32) : i32\n"
+            "  llvm.return %0 : i32\n"
+            "}\n",
+        &*context);
+    ASSERT_TRUE(module);
+    keys.push_back(JITModuleCache::getKey(*module, "pipeline"));
+    llvmModules.push_back(mlir::translateModuleToLLVMIR(*module, llvmContext));
+    ASSERT_TRUE(llvmModules.back());
+  }
+
+  auto directory = getTestDirectory();
+  JITModuleCache unlimited(directory);
+  unlimited.insert(keys[0], *llvmModules[0]);
+  unlimited.insert(keys[1], *llvmModules[1]);
+  const auto entrySize =
+      std::filesystem::file_size(directory / (keys[0] + ".bc"));
+
+  // Make the first entry the least recently used, then use it.
+  const auto now = std::filesystem::file_time_type::clock::now();
+  std::filesystem::last_write_time(directory / (keys[0] + ".bc"),
+                                   now - std::chrono::hours(2));
+  std::filesystem::last_write_time(directory / (keys[1] + ".bc"),
+                                   now - std::chrono::hours(1));
+  ASSERT_NE(nullptr, unlimited.lookup(keys[0]));
+
+  // Inserting a third entry in a cache limited to two entries evicts the
+  // least recently used one.
+  JITModuleCache limited(directory, 2 * entrySize + entrySize / 2);
+  limited.insert(keys[2], *llvmModules[2]);
+  EXPECT_NE(nullptr, limited.lookup(keys[0]));
+  EXPECT_EQ(nullptr, limited.lookup(keys[1]));
+  EXPECT_NE(nullptr, limited.lookup(keys[2]));
+
+  std::filesystem::remove_all(directory);
+}
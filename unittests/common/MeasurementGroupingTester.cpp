@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/MeasurementGrouping.h"
+#include <set>
+
+using namespace cudaq;
+
+namespace {
+spin_op makeH2() {
+  return 5.907 - 2.1433 * spin_op::x(0) * spin_op::x(1) -
+         2.1433 * spin_op::y(0) * spin_op::y(1) + .21829 * spin_op::z(0) -
+         6.125 * spin_op::z(1) + 0.5 * spin_op::z(0) * spin_op::z(1);
+}
+
+void checkPartition(const spin_op &op,
+                    const std::vector<MeasurementGroup> &groups) {
+  std::multiset<std::string> grouped;
+  for (const auto &group : groups) {
+    for (const auto &a : group.terms) {
+      grouped.insert(a.get_term_id());
+      for (const auto &b : group.terms)
+        EXPECT_TRUE(qubitWiseCommute(a, b));
+    }
+  }
+  std::multiset<std::string> expected;
+  for (const auto &term : op)
+    if (!term.is_identity())
+      expected.insert(term.get_term_id());
+  EXPECT_EQ(expected, grouped);
+}
+} // namespace
+
+CUDAQ_TEST(MeasurementGroupingTester, checkQubitWiseCommute) {
+  EXPECT_TRUE(qubitWiseCommute(spin_op::z(0) * spin_op::z(1), spin_op::z(1)));
+  EXPECT_TRUE(qubitWiseCommute(spin_op::x(0), spin_op::z(1)));
+  EXPECT_FALSE(qubitWiseCommute(spin_op::x(0) * spin_op::x(1),
+                                spin_op::y(0) * spin_op::y(1)));
+  EXPECT_FALSE(qubitWiseCommute(spin_op::x(0), spin_op::z(0) * spin_op::z(1)));
+}
+
+CUDAQ_TEST(MeasurementGroupingTester, checkStrategies) {
+  auto h = makeH2();
+
+  auto none = groupCommutingTerms(h, GroupingStrategy::none);
+  EXPECT_EQ(5, none.size());
+  checkPartition(h, none);
+
+  // {Z0, Z1, Z0Z1}, {X0X1}, {Y0Y1}
+  for (auto strategy : {GroupingStrategy::greedy, GroupingStrategy::coloring}) {
+    auto groups = groupCommutingTerms(h, strategy);
+    EXPECT_EQ(3, groups.size());
+    checkPartition(h, groups);
+    for (const auto &group : groups)
+      if (group.terms.size() == 3) {
+        EXPECT_EQ("ZZ", group.basis);
+        EXPECT_EQ((std::vector<std::size_t>{0, 1}), group.measuredQubits());
+      }
+  }
+
+  auto random = spin_op::random(4, 30, 13);
+  for (auto strategy : {GroupingStrategy::greedy, GroupingStrategy::coloring}) {
+    auto groups = groupCommutingTerms(random, strategy);
+    EXPECT_LT(groups.size(), random.num_terms());
+    checkPartition(random, groups);
+  }
+}
+
+CUDAQ_TEST(MeasurementGroupingTester, checkExpandGroupResult) {
+  // Terms Z0 and Z0Z2 measured together in the Z0 Z2 basis.
+  MeasurementGroup group{"ZIZ", {spin_op::z(0), spin_op::z(0) * spin_op::z(2)}};
+  EXPECT_EQ(getGroupBasis(group.registerName()), "ZIZ");
+  EXPECT_EQ(getGroupBasis("Z0Z2"), "");
+
+  ExecutionResult groupResult(CountsDictionary{{"00", 100}, {"10", 300}},
+                              group.registerName());
+  auto results = expandGroupResult(group, groupResult);
+  ASSERT_EQ(2, results.size());
+  EXPECT_EQ(spin_op::z(0).get_term_id(), results[0].registerName);
+  EXPECT_EQ(100, results[0].counts["0"]);
+  EXPECT_EQ(300, results[0].counts["1"]);
+  EXPECT_NEAR(-0.5, results[0].expectationValue.value(), 1e-12);
+  EXPECT_EQ(300, results[1].counts["10"]);
+  EXPECT_NEAR(-0.5, results[1].expectationValue.value(), 1e-12);
+
+  // Recover the per-term results from the group register only.
+  std::vector<ExecutionResult> raw{groupResult};
+  sample_result data(raw);
+  auto op = spin_op::z(0) + spin_op::z(0) * spin_op::z(2) + spin_op::x(1);
+  expandMeasurementGroups(data, op);
+  EXPECT_NEAR(-0.5, data.expectation(spin_op::z(0).get_term_id()), 1e-12);
+  EXPECT_NEAR(
+      -0.5,
+      data.expectation((spin_op::z(0) * spin_op::z(2)).get_term_id()), 1e-12);
+  auto names = data.register_names();
+  EXPECT_EQ(names.end(), std::find(names.begin(), names.end(),
+                                   spin_op::x(1).get_term_id()));
+}
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CUDAQTestUtils.h"
+#include "common/PackedCounts.h"
+
+using namespace cudaq;
+
+CUDAQ_TEST(PackedCountsTester, checkCounts) {
+  PackedCounts counts(3);
+  counts.add("101");
+  counts.add("000", 2);
+  counts.add("101");
+  EXPECT_EQ(2, counts.size());
+  EXPECT_EQ(4, counts.totalShots());
+  EXPECT_EQ(2, counts.count("101"));
+  EXPECT_EQ(0, counts.count("111"));
+  EXPECT_NEAR(0.5, counts.probability("000"), 1e-12);
+  // "101" has even parity, as does "000".
+  EXPECT_NEAR(1.0, counts.expectationZ(), 1e-12);
+
+  auto result = counts.toExecutionResult("reg");
+  EXPECT_EQ("reg", result.registerName);
+  EXPECT_EQ((CountsDictionary{{"101", 2}, {"000", 2}}), result.counts);
+  EXPECT_EQ((std::vector<std::string>{"101", "000", "000", "101"}),
+            result.sequentialData);
+
+  auto roundTrip = PackedCounts::fromExecutionResult(result);
+  EXPECT_EQ(result.sequentialData,
+            roundTrip.toExecutionResult().sequentialData);
+}
+
+CUDAQ_TEST(PackedCountsTester, checkManyWords) {
+  // Bit strings spanning several words, with enough distinct values to grow
+  // the hash table.
+  const std::size_t numBits = 130;
+  PackedCounts counts(numBits);
+  std::vector<std::string> bitStrings;
+  for (std::size_t i = 0; i < 100; ++i) {
+    std::string bits(numBits, '0');
+    bits[i] = '1';
+    bits[numBits - 1 - i % 7] = '1';
+    bitStrings.push_back(bits);
+    counts.add(bits, i + 1);
+  }
+  EXPECT_EQ(100, counts.size());
+  EXPECT_EQ(3, counts.numWords());
+  for (std::size_t i = 0; i < bitStrings.size(); ++i)
+    EXPECT_EQ(i + 1, counts.count(bitStrings[i]));
+  for (std::size_t entry = 0; entry < counts.size(); ++entry)
+    EXPECT_EQ(counts.count(entry), counts.count(counts.toString(entry)));
+}
+
+CUDAQ_TEST(PackedCountsTester, checkMarginalAndReorder) {
+  ExecutionResult result({{"110", 3}, {"011", 1}});
+  sample_result counts(result);
+
+  auto marginal = counts.get_marginal({2, 0});
+  EXPECT_EQ(3, marginal.count("10"));
+  EXPECT_EQ(1, marginal.count("01"));
+  EXPECT_EQ(4, marginal.get_total_shots());
+
+  auto packed = PackedCounts::fromExecutionResult(result);
+  auto reordered = packed.reorder({2, 1, 0}).toExecutionResult();
+  EXPECT_EQ((CountsDictionary{{"011", 3}, {"110", 1}}), reordered.counts);
+  EXPECT_NEAR(counts.expectation(), packed.expectationZ(), 1e-12);
+
+  EXPECT_ANY_THROW(packed.marginal({3}));
+  EXPECT_ANY_THROW(packed.reorder({0, 1}));
+}
@@ -0,0 +1,57 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+// A stand-in for the `cudaq-qpud` worker processes of `RestWorkerPool`. It
+// serves pings and job requests on the port given by `--port`, and does as the
+// job request says:
+//  - `sleepMs`: take that many milliseconds to answer,
+//  - `crash`: exit without answering,
+//  - `codeHash`: acknowledge holding the module with that hash.
+// The response carries the process ID of the worker.
+
+#include "RestServer.h"
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+int main(int argc, char **argv) {
+  int port = -1;
+  for (int i = 1; i + 1 < argc; ++i)
+    if (std::string(argv[i]) == "--port")
+      port = std::stoi(argv[i + 1]);
+  if (port < 0)
+    return 1;
+
+  cudaq::RestServer server(port, "cudaq-stub-worker");
+  server.addRoute(
+      cudaq::RestServer::Method::GET, "/",
+      [](const std::string &reqBody,
+         const std::unordered_multimap<std::string, std::string> &headers) {
+        return nlohmann::json();
+      });
+  server.addRoute(
+      cudaq::RestServer::Method::POST, "/job",
+      [](const std::string &reqBody,
+         const std::unordered_multimap<std::string, std::string> &headers) {
+        auto requestJs = nlohmann::json::parse(reqBody);
+        if (requestJs.value("crash", false))
+          std::_Exit(1);
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(requestJs.value("sleepMs", 0)));
+        nlohmann::json resultJs;
+        resultJs["executionContext"] = nlohmann::json::object();
+        resultJs["pid"] = ::getpid();
+        if (requestJs.contains("codeHash"))
+          resultJs["cachedCodeHash"] = requestJs["codeHash"];
+        return resultJs;
+      });
+  server.start();
+  return 0;
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "RestWorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cudaq;
+
+namespace {
+// The workers are instances of `RestStubWorker.cpp`.
+RestWorkerPool makePool(std::size_t numWorkers, std::size_t maxQueued) {
+  return RestWorkerPool(numWorkers, maxQueued, {}, STUB_WORKER_PATH);
+}
+
+std::string makeJob(int sleepMs, const std::string &codeHash = {}) {
+  nlohmann::json job;
+  job["sleepMs"] = sleepMs;
+  if (!codeHash.empty())
+    job["codeHash"] = codeHash;
+  return job.dump();
+}
+
+// Wait until the metrics of `pool` show `busy` busy workers and `queued`
+// queued requests.
+bool waitForLoad(const RestWorkerPool &pool, std::size_t busy,
+                 std::size_t queued) {
+  for (int i = 0; i < 500; ++i) {
+    auto metrics = pool.getMetrics();
+    if (metrics["busyWorkers"] == busy && metrics["queuedRequests"] == queued)
+      return true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+} // namespace
+
+TEST(RestWorkerPoolTester, checkQueueing) {
+  auto pool = makePool(2, 1);
+  EXPECT_EQ(3u, pool.getCapacity());
+
+  // Two jobs execute and one waits, further jobs are rejected.
+  std::vector<std::future<nlohmann::json>> results;
+  for (int i = 0; i < 3; ++i) {
+    results.push_back(std::async(std::launch::async,
+                                 [&] { return pool.submit(makeJob(1000)); }));
+    ASSERT_TRUE(waitForLoad(pool, std::min(i + 1, 2), i < 2 ? 0 : 1));
+  }
+  auto rejected = pool.submit(makeJob(0));
+  EXPECT_EQ("Server busy", rejected["status"]);
+  EXPECT_FALSE(rejected.contains("executionContext"));
+
+  std::set<int> pids;
+  for (auto &result : results) {
+    auto resultJs = result.get();
+    ASSERT_TRUE(resultJs.contains("executionContext"));
+    pids.insert(resultJs["pid"].get<int>());
+  }
+  EXPECT_EQ(2u, pids.size());
+
+  auto metrics = pool.getMetrics();
+  EXPECT_EQ(2, metrics["workers"]);
+  EXPECT_EQ(0, metrics["busyWorkers"]);
+  EXPECT_EQ(0, metrics["queuedRequests"]);
+  EXPECT_EQ(1, metrics["maxQueuedRequests"]);
+  EXPECT_EQ(1, metrics["peakQueuedRequests"]);
+  EXPECT_EQ(3, metrics["completedRequests"]);
+  EXPECT_EQ(0, metrics["failedRequests"]);
+  EXPECT_EQ(1, metrics["rejectedRequests"]);
+}
+
+TEST(RestWorkerPoolTester, checkWorkerRelaunch) {
+  auto pool = makePool(2, 1);
+  const int pid = pool.submit(makeJob(0))["pid"];
+
+  // The first worker crashes, and is relaunched for the next job. Whether the
+  // pool sees it exit, or shuts it down, depends on when the crash is noticed.
+  auto crashed = pool.submit(R"({"crash": true})");
+  EXPECT_FALSE(crashed.contains("executionContext"));
+  const auto errorMessage = crashed["errorMessage"].get<std::string>();
+  EXPECT_TRUE(errorMessage.find("terminated unexpectedly") !=
+                  std::string::npos ||
+              errorMessage.find("was shut down") != std::string::npos)
+      << errorMessage;
+  auto resultJs = pool.submit(makeJob(0));
+  ASSERT_TRUE(resultJs.contains("executionContext"));
+  EXPECT_NE(pid, resultJs["pid"]);
+
+  auto metrics = pool.getMetrics();
+  EXPECT_EQ(2, metrics["completedRequests"]);
+  EXPECT_EQ(1, metrics["failedRequests"]);
+  EXPECT_EQ(1, metrics["workerRestarts"]);
+}
+
+TEST(RestWorkerPoolTester, checkInvalidRequest) {
+  auto pool = makePool(2, 1);
+  auto resultJs = pool.submit("not json");
+  EXPECT_EQ("Failed to process incoming request", resultJs["status"]);
+  EXPECT_EQ(1, pool.getMetrics()["failedRequests"]);
+  EXPECT_EQ(0, pool.getMetrics()["busyWorkers"]);
+}
+
+TEST(RestWorkerPoolTester, checkModuleAffinity) {
+  auto pool = makePool(2, 1);
+
+  // Keep the first worker busy, so that the second one caches the module.
+  auto busy = std::async(std::launch::async,
+                         [&] { return pool.submit(makeJob(500)); });
+  ASSERT_TRUE(waitForLoad(pool, 1, 0));
+  const int pid = pool.submit(makeJob(0, "hash"))["pid"];
+  EXPECT_NE(busy.get()["pid"], pid);
+
+  // With both workers idle, the job goes to the worker holding the module.
+  EXPECT_EQ(pid, pool.submit(makeJob(0, "hash"))["pid"]);
+}
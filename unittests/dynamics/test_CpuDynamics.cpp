@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+
+#include "CpuDynamicsState.h"
+#include "CpuSuperOperator.h"
+#include "common/EigenDense.h"
+#include "cudaq/algorithms/evolve_internal.h"
+#include "cudaq/algorithms/integrator.h"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <unsupported/Eigen/KroneckerProduct>
+
+namespace {
+// Rabi oscillation of a qubit driven by `2 pi 0.1 X`, observed with `Z`.
+void checkRabi(cudaq::base_integrator &integrator, bool densityMatrix) {
+  const cudaq::dimension_map dims = {{0, 2}};
+  cudaq::product_op<cudaq::matrix_handler> ham1 =
+      (2.0 * M_PI * 0.1 * cudaq::spin_op::x(0));
+  cudaq::sum_op<cudaq::matrix_handler> ham(ham1);
+
+  constexpr int numSteps = 11;
+  std::vector<double> steps = cudaq::linspace(0.0, 1.0, numSteps);
+  cudaq::schedule schedule(steps, {"t"});
+
+  cudaq::product_op<cudaq::matrix_handler> pauliZ_t = cudaq::spin_op::z(0);
+  cudaq::sum_op<cudaq::matrix_handler> pauliZ(pauliZ_t);
+  auto initialState = cudaq::state::from_data(
+      densityMatrix ? std::vector<std::complex<double>>{1.0, 0.0, 0.0, 0.0}
+                    : std::vector<std::complex<double>>{1.0, 0.0});
+
+  auto result = cudaq::__internal__::evolveSingle(
+      ham, dims, schedule, initialState, integrator, {}, {pauliZ}, true);
+  EXPECT_TRUE(result.expectation_values.has_value());
+  EXPECT_EQ(result.expectation_values.value().size(), numSteps);
+
+  int count = 0;
+  for (auto expVals : result.expectation_values.value()) {
+    EXPECT_EQ(expVals.size(), 1);
+    const double expected = std::cos(2 * 2.0 * M_PI * 0.1 * steps[count++]);
+    EXPECT_NEAR((double)expVals[0], expected, 1e-4);
+  }
+}
+} // namespace
+
+TEST(CpuDynamicsTester, checkSuperOperator) {
+  // Compare the `Lindbladian` against its dense Kronecker product form.
+  const std::vector<int64_t> modeExtents = {2, 3};
+  const cudaq::dimension_map dims = {{0, 2}, {1, 3}};
+  auto hopping =
+      cudaq::boson_op::create(0) * cudaq::boson_op::annihilate(1) +
+      cudaq::boson_op::annihilate(0) * cudaq::boson_op::create(1);
+  auto ham = 0.3 * cudaq::boson_op::number(0) + 0.7 * hopping;
+  cudaq::product_op<cudaq::matrix_handler> collapse_t =
+      0.5 * cudaq::boson_op::annihilate(1);
+  cudaq::sum_op<cudaq::matrix_handler> collapse(collapse_t);
+  cudaq::dynamics::CpuSuperOperator liouvillian(ham, {collapse}, modeExtents,
+                                                {}, false);
+  EXPECT_TRUE(liouvillian.isMasterEquation());
+  EXPECT_FALSE(liouvillian.isTimeDependent());
+  EXPECT_EQ(liouvillian.getDimension(), 6);
+
+  auto toEigen = [&](const auto &op) {
+    auto matrix = op.to_matrix(dims);
+    Eigen::MatrixXcd result(matrix.rows(), matrix.cols());
+    for (std::size_t i = 0; i < matrix.rows(); ++i)
+      for (std::size_t j = 0; j < matrix.cols(); ++j)
+        result(i, j) = matrix[{i, j}];
+    return result;
+  };
+  const Eigen::MatrixXcd h = toEigen(ham);
+  // The collapse operator only acts on mode 1, the slowest varying index.
+  const Eigen::MatrixXcd c = Eigen::kroneckerProduct(
+      toEigen(collapse), Eigen::MatrixXcd::Identity(2, 2));
+  const Eigen::MatrixXcd id = Eigen::MatrixXcd::Identity(6, 6);
+  const Eigen::MatrixXcd cdc = c.adjoint() * c;
+  const std::complex<double> i(0.0, 1.0);
+  // `vec(A rho B) = (B^T (x) A) vec(rho)` for column-major `vec`.
+  const Eigen::MatrixXcd expected =
+      -i * (Eigen::kroneckerProduct(id, h) -
+            Eigen::kroneckerProduct(h.transpose(), id)) +
+      Eigen::kroneckerProduct(c.conjugate(), c) -
+      0.5 * (Eigen::kroneckerProduct(id, cdc) +
+             Eigen::kroneckerProduct(cdc.transpose(), id));
+
+  const Eigen::VectorXcd rho = Eigen::VectorXcd::Random(36);
+  Eigen::VectorXcd out(36);
+  liouvillian.apply(rho, out, {});
+  EXPECT_NEAR((out - expected * rho).norm(), 0.0, 1e-12);
+}
+
+TEST(CpuDynamicsTester, checkRungeKutta) {
+  cudaq::integrators::runge_kutta integrator(4, 0.001);
+  checkRabi(integrator, false);
+}
+
+TEST(CpuDynamicsTester, checkDormandPrince) {
+  cudaq::integrators::dormand_prince integrator(1e-8, 1e-10);
+  checkRabi(integrator, false);
+  cudaq::integrators::dormand_prince dmIntegrator(1e-8, 1e-10);
+  checkRabi(dmIntegrator, true);
+}
+
+TEST(CpuDynamicsTester, checkKrylov) {
+  cudaq::integrators::krylov integrator;
+  checkRabi(integrator, false);
+  cudaq::integrators::krylov dmIntegrator;
+  checkRabi(dmIntegrator, true);
+}
+
+TEST(CpuDynamicsTester, checkDecay) {
+  // A pure initial state is promoted to a density matrix when collapse
+  // operators are present.
+  const cudaq::dimension_map dims = {{0, 10}};
+  constexpr int numSteps = 51;
+  std::vector<double> steps = cudaq::linspace(0.0, 10.0, numSteps);
+  cudaq::schedule schedule(steps, {"t"});
+
+  cudaq::product_op<cudaq::matrix_handler> ham1 = cudaq::boson_op::number(0);
+  cudaq::sum_op<cudaq::matrix_handler> ham(ham1);
+  cudaq::sum_op<cudaq::matrix_handler> obs(ham1);
+  const double decayRate = 0.1;
+  cudaq::product_op<cudaq::matrix_handler> collapseOp1 =
+      std::sqrt(decayRate) * cudaq::boson_op::annihilate(0);
+  cudaq::sum_op<cudaq::matrix_handler> collapseOp(collapseOp1);
+  std::vector<std::complex<double>> initialStateVec(10, 0.0);
+  initialStateVec[9] = 1.0;
+  auto initialState = cudaq::state::from_data(initialStateVec);
+
+  for (int method = 0; method < 3; ++method) {
+    std::unique_ptr<cudaq::base_integrator> integrator;
+    if (method == 0)
+      integrator = std::make_unique<cudaq::integrators::runge_kutta>(4, 0.01);
+    else if (method == 1)
+      integrator = std::make_unique<cudaq::integrators::dormand_prince>();
+    else
+      integrator = std::make_unique<cudaq::integrators::krylov>();
+    auto result = cudaq::__internal__::evolveSingle(
+        ham, dims, schedule, initialState, *integrator, {collapseOp}, {obs},
+        true);
+    EXPECT_TRUE(result.expectation_values.has_value());
+    EXPECT_EQ(result.expectation_values.value().size(), numSteps);
+    int count = 0;
+    for (auto expVals : result.expectation_values.value()) {
+      const double expected = 9.0 * std::exp(-decayRate * steps[count++]);
+      EXPECT_NEAR((double)expVals[0], expected, 1e-3);
+    }
+    const auto &finalState =
+        cudaq::getCpuDynamicsState(result.states.value().back());
+    EXPECT_TRUE(finalState.is_density_matrix());
+  }
+}
+
+TEST(CpuDynamicsTester, checkTimeDependent) {
+  // `H(t) = 2 pi 0.1 t X` rotates by `2 pi 0.1 t^2` until time `t`.
+  const cudaq::dimension_map dims = {{0, 2}};
+  auto function =
+      [](const std::unordered_map<std::string, std::complex<double>>
+             &parameters) {
+        auto entry = parameters.find("t");
+        if (entry == parameters.end())
+          throw std::runtime_error("Cannot find value of expected parameter");
+        return entry->second;
+      };
+  cudaq::product_op<cudaq::matrix_handler> ham1 =
+      cudaq::scalar_operator(function) * 2.0 * M_PI * 0.1 *
+      cudaq::spin_op::x(0);
+  cudaq::sum_op<cudaq::matrix_handler> ham(ham1);
+  cudaq::product_op<cudaq::matrix_handler> pauliZ_t = cudaq::spin_op::z(0);
+  cudaq::sum_op<cudaq::matrix_handler> pauliZ(pauliZ_t);
+
+  constexpr int numSteps = 21;
+  std::vector<double> steps = cudaq::linspace(0.0, 2.0, numSteps);
+  cudaq::schedule schedule(steps, {"t"});
+  auto initialState =
+      cudaq::state::from_data(std::vector<std::complex<double>>{1.0, 0.0});
+
+  cudaq::integrators::dormand_prince dp(1e-8, 1e-10);
+  cudaq::integrators::krylov krylov(6, 1e-10, 0.01);
+  for (cudaq::base_integrator *integrator :
+       std::vector<cudaq::base_integrator *>{&dp, &krylov}) {
+    auto result = cudaq::__internal__::evolveSingle(
+        ham, dims, schedule, initialState, *integrator, {}, {pauliZ}, false);
+    EXPECT_TRUE(result.expectation_values.has_value());
+    const double t = steps.back();
+    EXPECT_NEAR((double)result.expectation_values.value().back()[0],
+                std::cos(2.0 * M_PI * 0.1 * t * t), 1e-4);
+  }
+}
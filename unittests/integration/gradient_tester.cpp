@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 #include <cudaq/algorithm.h>
+#include <cudaq/algorithms/gradients/adjoint.h>
 #include <cudaq/algorithms/gradients/central_difference.h>
 #include <cudaq/optimizers.h>
 
@@ -77,6 +78,96 @@ CUDAQ_TEST(GradientTester, checkSimple) {
   EXPECT_NEAR(-2.0453, opt_val, 1e-3);
 }
 
+#ifdef CUDAQ_BACKEND_QPP
+CUDAQ_TEST(GradientTester, checkAdjoint) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+  cudaq::spin_op h3 = h + 9.625 - 9.625 * cudaq::spin_op::z(2) -
+                      3.913119 * cudaq::spin_op::x(1) * cudaq::spin_op::x(2) -
+                      3.913119 * cudaq::spin_op::y(1) * cudaq::spin_op::y(2);
+
+  auto argsMapper = [](std::vector<double> x) {
+    return std::make_tuple(x[0], x[1]);
+  };
+  cudaq::gradients::central_difference central(deuteron_n3_ansatz{},
+                                               argsMapper);
+  cudaq::gradients::adjoint adjoint(deuteron_n3_ansatz{}, argsMapper);
+  std::vector<double> x{.3, -.7};
+  double e = cudaq::observe(deuteron_n3_ansatz{}, h3, x[0], x[1]);
+  std::vector<double> expected(2), grad(2);
+  central.compute(x, expected, h3, e);
+  adjoint.compute(x, grad, h3, e);
+  for (std::size_t i = 0; i < x.size(); ++i)
+    EXPECT_NEAR(expected[i], grad[i], 1e-3);
+}
+
+struct scaled_rotation_ansatz {
+  void operator()(double theta) __qpu__ {
+    cudaq::qubit q;
+    ry(2. * theta - .5, q);
+  }
+};
+
+struct controlled_phase_ansatz {
+  void operator()(double theta) __qpu__ {
+    cudaq::qvector q(2);
+    h(q);
+    r1<cudaq::ctrl>(theta, q[0], q[1]);
+  }
+};
+
+CUDAQ_TEST(GradientTester, checkAdjointAnalytic) {
+  auto argsMapper = [](std::vector<double> x) {
+    return std::make_tuple(x[0]);
+  };
+  std::vector<double> grad(1);
+
+  // <Z> = cos(2 theta - 0.5), the parameter map is reused for the second x.
+  cudaq::spin_op z = cudaq::spin_op::z(0);
+  cudaq::gradients::adjoint rotation(scaled_rotation_ansatz{}, argsMapper);
+  for (double theta : {.3, 1.1}) {
+    rotation.compute({theta}, grad, z, 0.);
+    EXPECT_NEAR(-2. * std::sin(2. * theta - .5), grad[0], 1e-10);
+  }
+
+  // <X0 X1> = (1 + cos(theta)) / 2.
+  cudaq::spin_op xx = cudaq::spin_op::x(0) * cudaq::spin_op::x(1);
+  cudaq::gradients::adjoint phase(controlled_phase_ansatz{}, argsMapper);
+  for (double theta : {.4, -2.3}) {
+    phase.compute({theta}, grad, xx, 0.);
+    EXPECT_NEAR(-std::sin(theta) / 2., grad[0], 1e-10);
+  }
+}
+
+struct measured_rotation_ansatz {
+  void operator()(double theta) __qpu__ {
+    cudaq::qvector q(2);
+    ry(theta, q[0]);
+    mz(q[1]);
+  }
+};
+
+CUDAQ_TEST(GradientTester, checkAdjointUnsupported) {
+  auto argsMapper = [](std::vector<double> x) {
+    return std::make_tuple(x[0]);
+  };
+  std::vector<double> grad(1);
+
+  // The measurement stops the recording of the gates, so nothing is
+  // differentiated.
+  cudaq::gradients::adjoint measured(measured_rotation_ansatz{}, argsMapper);
+  EXPECT_THROW(measured.compute({.3}, grad, cudaq::spin_op::z(0), 0.),
+               std::runtime_error);
+
+  // The observable acts on a qubit that the kernel does not allocate.
+  cudaq::gradients::adjoint rotation(scaled_rotation_ansatz{}, argsMapper);
+  EXPECT_THROW(rotation.compute({.3}, grad, cudaq::spin_op::z(3), 0.),
+               std::runtime_error);
+}
+#endif
+
 #endif
 
 #endif
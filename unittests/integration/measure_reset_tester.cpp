@@ -8,6 +8,7 @@
 
 #include "CUDAQTestUtils.h"
 
+#include <algorithm>
 #include <cudaq.h>
 #include <iostream>
 
@@ -82,3 +83,49 @@ TEST(MeasureResetTester, checkLibModeOrdering) {
   counts.dump();
   EXPECT_EQ("10", counts.begin()->first);
 }
+
+TEST(MeasureResetTester, checkConditionalFeedbackShots) {
+  // Simulators that branch the shots at each measurement must still account
+  // for every shot, in both the global and the mid-circuit registers.
+  static std::vector<bool> executedOutcomes;
+  auto kernel = []() __qpu__ {
+    cudaq::qubit a, b, c;
+    h(a);
+    h(c);
+    const bool outcome = mz(a);
+    if (outcome)
+      x(b);
+    reset(c);
+    executedOutcomes.push_back(outcome);
+  };
+
+  executedOutcomes.clear();
+  auto counts = cudaq::sample(/*shots=*/1000, kernel);
+  counts.dump();
+  EXPECT_EQ(1000, counts.get_total_shots());
+  EXPECT_EQ(2, counts.size());
+  EXPECT_EQ(1000, counts.count("000") + counts.count("110"));
+  // Each outcome has probability 1/2, allow for 6 standard deviations.
+  EXPECT_NEAR(500, counts.count("110"), 95);
+  // The register of the measurement of `a` has the outcome of every shot.
+  for (auto &name : counts.register_names())
+    if (name != cudaq::GlobalRegisterName)
+      EXPECT_EQ(counts.count("110"), counts.to_map(name)["1"]);
+
+  // The first execution traces the kernel to detect the conditional feedback.
+  ASSERT_FALSE(executedOutcomes.empty());
+  executedOutcomes.erase(executedOutcomes.begin());
+#if defined(CUDAQ_BACKEND_QPP)
+  // The shots are branched on the outcomes of the measurement of `a` and of
+  // the reset of `c`, i.e., one execution per measurement history, two of
+  // which measure `a` in |1>.
+  EXPECT_EQ(4, executedOutcomes.size());
+  EXPECT_EQ(2, std::count(executedOutcomes.begin(), executedOutcomes.end(),
+                          true));
+#else
+  // Executed shot by shot.
+  EXPECT_EQ(1000, executedOutcomes.size());
+  EXPECT_EQ(counts.count("110"), std::count(executedOutcomes.begin(),
+                                            executedOutcomes.end(), true));
+#endif
+}
@@ -12,7 +12,7 @@
 #include <stdio.h>
 
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 struct xOp {
   void operator()() __qpu__ {
     cudaq::qubit q;
@@ -76,7 +76,8 @@ struct bell_depolarization2_vec {
 };
 
 #endif
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support arbitrary cudaq::kraus_channel specification.
 
 namespace test::hello {
@@ -240,7 +241,7 @@ CUDAQ_TEST(NoiseTest, checkSimple) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_QPP)
 // Stim does not support arbitrary cudaq::kraus_channel specification.
 
 CUDAQ_TEST(NoiseTest, checkAmplitudeDamping) {
@@ -261,7 +262,8 @@ CUDAQ_TEST(NoiseTest, checkAmplitudeDamping) {
 
 #endif
 
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET_MPS)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET_MPS) ||       \
+    defined(CUDAQ_BACKEND_QPP)
 CUDAQ_TEST(NoiseTest, checkAmplitudeDamping2) {
   cudaq::set_random_seed(13);
   cudaq::kraus_channel amplitudeDamping{{1., 0., 0., .8660254037844386},
@@ -281,7 +283,8 @@ CUDAQ_TEST(NoiseTest, checkAmplitudeDamping2) {
 }
 #endif
 
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support arbitrary cudaq::kraus_op specification.
 
 CUDAQ_TEST(NoiseTest, checkCNOT) {
@@ -378,7 +381,7 @@ CUDAQ_TEST(NoiseTest, checkExceptions) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkDepolType) {
   cudaq::set_random_seed(13);
@@ -425,7 +428,7 @@ CUDAQ_TEST(NoiseTest, checkApplySimplePauliErrors) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkDepolTypeSimple) {
   cudaq::set_random_seed(13);
@@ -442,7 +445,7 @@ CUDAQ_TEST(NoiseTest, checkDepolTypeSimple) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_QPP)
 // Stim does not support cudaq::amplitude_damping_channel.
 
 CUDAQ_TEST(NoiseTest, checkAmpDampType) {
@@ -496,7 +499,7 @@ CUDAQ_TEST(NoiseTest, checkPhaseDampType) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_QPP)
 // Stim does not support cudaq::amplitude_damping_channel.
 
 CUDAQ_TEST(NoiseTest, checkAmpDampTypeSimple) {
@@ -514,7 +517,7 @@ CUDAQ_TEST(NoiseTest, checkAmpDampTypeSimple) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkBitFlipType) {
   cudaq::set_random_seed(13);
@@ -532,7 +535,7 @@ CUDAQ_TEST(NoiseTest, checkBitFlipType) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkBitFlipTypeSimple) {
   cudaq::set_random_seed(13);
@@ -549,7 +552,7 @@ CUDAQ_TEST(NoiseTest, checkBitFlipTypeSimple) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 // Same as above but use alternate sample interface that specifies the number of
 // shots and the noise model to use.
 CUDAQ_TEST(NoiseTest, checkBitFlipTypeSimpleOptions) {
@@ -570,7 +573,7 @@ CUDAQ_TEST(NoiseTest, checkBitFlipTypeSimpleOptions) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkPhaseFlipType) {
   cudaq::set_random_seed(13);
@@ -596,7 +599,7 @@ CUDAQ_TEST(NoiseTest, checkPhaseFlipType) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkPauli1) {
   cudaq::set_random_seed(13);
@@ -616,7 +619,7 @@ CUDAQ_TEST(NoiseTest, checkPauli1) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkPauli2) {
   cudaq::set_random_seed(13);
@@ -636,7 +639,7 @@ CUDAQ_TEST(NoiseTest, checkPauli2) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 template <std::size_t N>
 struct xOpAll {
@@ -648,7 +651,7 @@ struct xOpAll {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkAllQubitChannel) {
   cudaq::set_random_seed(13);
@@ -668,7 +671,8 @@ CUDAQ_TEST(NoiseTest, checkAllQubitChannel) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support arbitrary cudaq::kraus_op specification.
 
 static cudaq::kraus_channel create2pNoiseChannel() {
@@ -752,7 +756,8 @@ struct bellRandom {
 };
 
 #endif
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support arbitrary cudaq::kraus_op specification.
 
 CUDAQ_TEST(NoiseTest, checkAllQubitChannelWithControl) {
@@ -782,7 +787,8 @@ CUDAQ_TEST(NoiseTest, checkAllQubitChannelWithControl) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support arbitrary cudaq::kraus_op specification.
 
 CUDAQ_TEST(NoiseTest, checkAllQubitChannelWithControlPrefix) {
@@ -812,7 +818,7 @@ CUDAQ_TEST(NoiseTest, checkAllQubitChannelWithControlPrefix) {
 
 #endif
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkCallbackChannel) {
   cudaq::set_random_seed(13);
@@ -845,7 +851,8 @@ struct rxOp {
 };
 
 #endif
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support rx gate.
 
 CUDAQ_TEST(NoiseTest, checkCallbackChannelWithParams) {
@@ -882,7 +889,8 @@ CUDAQ_TEST(NoiseTest, checkCallbackChannelWithParams) {
 }
 
 #endif
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 // Stim does not support custom operations.
 
 CUDAQ_REGISTER_OPERATION(CustomXOp, 1, 0, {0, 1, 1, 0});
@@ -951,7 +959,7 @@ CUDAQ_TEST(NoiseTest, checkCustomOperation) {
 #endif
 
 #if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM) ||                \
-    defined(CUDAQ_BACKEND_TENSORNET)
+    defined(CUDAQ_BACKEND_TENSORNET) || defined(CUDAQ_BACKEND_QPP)
 
 CUDAQ_TEST(NoiseTest, checkMeasurementNoise) {
   cudaq::set_random_seed(13);
@@ -992,7 +1000,8 @@ CUDAQ_TEST(NoiseTest, checkMeasurementNoise) {
 
 #endif
 
-#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET)
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_TENSORNET) ||           \
+    defined(CUDAQ_BACKEND_QPP)
 CUDAQ_TEST(NoiseTest, checkObserveHamiltonianWithNoise) {
 
   cudaq::spin_op h =
@@ -1020,6 +1029,43 @@ CUDAQ_TEST(NoiseTest, checkObserveHamiltonianWithNoise) {
 }
 #endif
 
+#if defined(CUDAQ_BACKEND_DM) || defined(CUDAQ_BACKEND_STIM)
+CUDAQ_TEST(NoiseTest, checkObserveCliffordWithDepolarization) {
+  cudaq::set_random_seed(13);
+  constexpr double prob = 0.1;
+  cudaq::depolarization_channel depol(prob);
+  cudaq::noise_model noise;
+  noise.add_all_qubit_channel<cudaq::types::x>(depol);
+  cudaq::set_noise(noise);
+
+  // The `x` gates leave the Bell state unchanged, and depolarize each qubit
+  // after the state is prepared.
+  auto bellWithNoise = []() __qpu__ {
+    cudaq::qubit q, r;
+    h(q);
+    x<cudaq::ctrl>(q, r);
+    x(q);
+    x(r);
+  };
+
+  // A depolarizing channel scales the expectation value of every Pauli term
+  // acting on its qubit by 1 - 4p/3.
+  const double scale = (1. - 4. * prob / 3.) * (1. - 4. * prob / 3.);
+  auto xx = cudaq::spin_op::x(0) * cudaq::spin_op::x(1);
+  auto yy = cudaq::spin_op::y(0) * cudaq::spin_op::y(1);
+  auto zz = cudaq::spin_op::z(0) * cudaq::spin_op::z(1);
+  cudaq::spin_op h = 1.5 + 2.0 * xx - 3.0 * yy + zz;
+
+  // Stim estimates the scaling from 1000 noisy frames.
+  auto result = cudaq::observe(bellWithNoise, h);
+  EXPECT_NEAR(result.expectation(xx), scale, 0.1);
+  EXPECT_NEAR(result.expectation(yy), -scale, 0.1);
+  EXPECT_NEAR(result.expectation(zz), scale, 0.1);
+  EXPECT_NEAR(result.expectation(), 1.5 + 6.0 * scale, 0.5);
+  cudaq::unset_noise(); // clear for subsequent tests
+}
+#endif
+
 #if defined(CUDAQ_BACKEND_TENSORNET)
 CUDAQ_REGISTER_OPERATION(CustomIdOp, 1, 0, {1, 0, 0, 1});
 
@@ -123,5 +123,49 @@ CUDAQ_TEST(ObserveResult, checkExpValBug) {
   // it acts on a different number of qubits). This is in particular
   // also relevant for noise modeling.
 }
+
+CUDAQ_TEST(ObserveResult, checkExactGroupedTerms) {
+  // The Z terms are measured as one qubit-wise commuting group, and must be
+  // computed exactly without shots.
+  const double theta = .7, phi = -1.9;
+  auto kernel = [](double theta, double phi) __qpu__ {
+    cudaq::qvector q(2);
+    ry(theta, q[0]);
+    ry(phi, q[1]);
+  };
+  auto z0 = cudaq::spin_op::z(0);
+  auto z1 = cudaq::spin_op::z(1);
+  auto zz = cudaq::spin_op::z(0) * cudaq::spin_op::z(1);
+  cudaq::spin_op h = 2. + .5 * z0 - 1.5 * z1 + .75 * zz;
+
+  auto result = cudaq::observe(kernel, h, theta, phi);
+  EXPECT_NEAR(std::cos(theta), result.expectation(z0), 1e-6);
+  EXPECT_NEAR(std::cos(phi), result.expectation(z1), 1e-6);
+  EXPECT_NEAR(std::cos(theta) * std::cos(phi), result.expectation(zz), 1e-6);
+  EXPECT_NEAR(2. + .5 * std::cos(theta) - 1.5 * std::cos(phi) +
+                  .75 * std::cos(theta) * std::cos(phi),
+              result.expectation(), 1e-6);
+}
 #endif
 #endif
+
+CUDAQ_TEST(ObserveResult, checkCliffordTerms) {
+  // Stabilizer simulators compute these exactly from the tableau.
+  auto bell = []() __qpu__ {
+    cudaq::qvector q(2);
+    h(q[0]);
+    x<cudaq::ctrl>(q[0], q[1]);
+  };
+
+  auto xx = cudaq::spin_op::x(0) * cudaq::spin_op::x(1);
+  auto yy = cudaq::spin_op::y(0) * cudaq::spin_op::y(1);
+  auto zz = cudaq::spin_op::z(0) * cudaq::spin_op::z(1);
+  auto z0 = cudaq::spin_op::z(0);
+  cudaq::spin_op h = 1.5 + 2.0 * xx + 3.0 * yy + zz + 0.5 * z0;
+
+  auto result = cudaq::observe(bell, h);
+  EXPECT_NEAR(result.expectation(), 1.5 + 2.0 - 3.0 + 1.0, 1e-6);
+  EXPECT_NEAR(result.expectation(xx), 1.0, 1e-6);
+  EXPECT_NEAR(result.expectation(yy), -1.0, 1e-6);
+  EXPECT_NEAR(result.expectation(z0), 0.0, 1e-6);
+}
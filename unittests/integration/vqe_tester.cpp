@@ -127,6 +127,81 @@ CUDAQ_TEST_F(VQETester, checkSpsa) {
   EXPECT_NEAR(opt_val, -1.1371, 1e-3);
 }
 
+CUDAQ_TEST_F(VQETester, checkBatchOptimizers) {
+  auto objective = [&](const std::vector<std::vector<double>> &xs) {
+    return cudaq::observe_batch(ansatz_compute_action{}, *H, xs);
+  };
+  {
+    printf("Run with cmaes\n");
+    cudaq::optimizers::cmaes opt;
+    auto [opt_val, opt_params] = opt.optimize(1, objective);
+    EXPECT_NEAR(opt_val, -1.1371, 1e-3);
+  }
+  {
+    printf("Run with batch_nelder_mead\n");
+    cudaq::optimizers::batch_nelder_mead opt;
+    auto [opt_val, opt_params] = opt.optimize(1, objective);
+    EXPECT_NEAR(opt_val, -1.1371, 1e-3);
+  }
+  {
+    printf("Run with batch_spsa\n");
+    cudaq::optimizers::batch_spsa opt;
+    opt.num_perturbations = 2;
+    opt.f_tol = 1e-6;
+    auto [opt_val, opt_params] = opt.optimize(1, objective);
+    EXPECT_NEAR(opt_val, -1.1371, 1e-3);
+  }
+}
+
+CUDAQ_TEST_F(VQETester, checkBatchNelderMeadBudget) {
+  // The shrink steps evaluate dim points at once, which must not exceed the
+  // evaluation budget either.
+  std::size_t numEvals = 0;
+  auto objective = [&](const std::vector<std::vector<double>> &xs) {
+    std::vector<double> values;
+    for (const auto &x : xs) {
+      values.push_back(std::abs(x[0] - 1.) + std::abs(x[1] + 2.) +
+                       std::abs(x[2]) * std::abs(x[0]));
+      numEvals++;
+    }
+    return values;
+  };
+  for (std::size_t maxEval = 4; maxEval < 60; maxEval++) {
+    cudaq::optimizers::batch_nelder_mead opt;
+    opt.max_eval = maxEval;
+    opt.f_tol = 0.;
+    numEvals = 0;
+    opt.optimize(3, objective);
+    EXPECT_LE(numEvals, maxEval);
+  }
+}
+
+CUDAQ_TEST_F(VQETester, checkCmaesBudget) {
+  // The population is reduced to fit a small budget, and the initial point is
+  // evaluated if not even two evaluations fit.
+  std::size_t numEvals = 0;
+  auto f = [](const std::vector<double> &x) {
+    return (x[0] - 1.) * (x[0] - 1.) + x[1] * x[1];
+  };
+  auto objective = [&](const std::vector<std::vector<double>> &xs) {
+    std::vector<double> values;
+    for (const auto &x : xs) {
+      values.push_back(f(x));
+      numEvals++;
+    }
+    return values;
+  };
+  for (std::size_t maxEval = 1; maxEval < 12; maxEval++) {
+    cudaq::optimizers::cmaes opt;
+    opt.max_eval = maxEval;
+    opt.initial_parameters = {0., 0.};
+    numEvals = 0;
+    auto [optVal, optParams] = opt.optimize(2, objective);
+    EXPECT_LE(numEvals, maxEval);
+    EXPECT_DOUBLE_EQ(f(optParams), optVal);
+  }
+}
+
 CUDAQ_TEST_F(VQETester, checkDifferentArgStructure) {
   cudaq::optimizers::cobyla c_opt;
   auto argMapper = [](std::vector<double> x) { return std::make_tuple(x[0]); };
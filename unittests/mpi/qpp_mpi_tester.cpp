@@ -0,0 +1,115 @@
+/*******************************************************************************
+ * Copyright (c) 2022 - 2025 NVIDIA Corporation & Affiliates.                  *
+ * All rights reserved.                                                        *
+ *                                                                             *
+ * This source code and the accompanying materials are made available under    *
+ * the terms of the Apache License 2.0 which accompanies this distribution.    *
+ ******************************************************************************/
+#include <cudaq.h>
+#include <gtest/gtest.h>
+
+// The state vector is distributed over the ranks once every rank holds at
+// least 4 qubits, hence these kernels use more than `log2(NUM_PROCS) + 4`
+// qubits, and gates on the (initially global) highest qubits.
+
+TEST(QppMPITester, checkInit) {
+  EXPECT_TRUE(cudaq::mpi::is_initialized());
+  EXPECT_EQ(cudaq::mpi::num_ranks(), NUM_PROCS);
+}
+
+TEST(QppMPITester, checkGHZ) {
+  constexpr std::size_t numQubits = 20;
+  auto kernel = []() __qpu__ {
+    cudaq::qvector q(numQubits);
+    h(q[numQubits - 1]);
+    for (int i = numQubits - 1; i > 0; i--)
+      x<cudaq::ctrl>(q[i], q[i - 1]);
+    mz(q);
+  };
+
+  auto counts = cudaq::sample(1000, kernel);
+  // All ranks get the same results.
+  EXPECT_EQ(2, counts.size());
+  EXPECT_EQ(1000, counts.count(std::string(numQubits, '0')) +
+                      counts.count(std::string(numQubits, '1')));
+  const double numZeros = counts.count(std::string(numQubits, '0'));
+  EXPECT_EQ(cudaq::mpi::all_reduce(numZeros, std::plus<double>()),
+            NUM_PROCS * numZeros);
+}
+
+struct productState {
+  void operator()(std::vector<double> angles) __qpu__ {
+    cudaq::qvector q(angles.size());
+    for (std::size_t i = 0; i < angles.size(); i++)
+      ry(angles[i], q[i]);
+  }
+};
+
+TEST(QppMPITester, checkObserve) {
+  constexpr std::size_t numQubits = 10;
+  std::vector<double> angles;
+  for (std::size_t i = 0; i < numQubits; i++)
+    angles.push_back(0.1 + 0.3 * i);
+
+  // <X_i> = sin(angle_i), <Z_i> = cos(angle_i) for the product state.
+  auto h = cudaq::spin_op::empty();
+  double expected = 0.;
+  for (std::size_t i = 0; i < numQubits; i++) {
+    h += cudaq::spin_op::x(i);
+    expected += std::sin(angles[i]);
+    if (i + 1 < numQubits) {
+      h += cudaq::spin_op::z(i) * cudaq::spin_op::z(i + 1);
+      expected += std::cos(angles[i]) * std::cos(angles[i + 1]);
+    }
+  }
+  // <Y_i> = 0, and X and Y on the global qubits require exchanges.
+  h += cudaq::spin_op::y(0) * cudaq::spin_op::y(numQubits - 1);
+
+  auto result = cudaq::observe(productState{}, h, angles);
+  EXPECT_NEAR(result.expectation(), expected, 1e-9);
+}
+
+TEST(QppMPITester, checkGetState) {
+  constexpr std::size_t numQubits = 8;
+  std::vector<double> angles;
+  for (std::size_t i = 0; i < numQubits; i++)
+    angles.push_back(0.2 * (i + 1));
+
+  auto state = cudaq::get_state(productState{}, angles);
+  EXPECT_EQ(state.get_num_qubits(), numQubits);
+  // The amplitude of each basis state is the product of cos(angle / 2) and
+  // sin(angle / 2) for the qubits in |0> and |1> respectively.
+  for (std::size_t index : {0ul, 1ul, 128ul, 129ul, 255ul}) {
+    double expected = 1.;
+    for (std::size_t i = 0; i < numQubits; i++)
+      expected *= ((index >> i) & 1) ? std::sin(angles[i] / 2.)
+                                     : std::cos(angles[i] / 2.);
+    EXPECT_NEAR(state[index].real(), expected, 1e-9);
+  }
+}
+
+TEST(QppMPITester, checkMidCircuitMeasurement) {
+  constexpr std::size_t numQubits = 8;
+  auto kernel = []() __qpu__ {
+    cudaq::qvector q(numQubits);
+    x(q[numQubits - 1]);
+    auto bit = mz(q[numQubits - 1]);
+    if (bit)
+      x(q[0]);
+    reset(q[numQubits - 1]);
+    mz(q);
+  };
+
+  // The circuit is deterministic.
+  auto counts = cudaq::sample(100, kernel);
+  EXPECT_EQ(1, counts.size());
+  EXPECT_EQ(100, counts.get_total_shots());
+}
+
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  cudaq::mpi::initialize();
+  const auto testResult = RUN_ALL_TESTS();
+  cudaq::mpi::finalize();
+  return testResult;
+}
@@ -7,6 +7,7 @@
  ******************************************************************************/
 #include <cudaq.h>
 #include <cudaq/algorithm.h>
+#include <cudaq/optimizers.h>
 #include <gtest/gtest.h>
 #include <random>
 
@@ -29,6 +30,41 @@ TEST(MQPUTester, checkSimple) {
   printf("Get energy directly as double %.16lf\n", result);
 }
 
+TEST(MQPUTester, checkObserveBatch) {
+  cudaq::spin_op h =
+      5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+      2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+      .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+
+  auto ansatz = [](std::vector<double> theta) __qpu__ {
+    cudaq::qubit q, r;
+    x(q);
+    ry(theta[0], r);
+    x<cudaq::ctrl>(r, q);
+  };
+
+  // More parameter vectors than QPUs, so that the batch is spread over all of
+  // them, in order.
+  auto &platform = cudaq::get_platform();
+  std::vector<std::vector<double>> xs;
+  for (std::size_t i = 0; i < 2 * platform.num_qpus() + 1; i++)
+    xs.push_back({-1. + .25 * i});
+  auto values = cudaq::observe_batch(ansatz, h, xs);
+  ASSERT_EQ(xs.size(), values.size());
+  for (std::size_t i = 0; i < xs.size(); i++)
+    EXPECT_NEAR(cudaq::observe(ansatz, h, xs[i]).expectation(), values[i],
+                1e-6);
+
+  // The generations of the population-based optimizers are evaluated as
+  // batches.
+  cudaq::optimizers::cmaes opt;
+  auto [optVal, optParams] =
+      opt.optimize(1, [&](const std::vector<std::vector<double>> &x) {
+        return cudaq::observe_batch(ansatz, h, x);
+      });
+  EXPECT_NEAR(optVal, -1.7487, 1e-3);
+}
+
 TEST(MQPUTester, checkLarge) {
 
   // This will warm up the GPUs, we don't time this
@@ -593,3 +593,34 @@ TEST(OperatorExpressions, checkSpinOpsDegreeVerification) {
   ASSERT_ANY_THROW((op1 + op2).to_matrix({{0, 3}}));
   ASSERT_NO_THROW(op1.to_matrix({{0, 3}}));
 }
+
+TEST(OperatorExpressions, checkSpinOpsCommutation) {
+  auto x = [](std::size_t target) { return cudaq::spin_op::x(target); };
+  auto y = [](std::size_t target) { return cudaq::spin_op::y(target); };
+  auto z = [](std::size_t target) { return cudaq::spin_op::z(target); };
+
+  EXPECT_FALSE(x(0).commutes_with(z(0)));
+  EXPECT_FALSE(y(0).commutes_with(2. * z(0)));
+  EXPECT_TRUE(x(0).commutes_with(x(0)));
+  EXPECT_TRUE(x(0).commutes_with(z(1)));
+  EXPECT_TRUE(cudaq::spin_op::i(0).commutes_with(y(0)));
+  EXPECT_TRUE((x(0) * x(1)).commutes_with(z(0) * z(1)));
+  EXPECT_TRUE((x(0) * y(1)).commutes_with(y(0) * x(1)));
+  EXPECT_FALSE((x(0) * y(1)).commutes_with(y(0) * y(1)));
+
+  // Degrees beyond the first word of the packed representation.
+  EXPECT_FALSE((z(3) * x(70)).commutes_with(z(70)));
+  EXPECT_TRUE((z(3) * x(70)).commutes_with(x(3) * z(70)));
+  EXPECT_TRUE((z(3) * x(70)).commutes_with(x(3) * z(70) * y(130)));
+
+  // Agrees with the commutator of the matrices.
+  auto lhs = x(0) * z(1) * y(2);
+  for (const auto &rhs : {z(0) * x(1), y(0) * y(2), x(1) * z(2), x(0) * y(2)}) {
+    auto commutator = (lhs * rhs - rhs * lhs).to_matrix();
+    bool vanishes = true;
+    for (std::size_t i = 0; i < commutator.rows(); ++i)
+      for (std::size_t j = 0; j < commutator.cols(); ++j)
+        vanishes &= std::abs(commutator[{i, j}]) < 1e-12;
+    EXPECT_EQ(vanishes, lhs.commutes_with(rhs));
+  }
+}
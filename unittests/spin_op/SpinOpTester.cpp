@@ -224,6 +224,81 @@ TEST(SpinOpTester, checkGetSparseMatrix) {
   }
 }
 
+TEST(SpinOpTester, checkSparseMatrixOfLargeSum) {
+  auto H = cudaq::spin_op::random(6, 40, 13) +
+           0.5 * cudaq::spin_op::y(0) * cudaq::spin_op::z(5) - 1.5;
+  for (bool invert_order : {false, true}) {
+    auto matrix = H.to_matrix({}, {}, invert_order);
+    // The dense matrix must match the sum of the Pauli string matrices.
+    auto expected = cudaq::complex_matrix(matrix.rows(), matrix.cols());
+    for (const auto &term : H)
+      expected += cudaq::spin_handler::to_matrix(
+          term.get_pauli_word(6), term.evaluate_coefficient(), invert_order);
+    for (std::size_t i = 0; i < matrix.rows(); ++i)
+      for (std::size_t j = 0; j < matrix.cols(); ++j)
+        EXPECT_NEAR(std::abs(matrix(i, j) - expected(i, j)), 0., 1e-12);
+
+    // Every entry of the dense matrix must be in the sparse matrix, exactly
+    // once and in row-major order.
+    auto [values, rows, cols] = H.to_sparse_matrix({}, {}, invert_order);
+    auto fromSparse = cudaq::complex_matrix(matrix.rows(), matrix.cols());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      if (i > 0)
+        EXPECT_TRUE(rows[i - 1] < rows[i] ||
+                    (rows[i - 1] == rows[i] && cols[i - 1] < cols[i]));
+      fromSparse(rows[i], cols[i]) += values[i];
+    }
+    for (std::size_t i = 0; i < matrix.rows(); ++i)
+      for (std::size_t j = 0; j < matrix.cols(); ++j)
+        EXPECT_NEAR(std::abs(matrix(i, j) - fromSparse(i, j)), 0., 1e-12);
+  }
+}
+
+TEST(SpinOpTester, checkApply) {
+  auto H = 5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
+           2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
+           .21829 * cudaq::spin_op::z(0) - 6.125 * cudaq::spin_op::z(1);
+  auto matrix = H.to_matrix();
+  std::vector<std::complex<double>> state{
+      {0.1, 0.2}, {-0.3, 0.4}, {0.5, -0.6}, {0.7, 0.8}};
+  auto result = H.apply(state);
+  ASSERT_EQ(result.size(), state.size());
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    std::complex<double> expected = 0.;
+    for (std::size_t j = 0; j < state.size(); ++j)
+      expected += matrix(i, j) * state[j];
+    EXPECT_NEAR(std::abs(result[i] - expected), 0., 1e-12);
+  }
+  EXPECT_ANY_THROW(H.apply({1., 0.}));
+}
+
+TEST(SpinOpTester, checkProductOfLargeSums) {
+  // Products of sums with constant coefficients are computed on packed Pauli
+  // words; check them against the term by term product, including degrees
+  // beyond a single word and explicit identities.
+  auto lhs = cudaq::spin_op::random(5, 30, 13) +
+             0.5 * cudaq::spin_op::x(0) * cudaq::spin_op::y(70) - 2.0;
+  auto rhs = cudaq::spin_op::random(6, 40, 17) +
+             std::complex<double>(0., 1.) * cudaq::spin_op::z(70) *
+                 cudaq::spin_op::i(3);
+
+  auto expected = cudaq::spin_op::empty();
+  for (const auto &l : lhs)
+    for (const auto &r : rhs)
+      expected += l * r;
+
+  auto product = lhs * rhs;
+  EXPECT_EQ(product.num_terms(), expected.num_terms());
+  EXPECT_EQ(product, expected);
+
+  lhs *= rhs;
+  EXPECT_EQ(lhs, expected);
+
+  auto squared = cudaq::spin_op::x(0) + cudaq::spin_op::y(0);
+  squared *= squared;
+  EXPECT_EQ(squared.to_matrix(), 2.0 * cudaq::complex_matrix::identity(2));
+}
+
 TEST(SpinOpTester, checkGetMatrix) {
   auto H = 5.907 - 2.1433 * cudaq::spin_op::x(0) * cudaq::spin_op::x(1) -
            2.1433 * cudaq::spin_op::y(0) * cudaq::spin_op::y(1) +
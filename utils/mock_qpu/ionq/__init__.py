@@ -9,7 +9,7 @@
 import cudaq
 from fastapi import FastAPI, HTTPException, Header
 from typing import Union
-import uvicorn, uuid, base64, ctypes
+import uvicorn, uuid, base64, ctypes, asyncio
 from pydantic import BaseModel
 from llvmlite import binding as llvm
 
@@ -39,6 +39,17 @@ countJobGetRequests = 0
 # Save how many qubits were needed for each test (emulates real backend)
 numQubitsRequired = 0
 
+# Number of job posts being handled, and the highest number seen at once
+inFlightJobPosts = 0
+maxInFlightJobPosts = 0
+
+# Job posts are held until this many are in flight at once (see
+# `expectConcurrentJobPosts`), so that tests of concurrent submissions do not
+# depend on timing. A post gives up waiting after the timeout, releasing all.
+expectedConcurrentJobPosts = 0
+concurrentJobPostsReached = asyncio.Event()
+concurrentJobPostsTimeout = 10
+
 llvm.initialize()
 llvm.initialize_native_target()
 llvm.initialize_native_asmprinter()
@@ -80,10 +91,23 @@ async def postJob(job: Job,
                   token: Union[str, None] = Header(alias="Authorization",
                                                    default=None)):
     global createdJobs, shots, numQubitsRequired
+    global inFlightJobPosts, maxInFlightJobPosts
 
     if token == None:
         raise HTTPException(status_code(401), detail="Credentials not provided")
 
+    # Hold the post until the expected number of posts overlap
+    inFlightJobPosts += 1
+    maxInFlightJobPosts = max(maxInFlightJobPosts, inFlightJobPosts)
+    if inFlightJobPosts >= expectedConcurrentJobPosts:
+        concurrentJobPostsReached.set()
+    try:
+        await asyncio.wait_for(concurrentJobPostsReached.wait(),
+                               timeout=concurrentJobPostsTimeout)
+    except asyncio.TimeoutError:
+        concurrentJobPostsReached.set()
+    inFlightJobPosts -= 1
+
     print('Posting job with shots = ', job.shots)
     newId = str(uuid.uuid4())
     shots = job.shots
@@ -166,6 +190,25 @@ async def getResults(jobId: str):
     return res
 
 
+# Hold the next job posts until `count` of them are in flight at once
+@app.get("/v0.3/test/expect_concurrent_job_posts/{count}")
+async def expectConcurrentJobPosts(count: int):
+    global expectedConcurrentJobPosts, maxInFlightJobPosts
+    expectedConcurrentJobPosts = count
+    maxInFlightJobPosts = 0
+    concurrentJobPostsReached.clear()
+    return {}
+
+
+# Return the highest number of job posts handled at once since the last call
+@app.get("/v0.3/test/max_in_flight_job_posts")
+async def getMaxInFlightJobPosts():
+    global maxInFlightJobPosts
+    count = maxInFlightJobPosts
+    maxInFlightJobPosts = 0
+    return {"count": count}
+
+
 def startServer(port):
     uvicorn.run(app, port=port, host='0.0.0.0', log_level="info")
 
@@ -119,12 +119,32 @@ async def postJob(data: Dict[str, Any],
         results.dump()
         createdJobs[newId] = (task.task_id, results)
 
-    engine.remove_module(m)
+        engine.remove_module(m)
 
     # Job "created", return the id
     return {"job": newId}
 
 
+def getResults(jobId: str):
+    name, counts = createdJobs[jobId]
+    retData = {}
+    for bits, count in counts.items():
+        retData[str(bits)] = count
+    return retData
+
+
+# Retrieve several jobs at once, given as a comma-separated list of ids
+@app.get("/{deviceId}/tasks/all_info")
+async def getJobs(task_ids: str):
+    return {
+        "tasks": [{
+            "task_id": jobId,
+            "results": getResults(jobId),
+            "task_error": None
+        } for jobId in task_ids.split(",")]
+    }
+
+
 # Retrieve the job, simulate having to wait by counting to 3
 # until we return the job results
 @app.get("/{deviceId}/tasks/{jobId}/all_info")
@@ -132,12 +152,7 @@ async def getJob(jobId: str):
     global countJobGetRequests, createdJobs, shots
 
     countJobGetRequests = 0
-    name, counts = createdJobs[jobId]
-    retData = {}
-    for bits, count in counts.items():
-        retData[str(bits)] = count
-
-    return {"results": retData}
+    return {"results": getResults(jobId)}
 
 
 @app.post("/tasks")